@@ -23,8 +23,9 @@
 #include "adc.hpp"
 #include "version.hpp"
 #include "types.hpp"
-#include <boost/property_tree/ptree.hpp>
-#include <boost/foreach.hpp>
+#include "pdm.hpp"
+#include "layout.hpp"
+#include "history.hpp"
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -34,6 +35,12 @@ namespace itc
 {
     namespace eps
     {
+        class JsonReader;
+
+        const uint32_t CONFIG_CACHE_MAGIC = 0x43535045; //!< Compiled config cache magic ("EPSC")
+        const uint32_t CONFIG_CACHE_VERSION = 5;        //!< Compiled config cache format version
+        const unsigned int DEFAULT_METRICS_PERIOD_MS = 10000; //!< Default metrics export period (ms)
+
         /**
          * \brief NOS engine config
          */
@@ -46,6 +53,109 @@ namespace itc
             unsigned int tick_ms; //!< NOS time tick (ms)
         };
 
+        /**
+         * \brief Power distribution module (PDM) switch load profile config
+         */
+        struct LoadConfig
+        {
+            LoadConfig() : file(), loop(false) {}
+
+            std::string file; //!< Load profile playback file (empty if none)
+            bool loop;        //!< Repeat playback flag
+        };
+
+        /**
+         * \brief Persistent EEPROM config
+         */
+        struct EepromConfig
+        {
+            EepromConfig() : dir(), file(), sync_ms(1000) {}
+
+            std::string dir;      //!< EEPROM file directory (empty if not persistent)
+            std::string file;     //!< EEPROM file, named per board address (empty if not persistent)
+            unsigned int sync_ms; //!< EEPROM file sync period (ms)
+        };
+
+        /**
+         * \brief Get persistent EEPROM file of a board
+         *
+         * \param dir EEPROM file directory (empty if not persistent)
+         * \param address EPS I2C base address
+         *
+         * \return EEPROM file (empty if not persistent)
+         */
+        std::string get_eeprom_file(const std::string& dir, uint8_t address);
+
+        /**
+         * \brief EPS simulator window config
+         */
+        struct GuiConfig
+        {
+            GuiConfig() : refresh_hz(20) {}
+            double refresh_hz; //!< Window refresh rate (Hz)
+        };
+
+        /**
+         * \brief EPS simulator thread (actor) config
+         */
+        struct ActorConfig
+        {
+            ActorConfig() : enabled(false), cpu(-1) {}
+            bool enabled; //!< Run the EPS on its own thread fed by a task queue (otherwise lock it with a mutex)
+            int cpu;      //!< CPU to pin the simulator thread to (negative to not pin)
+        };
+
+        /**
+         * \brief Telemetry history config (strip charts)
+         */
+        struct HistoryConfig
+        {
+            HistoryConfig() : enabled(true), period_ms(DEFAULT_HISTORY_PERIOD_MS) {}
+            bool enabled;           //!< Record telemetry channel history
+            unsigned int period_ms; //!< History sample period (ms)
+        };
+
+        /**
+         * \brief Config file hot reload config
+         */
+        struct ReloadConfig
+        {
+            ReloadConfig() : enabled(false), debounce_ms(100) {}
+            bool enabled;             //!< Watch the config file and apply changes while running
+            unsigned int debounce_ms; //!< Time to wait for further writes before reloading (ms)
+        };
+
+        /**
+         * \brief Per command statistics config
+         */
+        struct StatsConfig
+        {
+            StatsConfig() : enabled(true) {}
+            bool enabled; //!< Count commands and record transaction latency per command type
+        };
+
+        /**
+         * \brief Periodic operational metrics export config (soak test dashboards)
+         */
+        struct MetricsConfig
+        {
+            MetricsConfig() : enabled(false), period_ms(DEFAULT_METRICS_PERIOD_MS), textfile(), shm() {}
+            bool enabled;           //!< Export metrics periodically (also counts commands if stats are disabled)
+            unsigned int period_ms; //!< Export period (ms)
+            std::string textfile;   //!< Prometheus text format file (empty to not write)
+            std::string shm;        //!< Shared memory metrics block name (empty to not publish)
+        };
+
+        /**
+         * \brief Shared memory state segment config (out of process viewers)
+         */
+        struct ShmConfig
+        {
+            ShmConfig() : enabled(false), name() {}
+            bool enabled;     //!< Publish state frames and accept edits over shared memory
+            std::string name; //!< Segment name (defaults to a name per board address)
+        };
+
         /**
          * \brief EPS simulator config
          */
@@ -56,24 +166,33 @@ namespace itc
              * \brief Constructor
              *
              * \param cfgfile The EPS simulator config file to load
+             * \param cachefile Compiled config cache file (empty if not cached)
              *
              * \throw boost::property_tree::json_parser_error Error parsing config file
+             * \throw std::invalid_argument Invalid board topology
              */
-            Config(const std::string& cfgfile = "");
+            Config(const std::string& cfgfile = "", const std::string& cachefile = "");
 
             /**
              * \brief Load the EPS simulator config file
              *
+             * The config file is read in one pass, without building a document tree. If a cache
+             * file is given, the config is loaded from it when it was compiled from the same config
+             * file contents, otherwise the config file is parsed and the cache is (re)written.
+             *
              * \param cfgfile The EPS simulator config file to load
+             * \param cachefile Compiled config cache file (empty if not cached)
              *
              * \throw boost::property_tree::json_parser_error Error parsing config file
+             * \throw std::invalid_argument Invalid board topology
              */
-            void load(const std::string& cfgfile);
+            void load(const std::string& cfgfile, const std::string& cachefile = "");
             
         public:
             std::string log_level; //!< Log level
             ByteSwapConfig swap;   //!< byte swap config
             NosConfig nos;         //!< NOS engine config
+            GuiConfig gui;         //!< EPS simulator window config
             uint8_t eps_address;   //!< EPS I2C base address
 
             Version version; //!< EPS board version
@@ -81,35 +200,108 @@ namespace itc
             bool db_connected;  //!< EPS daughterboard connected
             Version db_version; //!< EPS daughterboard version
 
+            BoardLayout layout; //!< EPS board layout (built-in layout if no topology configured)
+
+            EepromConfig eeprom; //!< Persistent EEPROM config
+            ActorConfig actor;   //!< EPS simulator thread config
+            ShmConfig shm;       //!< Shared memory state segment config
+            HistoryConfig history; //!< Telemetry history config
+            ReloadConfig reload;   //!< Config file hot reload config
+            StatsConfig stats;     //!< Per command statistics config
+            MetricsConfig metrics; //!< Metrics export config
+
             typedef std::vector<bool> SwitchStates;
             SwitchStates switch_states; //!< Power distribution module (PDM) switch states
 
-            typedef std::map<ChannelCode, double> Telemetry;
+            typedef std::vector<PdmTripConfig> SwitchTrips;
+            SwitchTrips switch_trips; //!< Power distribution module (PDM) switch overcurrent trip configs
+
+            bool load_aggregation; //!< Aggregate power conditioning module (PCM) currents from switch loads
+
+            typedef std::vector<LoadConfig> SwitchLoads;
+            SwitchLoads switch_loads; //!< Power distribution module (PDM) switch load profiles
+
+            typedef TelemetryValues Telemetry;
             Telemetry tlm; //!< Default sim telemetry
 
-            typedef std::map<ChannelCode, ConverterParams> ChannelConfig;
+            typedef ConverterConfig ChannelConfig;
             ChannelConfig adc; //!< Analog telemetry channel config
 
         private:
             /**
-             * \brief Get array values from config
+             * \brief Parse config document
+             *
+             * \param reader Config document reader
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             * \throw std::invalid_argument Invalid board topology
+             */
+            void parse(JsonReader& reader);
+
+            /**
+             * \brief Parse EPS board config section
+             *
+             * \param reader Config document reader (at the eps section)
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             * \throw std::invalid_argument Invalid board topology
+             */
+            void parse_eps(JsonReader& reader);
+
+            /**
+             * \brief Parse analog telemetry channel config section
+             *
+             * \param reader Config document reader (at the tlm section)
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             */
+            void parse_tlm(JsonReader& reader);
+
+            /**
+             * \brief Parse board layout from topology config
+             *
+             * Buses are listed in order with a name, type (bcr, pcm, or pdm), number of regulator
+             * units (bcr only), and parent bus names. Channels map telemetry codes to a bus, slot
+             * (voltage, current, current_b, temp, temp_b, sun, sun_b, or misc), and unit. Switches
+             * and pcm resets list bus names in command number order.
+             *
+             * \param reader Config document reader (at the topology section)
+             *
+             * \return Board layout
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             * \throw std::invalid_argument Invalid board topology
+             */
+            BoardLayout parse_layout(JsonReader& reader);
+
+            /**
+             * \brief Get compiled config cache key
+             *
+             * \param source Config file contents
+             *
+             * \return Checksum of the config file contents (64 bit FNV-1a)
+             */
+            static uint64_t get_cache_key(const std::string& source);
+
+            /**
+             * \brief Load config from compiled cache file (memory mapped)
+             *
+             * \param cachefile Compiled config cache file
+             * \param key Checksum of the config file contents the cache must be compiled from
+             *
+             * \return True if a valid cache for the config file contents was loaded
+             */
+            bool load_cache(const std::string& cachefile, uint64_t key);
+
+            /**
+             * \brief Write config to compiled cache file
              *
-             * \param cfg Config section containing array
-             * \param size Expected array size
+             * \param cachefile Compiled config cache file
+             * \param key Checksum of the config file contents
              *
-             * \return Array values
+             * \return True if the cache was written
              */
-            template <typename T>
-            std::vector<T> get_config_array(boost::property_tree::ptree& cfg, unsigned int size)
-            {
-                std::vector<T> values;
-                BOOST_FOREACH(boost::property_tree::ptree::value_type &val, cfg)
-                {
-                    values.push_back(val.second.get_value<T>());
-                }
-                values.resize(size, T());
-                return values;
-            }
+            bool save_cache(const std::string& cachefile, uint64_t key) const;
         };
     }
 }
@@ -0,0 +1,153 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef ITC_EPS_CONFIG_WATCH_HPP
+#define ITC_EPS_CONFIG_WATCH_HPP
+
+#include "config.hpp"
+#include "version.hpp"
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Changes between two EPS simulator configs
+         *
+         * Telemetry defaults, converter params, switch defaults, and board versions are applied
+         * to a running simulator. Other changed settings are listed, they take effect on restart.
+         */
+        struct ConfigDiff
+        {
+            ConfigDiff() :
+                tlm(), adc(), switch_states(), version_changed(false), version(),
+                db_version_changed(false), db_version(), restart()
+            {}
+
+            /**
+             * \brief Get empty diff state
+             *
+             * \return True if nothing is applied to a running simulator
+             */
+            bool empty() const;
+
+            Config::Telemetry tlm;                      //!< Changed default telemetry values
+            Config::ChannelConfig adc;                  //!< Changed converter params
+            std::map<unsigned int, bool> switch_states; //!< Changed switch defaults by switch number
+            bool version_changed;                       //!< EPS board version changed
+            Version version;                            //!< EPS board version
+            bool db_version_changed;                    //!< EPS daughterboard version changed
+            Version db_version;                         //!< EPS daughterboard version
+            std::vector<std::string> restart;           //!< Changed settings not applied until restart
+        };
+
+        /**
+         * \brief Compare EPS simulator configs
+         *
+         * \param running Config the simulator is running with
+         * \param updated Updated config
+         *
+         * \return Changes from running to updated config
+         */
+        ConfigDiff diff_config(const Config& running, const Config& updated);
+
+        /**
+         * \brief EPS simulator config file watcher (hot reload)
+         *
+         * Watches the config file directory with inotify (editors often replace the file), and
+         * on change re-parses the config on the watcher thread and hands the diff against the
+         * running config to the apply handler. Invalid configs are logged and ignored.
+         */
+        class ConfigWatcher
+        {
+        public:
+            typedef std::function<void(const ConfigDiff&)> ApplyHandler;
+
+            /**
+             * \brief Constructor
+             *
+             * \param cfgfile Config file to watch
+             * \param cachefile Compiled config cache file (empty if not cached)
+             * \param config Config the simulator is running with
+             * \param apply Handler applying changes to the simulator (called on the watcher thread)
+             */
+            ConfigWatcher(const std::string& cfgfile, const std::string& cachefile, const Config& config,
+                          ApplyHandler apply);
+
+            /**
+             * \brief Destructor (stops watching)
+             */
+            ~ConfigWatcher();
+
+            /**
+             * \brief Start watching the config file
+             *
+             * \return True if the watcher was started
+             */
+            bool start();
+
+            /**
+             * \brief Stop watching the config file
+             */
+            void stop();
+
+        private:
+            ConfigWatcher(const ConfigWatcher&) = delete;
+            ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+            /**
+             * \brief Watcher thread (waits for config file changes)
+             */
+            void run();
+
+            /**
+             * \brief Wait for file events
+             *
+             * \param timeout_ms Wait timeout (ms, negative to wait until an event or stop)
+             *
+             * \return True if the config file changed, false on timeout or stop
+             */
+            bool wait_change(int timeout_ms);
+
+            /**
+             * \brief Reload config file and apply changes
+             */
+            void reload();
+
+        private:
+            const std::string cfgfile;   //!< Config file
+            const std::string cachefile; //!< Compiled config cache file
+            std::string dir;             //!< Watched directory
+            std::string name;            //!< Config file name within directory
+            Config config;               //!< Running config (watcher thread)
+            ApplyHandler apply;          //!< Handler applying changes to the simulator
+            int inotify_fd;              //!< Inotify instance (negative if not watching)
+            int stop_fd[2];              //!< Stop request pipe (read, write)
+            bool stopping;               //!< Stop requested (watcher thread)
+            std::thread thread;          //!< Watcher thread
+        };
+    }
+}
+
+#endif
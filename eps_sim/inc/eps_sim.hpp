@@ -21,10 +21,17 @@
 #define ITC_EPS_SIM_HPP
 
 #include "eps.hpp"
+#include "actor.hpp"
 #include "config.hpp"
+#include "metrics.hpp"
+#include "shm.hpp"
+#include "startup.hpp"
 #include <Common/types.hpp>
 #include <I2C/Client/I2CSlave.hpp>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace NosEngine
 {
@@ -35,25 +42,38 @@ namespace NosEngine
     }
 }
 
-class EpsWindow;
-class Fl_Widget;
-
 namespace itc
 {
     namespace eps
     {
+        struct ConfigDiff;
+        struct BoardConfig;
+
         /**
-         * \brief EPS simulator
+         * \brief EPS simulator (NOS I2C slave, no user interface)
          */
         class EpsSim : public NosEngine::I2C::I2CSlave
         {
         public:
             /**
-             * \brief Constructor
+             * \brief Constructor (connects to NOS and initializes the EPS)
              *
              * \param config EPS simulator config
+             * \param startup Startup timing (null if not profiled)
              */
-            EpsSim(const Config& config);
+            EpsSim(const Config& config, StartupProfile *startup = nullptr);
+
+            /**
+             * \brief Constructor for a fleet board (connects to NOS, forks the EPS from a prototype)
+             *
+             * The board shares the prototype's immutable configuration, only its overrides are
+             * applied. The EEPROM file and shared memory segment are named per board address.
+             *
+             * \param base Base board config (fleet profile)
+             * \param board Board overrides
+             * \param prototype EPS configured from the base board config (see create_eps())
+             */
+            EpsSim(const Config& base, const BoardConfig& board, const Eps& prototype);
 
             /**
              * \brief Destructor
@@ -61,9 +81,121 @@ namespace itc
             virtual ~EpsSim();
 
             /**
-             * \brief Minimize the EPS simulator window
+             * \brief Create EPS configured from config (not attached to NOS or files)
+             *
+             * \param config EPS simulator config
+             *
+             * \return Configured EPS
+             */
+            static std::unique_ptr<Eps> create_eps(const Config& config);
+
+            /**
+             * \brief Save EPS simulator state to snapshot file
+             *
+             * \param filename Snapshot file
+             *
+             * \return True if snapshot was saved
+             */
+            bool save_snapshot(const std::string& filename);
+
+            /**
+             * \brief Load EPS simulator state from snapshot file
+             *
+             * \param filename Snapshot file
+             *
+             * \return True if snapshot was loaded
+             */
+            bool load_snapshot(const std::string& filename);
+
+            /**
+             * \brief Flush persistent EEPROM changes to file
+             */
+            void sync_eeprom();
+
+            /**
+             * \brief Write per command statistics report
+             *
+             * \param filename Report file (empty to log the report)
+             *
+             * \return True if the report was written (false if statistics are disabled)
+             */
+            bool dump_stats(const std::string& filename);
+
+            /**
+             * \brief Run task on the EPS (simulator thread, or under the EPS mutex)
+             *
+             * \param task Task
+             * \param wait If true wait for the task to complete
              */
-            void minimize();
+            void execute(EpsTask task, bool wait);
+
+            /**
+             * \brief Apply viewer edit to the EPS (does not wait)
+             *
+             * \param command Edit command
+             */
+            void apply_edit(const EditCommand& command);
+
+            /**
+             * \brief Apply config changes to the running EPS (one task, waits)
+             *
+             * \param diff Config changes
+             */
+            void apply_config(const ConfigDiff& diff);
+
+            /**
+             * \brief Apply pending edits from out of process viewers (shared memory)
+             */
+            void poll_edits();
+
+            /**
+             * \brief Get published EPS state frames
+             *
+             * \return State frame publisher
+             */
+            std::shared_ptr<const FramePublisher> get_frames() const;
+
+            /**
+             * \brief Get recorded telemetry history
+             *
+             * \return Channel history store (null if disabled)
+             */
+            std::shared_ptr<const HistoryStore> get_history() const;
+
+            /**
+             * \brief Get per command statistics
+             *
+             * \return Command statistics (null if disabled)
+             */
+            std::shared_ptr<const CommandStats> get_stats() const;
+
+            /**
+             * \brief Get time spent waiting for the EPS mutex
+             *
+             * \return Lock wait durations (recorded only if metrics are enabled)
+             */
+            const DurationCounter& get_lock_wait() const;
+
+            /**
+             * \brief Get time spent refreshing the simulator window
+             *
+             * \return Window refresh durations (recorded by the window)
+             */
+            const DurationCounter& get_frame_time() const;
+
+            /**
+             * \brief Get time spent refreshing the simulator window
+             *
+             * \return Window refresh durations (recorded by the window)
+             */
+            DurationCounter& get_frame_time();
+
+            /**
+             * \brief Get latest simulated time received from NOS
+             *
+             * \return Simulated time (ms)
+             */
+            uint64_t get_sim_time_ms() const;
 
             /*
              * \brief I2C master read
@@ -87,42 +219,63 @@ namespace itc
 
         private:
             /**
-             * \brief Callback to handle NOS time ticks
+             * \brief Attach persistent EEPROM, shared memory, history, and simulator thread to the EPS
              *
-             * \param time New NOS time
+             * \param config EPS simulator config
+             * \param eeprom_file EEPROM file (empty if not persistent)
+             * \param shm_name Shared memory segment name
              */
-            void on_time_tick(NosEngine::Common::SimTime time);
+            void attach(const Config& config, const std::string& eeprom_file, const std::string& shm_name);
 
             /**
-             * \brief Callback to handle telemetry updates
+             * \brief Callback to handle NOS time ticks
              *
-             * \param widget Telemetry widget
-             * \param user User data
+             * \param time New NOS time
              */
-            static void on_tlm_update(Fl_Widget *widget, void *user);
+            void on_time_tick(NosEngine::Common::SimTime time);
 
             /**
-             * \brief Callback to handle switch state updates
-             *
-             * \param widget Switch widget
-             * \param user User data
+             * \brief NOS callback in progress (counted while the simulator accepts callbacks)
              */
-            static void on_switch_update(Fl_Widget *widget, void *user);
+            struct NosCall
+            {
+                /**
+                 * \brief Constructor (enters callback)
+                 *
+                 * \param sim EPS simulator
+                 */
+                NosCall(EpsSim& sim);
 
-            /**
-             * \brief Update window with latest EPS data
-             */
-            void update_win();
+                /**
+                 * \brief Destructor (leaves callback)
+                 */
+                ~NosCall();
+
+                EpsSim& sim;   //!< EPS simulator
+                bool accepted; //!< Flag indicating the callback may use the EPS
+            };
 
         private:
-            std::mutex mutex;   //!< Mutex for thread safety
+            std::mutex mutex;   //!< Mutex for thread safety (if not using simulator thread)
+            std::atomic<bool> nos_enabled;     //!< Flag indicating NOS callbacks are accepted
+            std::atomic<unsigned int> nos_calls; //!< NOS callbacks in progress
 
             NosEngine::Client::Bus time_bus; //!< NOS client time bus
             unsigned int tick_ms; //!< NOS time tick (ms)
 
-            itc::eps::Eps eps; //!< EPS simulator
+            std::unique_ptr<Eps> eps; //!< EPS simulator
+            std::shared_ptr<EepromStore> eeprom; //!< Persistent EEPROM store (null if not persistent)
+            std::unique_ptr<EpsActor> actor; //!< EPS simulator thread (null if EPS is locked by mutex)
+
+            std::shared_ptr<ShmServer> shm; //!< Shared memory state segment (null if not shared)
+            std::shared_ptr<const FramePublisher> frames; //!< Published EPS state frames
+            std::shared_ptr<const HistoryStore> history;  //!< Recorded telemetry history (null if disabled)
+            std::shared_ptr<CommandStats> stats;          //!< Per command statistics (null if disabled)
 
-            EpsWindow *win; //!< EPS simulator window
+            DurationCounter lock_wait;             //!< EPS mutex wait durations
+            DurationCounter frame_time;            //!< Window refresh durations
+            std::atomic<uint64_t> sim_time_ms;     //!< Latest simulated time received from NOS (ms)
+            bool lock_timing;                      //!< Record EPS mutex wait durations
         };
     }
 }
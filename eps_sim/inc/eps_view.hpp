@@ -0,0 +1,168 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef ITC_EPS_VIEW_HPP
+#define ITC_EPS_VIEW_HPP
+
+#include "frame.hpp"
+#include "history.hpp"
+#include "shm.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+class EpsWindow;
+class Fl_Widget;
+
+namespace itc
+{
+    namespace eps
+    {
+        class DurationCounter;
+
+        /**
+         * \brief EPS simulator window (FLTK)
+         *
+         * Runs on the FLTK thread. The window is refreshed from published state frames by a
+         * timer, edits are handed to the edit handler (simulator in process, or the shared
+         * memory edit ring of a viewer process).
+         */
+        class EpsView
+        {
+        public:
+            typedef std::function<void(const EditCommand&)> EditHandler;
+
+            /**
+             * \brief Constructor (window is not shown until show or minimize)
+             *
+             * \param frames Published EPS state frames
+             * \param history Recorded telemetry history (null to record from frames at the refresh rate)
+             * \param edit Edit handler
+             * \param refresh_hz Window refresh rate (Hz)
+             * \param prepared Window built ahead of the view, ownership is taken (null to build here)
+             */
+            EpsView(std::shared_ptr<const FramePublisher> frames, std::shared_ptr<const HistoryStore> history,
+                    EditHandler edit, double refresh_hz, EpsWindow *prepared = nullptr);
+
+            /**
+             * \brief Destructor
+             */
+            ~EpsView();
+
+            /**
+             * \brief Show the EPS simulator window
+             */
+            void show();
+
+            /**
+             * \brief Minimize the EPS simulator window
+             */
+            void minimize();
+
+            /**
+             * \brief Show simulator connection state
+             *
+             * \param connected True if the simulator is running
+             */
+            void set_connected(bool connected);
+
+            /**
+             * \brief Record window refresh durations
+             *
+             * \param counter Duration counter (null to not record)
+             */
+            void set_frame_time(DurationCounter *counter);
+
+        private:
+            EpsView(const EpsView&) = delete;
+            EpsView& operator=(const EpsView&) = delete;
+
+            /**
+             * \brief Callback to handle telemetry updates
+             *
+             * \param widget Telemetry widget
+             * \param user User data
+             */
+            static void on_tlm_update(Fl_Widget *widget, void *user);
+
+            /**
+             * \brief Callback to handle switch state updates
+             *
+             * \param widget Switch widget
+             * \param user User data
+             */
+            static void on_switch_update(Fl_Widget *widget, void *user);
+
+            /**
+             * \brief Callback to handle telemetry filter updates
+             *
+             * \param widget Filter widget
+             * \param user User data
+             */
+            static void on_filter_update(Fl_Widget *widget, void *user);
+
+            /**
+             * \brief Callback to handle telemetry channel selection (charted channel)
+             *
+             * \param widget Telemetry table widget
+             * \param user User data
+             */
+            static void on_channel_select(Fl_Widget *widget, void *user);
+
+            /**
+             * \brief Callback to handle chart span updates
+             *
+             * \param widget Span widget
+             * \param user User data
+             */
+            static void on_span_update(Fl_Widget *widget, void *user);
+
+            /**
+             * \brief Timer callback to refresh window at the configured rate (GUI thread)
+             *
+             * \param user User data
+             */
+            static void on_refresh(void *user);
+
+            /**
+             * \brief Update window with latest published EPS state frame (GUI thread)
+             *
+             * Reads the frame without locking the EPS. Only areas and visible channels changed
+             * since the last update are redrawn, nothing is done if no frame was published.
+             *
+             * \param full If true redraw everything
+             */
+            void update_win(bool full = false);
+
+        private:
+            std::shared_ptr<const FramePublisher> frames; //!< Published EPS state frames
+            EditHandler edit; //!< Edit handler
+            std::shared_ptr<HistoryStore> recorder; //!< History recorded from frames (null if simulator history is shared)
+
+            EpsWindow *win; //!< EPS simulator window
+            double refresh_s;     //!< Window refresh period (s)
+            StateFrame win_frame; //!< EPS state frame shown in window
+            uint64_t win_count;   //!< Published frame count shown in window
+            bool win_full;        //!< Flag indicating next window update redraws everything
+            DurationCounter *frame_time; //!< Window refresh durations (null if not recorded)
+        };
+    }
+}
+
+#endif
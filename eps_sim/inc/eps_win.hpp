@@ -5,12 +5,18 @@
 #include <FL/Fl.H>
 #undef Status
 #include "widgets.hpp"
+#include "tlm_table.hpp"
+#include "strip_chart.hpp"
+#include <vector>
 #include <FL/Fl_Window.H>
 #include <FL/Fl_Group.H>
 #include <FL/Fl_Light_Button.H>
 #include <FL/Fl_Value_Output.H>
 #include <FL/Fl_Output.H>
 #include <FL/Fl_Box.H>
+#include <FL/Fl_Scroll.H>
+#include <FL/Fl_Choice.H>
+#include <FL/Fl_Table.H>
 
 class EpsWindow : public Fl_Window {
   void _EpsWindow();
@@ -18,7 +24,7 @@ public:
   EpsWindow(int X, int Y, int W, int H, const char *L = 0);
   EpsWindow(int W, int H, const char *L = 0);
   EpsWindow();
-  itc::eps::TlmWidgetMap tlm; 
+  std::vector<itc::eps::SwitchButton*> switch_in; 
   Fl_Light_Button *nos_status_out;
   Fl_Value_Output *sim_time_out;
   Fl_Value_Output *firmware_out;
@@ -31,6 +37,10 @@ public:
   Fl_Light_Button *status_out[7];
   Fl_Output *error_code_out;
   Fl_Output *error_msg_out;
-  itc::eps::SwitchButton *switch_in[10];
+  Fl_Scroll *switch_scroll;
+  Fl_Choice *tlm_filter;
+  itc::eps::TlmTable *tlm_table;
+  Fl_Choice *chart_span;
+  itc::eps::StripChart *tlm_chart;
 };
 #endif
@@ -0,0 +1,117 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef ITC_EPS_EVENT_LOOP_HPP
+#define ITC_EPS_EVENT_LOOP_HPP
+
+#include "config.hpp"
+#include "eps_sim.hpp"
+#include "startup.hpp"
+#include <csignal>
+#include <string>
+
+namespace itc
+{
+    namespace eps
+    {
+        const double CHECKPOINT_POLL_S = 0.25; //!< Checkpoint request poll period (s)
+        const double EDIT_POLL_S = 0.05;       //!< Viewer edit poll period (s)
+
+        class Fleet;
+
+        /**
+         * \brief EPS simulator run options (command line)
+         */
+        struct RunOptions
+        {
+            RunOptions() : checkpoint(), stats(), iconized(false), startup(nullptr) {}
+            std::string checkpoint;  //!< Snapshot file written on SIGUSR1
+            std::string stats;       //!< Command statistics file written on SIGUSR2 and at exit (empty to log)
+            bool iconized;           //!< Start window iconized (ignored if headless)
+            StartupProfile *startup; //!< Startup timing, reported when the loop is ready (null if not profiled)
+        };
+
+        /**
+         * \brief Save checkpoint snapshot if requested by signal
+         *
+         * \param sim EPS simulator
+         * \param file Checkpoint snapshot file
+         */
+        void poll_checkpoint(EpsSim& sim, const std::string& file);
+
+        /**
+         * \brief Save checkpoint snapshots of all fleet boards if requested by signal
+         *
+         * \param fleet EPS simulator fleet
+         * \param file Checkpoint snapshot file prefix (one file per board)
+         */
+        void poll_checkpoint(Fleet& fleet, const std::string& file);
+
+        /**
+         * \brief Write command statistics report (and trace, if tracing) if requested by signal
+         *
+         * \param sim EPS simulator
+         * \param file Statistics report file (empty to log)
+         */
+        void poll_stats(EpsSim& sim, const std::string& file);
+
+        /**
+         * \brief Write command statistics reports of all fleet boards (and trace, if tracing) if requested by signal
+         *
+         * \param fleet EPS simulator fleet
+         * \param file Statistics report file prefix (one file per board, empty to log)
+         */
+        void poll_stats(Fleet& fleet, const std::string& file);
+
+        /**
+         * \brief Prepare event loop resources that do not need the simulator (window build)
+         *
+         * Runs on the main thread while the simulator connects to NOS on a worker thread.
+         *
+         * \param config EPS simulator config
+         */
+        void prepare_event_loop(const Config& config);
+
+        /**
+         * \brief Run simulator event loop until exit
+         *
+         * Implemented by the FLTK window loop (gui_loop.cpp) or the headless loop
+         * (headless_loop.cpp), linked per executable.
+         *
+         * \param sim EPS simulator
+         * \param config EPS simulator config
+         * \param options Run options
+         *
+         * \return Process exit code
+         */
+        int run_event_loop(EpsSim& sim, const Config& config, const RunOptions& options);
+
+        /**
+         * \brief Run fleet event loop until exit (no window, viewers attach per board over shared memory)
+         *
+         * \param fleet EPS simulator fleet
+         * \param options Run options
+         *
+         * \return Process exit code
+         */
+        int run_fleet_loop(Fleet& fleet, const RunOptions& options);
+    }
+}
+
+#endif
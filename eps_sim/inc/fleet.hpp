@@ -0,0 +1,233 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_FLEET_HPP
+#define ITC_EPS_FLEET_HPP
+
+#include "config.hpp"
+#include "eps_sim.hpp"
+#include "startup.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        struct ConfigDiff;
+
+        /**
+         * \brief Fleet board config (overrides of the base board profile)
+         */
+        struct BoardConfig
+        {
+            BoardConfig() : name(), address(0), i2c_bus(), tlm(), switch_states() {}
+
+            std::string name;     //!< Board name (snapshot file suffix, defaults to a name per address)
+            uint8_t address;      //!< EPS I2C base address (unique in the fleet)
+            std::string i2c_bus;  //!< NOS I2C hardware bus name (empty for the base bus)
+            Config::Telemetry tlm; //!< Default telemetry values replacing base values
+            std::map<unsigned int, bool> switch_states; //!< Switch defaults replacing base values by switch number
+        };
+
+        /**
+         * \brief EPS simulator fleet config
+         *
+         * A fleet file names a base board config file (channel table, calibrations, topology) and
+         * lists per board overrides:
+         *
+         *     {"base": "eps.json",
+         *      "boards": [{"name": "eps_a", "address": 43},
+         *                 {"name": "eps_b", "address": 44, "i2c_bus": "i2c_1",
+         *                  "tlm": {"0xe110": 21.5}, "switch": {"2": true}}]}
+         *
+         * The base file (relative to the fleet file) is parsed once and shared by all boards.
+         */
+        class FleetConfig
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param fleetfile The EPS fleet config file to load
+             * \param cachefile Compiled config cache file for the base config (empty if not cached)
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             * \throw std::invalid_argument Invalid board topology
+             */
+            FleetConfig(const std::string& fleetfile = "", const std::string& cachefile = "");
+
+            /**
+             * \brief Load the EPS fleet config file and its base config file
+             *
+             * \param fleetfile The EPS fleet config file to load
+             * \param cachefile Compiled config cache file for the base config (empty if not cached)
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             * \throw std::invalid_argument Invalid board topology
+             */
+            void load(const std::string& fleetfile, const std::string& cachefile = "");
+
+        public:
+            std::string base_file;              //!< Base board config file
+            std::shared_ptr<const Config> base; //!< Base board config (shared by all boards)
+            std::vector<BoardConfig> boards;    //!< Board overrides
+
+        private:
+            /**
+             * \brief Parse fleet config document
+             *
+             * \param reader Config document reader
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             */
+            void parse(JsonReader& reader);
+
+            /**
+             * \brief Parse board overrides
+             *
+             * \param reader Config document reader (at the board object)
+             * \param board Board overrides
+             *
+             * \throw boost::property_tree::json_parser_error Error parsing config file
+             */
+            void parse_board(JsonReader& reader, BoardConfig& board) const;
+
+            /**
+             * \brief Verify board overrides against the base config
+             *
+             * \param fleetfile The EPS fleet config file
+             *
+             * \throw boost::property_tree::json_parser_error Invalid board overrides
+             */
+            void validate(const std::string& fleetfile) const;
+        };
+
+        /**
+         * \brief EPS simulator fleet (boards forked from one base board)
+         *
+         * The EPS configured from the base config is built once, each board forks it and applies
+         * its overrides, so boards only hold mutable state.
+         */
+        class Fleet
+        {
+        public:
+            /**
+             * \brief Constructor (connects each board to NOS)
+             *
+             * \param config EPS fleet config
+             * \param startup Startup timing (null if not profiled)
+             */
+            Fleet(const FleetConfig& config, StartupProfile *startup = nullptr);
+
+            /**
+             * \brief Destructor
+             */
+            ~Fleet();
+
+            /**
+             * \brief Get base board config
+             *
+             * \return Base board config
+             */
+            const Config& get_base() const;
+
+            /**
+             * \brief Get number of boards
+             *
+             * \return Number of boards
+             */
+            size_t size() const;
+
+            /**
+             * \brief Get board simulator
+             *
+             * \param index Board index
+             *
+             * \return Board simulator
+             */
+            EpsSim& get_sim(size_t index);
+
+            /**
+             * \brief Save board states to snapshot files (one file per board, named by suffix)
+             *
+             * \param filename Snapshot file prefix
+             *
+             * \return True if all snapshots were saved
+             */
+            bool save_snapshots(const std::string& filename);
+
+            /**
+             * \brief Load board states from snapshot files (one file per board, named by suffix)
+             *
+             * \param filename Snapshot file prefix
+             *
+             * \return True if all snapshots were loaded
+             */
+            bool load_snapshots(const std::string& filename);
+
+            /**
+             * \brief Flush persistent EEPROM changes of all boards to file
+             */
+            void sync_eeprom();
+
+            /**
+             * \brief Write per command statistics reports of all boards
+             *
+             * \param filename Report file prefix (one file per board, named by suffix, empty to log the reports)
+             */
+            void dump_stats(const std::string& filename);
+
+            /**
+             * \brief Apply pending edits from out of process viewers to all boards
+             */
+            void poll_edits();
+
+            /**
+             * \brief Apply base config changes to all boards (board overrides are kept)
+             *
+             * \param diff Base config changes
+             */
+            void apply_config(const ConfigDiff& diff);
+
+        private:
+            Fleet(const Fleet&) = delete;
+            Fleet& operator=(const Fleet&) = delete;
+
+            /**
+             * \brief Get snapshot or report file of a board
+             *
+             * \param filename File prefix
+             * \param board Board overrides
+             *
+             * \return Board file
+             */
+            static std::string get_board_file(const std::string& filename, const BoardConfig& board);
+
+        private:
+            std::shared_ptr<const Config> base; //!< Base board config
+            std::vector<BoardConfig> boards;    //!< Board overrides
+            std::vector<std::unique_ptr<EpsSim>> sims; //!< Board simulators in board order
+        };
+    }
+}
+
+#endif
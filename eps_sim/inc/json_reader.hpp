@@ -0,0 +1,244 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef ITC_EPS_JSON_READER_HPP
+#define ITC_EPS_JSON_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Streaming JSON reader
+         *
+         * Pull parser over a JSON document in memory. Values are read in document order without
+         * building a tree. Scalars are converted from their text like boost property_tree values
+         * (numbers, booleans, and strings are interchangeable if the text converts).
+         */
+        class JsonReader
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param data JSON document (not copied, must outlive the reader)
+             * \param size JSON document size
+             * \param filename File name reported in errors
+             */
+            JsonReader(const char *data, size_t size, const std::string& filename);
+
+            /**
+             * \brief Destructor
+             */
+            ~JsonReader();
+
+            /**
+             * \brief Begin reading object members
+             *
+             * \return True if the next value is an object (otherwise the value is skipped)
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool begin_object();
+
+            /**
+             * \brief Read next object member key (the member value is read next)
+             *
+             * \param key Member key
+             *
+             * \return False at the end of the object
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool next_member(std::string& key);
+
+            /**
+             * \brief Begin reading array elements
+             *
+             * \return True if the next value is an array (otherwise the value is skipped)
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool begin_array();
+
+            /**
+             * \brief Advance to next array element (the element value is read next)
+             *
+             * \return False at the end of the array
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool next_element();
+
+            /**
+             * \brief Read string value (scalar text)
+             *
+             * \param value Value (unchanged if the value is not a scalar or does not convert)
+             *
+             * \return True if the value was read
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool read(std::string& value);
+
+            /**
+             * \brief Read boolean value (true, false, 1, or 0)
+             *
+             * \param value Value (unchanged if the value is not a scalar or does not convert)
+             *
+             * \return True if the value was read
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool read(bool& value);
+
+            /**
+             * \brief Read integer value
+             *
+             * \param value Value (unchanged if the value is not a scalar or does not convert)
+             *
+             * \return True if the value was read
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool read(int& value);
+
+            /**
+             * \brief Read unsigned integer value
+             *
+             * \param value Value (unchanged if the value is not a scalar or does not convert)
+             *
+             * \return True if the value was read
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool read(unsigned int& value);
+
+            /**
+             * \brief Read byte value (integer text, not a character)
+             *
+             * \param value Value (unchanged if the value is not a scalar or does not convert)
+             *
+             * \return True if the value was read
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool read(uint8_t& value);
+
+            /**
+             * \brief Read floating point value
+             *
+             * \param value Value (unchanged if the value is not a scalar or does not convert)
+             *
+             * \return True if the value was read
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool read(double& value);
+
+            /**
+             * \brief Skip next value
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            void skip();
+
+            /**
+             * \brief Verify nothing follows the document
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            void finish();
+
+            /**
+             * \brief Report error at the current position
+             *
+             * \param message Error message
+             *
+             * \throw boost::property_tree::json_parser_error Always
+             */
+            [[noreturn]] void error(const std::string& message) const;
+
+        private:
+            JsonReader(const JsonReader&) = delete;
+            JsonReader& operator=(const JsonReader&) = delete;
+
+            /**
+             * \brief Skip whitespace
+             *
+             * \return Next character (0 at end of document)
+             */
+            char skip_space();
+
+            /**
+             * \brief Consume expected character (after whitespace)
+             *
+             * \param c Expected character
+             *
+             * \throw boost::property_tree::json_parser_error Unexpected character
+             */
+            void expect(char c);
+
+            /**
+             * \brief Read string token
+             *
+             * \param value Decoded string
+             *
+             * \throw boost::property_tree::json_parser_error Invalid string
+             */
+            void read_string(std::string& value);
+
+            /**
+             * \brief Read scalar text
+             *
+             * \param text Scalar text (string contents or literal)
+             *
+             * \return True if the value is a scalar (otherwise the value is skipped)
+             *
+             * \throw boost::property_tree::json_parser_error Invalid JSON
+             */
+            bool read_text(std::string& text);
+
+            /**
+             * \brief Read signed integer scalar
+             *
+             * \param value Value
+             * \param min Minimum value
+             * \param max Maximum value
+             *
+             * \return True if the value was read and is in range
+             */
+            bool read_integer(long long& value, long long min, long long max);
+
+        private:
+            const char *begin;        //!< Document begin
+            const char *pos;          //!< Read position
+            const char *end;          //!< Document end
+            std::string filename;     //!< File name reported in errors
+            std::vector<bool> first;  //!< Open containers, true until the first member/element is read
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,316 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_METRICS_HPP
+#define ITC_EPS_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        class EpsSim;
+        struct MetricsConfig;
+
+        const uint32_t METRICS_SHM_MAGIC = 0x4d535045; //!< Shared memory metrics block magic ("EPSM")
+        const uint32_t METRICS_SHM_VERSION = 1;        //!< Shared memory metrics block layout version
+        const unsigned int METRICS_NAME_SIZE = 32;     //!< Board name bytes in the shared memory metrics block
+
+        /**
+         * \brief Accumulated durations (lock free, recorded on any thread)
+         */
+        class DurationCounter
+        {
+        public:
+            /**
+             * \brief Constructor (nothing recorded)
+             */
+            DurationCounter() : count(0), total_ns(0) {}
+
+            /**
+             * \brief Record duration
+             *
+             * \param ns Duration (ns)
+             */
+            void record(uint64_t ns)
+            {
+                count.fetch_add(1, std::memory_order_relaxed);
+                total_ns.fetch_add(ns, std::memory_order_relaxed);
+            }
+
+            /**
+             * \brief Get number of recorded durations
+             *
+             * \return Number of recorded durations
+             */
+            uint64_t get_count() const {return count.load(std::memory_order_relaxed);}
+
+            /**
+             * \brief Get sum of recorded durations
+             *
+             * \return Sum of recorded durations (ns)
+             */
+            uint64_t get_total_ns() const {return total_ns.load(std::memory_order_relaxed);}
+
+        private:
+            DurationCounter(const DurationCounter&) = delete;
+            DurationCounter& operator=(const DurationCounter&) = delete;
+
+        private:
+            std::atomic<uint64_t> count;    //!< Number of recorded durations
+            std::atomic<uint64_t> total_ns; //!< Sum of recorded durations (ns)
+        };
+
+        /**
+         * \brief Scope duration recorder (records from construction to destruction)
+         */
+        class ScopedDuration
+        {
+        public:
+            typedef std::chrono::steady_clock Clock;
+
+            /**
+             * \brief Constructor
+             *
+             * \param counter Duration counter (null to not record)
+             */
+            ScopedDuration(DurationCounter *counter) :
+                counter(counter), begin(counter ? Clock::now() : Clock::time_point())
+            {}
+
+            /**
+             * \brief Destructor (records duration)
+             */
+            ~ScopedDuration()
+            {
+                if(counter) counter->record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+            }
+
+        private:
+            ScopedDuration(const ScopedDuration&) = delete;
+            ScopedDuration& operator=(const ScopedDuration&) = delete;
+
+        private:
+            DurationCounter *counter; //!< Duration counter (null to not record)
+            Clock::time_point begin;  //!< Scope begin time
+        };
+
+        /**
+         * \brief Exported metric
+         */
+        enum MetricId
+        {
+            METRIC_TRANSACTIONS = 0,  //!< I2C transactions received
+            METRIC_TRANSACTION_RATE,  //!< I2C transactions per second (last period)
+            METRIC_ERRORS,            //!< Commands answered with an error
+            METRIC_ERROR_RATIO,       //!< Error responses per transaction (last period)
+            METRIC_WDT_RESETS,        //!< Watchdog timer resets
+            METRIC_BUS_RESETS,        //!< Bus resets
+            METRIC_PDM_TRIPS,         //!< PDM switch overcurrent trips
+            METRIC_LOCK_WAITS,        //!< EPS lock acquisitions timed
+            METRIC_LOCK_WAIT_SECONDS, //!< Time waiting for the EPS lock
+            METRIC_GUI_FRAMES,        //!< Window refreshes
+            METRIC_GUI_FRAME_SECONDS, //!< Time refreshing the window
+            METRIC_SIM_TIME_RATIO,    //!< Simulated time per wall clock time (last period)
+            NUM_METRICS               //!< Number of exported metrics
+        };
+
+        /**
+         * \brief Exported metric description
+         */
+        struct MetricInfo
+        {
+            const char *name; //!< Prometheus metric name
+            const char *type; //!< Prometheus metric type (counter or gauge)
+            const char *help; //!< Description
+        };
+
+        const MetricInfo METRIC_INFO[NUM_METRICS] = {
+            {"eps_sim_transactions_total", "counter", "I2C transactions received"},
+            {"eps_sim_transactions_per_second", "gauge", "I2C transactions per second over the last export period"},
+            {"eps_sim_command_errors_total", "counter", "Commands answered with an error"},
+            {"eps_sim_command_error_ratio", "gauge", "Error responses per transaction over the last export period"},
+            {"eps_sim_wdt_resets_total", "counter", "Watchdog timer resets"},
+            {"eps_sim_bus_resets_total", "counter", "Bus resets"},
+            {"eps_sim_pdm_trips_total", "counter", "PDM switch overcurrent trips"},
+            {"eps_sim_lock_waits_total", "counter", "EPS lock acquisitions (simulator without its own thread)"},
+            {"eps_sim_lock_wait_seconds_total", "counter", "Time waiting for the EPS lock"},
+            {"eps_sim_gui_frames_total", "counter", "Simulator window refreshes"},
+            {"eps_sim_gui_frame_seconds_total", "counter", "Time refreshing the simulator window"},
+            {"eps_sim_sim_time_ratio", "gauge", "Simulated time per wall clock time over the last export period"}
+        }; //!< Exported metrics (MetricId order)
+
+        /**
+         * \brief Board metrics in the shared memory metrics block
+         */
+        struct MetricsBoard
+        {
+            char name[METRICS_NAME_SIZE];              //!< Board name (null terminated)
+            uint64_t address;                          //!< EPS I2C address
+            std::atomic<uint64_t> values[NUM_METRICS]; //!< Metric values (IEEE 754 double bits, MetricId order)
+        };
+
+        /**
+         * \brief Shared memory metrics block (local collectors)
+         *
+         * Collectors copy the values between two equal, even reads of sequence (the exporter
+         * makes it odd while writing), and retry otherwise.
+         */
+        struct MetricsBlock
+        {
+            std::atomic<uint32_t> magic;    //!< METRICS_SHM_MAGIC once initialized
+            uint32_t version;               //!< METRICS_SHM_VERSION
+            uint32_t num_boards;            //!< Number of boards
+            uint32_t num_metrics;           //!< Metric values per board
+            std::atomic<uint64_t> sequence; //!< Export sequence (odd while values are written)
+            std::atomic<uint64_t> time_ns;  //!< Wall clock time of the last export (ns since epoch)
+            MetricsBoard boards[1];         //!< Boards (num_boards)
+        };
+
+        /**
+         * \brief Exported simulator
+         */
+        struct MetricsSource
+        {
+            std::string name;  //!< Board name (metric label)
+            uint8_t address;   //!< EPS I2C address (metric label)
+            const EpsSim *sim; //!< EPS simulator
+        };
+
+        /**
+         * \brief Periodic operational metrics exporter (Prometheus text file and shared memory)
+         *
+         * Reads the simulators' atomic counters on its own thread, so nothing is aggregated on
+         * the I2C or simulator threads.
+         */
+        class MetricsExporter
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param config Metrics export config
+             * \param sources Exported simulators (outlive the exporter)
+             */
+            MetricsExporter(const MetricsConfig& config, const std::vector<MetricsSource>& sources);
+
+            /**
+             * \brief Destructor (stops exporting)
+             */
+            ~MetricsExporter();
+
+            /**
+             * \brief Start exporting
+             *
+             * \return True if the exporter was started
+             */
+            bool start();
+
+            /**
+             * \brief Export once more and stop exporting
+             */
+            void stop();
+
+        private:
+            MetricsExporter(const MetricsExporter&) = delete;
+            MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+            /**
+             * \brief Counter values at the previous export (rates)
+             */
+            struct Sample
+            {
+                uint64_t transactions; //!< I2C transactions received
+                uint64_t errors;       //!< Error responses
+                uint64_t sim_time_ms;  //!< Simulated time (ms)
+            };
+
+            /**
+             * \brief Exporter thread (exports every period until stopped)
+             */
+            void run();
+
+            /**
+             * \brief Collect metrics of all simulators, write text file, and publish to shared memory
+             */
+            void export_metrics();
+
+            /**
+             * \brief Collect simulator metrics
+             *
+             * \param sim EPS simulator
+             * \param previous Counter values at the previous export (updated)
+             * \param period_s Time since the previous export (s)
+             * \param values Metric values (MetricId order)
+             */
+            static void collect(const EpsSim& sim, Sample& previous, double period_s, double *values);
+
+            /**
+             * \brief Write Prometheus text format file (replaced atomically for textfile collectors)
+             *
+             * \param values Metric values of all simulators (NUM_METRICS per simulator)
+             *
+             * \return True if the file was written
+             */
+            bool write_textfile(const std::vector<double>& values) const;
+
+            /**
+             * \brief Create shared memory metrics block
+             *
+             * \return True if the block was created
+             */
+            bool create_shm();
+
+            /**
+             * \brief Remove shared memory metrics block
+             */
+            void close_shm();
+
+            /**
+             * \brief Publish metric values to the shared memory block
+             *
+             * \param values Metric values of all simulators (NUM_METRICS per simulator)
+             */
+            void publish(const std::vector<double>& values);
+
+        private:
+            const unsigned int period_ms;             //!< Export period (ms)
+            const std::string textfile;               //!< Prometheus text format file (empty to not write)
+            const std::string shm_name;               //!< Shared memory block name (empty to not publish)
+            const std::vector<MetricsSource> sources; //!< Exported simulators
+            std::vector<Sample> previous;             //!< Counter values at the previous export (per simulator)
+            std::chrono::steady_clock::time_point previous_time; //!< Previous export time
+            MetricsBlock *block;                      //!< Shared memory metrics block (null if not published)
+            size_t block_size;                        //!< Shared memory metrics block size (bytes)
+            bool stopping;                            //!< Stop requested (under mutex)
+            std::mutex mutex;                         //!< Mutex for stop request
+            std::condition_variable wake;             //!< Stop request condition
+            std::thread thread;                       //!< Exporter thread
+        };
+    }
+}
+
+#endif
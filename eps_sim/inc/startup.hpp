@@ -0,0 +1,100 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef ITC_EPS_STARTUP_HPP
+#define ITC_EPS_STARTUP_HPP
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief EPS simulator startup timing
+         *
+         * Records the start and duration of each startup phase (phases may run on different
+         * threads and overlap) and reports them once the event loop is ready.
+         */
+        class StartupProfile
+        {
+        public:
+            typedef std::chrono::steady_clock Clock;
+            typedef Clock::time_point TimePoint;
+
+            /**
+             * \brief Constructor (startup begins)
+             *
+             * \param print Print the phase report to stdout (as well as the log)
+             */
+            StartupProfile(bool print);
+
+            /**
+             * \brief Get current time
+             *
+             * \return Current time
+             */
+            static TimePoint now();
+
+            /**
+             * \brief Add startup phase ending now (thread safe)
+             *
+             * \param name Phase name
+             * \param begin Phase begin time
+             */
+            void add(const std::string& name, TimePoint begin);
+
+            /**
+             * \brief Report startup phases and total startup time (first call only)
+             */
+            void report();
+
+        private:
+            /**
+             * \brief Startup phase
+             */
+            struct Phase
+            {
+                std::string name; //!< Phase name
+                double start_ms;  //!< Phase start since startup (ms)
+                double ms;        //!< Phase duration (ms)
+            };
+
+            /**
+             * \brief Convert time since startup to milliseconds
+             *
+             * \param time Time
+             *
+             * \return Milliseconds since startup
+             */
+            double to_ms(TimePoint time) const;
+
+            mutable std::mutex mutex;  //!< Phase list lock
+            const TimePoint start;     //!< Startup time
+            const bool print;          //!< Print report to stdout
+            bool reported;             //!< Report done
+            std::vector<Phase> phases; //!< Startup phases
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,95 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_STRIP_CHART_HPP
+#define ITC_EPS_STRIP_CHART_HPP
+
+#include "history.hpp"
+#include <FL/Fl_Widget.H>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Telemetry channel strip chart
+         *
+         * Draws the min/max band and mean of one channel history over a time span, from the
+         * lowest decimation level covering the span. Drawing costs at most HISTORY_SIZE
+         * points whatever the span.
+         */
+        class StripChart : public Fl_Widget
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            StripChart(int x, int y, int w, int h, const char *l = 0);
+
+            /**
+             * \brief Destructor
+             */
+            ~StripChart();
+
+            /**
+             * \brief Set channel history store
+             *
+             * \param history Channel history store (null for none)
+             */
+            void set_history(std::shared_ptr<const HistoryStore> history);
+
+            /**
+             * \brief Set charted channel
+             *
+             * \param code Channel code (CHANNEL_INVALID for none)
+             */
+            void set_channel(ChannelCode code);
+
+            /**
+             * \brief Set charted time span
+             *
+             * \param span_ms Time span (ms)
+             */
+            void set_span(uint64_t span_ms);
+
+            /**
+             * \brief Redraw if the charted level has new points
+             */
+            void update();
+
+        protected:
+            /**
+             * \brief Draw chart (Fl_Widget)
+             */
+            void draw();
+
+        private:
+            std::shared_ptr<const HistoryStore> history; //!< Channel history store
+            const ChannelHistory *channel;               //!< Charted channel history (null if none)
+            ChannelCode code;                            //!< Charted channel code
+            uint64_t span_ms;                            //!< Charted time span (ms)
+            uint64_t drawn_count;                        //!< Level point count when last drawn
+            std::vector<HistoryPoint> points;            //!< Points read for drawing (scratch)
+        };
+    }
+}
+
+#endif
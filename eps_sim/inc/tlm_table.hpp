@@ -0,0 +1,174 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_TLM_TABLE_HPP
+#define ITC_EPS_TLM_TABLE_HPP
+
+#include "frame.hpp"
+#include "widgets.hpp"
+#include <FL/Fl_Table.H>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Telemetry table channel filter
+         */
+        enum TlmFilter
+        {
+            FILTER_ALL,   //!< All channels
+            FILTER_BCR,   //!< Battery charge regulator (BCR) channels
+            FILTER_PCM,   //!< Power conditioning module (PCM) channels
+            FILTER_PDM,   //!< Power distribution module (PDM) channels
+            FILTER_BOARD  //!< Board channels not on a bus
+        };
+
+        /**
+         * \brief Virtual telemetry table
+         *
+         * Rows are generated from the channel descriptors of published state frames, grouped by
+         * bus type and bus (the row header names the bus). Cells are formatted when drawn, so
+         * only visible rows are drawn and refreshed. Analog values are set with a single input
+         * placed over the clicked cell, clicking other cells selects the row channel.
+         */
+        class TlmTable : public Fl_Table
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            TlmTable(int x, int y, int w, int h, const char *l = 0);
+
+            /**
+             * \brief Destructor
+             */
+            ~TlmTable();
+
+            /**
+             * \brief Get analog value input (callback set by window owner)
+             *
+             * \return Analog value input
+             */
+            TlmInput* get_input();
+
+            /**
+             * \brief Set callback for channel selection (row click)
+             *
+             * \param callback Callback
+             * \param user User data
+             */
+            void set_select_callback(Fl_Callback *callback, void *user);
+
+            /**
+             * \brief Get selected channel
+             *
+             * \return Selected channel code (CHANNEL_INVALID if none)
+             */
+            ChannelCode get_selected() const;
+
+            /**
+             * \brief Set channel filter
+             *
+             * \param filter Channel filter
+             */
+            void set_filter(TlmFilter filter);
+
+            /**
+             * \brief Update table with state frame
+             *
+             * Rows are rebuilt if the frame channels changed. Otherwise only visible rows with
+             * changed values are redrawn.
+             *
+             * \param frame State frame
+             * \param full If true redraw all visible rows
+             */
+            void update(const StateFrame& frame, bool full);
+
+        protected:
+            /**
+             * \brief Draw table cell (Fl_Table)
+             */
+            void draw_cell(TableContext context, int row, int col, int x, int y, int w, int h);
+
+        private:
+            /**
+             * \brief Table column
+             */
+            enum Column
+            {
+                COL_SLOT,    //!< Channel slot
+                COL_CODE,    //!< Channel code
+                COL_DIGITAL, //!< Digital (sampled) value
+                COL_ANALOG,  //!< Analog value
+                COL_SET,     //!< Analog value input
+                NUM_COLUMNS
+            };
+
+            /**
+             * \brief Callback to handle table clicks (starts analog value edit)
+             *
+             * \param widget Table widget
+             * \param user User data
+             */
+            static void on_click(Fl_Widget *widget, void *user);
+
+            /**
+             * \brief Rebuild rows from frame channels (filtered and grouped)
+             */
+            void build_rows();
+
+            /**
+             * \brief Show analog value input over row
+             *
+             * \param row Table row
+             */
+            void start_edit(int row);
+
+            /**
+             * \brief Select row channel
+             *
+             * \param row Table row
+             */
+            void select(int row);
+
+            /**
+             * \brief Format cell text
+             *
+             * \param row Table row
+             * \param col Table column
+             * \param text Text buffer
+             * \param size Text buffer size
+             */
+            void format_cell(int row, int col, char *text, unsigned int size) const;
+
+        private:
+            TlmInput *input;                  //!< Analog value input
+            StateFrame frame;                 //!< State frame shown in table
+            std::vector<unsigned int> index;  //!< Frame channel index of each row
+            TlmFilter filter;                 //!< Channel filter
+            int edit_row;                     //!< Row being edited (negative if none)
+            ChannelCode selected;             //!< Selected channel code
+            Fl_Callback *select_callback;     //!< Channel selection callback (null if none)
+            void *select_user;                //!< Channel selection callback user data
+        };
+    }
+}
+
+#endif
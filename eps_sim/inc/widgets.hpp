@@ -21,10 +21,8 @@
 #define ITC_EPS_WIDGETS_HPP
 
 #include "adc.hpp"
-#include <FL/Fl_Value_Output.H>
 #include <FL/Fl_Value_Input.H>
 #include <FL/Fl_Light_Button.H>
-#include <map>
 
 namespace itc
 {
@@ -107,18 +105,6 @@ namespace itc
         private:
             unsigned int num; //!< PDM switch number
         };
-
-        /**
-         * \brief Telemetry widgets for each channel
-         */
-        struct TlmWidgets
-        {
-            Fl_Value_Output *digital_out; //!< Digital (sampled) telemetry output
-            Fl_Value_Output *analog_out;  //!< Analog telemetry output
-            TlmInput *analog_in;          //!< Analog telemetry input
-        };
-
-        typedef std::map<ChannelCode, TlmWidgets> TlmWidgetMap; //!< Telemetry widget map
     }
 }
 
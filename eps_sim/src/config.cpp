@@ -18,78 +18,591 @@
 */
 
 #include "config.hpp"
+#include "json_reader.hpp"
 #include "util.hpp"
 #include "bcr.hpp"
 #include "pdm.hpp"
-#include <boost/property_tree/json_parser.hpp>
+#include "shm.hpp"
+#include <boost/property_tree/json_parser/error.hpp>
 #include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
 
 using namespace itc::eps;
 
-Config::Config(const std::string& cfgfile) :
-    log_level(),
+namespace
+{
+    /**
+     * \brief Topology bus entry (buses are connected once all are listed)
+     */
+    struct BusEntry
+    {
+        BusEntry() : name(), type(), units(1), parents() {}
+
+        std::string name;                 //!< Bus name
+        std::string type;                 //!< Bus type name
+        unsigned int units;               //!< Number of regulator units
+        std::vector<std::string> parents; //!< Parent bus names
+    };
+
+    /**
+     * \brief Topology channel entry (channels are assigned once all buses are listed)
+     */
+    struct ChannelEntry
+    {
+        ChannelEntry() : code(CHANNEL_INVALID), bus(), slot(), unit(0) {}
+
+        ChannelCode code;  //!< Telemetry channel code
+        std::string bus;   //!< Bus name
+        std::string slot;  //!< Slot name
+        unsigned int unit; //!< Regulator number within bus
+    };
+
+    /* read telemetry channel code key (hex) */
+    ChannelCode read_channel_code(JsonReader& reader, const std::string& key)
+    {
+        char *last = nullptr;
+        unsigned long code = std::strtoul(key.c_str(), &last, 16);
+        if(key.empty() || (*last != '\0') || (code > 0xffff)) reader.error("invalid eps channel code: " + key);
+        return static_cast<ChannelCode>(code);
+    }
+
+    /* read array of bus names */
+    void read_names(JsonReader& reader, std::vector<std::string>& names)
+    {
+        if(!reader.begin_array()) return;
+        while(reader.next_element())
+        {
+            std::string name;
+            reader.read(name);
+            names.push_back(name);
+        }
+    }
+
+    /* read array values */
+    template <typename T>
+    std::vector<T> read_array(JsonReader& reader, const char *name)
+    {
+        std::vector<T> values;
+        if(reader.begin_array())
+        {
+            while(reader.next_element())
+            {
+                T value = T();
+                if(!reader.read(value)) reader.error(std::string("invalid ") + name + " value");
+                values.push_back(value);
+            }
+        }
+        return values;
+    }
+}
+
+std::string itc::eps::get_eeprom_file(const std::string& dir, uint8_t address)
+{
+    if(dir.empty()) return "";
+    return dir + "/eps_" + to_string(static_cast<unsigned int>(address), true) + ".eeprom";
+}
+
+Config::Config(const std::string& cfgfile, const std::string& cachefile) :
+    log_level("error"),
     swap(),
     nos(),
+    gui(),
     eps_address(),
     version(),
     db_connected(false),
     db_version(),
+    layout(BoardLayout::clyde_3g()),
+    eeprom(),
+    actor(),
+    shm(),
+    history(),
+    reload(),
+    stats(),
+    metrics(),
     switch_states(),
+    switch_trips(),
+    load_aggregation(false),
+    switch_loads(),
     tlm(),
     adc()
 {
     // load config file
-    load(cfgfile);
+    load(cfgfile, cachefile);
 }
 
-void Config::load(const std::string& cfgfile)
+void Config::load(const std::string& cfgfile, const std::string& cachefile)
 {
     if(cfgfile.empty()) return;
 
-    int index;
-    boost::property_tree::ptree cfg;
-    boost::property_tree::read_json(cfgfile, cfg);
+    // read whole file at once
+    std::ifstream file(cfgfile.c_str(), std::ios::binary | std::ios::ate);
+    if(!file) throw boost::property_tree::json_parser::json_parser_error("cannot open file", cfgfile, 0);
+    std::string json(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&json[0], json.size());
+    if(!file) throw boost::property_tree::json_parser::json_parser_error("cannot read file", cfgfile, 0);
+
+    // compiled config for the same file contents
+    uint64_t key = 0;
+    if(!cachefile.empty())
+    {
+        key = get_cache_key(json);
+        if(load_cache(cachefile, key)) return;
+    }
 
-    // logger
-    log_level = cfg.get("log_level", "error");
+    // values not in the file keep their defaults
+    *this = Config();
+    JsonReader reader(json.data(), json.size(), cfgfile);
+    parse(reader);
 
-    // byte swapping
-    swap.in = cfg.get("swap_bytes.in", false);
-    swap.out = cfg.get("swap_bytes.out", false);
+    if(!cachefile.empty()) save_cache(cachefile, key);
+}
 
-    // nos engine
-    nos.uri = cfg.get("nos.uri", "");
-    nos.node = cfg.get("nos.node", "");
-    nos.i2c_bus = cfg.get("nos.i2c_bus", "");
-    nos.time_bus = cfg.get("nos.time_bus", "");
-    nos.tick_ms = cfg.get("nos.tick_ms", 0);
+void Config::parse(JsonReader& reader)
+{
+    std::string key;
+    if(!reader.begin_object()) reader.error("expected config object");
+    bool has_eps = false;
+    while(reader.next_member(key))
+    {
+        if(key == "log_level")
+        {
+            // logger
+            reader.read(log_level);
+        }
+        else if((key == "swap_bytes") && reader.begin_object())
+        {
+            // byte swapping
+            while(reader.next_member(key))
+            {
+                if(key == "in") reader.read(swap.in);
+                else if(key == "out") reader.read(swap.out);
+                else reader.skip();
+            }
+        }
+        else if((key == "nos") && reader.begin_object())
+        {
+            // nos engine
+            while(reader.next_member(key))
+            {
+                if(key == "uri") reader.read(nos.uri);
+                else if(key == "node") reader.read(nos.node);
+                else if(key == "i2c_bus") reader.read(nos.i2c_bus);
+                else if(key == "time_bus") reader.read(nos.time_bus);
+                else if(key == "tick_ms") reader.read(nos.tick_ms);
+                else reader.skip();
+            }
+        }
+        else if((key == "gui") && reader.begin_object())
+        {
+            // simulator window
+            while(reader.next_member(key))
+            {
+                if(key == "refresh_hz") reader.read(gui.refresh_hz);
+                else reader.skip();
+            }
+        }
+        else if(key == "eps")
+        {
+            parse_eps(reader);
+            has_eps = true;
+        }
+        else if((key != "swap_bytes") && (key != "nos") && (key != "gui"))
+        {
+            reader.skip();
+        }
+    }
+    reader.finish();
+    if(!has_eps) reader.error("missing eps config");
+}
 
-    // i2c address
-    eps_address = cfg.get<uint8_t>("eps.address", 0);
+void Config::parse_eps(JsonReader& reader)
+{
+    std::string key;
+    unsigned int firmware = 0;
+    unsigned int revision = 0;
+    unsigned int db_firmware = 0;
+    unsigned int db_revision = 0;
+    bool has_switch = false;
+    bool has_tlm = false;
+    std::vector<bool> states;
+    std::vector<PdmTripConfig> trips;
+    std::vector<LoadConfig> loads;
 
-    // board version
-    version.set_version(cfg.get("eps.version.firmware", 0),
-                        cfg.get("eps.version.revision", 0));
+    if(!reader.begin_object()) reader.error("expected eps config object");
+    while(reader.next_member(key))
+    {
+        if(key == "address")
+        {
+            // i2c address
+            reader.read(eps_address);
+        }
+        else if((key == "version") && reader.begin_object())
+        {
+            // board version
+            while(reader.next_member(key))
+            {
+                if(key == "firmware") reader.read(firmware);
+                else if(key == "revision") reader.read(revision);
+                else reader.skip();
+            }
+        }
+        else if((key == "daughterboard") && reader.begin_object())
+        {
+            // daughterboard version
+            while(reader.next_member(key))
+            {
+                if(key == "connected") reader.read(db_connected);
+                else if(key == "firmware") reader.read(db_firmware);
+                else if(key == "revision") reader.read(db_revision);
+                else reader.skip();
+            }
+        }
+        else if((key == "eeprom") && reader.begin_object())
+        {
+            // persistent eeprom directory (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "dir") reader.read(eeprom.dir);
+                else if(key == "sync_ms") reader.read(eeprom.sync_ms);
+                else reader.skip();
+            }
+        }
+        else if((key == "actor") && reader.begin_object())
+        {
+            // simulator thread (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "enabled") reader.read(actor.enabled);
+                else if(key == "cpu") reader.read(actor.cpu);
+                else reader.skip();
+            }
+        }
+        else if((key == "shm") && reader.begin_object())
+        {
+            // shared memory state segment for viewers (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "enabled") reader.read(shm.enabled);
+                else if(key == "name") reader.read(shm.name);
+                else reader.skip();
+            }
+        }
+        else if((key == "history") && reader.begin_object())
+        {
+            // telemetry history for strip charts (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "enabled") reader.read(history.enabled);
+                else if(key == "period_ms") reader.read(history.period_ms);
+                else reader.skip();
+            }
+        }
+        else if((key == "reload") && reader.begin_object())
+        {
+            // config file hot reload (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "enabled") reader.read(reload.enabled);
+                else if(key == "debounce_ms") reader.read(reload.debounce_ms);
+                else reader.skip();
+            }
+        }
+        else if((key == "stats") && reader.begin_object())
+        {
+            // per command statistics (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "enabled") reader.read(stats.enabled);
+                else reader.skip();
+            }
+        }
+        else if((key == "metrics") && reader.begin_object())
+        {
+            // periodic metrics export (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "enabled") reader.read(metrics.enabled);
+                else if(key == "period_ms") reader.read(metrics.period_ms);
+                else if(key == "textfile") reader.read(metrics.textfile);
+                else if(key == "shm") reader.read(metrics.shm);
+                else reader.skip();
+            }
+        }
+        else if(key == "topology")
+        {
+            // board topology (optional)
+            layout = parse_layout(reader);
+        }
+        else if(key == "switch")
+        {
+            // power distribution module (pdm) switch states
+            states = read_array<bool>(reader, "eps switch state");
+            has_switch = true;
+        }
+        else if((key == "switch_trip") && reader.begin_array())
+        {
+            // power distribution module (pdm) switch overcurrent trip configs (optional)
+            while(reader.next_element())
+            {
+                PdmTripConfig trip;
+                if(reader.begin_object())
+                {
+                    while(reader.next_member(key))
+                    {
+                        if(key == "current_limit") reader.read(trip.current_limit);
+                        else if(key == "trip_delay_ms") reader.read(trip.trip_delay_ms);
+                        else if(key == "retry_delay_ms") reader.read(trip.retry_delay_ms);
+                        else if(key == "retries") reader.read(trip.max_retries);
+                        else reader.skip();
+                    }
+                }
+                trips.push_back(trip);
+            }
+        }
+        else if((key == "loads") && reader.begin_object())
+        {
+            // power distribution module (pdm) switch load profiles (optional)
+            while(reader.next_member(key))
+            {
+                if(key == "aggregate")
+                {
+                    reader.read(load_aggregation);
+                }
+                else if((key == "switch") && reader.begin_array())
+                {
+                    while(reader.next_element())
+                    {
+                        LoadConfig load;
+                        if(reader.begin_object())
+                        {
+                            while(reader.next_member(key))
+                            {
+                                if(key == "file") reader.read(load.file);
+                                else if(key == "loop") reader.read(load.loop);
+                                else reader.skip();
+                            }
+                        }
+                        loads.push_back(load);
+                    }
+                }
+                else if(key != "switch")
+                {
+                    reader.skip();
+                }
+            }
+        }
+        else if(key == "tlm")
+        {
+            // analog telemetry (channel) data
+            parse_tlm(reader);
+            has_tlm = true;
+        }
+        else if((key != "version") && (key != "daughterboard") && (key != "eeprom") && (key != "actor") &&
+                (key != "shm") && (key != "history") && (key != "reload") && (key != "stats") &&
+                (key != "metrics") && (key != "switch_trip") && (key != "loads"))
+        {
+            reader.skip();
+        }
+    }
+    if(!has_switch) reader.error("missing eps switch config");
+    if(!has_tlm) reader.error("missing eps tlm config");
 
-    // daughterboard version
-    db_connected = cfg.get<bool>("eps.daughterboard.connected", false);
-    db_version.set_version(cfg.get("eps.daughterboard.firmware", 0),
-                           cfg.get("eps.daughterboard.revision", 0));
+    // values that depend on other values (members may be listed in any order)
+    version.set_version(firmware, revision);
+    db_version.set_version(db_firmware, db_revision);
+    eeprom.file = get_eeprom_file(eeprom.dir, eps_address);
+    if(shm.name.empty()) shm.name = get_shm_name(eps_address);
 
-    // power distribution module (pdm) switch states
-    switch_states = get_config_array<bool>(cfg.get_child("eps.switch"), 10);
+    // per switch values sized to the board layout
+    size_t num_switches = layout.get_switches().size();
+    switch_states = states;
+    switch_states.resize(num_switches, false);
+    switch_trips = trips;
+    switch_trips.resize(num_switches, PdmTripConfig());
+    switch_loads = loads;
+    switch_loads.resize(num_switches, LoadConfig());
+}
 
-    // analog telemetry (channel) data
-    BOOST_FOREACH(boost::property_tree::ptree::value_type &val, cfg.get_child("eps.tlm"))
+void Config::parse_tlm(JsonReader& reader)
+{
+    std::string key;
+    if(!reader.begin_object()) return;
+    while(reader.next_member(key))
     {
-        ChannelCode channel = static_cast<ChannelCode>(from_string<uint16_t>(val.first, true));
-
-        // default telemetry value
-        tlm[channel] = val.second.get("value", 0.0);
-        
-        // analog to digital conversion params
-        ConverterParams params = get_config_array<double>(val.second.get_child("adc"), 2);
+        ChannelCode channel = read_channel_code(reader, key);
+        double value = 0.0;
+        ConverterParams params;
+        bool has_adc = false;
+        if(reader.begin_object())
+        {
+            while(reader.next_member(key))
+            {
+                if(key == "value")
+                {
+                    // default telemetry value
+                    reader.read(value);
+                }
+                else if(key == "adc")
+                {
+                    // analog to digital conversion params
+                    params = read_array<double>(reader, "eps adc param");
+                    params.resize(2, 0.0);
+                    has_adc = true;
+                }
+                else
+                {
+                    reader.skip();
+                }
+            }
+        }
+        if(!has_adc) reader.error("missing eps adc config");
+        tlm[channel] = value;
         adc[channel] = params;
     }
 }
 
+BoardLayout Config::parse_layout(JsonReader& reader)
+{
+    static const std::map<std::string, BusType> BUS_TYPES = {
+        {"bcr", BUS_BCR},
+        {"pcm", BUS_PCM},
+        {"pdm", BUS_PDM}
+    };
+    static const std::map<std::string, ChannelSlot> SLOTS = {
+        {"voltage",   SLOT_VOLTAGE},
+        {"current",   SLOT_CURRENT},
+        {"current_b", SLOT_CURRENT_B},
+        {"temp",      SLOT_TEMP},
+        {"temp_b",    SLOT_TEMP_B},
+        {"sun",       SLOT_SUN},
+        {"sun_b",     SLOT_SUN_B},
+        {"misc",      SLOT_MISC}
+    };
+
+    // sections may be listed in any order, so entries are collected before the board is built
+    std::string key;
+    std::vector<BusEntry> buses;
+    std::vector<ChannelEntry> channels;
+    std::vector<std::string> switches;
+    std::vector<std::string> pcm_resets;
+    std::string node_reset;
+    bool has_buses = false;
+    bool has_channels = false;
+    bool has_switches = false;
+    bool has_pcm_resets = false;
+    bool has_node_reset = false;
+    if(!reader.begin_object()) reader.error("expected eps topology object");
+    while(reader.next_member(key))
+    {
+        if(key == "buses")
+        {
+            has_buses = true;
+            if(!reader.begin_array()) continue;
+            while(reader.next_element())
+            {
+                BusEntry bus;
+                bool has_name = false;
+                if(reader.begin_object())
+                {
+                    while(reader.next_member(key))
+                    {
+                        if(key == "name") has_name = reader.read(bus.name);
+                        else if(key == "type") reader.read(bus.type);
+                        else if(key == "units") reader.read(bus.units);
+                        else if(key == "parents") read_names(reader, bus.parents);
+                        else reader.skip();
+                    }
+                }
+                if(!has_name) reader.error("missing eps bus name");
+                buses.push_back(bus);
+            }
+        }
+        else if(key == "channels")
+        {
+            has_channels = true;
+            if(!reader.begin_object()) continue;
+            while(reader.next_member(key))
+            {
+                ChannelEntry channel;
+                channel.code = read_channel_code(reader, key);
+                if(reader.begin_object())
+                {
+                    while(reader.next_member(key))
+                    {
+                        if(key == "bus") reader.read(channel.bus);
+                        else if(key == "slot") reader.read(channel.slot);
+                        else if(key == "unit") reader.read(channel.unit);
+                        else reader.skip();
+                    }
+                }
+                channels.push_back(channel);
+            }
+        }
+        else if(key == "switches")
+        {
+            read_names(reader, switches);
+            has_switches = true;
+        }
+        else if(key == "pcm_resets")
+        {
+            read_names(reader, pcm_resets);
+            has_pcm_resets = true;
+        }
+        else if(key == "node_reset")
+        {
+            has_node_reset = reader.read(node_reset);
+        }
+        else
+        {
+            reader.skip();
+        }
+    }
+    if(!has_buses || !has_channels || !has_switches || !has_pcm_resets || !has_node_reset)
+    {
+        reader.error("incomplete eps topology");
+    }
+
+    BoardLayout board;
+
+    // buses (all buses added before connecting, so parents may be listed in any order)
+    for(std::vector<BusEntry>::const_iterator it = buses.begin(); it != buses.end(); ++it)
+    {
+        std::map<std::string, BusType>::const_iterator type = BUS_TYPES.find(it->type);
+        if(type == BUS_TYPES.end()) throw std::invalid_argument("invalid eps bus type: " + it->type);
+        board.add_bus(it->name, type->second, it->units);
+    }
+    for(std::vector<BusEntry>::const_iterator it = buses.begin(); it != buses.end(); ++it)
+    {
+        unsigned int child = board.find_bus(it->name);
+        for(std::vector<std::string>::const_iterator parent = it->parents.begin(); parent != it->parents.end(); ++parent)
+        {
+            board.connect(board.find_bus(*parent), child);
+        }
+    }
+
+    // telemetry channel assignments
+    for(std::vector<ChannelEntry>::const_iterator it = channels.begin(); it != channels.end(); ++it)
+    {
+        std::map<std::string, ChannelSlot>::const_iterator slot = SLOTS.find(it->slot);
+        if(slot == SLOTS.end()) throw std::invalid_argument("invalid eps channel slot: " + it->slot);
+        board.add_channel(it->code, board.find_bus(it->bus), slot->second, it->unit);
+    }
+
+    // command mappings
+    for(std::vector<std::string>::const_iterator it = switches.begin(); it != switches.end(); ++it)
+    {
+        board.add_switch(board.find_bus(*it));
+    }
+    for(std::vector<std::string>::const_iterator it = pcm_resets.begin(); it != pcm_resets.end(); ++it)
+    {
+        board.add_pcm_reset(board.find_bus(*it));
+    }
+    board.set_node_reset(board.find_bus(node_reset));
+
+    std::string error;
+    if(!board.validate(error)) throw std::invalid_argument("invalid eps topology: " + error);
+    return board;
+}
@@ -0,0 +1,336 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include "config.hpp"
+#include "state.hpp"
+#include "types.hpp"
+
+#include <ItcLogger/Logger.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+
+    const uint64_t FNV_OFFSET = 0xcbf29ce484222325ull; //!< 64 bit FNV-1a offset basis
+    const uint64_t FNV_PRIME = 0x100000001b3ull;       //!< 64 bit FNV-1a prime
+
+    /**
+     * \brief Compiled config cache file header (followed by the serialized config)
+     */
+    struct CacheHeader
+    {
+        uint32_t magic;    //!< CONFIG_CACHE_MAGIC
+        uint32_t version;  //!< CONFIG_CACHE_VERSION
+        uint64_t key;      //!< Checksum of the config file contents the cache was compiled from
+        uint64_t size;     //!< Serialized config size
+        uint64_t checksum; //!< Serialized config checksum
+    };
+
+    /* 64 bit FNV-1a checksum */
+    uint64_t fnv1a(const uint8_t *data, size_t size)
+    {
+        uint64_t hash = FNV_OFFSET;
+        for(size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ data[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /* write string (length and characters) */
+    void write_string(StateWriter& writer, const std::string& value)
+    {
+        writer.write(std::vector<char>(value.begin(), value.end()));
+    }
+
+    /* read string (length and characters) */
+    bool read_string(StateReader& reader, std::string& value)
+    {
+        std::vector<char> chars;
+        if(!reader.read(chars)) return false;
+        value.assign(chars.begin(), chars.end());
+        return true;
+    }
+
+    /* write board layout (as the calls that build it) */
+    void write_layout(StateWriter& writer, const BoardLayout& layout)
+    {
+        const std::vector<BusInfo>& buses = layout.get_buses();
+        writer.write(static_cast<uint32_t>(buses.size()));
+        for(std::vector<BusInfo>::const_iterator it = buses.begin(); it != buses.end(); ++it)
+        {
+            write_string(writer, it->name);
+            writer.write(static_cast<uint32_t>(it->type));
+            writer.write(static_cast<uint32_t>(it->units));
+        }
+
+        const std::vector<BoardLayout::Connection>& connections = layout.get_connections();
+        writer.write(static_cast<uint32_t>(connections.size()));
+        for(std::vector<BoardLayout::Connection>::const_iterator it = connections.begin(); it != connections.end(); ++it)
+        {
+            writer.write(static_cast<uint32_t>(it->first));
+            writer.write(static_cast<uint32_t>(it->second));
+        }
+
+        writer.write(layout.get_channels());
+        writer.write(layout.get_switches());
+        writer.write(layout.get_pcm_resets());
+        writer.write(static_cast<uint32_t>(layout.get_node_reset()));
+    }
+
+    /* read board layout (validated before it was written, intact if the cache checksum matches) */
+    bool read_layout(StateReader& reader, BoardLayout& layout)
+    {
+        BoardLayout board;
+        uint32_t count = 0;
+        reader.read(count);
+        for(uint32_t i = 0; (i < count) && reader.is_valid(); i++)
+        {
+            std::string name;
+            uint32_t type = 0;
+            uint32_t units = 0;
+            read_string(reader, name);
+            reader.read(type);
+            reader.read(units);
+            board.add_bus(name, static_cast<BusType>(type), units);
+        }
+
+        count = 0;
+        reader.read(count);
+        for(uint32_t i = 0; (i < count) && reader.is_valid(); i++)
+        {
+            uint32_t parent = 0;
+            uint32_t child = 0;
+            reader.read(parent);
+            reader.read(child);
+            board.connect(parent, child);
+        }
+
+        std::vector<ChannelInfo> channels;
+        std::vector<unsigned int> switches;
+        std::vector<unsigned int> pcm_resets;
+        uint32_t node_reset = 0;
+        reader.read(channels);
+        reader.read(switches);
+        reader.read(pcm_resets);
+        reader.read(node_reset);
+        if(!reader.is_valid()) return false;
+        for(std::vector<ChannelInfo>::const_iterator it = channels.begin(); it != channels.end(); ++it)
+        {
+            board.add_channel(it->code, it->bus, it->slot, it->unit);
+        }
+        for(std::vector<unsigned int>::const_iterator it = switches.begin(); it != switches.end(); ++it)
+        {
+            board.add_switch(*it);
+        }
+        for(std::vector<unsigned int>::const_iterator it = pcm_resets.begin(); it != pcm_resets.end(); ++it)
+        {
+            board.add_pcm_reset(*it);
+        }
+        board.set_node_reset(node_reset);
+        layout = board;
+        return true;
+    }
+}
+
+uint64_t Config::get_cache_key(const std::string& source)
+{
+    return fnv1a(reinterpret_cast<const uint8_t*>(source.data()), source.size());
+}
+
+bool Config::load_cache(const std::string& cachefile, uint64_t key)
+{
+    int fd = open(cachefile.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    if((fstat(fd, &info) == 0) && (static_cast<size_t>(info.st_size) >= sizeof(CacheHeader)))
+    {
+        size = static_cast<size_t>(info.st_size);
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapped != MAP_FAILED) data = reinterpret_cast<const uint8_t*>(mapped);
+    }
+    ::close(fd);
+    if(!data) return false;
+
+    // cache must be compiled by this format from the same config file contents, and intact
+    CacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const uint8_t *payload = data + sizeof(header);
+    bool loaded = (header.magic == CONFIG_CACHE_MAGIC) && (header.version == CONFIG_CACHE_VERSION) &&
+                  (header.key == key) && (header.size == size - sizeof(header)) &&
+                  (header.checksum == fnv1a(payload, header.size));
+    if(loaded)
+    {
+        Config cached;
+        StateReader reader(payload, header.size);
+        uint32_t count = 0;
+        uint16_t code = 0;
+
+        read_string(reader, cached.log_level);
+        reader.read(cached.swap);
+        read_string(reader, cached.nos.uri);
+        read_string(reader, cached.nos.node);
+        read_string(reader, cached.nos.i2c_bus);
+        read_string(reader, cached.nos.time_bus);
+        reader.read(cached.nos.tick_ms);
+        reader.read(cached.gui.refresh_hz);
+        reader.read(cached.eps_address);
+        reader.read(cached.version.version);
+        reader.read(cached.db_connected);
+        reader.read(cached.db_version.version);
+        loaded = read_layout(reader, cached.layout);
+        read_string(reader, cached.eeprom.dir);
+        read_string(reader, cached.eeprom.file);
+        reader.read(cached.eeprom.sync_ms);
+        reader.read(cached.actor.enabled);
+        reader.read(cached.actor.cpu);
+        reader.read(cached.shm.enabled);
+        read_string(reader, cached.shm.name);
+        reader.read(cached.history.enabled);
+        reader.read(cached.history.period_ms);
+        reader.read(cached.reload.enabled);
+        reader.read(cached.reload.debounce_ms);
+        reader.read(cached.stats.enabled);
+        reader.read(cached.metrics.enabled);
+        reader.read(cached.metrics.period_ms);
+        read_string(reader, cached.metrics.textfile);
+        read_string(reader, cached.metrics.shm);
+
+        std::vector<uint8_t> states;
+        reader.read(states);
+        cached.switch_states.assign(states.begin(), states.end());
+        reader.read(cached.switch_trips);
+        reader.read(cached.load_aggregation);
+        reader.read(count);
+        for(uint32_t i = 0; (i < count) && reader.is_valid(); i++)
+        {
+            LoadConfig load;
+            read_string(reader, load.file);
+            reader.read(load.loop);
+            cached.switch_loads.push_back(load);
+        }
+
+        reader.read(count);
+        for(uint32_t i = 0; (i < count) && reader.is_valid(); i++)
+        {
+            double value = 0.0;
+            ConverterParams params;
+            reader.read(code);
+            reader.read(value);
+            reader.read(params);
+            cached.tlm[static_cast<ChannelCode>(code)] = value;
+            cached.adc[static_cast<ChannelCode>(code)] = params;
+        }
+
+        loaded = loaded && reader.is_valid() && reader.is_done();
+        if(loaded) *this = cached;
+    }
+    munmap(const_cast<uint8_t*>(data), size);
+
+    if(loaded) logger->debug("eps config cache loaded: %s", cachefile.c_str());
+    return loaded;
+}
+
+bool Config::save_cache(const std::string& cachefile, uint64_t key) const
+{
+    StateBlob blob;
+    StateWriter writer(blob);
+
+    write_string(writer, log_level);
+    writer.write(swap);
+    write_string(writer, nos.uri);
+    write_string(writer, nos.node);
+    write_string(writer, nos.i2c_bus);
+    write_string(writer, nos.time_bus);
+    writer.write(nos.tick_ms);
+    writer.write(gui.refresh_hz);
+    writer.write(eps_address);
+    writer.write(version.version);
+    writer.write(db_connected);
+    writer.write(db_version.version);
+    write_layout(writer, layout);
+    write_string(writer, eeprom.dir);
+    write_string(writer, eeprom.file);
+    writer.write(eeprom.sync_ms);
+    writer.write(actor.enabled);
+    writer.write(actor.cpu);
+    writer.write(shm.enabled);
+    write_string(writer, shm.name);
+    writer.write(history.enabled);
+    writer.write(history.period_ms);
+    writer.write(reload.enabled);
+    writer.write(reload.debounce_ms);
+    writer.write(stats.enabled);
+    writer.write(metrics.enabled);
+    writer.write(metrics.period_ms);
+    write_string(writer, metrics.textfile);
+    write_string(writer, metrics.shm);
+
+    writer.write(std::vector<uint8_t>(switch_states.begin(), switch_states.end()));
+    writer.write(switch_trips);
+    writer.write(load_aggregation);
+    writer.write(static_cast<uint32_t>(switch_loads.size()));
+    for(SwitchLoads::const_iterator it = switch_loads.begin(); it != switch_loads.end(); ++it)
+    {
+        write_string(writer, it->file);
+        writer.write(it->loop);
+    }
+
+    // telemetry and converter params share channel codes (both set per tlm entry)
+    writer.write(static_cast<uint32_t>(tlm.size()));
+    for(Telemetry::const_iterator it = tlm.begin(); it != tlm.end(); ++it)
+    {
+        ChannelConfig::const_iterator params = adc.find(it->first);
+        writer.write(static_cast<uint16_t>(it->first));
+        writer.write(it->second);
+        writer.write((params != adc.end()) ? params->second : ConverterParams());
+    }
+
+    CacheHeader header = {CONFIG_CACHE_MAGIC, CONFIG_CACHE_VERSION, key, blob.size(), fnv1a(blob.data(), blob.size())};
+
+    // write to temporary file and rename, so readers never map a partial cache
+    std::string tmpfile = cachefile + ".tmp";
+    std::ofstream file(tmpfile.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+    file.close();
+    if(!file || (std::rename(tmpfile.c_str(), cachefile.c_str()) != 0))
+    {
+        logger->warning("unable to write eps config cache: %s", cachefile.c_str());
+        std::remove(tmpfile.c_str());
+        return false;
+    }
+
+    logger->debug("eps config cache written: %s (%lu bytes)", cachefile.c_str(), static_cast<unsigned long>(blob.size()));
+    return true;
+}
@@ -0,0 +1,308 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include "config_watch.hpp"
+#include "types.hpp"
+
+#include <ItcLogger/Logger.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <exception>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+
+    const uint32_t WATCH_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE; //!< Events that replace file contents
+
+    /* compare board layouts */
+    bool same_layout(const BoardLayout& a, const BoardLayout& b)
+    {
+        if((a.get_buses().size() != b.get_buses().size()) || (a.get_connections() != b.get_connections()) ||
+           (a.get_channels().size() != b.get_channels().size()) || (a.get_switches() != b.get_switches()) ||
+           (a.get_pcm_resets() != b.get_pcm_resets()) || (a.get_node_reset() != b.get_node_reset()))
+        {
+            return false;
+        }
+        for(size_t i = 0; i < a.get_buses().size(); i++)
+        {
+            const BusInfo& x = a.get_buses()[i];
+            const BusInfo& y = b.get_buses()[i];
+            if((x.name != y.name) || (x.type != y.type) || (x.units != y.units)) return false;
+        }
+        for(size_t i = 0; i < a.get_channels().size(); i++)
+        {
+            const ChannelInfo& x = a.get_channels()[i];
+            const ChannelInfo& y = b.get_channels()[i];
+            if((x.code != y.code) || (x.bus != y.bus) || (x.slot != y.slot) || (x.unit != y.unit)) return false;
+        }
+        return true;
+    }
+
+    /* compare switch trip configs */
+    bool same_trips(const Config::SwitchTrips& a, const Config::SwitchTrips& b)
+    {
+        if(a.size() != b.size()) return false;
+        for(size_t i = 0; i < a.size(); i++)
+        {
+            if((a[i].current_limit != b[i].current_limit) || (a[i].trip_delay_ms != b[i].trip_delay_ms) ||
+               (a[i].retry_delay_ms != b[i].retry_delay_ms) || (a[i].max_retries != b[i].max_retries))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* compare switch load configs */
+    bool same_loads(const Config::SwitchLoads& a, const Config::SwitchLoads& b)
+    {
+        if(a.size() != b.size()) return false;
+        for(size_t i = 0; i < a.size(); i++)
+        {
+            if((a[i].file != b[i].file) || (a[i].loop != b[i].loop)) return false;
+        }
+        return true;
+    }
+}
+
+bool ConfigDiff::empty() const
+{
+    return tlm.empty() && adc.empty() && switch_states.empty() && !version_changed && !db_version_changed;
+}
+
+ConfigDiff itc::eps::diff_config(const Config& running, const Config& updated)
+{
+    ConfigDiff diff;
+
+    // applied while running (channels removed from the config keep their values)
+    for(Config::Telemetry::const_iterator it = updated.tlm.begin(); it != updated.tlm.end(); ++it)
+    {
+        Config::Telemetry::const_iterator old = running.tlm.find(it->first);
+        if((old == running.tlm.end()) || (old->second != it->second)) diff.tlm.insert(*it);
+    }
+    for(Config::ChannelConfig::const_iterator it = updated.adc.begin(); it != updated.adc.end(); ++it)
+    {
+        Config::ChannelConfig::const_iterator old = running.adc.find(it->first);
+        if((old == running.adc.end()) || (old->second != it->second)) diff.adc.insert(*it);
+    }
+    for(unsigned int i = 0; i < updated.switch_states.size(); i++)
+    {
+        if((i >= running.switch_states.size()) || (running.switch_states[i] != updated.switch_states[i]))
+        {
+            diff.switch_states[i] = updated.switch_states[i];
+        }
+    }
+    diff.version_changed = (running.version.version != updated.version.version);
+    diff.version = updated.version;
+    diff.db_version_changed = (running.db_version.version != updated.db_version.version);
+    diff.db_version = updated.db_version;
+
+    // applied on restart
+    if(running.log_level != updated.log_level) diff.restart.push_back("log_level");
+    if((running.swap.in != updated.swap.in) || (running.swap.out != updated.swap.out)) diff.restart.push_back("swap_bytes");
+    if((running.nos.uri != updated.nos.uri) || (running.nos.node != updated.nos.node) ||
+       (running.nos.i2c_bus != updated.nos.i2c_bus) || (running.nos.time_bus != updated.nos.time_bus) ||
+       (running.nos.tick_ms != updated.nos.tick_ms))
+    {
+        diff.restart.push_back("nos");
+    }
+    if(running.gui.refresh_hz != updated.gui.refresh_hz) diff.restart.push_back("gui");
+    if(running.eps_address != updated.eps_address) diff.restart.push_back("eps.address");
+    if(running.db_connected != updated.db_connected) diff.restart.push_back("eps.daughterboard.connected");
+    if(!same_layout(running.layout, updated.layout)) diff.restart.push_back("eps.topology");
+    if((running.eeprom.file != updated.eeprom.file) || (running.eeprom.sync_ms != updated.eeprom.sync_ms))
+    {
+        diff.restart.push_back("eps.eeprom");
+    }
+    if((running.actor.enabled != updated.actor.enabled) || (running.actor.cpu != updated.actor.cpu))
+    {
+        diff.restart.push_back("eps.actor");
+    }
+    if((running.shm.enabled != updated.shm.enabled) || (running.shm.name != updated.shm.name))
+    {
+        diff.restart.push_back("eps.shm");
+    }
+    if((running.history.enabled != updated.history.enabled) || (running.history.period_ms != updated.history.period_ms))
+    {
+        diff.restart.push_back("eps.history");
+    }
+    if((running.reload.enabled != updated.reload.enabled) || (running.reload.debounce_ms != updated.reload.debounce_ms))
+    {
+        diff.restart.push_back("eps.reload");
+    }
+    if(running.stats.enabled != updated.stats.enabled) diff.restart.push_back("eps.stats");
+    if((running.metrics.enabled != updated.metrics.enabled) || (running.metrics.period_ms != updated.metrics.period_ms) ||
+       (running.metrics.textfile != updated.metrics.textfile) || (running.metrics.shm != updated.metrics.shm))
+    {
+        diff.restart.push_back("eps.metrics");
+    }
+    if(!same_trips(running.switch_trips, updated.switch_trips)) diff.restart.push_back("eps.switch_trip");
+    if((running.load_aggregation != updated.load_aggregation) || !same_loads(running.switch_loads, updated.switch_loads))
+    {
+        diff.restart.push_back("eps.loads");
+    }
+    return diff;
+}
+
+ConfigWatcher::ConfigWatcher(const std::string& cfgfile, const std::string& cachefile, const Config& config,
+                             ApplyHandler apply) :
+    cfgfile(cfgfile),
+    cachefile(cachefile),
+    dir(),
+    name(),
+    config(config),
+    apply(apply),
+    inotify_fd(-1),
+    stop_fd{-1, -1},
+    stopping(false),
+    thread()
+{
+    // watch the directory, the file itself is replaced by editors that write and rename
+    size_t slash = cfgfile.find_last_of('/');
+    dir = (slash == std::string::npos) ? "." : ((slash == 0) ? "/" : cfgfile.substr(0, slash));
+    name = (slash == std::string::npos) ? cfgfile : cfgfile.substr(slash + 1);
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    stop();
+}
+
+bool ConfigWatcher::start()
+{
+    if(thread.joinable()) return true;
+
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if((inotify_fd < 0) || (inotify_add_watch(inotify_fd, dir.c_str(), WATCH_EVENTS) < 0) ||
+       (pipe2(stop_fd, O_CLOEXEC) != 0))
+    {
+        logger->error("unable to watch eps config file: %s (errno %d)", cfgfile.c_str(), errno);
+        stop();
+        return false;
+    }
+
+    stopping = false;
+    thread = std::thread(&ConfigWatcher::run, this);
+    logger->info("watching eps config file: %s", cfgfile.c_str());
+    return true;
+}
+
+void ConfigWatcher::stop()
+{
+    if(thread.joinable())
+    {
+        char c = 0;
+        if(write(stop_fd[1], &c, 1) < 0) logger->error("unable to stop eps config watcher");
+        thread.join();
+    }
+    if(inotify_fd >= 0) ::close(inotify_fd);
+    if(stop_fd[0] >= 0) ::close(stop_fd[0]);
+    if(stop_fd[1] >= 0) ::close(stop_fd[1]);
+    inotify_fd = -1;
+    stop_fd[0] = -1;
+    stop_fd[1] = -1;
+}
+
+void ConfigWatcher::run()
+{
+    while(!stopping)
+    {
+        if(!wait_change(-1)) continue;
+
+        // wait for writes to settle (editors may write several times), then reload once
+        while(wait_change(static_cast<int>(config.reload.debounce_ms))) {}
+        if(!stopping) reload();
+    }
+}
+
+bool ConfigWatcher::wait_change(int timeout_ms)
+{
+    struct pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {stop_fd[0], POLLIN, 0}};
+    int ready = poll(fds, 2, timeout_ms);
+    if(ready < 0)
+    {
+        if(errno == EINTR) return false;
+        logger->error("eps config watch failed (errno %d)", errno);
+        stopping = true;
+        return false;
+    }
+    if(fds[1].revents != 0)
+    {
+        stopping = true;
+        return false;
+    }
+    if(fds[0].revents == 0) return false;
+
+    // events for the config file (other files in the directory are ignored)
+    bool changed = false;
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t len;
+    while((len = read(inotify_fd, buffer, sizeof(buffer))) > 0)
+    {
+        for(char *ptr = buffer; ptr < buffer + len; )
+        {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>(ptr);
+            if((event->len > 0) && (name == event->name)) changed = true;
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+void ConfigWatcher::reload()
+{
+    // parse off the simulator thread (a bad edit keeps the running config)
+    Config updated;
+    try
+    {
+        updated.load(cfgfile, cachefile);
+    }
+    catch(const std::exception& e)
+    {
+        logger->error("eps config reload failed: %s", e.what());
+        return;
+    }
+
+    ConfigDiff diff = diff_config(config, updated);
+    for(std::vector<std::string>::const_iterator it = diff.restart.begin(); it != diff.restart.end(); ++it)
+    {
+        logger->warning("eps config change needs restart: %s", it->c_str());
+    }
+    if(!diff.empty())
+    {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        apply(diff);
+        double apply_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        logger->info("eps config reloaded: tlm=%u adc=%u switches=%u versions=%u (%.2f ms)",
+                     static_cast<unsigned int>(diff.tlm.size()), static_cast<unsigned int>(diff.adc.size()),
+                     static_cast<unsigned int>(diff.switch_states.size()),
+                     static_cast<unsigned int>(diff.version_changed) + static_cast<unsigned int>(diff.db_version_changed),
+                     apply_ms);
+    }
+    config = updated;
+}
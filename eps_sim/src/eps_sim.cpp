@@ -18,243 +18,422 @@
 */
 
 #include "eps_sim.hpp"
+#include "config_watch.hpp"
+#include "fleet.hpp"
+#include "log.hpp"
+#include "trace.hpp"
 #include "types.hpp"
 #include "util.hpp"
 
 #include <Client/Bus.hpp>
-#include <ItcLogger/Logger.hpp>
-
-// NOTE: fltk includes X11/X.h, which has '#define Success', which causes issues when
-//       including nos engine headers that define a 'Success' enum field. to prevent
-//       this, the fltk headers are included after nos.
-#include "eps_win.hpp"
-#include "widgets.hpp"
 
 #include <cstdint>
+#include <cstdio>
 #include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
 
 using namespace itc::eps;
 
-ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
-
-const ChannelCode SWITCH_CHANNELS[][2] = {
-    {CHANNEL_VSW1,  CHANNEL_ISW1},
-    {CHANNEL_VSW2,  CHANNEL_ISW2},
-    {CHANNEL_VSW3,  CHANNEL_ISW3},
-    {CHANNEL_VSW4,  CHANNEL_ISW4},
-    {CHANNEL_VSW5,  CHANNEL_ISW5},
-    {CHANNEL_VSW6,  CHANNEL_ISW6},
-    {CHANNEL_VSW7,  CHANNEL_ISW7},
-    {CHANNEL_VSW8,  CHANNEL_ISW8},
-    {CHANNEL_VSW9,  CHANNEL_ISW9},
-    {CHANNEL_VSW10, CHANNEL_ISW10},
-};
-
-EpsSim::EpsSim(const Config& config) :
+EpsSim::EpsSim(const Config& config, StartupProfile *startup) :
     NosEngine::I2C::I2CSlave(config.eps_address, config.nos.uri, config.nos.i2c_bus),
     mutex(),
+    nos_enabled(true),
+    nos_calls(0),
     time_bus(get_transport_hub(), config.nos.uri, config.nos.time_bus),
     tick_ms(config.nos.tick_ms),
-    eps(config.eps_address, config.db_connected, config.swap),
-    win(new EpsWindow)
+    eps(),
+    eeprom(),
+    actor(),
+    shm(),
+    frames(),
+    history(),
+    stats(),
+    lock_wait(),
+    frame_time(),
+    sim_time_ms(0),
+    lock_timing(false)
 {
     // create time client
     //time_bus.add_time_tick_callback(std::bind(&EpsSim::on_time_tick, this, std::placeholders::_1);
 
-    // setup gui callbacks
-    for(TlmWidgetMap::iterator it = win->tlm.begin(); it != win->tlm.end(); ++it)
+    // initialize eps simulator (channels initialized in bulk, logged once)
+    StartupProfile::TimePoint init_begin = StartupProfile::now();
+    eps = create_eps(config);
+    attach(config, config.eeprom.file, config.shm.name);
+    if(startup) startup->add("eps init", init_begin);
+}
+
+EpsSim::EpsSim(const Config& base, const BoardConfig& board, const Eps& prototype) :
+    NosEngine::I2C::I2CSlave(board.address, base.nos.uri, board.i2c_bus.empty() ? base.nos.i2c_bus : board.i2c_bus),
+    mutex(),
+    nos_enabled(true),
+    nos_calls(0),
+    time_bus(get_transport_hub(), base.nos.uri, base.nos.time_bus),
+    tick_ms(base.nos.tick_ms),
+    eps(prototype.fork()),
+    eeprom(),
+    actor(),
+    shm(),
+    frames(),
+    history(),
+    stats(),
+    lock_wait(),
+    frame_time(),
+    sim_time_ms(0),
+    lock_timing(false)
+{
+    // board configured from the shared base, only the overrides are applied
+    eps->set_address(board.address);
+    if(!board.tlm.empty()) eps->set_telemetry(board.tlm);
+    for(std::map<unsigned int, bool>::const_iterator it = board.switch_states.begin();
+        it != board.switch_states.end(); ++it)
     {
-        it->second.analog_in->set_channel(it->first);
-        it->second.analog_in->when(FL_WHEN_ENTER_KEY | FL_WHEN_NOT_CHANGED);
-        it->second.analog_in->callback(on_tlm_update, this);
+        eps->set_switch_state(it->first, it->second);
     }
-    for(int i = 0; i < NUM_SWITCHES; i++)
+    attach(base, get_eeprom_file(base.eeprom.dir, board.address), get_shm_name(board.address));
+}
+
+std::unique_ptr<Eps> EpsSim::create_eps(const Config& config)
+{
+    std::unique_ptr<Eps> eps(new Eps(config.eps_address, config.db_connected, config.layout, config.swap));
+    eps->set_version(config.version);
+    eps->set_daughterboard_version(config.db_version);
+    eps->set_telemetry(config.tlm);
+    eps->configure_channels(config.adc);
+    for(unsigned int i = 0; i < config.switch_trips.size(); i++)
     {
-        win->switch_in[i]->set_switch_num(i);
-        win->switch_in[i]->callback(on_switch_update, this);
+        eps->set_switch_trip_config(i, config.switch_trips[i]);
     }
+    for(unsigned int i = 0; i < config.switch_loads.size(); i++)
+    {
+        const LoadConfig& load = config.switch_loads[i];
+        if(load.file.empty()) continue;
 
-    // show window
-    win->nos_status_out->value(true);
-    win->show();
-
-    // initialize eps simulator
-    eps.set_version(config.version);
-    eps.set_daughterboard_version(config.db_version);
-    for(Config::Telemetry::const_iterator it = config.tlm.begin(); it != config.tlm.end(); ++it)
+        std::shared_ptr<FileLoadProfile> profile(new FileLoadProfile(load.loop));
+        if(profile->load(load.file)) eps->set_switch_load(i, profile);
+    }
+    eps->set_load_aggregation(config.load_aggregation);
+    for(unsigned int i = 0; i < config.switch_states.size(); i++)
     {
-        eps.set_telemetry(it->first, it->second);
+        eps->set_switch_state(i, config.switch_states[i]);
     }
-    for(Config::ChannelConfig::const_iterator it = config.adc.begin(); it != config.adc.end(); ++it)
+    return eps;
+}
+
+void EpsSim::attach(const Config& config, const std::string& eeprom_file, const std::string& shm_name)
+{
+    // restore eeprom backed values
+    if(!eeprom_file.empty())
     {
-        eps.configure_channel(it->first, it->second);
+        eeprom = std::make_shared<EepromStore>();
+        if(eeprom->open(eeprom_file))
+        {
+            eps->attach_eeprom(eeprom);
+        }
+        else
+        {
+            eeprom.reset();
+        }
     }
-    for(int i = 0; i < config.switch_states.size(); i++)
+
+    // shared memory segment for out of process viewers
+    if(config.shm.enabled)
     {
-        eps.set_switch_state(i, config.switch_states[i]);
+        shm = std::make_shared<ShmServer>();
+        if(!shm->create(shm_name, eps->get_address())) shm.reset();
     }
 
-    // set intial window state
-    update_win();
+    // readers (window, viewers, exporters) use published state frames, in shared memory if enabled
+    frames = shm ? eps->enable_frames(std::shared_ptr<FramePublisher>(shm, &shm->get_frames())) :
+                   eps->enable_frames();
+
+    // telemetry history recorded as time advances (charts read it without locking)
+    if(config.history.enabled) history = eps->enable_history(config.history.period_ms);
+
+    // per command counters (eps) and transaction latency (recorded here), also read by the metrics exporter
+    if(config.stats.enabled || config.metrics.enabled) stats = eps->enable_stats();
+    lock_timing = config.metrics.enabled;
+
+    // hand the eps to the simulator thread
+    if(config.actor.enabled)
+    {
+        actor.reset(new EpsActor(*eps));
+        actor->start(config.actor.cpu);
+    }
 }
 
 EpsSim::~EpsSim()
 {
-    if(win) delete win;
+    // NOS may still deliver callbacks until the slave is destroyed, they are rejected from now on
+    nos_enabled = false;
+    while(nos_calls.load() > 0) std::this_thread::yield();
+    if(actor) actor->stop();
 }
 
-void EpsSim::minimize()
+EpsSim::NosCall::NosCall(EpsSim& sim) :
+    sim(sim),
+    accepted(false)
 {
-    win->iconize();
+    // counted before checking, so the destructor waits for every accepted callback
+    sim.nos_calls.fetch_add(1);
+    accepted = sim.nos_enabled.load();
 }
 
-size_t EpsSim::i2c_read(uint8_t* rbuf, size_t rlen)
+EpsSim::NosCall::~NosCall()
 {
-    // lock for the eps sim object
-    std::lock_guard<std::mutex> lock(mutex);
+    sim.nos_calls.fetch_sub(1);
+}
 
-    // eps i2c transaction
-    itc::eps::I2CData response;
-    eps.i2c_read(response);
+std::shared_ptr<const FramePublisher> EpsSim::get_frames() const
+{
+    return frames;
+}
 
-    size_t num_read = response.size();
-    if(num_read > rlen)
-    {
-        response.resize(rlen);
-    }
+std::shared_ptr<const HistoryStore> EpsSim::get_history() const
+{
+    return history;
+}
 
-    std::copy(response.begin(), response.end(), rbuf);
+std::shared_ptr<const CommandStats> EpsSim::get_stats() const
+{
+    return stats;
+}
 
-    return num_read;
+const DurationCounter& EpsSim::get_lock_wait() const
+{
+    return lock_wait;
 }
 
-size_t EpsSim::i2c_write(const uint8_t *wbuf, size_t wlen)
+const DurationCounter& EpsSim::get_frame_time() const
 {
-    // lock for the eps sim object
-    std::lock_guard<std::mutex> lock(mutex);
+    return frame_time;
+}
 
-    // update eps time
-    uint64_t time_ms = time_bus.get_time() * tick_ms;
-    eps.set_time(time_ms);
+DurationCounter& EpsSim::get_frame_time()
+{
+    return frame_time;
+}
 
-    logger->info("nos request received: time=%lums", static_cast<unsigned long>(time_ms));
-    
-    // eps i2c transaction
-    itc::eps::I2CData data(wbuf, wbuf + wlen);
-    eps.i2c_write(data);
+uint64_t EpsSim::get_sim_time_ms() const
+{
+    return sim_time_ms.load(std::memory_order_relaxed);
+}
 
-    // update ui
-    update_win();
+bool EpsSim::save_snapshot(const std::string& filename)
+{
+    StateBlob blob;
+    execute([&blob](Eps& eps) {eps.save_state(blob);}, true);
+
+    // write to temporary file and rename, so an interrupted write never replaces a good snapshot
+    std::string tmpfile = filename + ".tmp";
+    std::ofstream file(tmpfile.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+    file.close();
+    if(!file || (std::rename(tmpfile.c_str(), filename.c_str()) != 0))
+    {
+        EPS_LOG_ERROR("unable to write eps snapshot: %s", filename.c_str());
+        return false;
+    }
 
-    return wlen;
+    EPS_LOG_INFO("eps snapshot saved: %s (%lu bytes)", filename.c_str(), static_cast<unsigned long>(blob.size()));
+    return true;
 }
 
-void EpsSim::on_time_tick(NosEngine::Common::SimTime time)
+bool EpsSim::load_snapshot(const std::string& filename)
 {
-    logger->info("on_time_tick: %lu", static_cast<unsigned long>(time));
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if(!file)
+    {
+        EPS_LOG_ERROR("unable to open eps snapshot: %s", filename.c_str());
+        return false;
+    }
+    StateBlob blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    bool loaded = false;
+    execute([&blob, &loaded](Eps& eps) {loaded = eps.load_state(blob);}, true);
+    if(!loaded)
+    {
+        EPS_LOG_ERROR("invalid eps snapshot: %s", filename.c_str());
+        return false;
+    }
+
+    EPS_LOG_INFO("eps snapshot loaded: %s", filename.c_str());
+    return true;
 }
 
-void EpsSim::on_tlm_update(Fl_Widget *widget, void *user)
+void EpsSim::sync_eeprom()
 {
-    EpsSim *sim = reinterpret_cast<EpsSim*>(user);
-    TlmInput *input = reinterpret_cast<TlmInput*>(widget);
-
-    // lock for the eps sim object
-    std::lock_guard<std::mutex> lock(sim->mutex);
-
-    // update telemetry
-    ChannelCode code = input->get_channel();
-    double val = input->value();
-    sim->eps.set_telemetry(code, val);
-
-    // reset input widget
-    input->value(0);
-
-    // read actual value to ensure successful update
-    ChannelTelemetry tlm;
-    sim->eps.get_telemetry(code, tlm);
-    TlmWidgets widgets = sim->win->tlm[code];
-    widgets.digital_out->value(tlm.digital);
-    widgets.analog_out->value(tlm.analog);
+    if(eeprom) eeprom->sync();
 }
 
-void EpsSim::on_switch_update(Fl_Widget *widget, void *user)
+bool EpsSim::dump_stats(const std::string& filename)
 {
-    EpsSim *sim = reinterpret_cast<EpsSim*>(user);
-    SwitchButton *btn = reinterpret_cast<SwitchButton*>(widget);
+    if(!stats) return false;
 
-    // lock for the eps sim object
-    std::lock_guard<std::mutex> lock(sim->mutex);
+    // statistics are read without locking the eps
+    std::string report = stats->get_report();
+    if(filename.empty())
+    {
+        EPS_LOG_INFO("eps command stats: address=0x%x", static_cast<unsigned int>(eps->get_address()));
+        std::string::size_type begin = 0;
+        std::string::size_type end = 0;
+        while((end = report.find('\n', begin)) != std::string::npos)
+        {
+            EPS_LOG_INFO("%s", report.substr(begin, end - begin).c_str());
+            begin = end + 1;
+        }
+        return true;
+    }
 
-    // update switch state
-    unsigned int num = btn->get_switch_num();
-    bool state = btn->value();
-    sim->eps.set_switch_state(num, state);
+    // write to temporary file and rename, so readers never see a partial report
+    std::string tmpfile = filename + ".tmp";
+    std::ofstream file(tmpfile.c_str(), std::ios::trunc);
+    file << report;
+    file.close();
+    if(!file || (std::rename(tmpfile.c_str(), filename.c_str()) != 0))
+    {
+        EPS_LOG_ERROR("unable to write eps command stats: %s", filename.c_str());
+        return false;
+    }
 
-    // reset switch state
-    btn->value(sim->eps.get_switch_state(num));
+    EPS_LOG_INFO("eps command stats written: %s", filename.c_str());
+    return true;
+}
 
-    // update switch telemetry values
-    for(int i = 0; i < 2; i++)
+void EpsSim::apply_edit(const EditCommand& command)
+{
+    unsigned int num = command.num;
+    double value = command.value;
+    switch(command.type)
     {
-        ChannelCode code = SWITCH_CHANNELS[num][i];
-        ChannelTelemetry tlm;
-        sim->eps.get_telemetry(code, tlm);
-        TlmWidgets widgets = sim->win->tlm[code];
-        widgets.digital_out->value(tlm.digital);
-        widgets.analog_out->value(tlm.analog);
+        case EDIT_TELEMETRY:
+            execute([num, value](Eps& eps) {eps.set_telemetry(static_cast<ChannelCode>(num), value);}, false);
+            break;
+        case EDIT_SWITCH:
+            execute([num, value](Eps& eps) {eps.set_switch_state(num, value != 0);}, false);
+            break;
+        default:
+            EPS_LOG_WARNING("unknown eps edit: type=%u", command.type);
+            break;
     }
 }
 
-void EpsSim::update_win()
+void EpsSim::apply_config(const ConfigDiff& diff)
+{
+    // all changes in one task, so i2c transactions see either the old or the new config
+    execute([&diff](Eps& eps) {
+        if(diff.version_changed) eps.set_version(diff.version);
+        if(diff.db_version_changed) eps.set_daughterboard_version(diff.db_version);
+        if(!diff.adc.empty()) eps.configure_channels(diff.adc);
+        if(!diff.tlm.empty()) eps.set_telemetry(diff.tlm);
+        for(std::map<unsigned int, bool>::const_iterator it = diff.switch_states.begin();
+            it != diff.switch_states.end(); ++it)
+        {
+            eps.set_switch_state(it->first, it->second);
+        }
+    }, true);
+}
+
+void EpsSim::poll_edits()
 {
-    // ensure proper locking for thread support
-    Fl::lock();
-
-    // update sim time
-    win->sim_time_out->value(eps.get_time() / 1000.0); 
-
-    // update version
-    Version version = eps.get_version();
-    win->firmware_out->value(version.get_firmware());
-    win->revision_out->value(version.get_revision());
-
-    // update status
-    Status status = eps.get_status();
-    win->checksum_out->value(to_string(status.get_checksum(), true).c_str());
-    win->reset_power_on_out->value(status.get_num_resets(RESET_POWER_ON));
-    win->reset_brown_out->value(status.get_num_resets(RESET_BROWN_OUT));
-    win->reset_manual_out->value(status.get_num_resets(RESET_MANUAL));
-    win->reset_wdt_out->value(status.get_num_resets(RESET_WDT));
-    for(int i = 0; i < NUM_STATUS_BITS; i++)
+    EditCommand command;
+    while(shm && shm->poll(command))
     {
-        win->status_out[i]->value(status.is_set(static_cast<BoardStatus>(i)));
+        apply_edit(command);
     }
-    ErrorCode ec = status.get_last_error();
-    win->error_code_out->value(to_string(ec, true).c_str());
-    win->error_msg_out->value(to_string(ec).c_str());
+}
+
+size_t EpsSim::i2c_read(uint8_t* rbuf, size_t rlen)
+{
+    TraceSpan span("nos_i2c_read", "sim");
+    NosCall call(*this);
+    if(!call.accepted) return 0;
+
+    // eps i2c transaction
+    itc::eps::I2CData response;
+    execute([&response](Eps& eps) {eps.i2c_read(response);}, true);
 
-    // update switch states
-    for(int i = 0; i < NUM_SWITCHES; i++)
+    size_t num_read = response.size();
+    if(num_read > rlen)
     {
-        win->switch_in[i]->value(eps.get_switch_state(i));
+        response.resize(rlen);
     }
 
-    // update telemetry
-    Telemetry tlm;
-    eps.get_telemetry(tlm);
-    for(Telemetry::const_iterator it = tlm.begin(); it != tlm.end(); ++it)
+    std::copy(response.begin(), response.end(), rbuf);
+
+    return num_read;
+}
+
+size_t EpsSim::i2c_write(const uint8_t *wbuf, size_t wlen)
+{
+    TraceSpan span("nos_i2c_write", "sim", "cmd", (wlen > 0) ? wbuf[0] : -1);
+    NosCall call(*this);
+    if(!call.accepted) return 0;
+
+    // transaction latency from nos request to response ready
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    // update eps time
+    uint64_t time_ms = time_bus.get_time() * tick_ms;
+    EPS_LOG_DEBUG("nos request received: time=%lums", static_cast<unsigned long>(time_ms));
+    sim_time_ms.store(time_ms, std::memory_order_relaxed);
+
+    // eps i2c transaction
+    itc::eps::I2CData data(wbuf, wbuf + wlen);
+    execute([time_ms, &data](Eps& eps) {
+        eps.set_time(time_ms);
+        eps.i2c_write(data);
+    }, true);
+
+    if(stats && (wlen > 0))
     {
-        TlmWidgetMap::const_iterator wit = win->tlm.find(it->first);
-        if(wit != win->tlm.end())
-        {
-            wit->second.digital_out->value(it->second.digital);
-            wit->second.analog_out->value(it->second.analog);
-        }
+        std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - begin;
+        stats->record_latency(wbuf[0], static_cast<uint64_t>(latency.count()));
     }
+    return wlen;
+}
 
-    Fl::awake();
-    Fl::unlock();
+void EpsSim::on_time_tick(NosEngine::Common::SimTime time)
+{
+    EPS_LOG_DEBUG("on_time_tick: %lu", static_cast<unsigned long>(time));
+
+    TraceSpan span("nos_time_tick", "sim", "tick", static_cast<int64_t>(time));
+    NosCall call(*this);
+    if(!call.accepted) return;
+    uint64_t time_ms = time * tick_ms;
+    sim_time_ms.store(time_ms, std::memory_order_relaxed);
+    execute([time_ms](Eps& eps) {eps.set_time(time_ms);}, false);
 }
 
+void EpsSim::execute(EpsTask task, bool wait)
+{
+    if(actor)
+    {
+        if(wait)
+        {
+            // queue wait plus task run on the simulator thread
+            TraceSpan span("actor_call", "sim");
+            actor->call(task);
+        }
+        else
+        {
+            actor->post(std::move(task));
+        }
+    }
+    else
+    {
+        // lock for the eps sim object
+        std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+        {
+            TraceSpan span("lock_wait", "sim");
+            ScopedDuration duration(lock_timing ? &lock_wait : nullptr);
+            lock.lock();
+        }
+        task(*eps);
+    }
+}
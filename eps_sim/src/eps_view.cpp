@@ -0,0 +1,268 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include "eps_view.hpp"
+#include "eeprom.hpp"
+#include "metrics.hpp"
+#include "status.hpp"
+#include "trace.hpp"
+#include "util.hpp"
+#include "version.hpp"
+
+// NOTE: fltk includes X11/X.h, which has '#define Success', which causes issues when
+//       including nos engine headers that define a 'Success' enum field. to prevent
+//       this, the fltk headers are included after nos.
+#include "eps_win.hpp"
+#include "widgets.hpp"
+
+#include <algorithm>
+
+using namespace itc::eps;
+
+namespace
+{
+    const char *CHART_SPAN_NAMES[] = {"10 s", "1 min", "10 min", "1 h", "6 h"};                //!< Chart span choices
+    const uint64_t CHART_SPANS_MS[] = {10000, 60000, 600000, 3600000, 21600000};             //!< Chart spans (ms)
+    const unsigned int NUM_CHART_SPANS = sizeof(CHART_SPANS_MS) / sizeof(CHART_SPANS_MS[0]); //!< Chart span choice count
+}
+
+EpsView::EpsView(std::shared_ptr<const FramePublisher> frames, std::shared_ptr<const HistoryStore> history,
+                 EditHandler edit, double refresh_hz, EpsWindow *prepared) :
+    frames(frames),
+    edit(edit),
+    recorder(),
+    win(prepared ? prepared : new EpsWindow),
+    refresh_s(1.0 / std::max(refresh_hz, 0.1)),
+    win_frame(),
+    win_count(0),
+    win_full(false),
+    frame_time(nullptr)
+{
+    // window contents follow the board layout of the current frame
+    StateFrame frame = StateFrame();
+    if(frames) frames->read(frame);
+
+    // telemetry table generated from frame channels, filtered by bus type
+    win->tlm_table->get_input()->when(FL_WHEN_ENTER_KEY | FL_WHEN_NOT_CHANGED);
+    win->tlm_table->get_input()->callback(on_tlm_update, this);
+    win->tlm_filter->add("All");
+    win->tlm_filter->add("BCR");
+    win->tlm_filter->add("PCM");
+    win->tlm_filter->add("PDM");
+    win->tlm_filter->add("Board");
+    win->tlm_filter->value(FILTER_ALL);
+    win->tlm_filter->callback(on_filter_update, this);
+    win->tlm_table->set_select_callback(on_channel_select, this);
+
+    // strip chart of selected channel (history recorded here if the simulator does not share it)
+    if(!history)
+    {
+        std::vector<ChannelCode> codes;
+        for(unsigned int i = 0; i < frame.num_channels; i++)
+        {
+            codes.push_back(static_cast<ChannelCode>(frame.codes[i]));
+        }
+        recorder = std::make_shared<HistoryStore>(codes, static_cast<unsigned int>(refresh_s * 1000));
+        history = recorder;
+    }
+    for(unsigned int i = 0; i < NUM_CHART_SPANS; i++)
+    {
+        win->chart_span->add(CHART_SPAN_NAMES[i]);
+    }
+    win->chart_span->value(0);
+    win->chart_span->callback(on_span_update, this);
+    win->tlm_chart->set_history(history);
+    win->tlm_chart->set_span(CHART_SPANS_MS[0]);
+
+    // switch buttons generated from frame switches
+    win->switch_scroll->begin();
+    for(unsigned int i = 0; i < frame.num_switches; i++)
+    {
+        SwitchButton *btn = new SwitchButton(win->switch_scroll->x(), win->switch_scroll->y() + 20 * i, 110, 20);
+        btn->copy_label(("Switch " + to_string(i + 1)).c_str());
+        btn->box(FL_NO_BOX);
+        btn->selection_color(static_cast<Fl_Color>(2));
+        btn->labelsize(12);
+        btn->set_switch_num(i);
+        btn->callback(on_switch_update, this);
+        win->switch_in.push_back(btn);
+    }
+    win->switch_scroll->end();
+
+    // set intial window state and refresh at frame rate (shown later, startup does not wait on the display)
+    win->nos_status_out->value(true);
+    update_win(true);
+    Fl::add_timeout(refresh_s, on_refresh, this);
+}
+
+EpsView::~EpsView()
+{
+    Fl::remove_timeout(on_refresh, this);
+    if(win) delete win;
+}
+
+void EpsView::show()
+{
+    win->show();
+}
+
+void EpsView::minimize()
+{
+    win->iconize();
+}
+
+void EpsView::set_connected(bool connected)
+{
+    win->nos_status_out->value(connected);
+}
+
+void EpsView::set_frame_time(DurationCounter *counter)
+{
+    frame_time = counter;
+}
+
+void EpsView::on_tlm_update(Fl_Widget *widget, void *user)
+{
+    EpsView *view = reinterpret_cast<EpsView*>(user);
+    TlmInput *input = reinterpret_cast<TlmInput*>(widget);
+
+    // update telemetry (show actual values to ensure successful update)
+    ChannelCode code = input->get_channel();
+    double val = input->value();
+    view->win_full = true;
+    view->edit(EditCommand(EDIT_TELEMETRY, code, val));
+
+    // reset input widget
+    input->value(0);
+    input->hide();
+}
+
+void EpsView::on_switch_update(Fl_Widget *widget, void *user)
+{
+    EpsView *view = reinterpret_cast<EpsView*>(user);
+    SwitchButton *btn = reinterpret_cast<SwitchButton*>(widget);
+
+    // update switch state (reset switch state and update switch telemetry values)
+    unsigned int num = btn->get_switch_num();
+    bool state = btn->value();
+    view->win_full = true;
+    view->edit(EditCommand(EDIT_SWITCH, num, state ? 1 : 0));
+}
+
+void EpsView::on_filter_update(Fl_Widget *widget, void *user)
+{
+    EpsView *view = reinterpret_cast<EpsView*>(user);
+    Fl_Choice *choice = reinterpret_cast<Fl_Choice*>(widget);
+    view->win->tlm_table->set_filter(static_cast<TlmFilter>(choice->value()));
+}
+
+void EpsView::on_channel_select(Fl_Widget *widget, void *user)
+{
+    EpsView *view = reinterpret_cast<EpsView*>(user);
+    TlmTable *table = reinterpret_cast<TlmTable*>(widget);
+    view->win->tlm_chart->set_channel(table->get_selected());
+}
+
+void EpsView::on_span_update(Fl_Widget *widget, void *user)
+{
+    EpsView *view = reinterpret_cast<EpsView*>(user);
+    Fl_Choice *choice = reinterpret_cast<Fl_Choice*>(widget);
+    unsigned int index = std::min<unsigned int>(choice->value(), NUM_CHART_SPANS - 1);
+    view->win->tlm_chart->set_span(CHART_SPANS_MS[index]);
+}
+
+void EpsView::on_refresh(void *user)
+{
+    EpsView *view = reinterpret_cast<EpsView*>(user);
+    view->update_win(view->win_full);
+    view->win->tlm_chart->update();
+    Fl::repeat_timeout(view->refresh_s, on_refresh, user);
+}
+
+void EpsView::update_win(bool full)
+{
+    // latest state (never blocks the simulator thread)
+    if(!frames) return;
+    uint64_t count = frames->get_count();
+    if(!full && (count == win_count)) return;
+    TraceSpan span("update_win", "gui", "full", full);
+    ScopedDuration duration(frame_time);
+    StateFrame frame;
+    if(!frames->read(frame)) return;
+    win_count = count;
+    win_full = false;
+    if(recorder) recorder->record(frame.time_ms, frame.analog, frame.num_channels);
+
+    // update sim time
+    if(full || (frame.time_ms != win_frame.time_ms)) win->sim_time_out->value(frame.time_ms / 1000.0);
+
+    // nothing else changed
+    if(!full && (frame.version == win_frame.version))
+    {
+        win_frame.time_ms = frame.time_ms;
+        return;
+    }
+
+    // update version
+    if(full || (frame.area_versions[CHANGE_AREA_CONFIG] != win_frame.area_versions[CHANGE_AREA_CONFIG]))
+    {
+        Version version(frame.board.version);
+        win->firmware_out->value(version.get_firmware());
+        win->revision_out->value(version.get_revision());
+    }
+
+    // update status
+    if(full || (frame.area_versions[CHANGE_AREA_STATUS] != win_frame.area_versions[CHANGE_AREA_STATUS]))
+    {
+        Status status(frame.board.status);
+        win->checksum_out->value(to_string(frame.board.checksum, true).c_str());
+        for(unsigned int i = 0; i < NUM_EEPROM_RESETS; i++)
+        {
+            unsigned int num = frame.board.reset_counts[i];
+            switch(EEPROM_RESET_TYPES[i])
+            {
+                case RESET_POWER_ON:  win->reset_power_on_out->value(num); break;
+                case RESET_BROWN_OUT: win->reset_brown_out->value(num);    break;
+                case RESET_MANUAL:    win->reset_manual_out->value(num);   break;
+                case RESET_WDT:       win->reset_wdt_out->value(num);      break;
+            }
+        }
+        for(int i = 0; i < NUM_STATUS_BITS; i++)
+        {
+            win->status_out[i]->value(status.is_set(static_cast<BoardStatus>(i)));
+        }
+        ErrorCode ec = static_cast<ErrorCode>(frame.board.last_error);
+        win->error_code_out->value(to_string(ec, true).c_str());
+        win->error_msg_out->value(to_string(ec).c_str());
+    }
+
+    // update switch states
+    if(full || (frame.area_versions[CHANGE_AREA_SWITCHES] != win_frame.area_versions[CHANGE_AREA_SWITCHES]))
+    {
+        unsigned int num_switches = std::min<unsigned int>(win->switch_in.size(), frame.num_switches);
+        for(unsigned int i = 0; i < num_switches; i++)
+        {
+            win->switch_in[i]->value(StateFrame::is_set(frame.switch_actual, i));
+        }
+    }
+
+    // update telemetry (visible rows only)
+    win->tlm_table->update(frame, full);
+    win_frame = frame;
+}
@@ -0,0 +1,362 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "fleet.hpp"
+#include "config_watch.hpp"
+#include "event_loop.hpp"
+#include "json_reader.hpp"
+#include "shm.hpp"
+#include "util.hpp"
+
+#include <ItcLogger/Logger.hpp>
+
+#include <boost/property_tree/json_parser/error.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <thread>
+
+using namespace itc::eps;
+
+namespace
+{
+    ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+
+    volatile std::sig_atomic_t exit_requested = 0; //!< Set by exit signals
+
+    /* request exit (signal handler) */
+    void on_exit_signal(int)
+    {
+        exit_requested = 1;
+    }
+
+    /* read telemetry channel code key (hex) */
+    ChannelCode read_channel_code(JsonReader& reader, const std::string& key)
+    {
+        char *last = nullptr;
+        unsigned long code = std::strtoul(key.c_str(), &last, 16);
+        if(key.empty() || (*last != '\0') || (code > 0xffff)) reader.error("invalid eps channel code: " + key);
+        return static_cast<ChannelCode>(code);
+    }
+
+    /* read switch number key (decimal) */
+    unsigned int read_switch_number(JsonReader& reader, const std::string& key)
+    {
+        char *last = nullptr;
+        unsigned long num = std::strtoul(key.c_str(), &last, 10);
+        if(key.empty() || (*last != '\0') || (num > 0xffff)) reader.error("invalid eps switch number: " + key);
+        return static_cast<unsigned int>(num);
+    }
+}
+
+FleetConfig::FleetConfig(const std::string& fleetfile, const std::string& cachefile) :
+    base_file(),
+    base(),
+    boards()
+{
+    // load config file
+    load(fleetfile, cachefile);
+}
+
+void FleetConfig::load(const std::string& fleetfile, const std::string& cachefile)
+{
+    if(fleetfile.empty()) return;
+
+    // read whole file at once
+    std::ifstream file(fleetfile.c_str(), std::ios::binary | std::ios::ate);
+    if(!file) throw boost::property_tree::json_parser::json_parser_error("cannot open file", fleetfile, 0);
+    std::string json(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&json[0], json.size());
+    if(!file) throw boost::property_tree::json_parser::json_parser_error("cannot read file", fleetfile, 0);
+
+    base_file.clear();
+    boards.clear();
+    JsonReader reader(json.data(), json.size(), fleetfile);
+    parse(reader);
+
+    // base config path is relative to the fleet file
+    size_t slash = fleetfile.find_last_of('/');
+    if((base_file[0] != '/') && (slash != std::string::npos)) base_file = fleetfile.substr(0, slash + 1) + base_file;
+
+    // base parsed once, boards only hold their overrides
+    base = std::make_shared<const Config>(base_file, cachefile);
+    validate(fleetfile);
+}
+
+void FleetConfig::parse(JsonReader& reader)
+{
+    std::string key;
+    if(!reader.begin_object()) reader.error("expected fleet config object");
+    while(reader.next_member(key))
+    {
+        if(key == "base")
+        {
+            // base board config file
+            reader.read(base_file);
+        }
+        else if((key == "boards") && reader.begin_array())
+        {
+            // board overrides
+            while(reader.next_element())
+            {
+                BoardConfig board;
+                parse_board(reader, board);
+                boards.push_back(board);
+            }
+        }
+        else if(key != "boards")
+        {
+            reader.skip();
+        }
+    }
+    reader.finish();
+    if(base_file.empty()) reader.error("missing fleet base config");
+    if(boards.empty()) reader.error("missing fleet boards");
+}
+
+void FleetConfig::parse_board(JsonReader& reader, BoardConfig& board) const
+{
+    std::string key;
+    bool has_address = false;
+    if(!reader.begin_object()) reader.error("expected fleet board object");
+    while(reader.next_member(key))
+    {
+        if(key == "name")
+        {
+            reader.read(board.name);
+        }
+        else if(key == "address")
+        {
+            // i2c address
+            if(!reader.read(board.address)) reader.error("invalid fleet board address");
+            has_address = true;
+        }
+        else if(key == "i2c_bus")
+        {
+            reader.read(board.i2c_bus);
+        }
+        else if((key == "tlm") && reader.begin_object())
+        {
+            // default telemetry values by channel code
+            while(reader.next_member(key))
+            {
+                ChannelCode channel = read_channel_code(reader, key);
+                double value = 0.0;
+                if(!reader.read(value)) reader.error("invalid fleet board tlm value");
+                board.tlm[channel] = value;
+            }
+        }
+        else if((key == "switch") && reader.begin_object())
+        {
+            // switch defaults by switch number
+            while(reader.next_member(key))
+            {
+                unsigned int num = read_switch_number(reader, key);
+                bool state = false;
+                if(!reader.read(state)) reader.error("invalid fleet board switch state");
+                board.switch_states[num] = state;
+            }
+        }
+        else if((key != "tlm") && (key != "switch"))
+        {
+            reader.skip();
+        }
+    }
+    if(!has_address) reader.error("missing fleet board address");
+    if(board.name.empty()) board.name = "eps_" + to_string(static_cast<unsigned int>(board.address), true);
+}
+
+void FleetConfig::validate(const std::string& fleetfile) const
+{
+    // eeprom files and shared memory segments are named per address, so addresses are unique across buses
+    std::set<uint8_t> addresses;
+    std::set<std::string> names;
+    for(std::vector<BoardConfig>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+    {
+        if(!addresses.insert(it->address).second)
+        {
+            throw boost::property_tree::json_parser::json_parser_error("duplicate fleet board address: " + it->name, fleetfile, 0);
+        }
+        if(!names.insert(it->name).second)
+        {
+            throw boost::property_tree::json_parser::json_parser_error("duplicate fleet board name: " + it->name, fleetfile, 0);
+        }
+        for(Config::Telemetry::const_iterator tlm = it->tlm.begin(); tlm != it->tlm.end(); ++tlm)
+        {
+            if(base->tlm.count(tlm->first) == 0)
+            {
+                throw boost::property_tree::json_parser::json_parser_error("unknown fleet board tlm channel: " + it->name, fleetfile, 0);
+            }
+        }
+        if(!it->switch_states.empty() && (it->switch_states.rbegin()->first >= base->switch_states.size()))
+        {
+            throw boost::property_tree::json_parser::json_parser_error("invalid fleet board switch number: " + it->name, fleetfile, 0);
+        }
+    }
+}
+
+Fleet::Fleet(const FleetConfig& config, StartupProfile *startup) :
+    base(config.base),
+    boards(config.boards),
+    sims()
+{
+    // boards fork one configured eps (shared layout, topology, and converter params)
+    StartupProfile::TimePoint begin = StartupProfile::now();
+    std::unique_ptr<Eps> prototype = EpsSim::create_eps(*base);
+    if(startup) startup->add("eps init", begin);
+
+    begin = StartupProfile::now();
+    sims.reserve(boards.size());
+    for(std::vector<BoardConfig>::const_iterator it = boards.begin(); it != boards.end(); ++it)
+    {
+        sims.push_back(std::unique_ptr<EpsSim>(new EpsSim(*base, *it, *prototype)));
+    }
+    if(startup) startup->add("fleet boards", begin);
+    logger->info("eps fleet created: %u boards", static_cast<unsigned int>(sims.size()));
+}
+
+Fleet::~Fleet()
+{
+}
+
+const Config& Fleet::get_base() const
+{
+    return *base;
+}
+
+size_t Fleet::size() const
+{
+    return sims.size();
+}
+
+EpsSim& Fleet::get_sim(size_t index)
+{
+    return *sims[index];
+}
+
+std::string Fleet::get_board_file(const std::string& filename, const BoardConfig& board)
+{
+    return filename + "." + board.name;
+}
+
+bool Fleet::save_snapshots(const std::string& filename)
+{
+    bool saved = true;
+    for(size_t i = 0; i < sims.size(); i++)
+    {
+        if(!sims[i]->save_snapshot(get_board_file(filename, boards[i]))) saved = false;
+    }
+    return saved;
+}
+
+bool Fleet::load_snapshots(const std::string& filename)
+{
+    for(size_t i = 0; i < sims.size(); i++)
+    {
+        if(!sims[i]->load_snapshot(get_board_file(filename, boards[i]))) return false;
+    }
+    return true;
+}
+
+void Fleet::sync_eeprom()
+{
+    for(size_t i = 0; i < sims.size(); i++)
+    {
+        sims[i]->sync_eeprom();
+    }
+}
+
+void Fleet::dump_stats(const std::string& filename)
+{
+    for(size_t i = 0; i < sims.size(); i++)
+    {
+        sims[i]->dump_stats(filename.empty() ? filename : get_board_file(filename, boards[i]));
+    }
+}
+
+void Fleet::poll_edits()
+{
+    for(size_t i = 0; i < sims.size(); i++)
+    {
+        sims[i]->poll_edits();
+    }
+}
+
+void Fleet::apply_config(const ConfigDiff& diff)
+{
+    for(size_t i = 0; i < sims.size(); i++)
+    {
+        const BoardConfig& board = boards[i];
+        if(board.tlm.empty() && board.switch_states.empty())
+        {
+            sims[i]->apply_config(diff);
+            continue;
+        }
+
+        // base value changes do not replace board overrides
+        ConfigDiff board_diff = diff;
+        for(Config::Telemetry::const_iterator it = board.tlm.begin(); it != board.tlm.end(); ++it)
+        {
+            board_diff.tlm.erase(it->first);
+        }
+        for(std::map<unsigned int, bool>::const_iterator it = board.switch_states.begin();
+            it != board.switch_states.end(); ++it)
+        {
+            board_diff.switch_states.erase(it->first);
+        }
+        sims[i]->apply_config(board_diff);
+    }
+}
+
+int itc::eps::run_fleet_loop(Fleet& fleet, const RunOptions& options)
+{
+    // exit cleanly (eeprom sync, simulator thread stop) on interrupt or termination
+    std::signal(SIGINT, on_exit_signal);
+    std::signal(SIGTERM, on_exit_signal);
+    logger->info("eps fleet running headless");
+    if(options.startup) options.startup->report();
+
+    // poll checkpoint requests, viewer edits, and sync eeprom, the boards are driven by nos callbacks
+    const Config& base = fleet.get_base();
+    const double poll_s = base.shm.enabled ? EDIT_POLL_S : CHECKPOINT_POLL_S;
+    const std::chrono::milliseconds poll_period(static_cast<int>(poll_s * 1000));
+    const std::chrono::milliseconds sync_period(std::max(base.eeprom.sync_ms, 1u));
+    std::chrono::steady_clock::time_point next_sync = std::chrono::steady_clock::now() + sync_period;
+    while(!exit_requested)
+    {
+        std::this_thread::sleep_for(poll_period);
+        fleet.poll_edits();
+        poll_checkpoint(fleet, options.checkpoint);
+        poll_stats(fleet, options.stats);
+        if(std::chrono::steady_clock::now() >= next_sync)
+        {
+            fleet.sync_eeprom();
+            next_sync += sync_period;
+        }
+    }
+
+    logger->info("eps fleet exiting");
+    fleet.sync_eeprom();
+    fleet.dump_stats(options.stats);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include "event_loop.hpp"
+#include "eps_view.hpp"
+#include "eps_win.hpp"
+
+#include <Fl/Fl.H>
+
+#include <algorithm>
+#include <memory>
+
+using namespace itc::eps;
+
+namespace
+{
+    /**
+     * \brief EEPROM sync state
+     */
+    struct EepromSync
+    {
+        EpsSim *sim;     //!< EPS simulator
+        double period_s; //!< Sync period (s)
+    };
+
+    /**
+     * \brief Deferred window show state
+     */
+    struct WindowShow
+    {
+        EpsView *view;           //!< EPS simulator window
+        bool iconized;           //!< Show minimized
+        StartupProfile *startup; //!< Startup timing (null if not profiled)
+    };
+
+    std::unique_ptr<EpsWindow> prepared_win; //!< Window built while the simulator connects
+
+    /**
+     * \brief Checkpoint and statistics request poll state
+     */
+    struct Checkpoint
+    {
+        EpsSim *sim;       //!< EPS simulator
+        std::string file;  //!< Checkpoint snapshot file
+        std::string stats; //!< Command statistics file (empty to log)
+    };
+
+    /* apply viewer edits (fltk timeout) */
+    void on_edit_poll(void *user)
+    {
+        EpsSim *sim = reinterpret_cast<EpsSim*>(user);
+        sim->poll_edits();
+        Fl::repeat_timeout(EDIT_POLL_S, on_edit_poll, user);
+    }
+
+    /* show window once the event loop runs (fltk timeout) */
+    void on_window_show(void *user)
+    {
+        WindowShow *show = reinterpret_cast<WindowShow*>(user);
+        StartupProfile::TimePoint begin = StartupProfile::now();
+        if(show->iconized)
+        {
+            show->view->minimize();
+        }
+        else
+        {
+            show->view->show();
+        }
+        if(show->startup)
+        {
+            show->startup->add("window show", begin);
+            show->startup->report();
+        }
+    }
+
+    /* save checkpoint and statistics if requested (fltk timeout) */
+    void on_checkpoint_poll(void *user)
+    {
+        Checkpoint *checkpoint = reinterpret_cast<Checkpoint*>(user);
+        poll_checkpoint(*checkpoint->sim, checkpoint->file);
+        poll_stats(*checkpoint->sim, checkpoint->stats);
+        Fl::repeat_timeout(CHECKPOINT_POLL_S, on_checkpoint_poll, user);
+    }
+
+    /* flush eeprom changes (fltk timeout) */
+    void on_eeprom_sync(void *user)
+    {
+        EepromSync *sync = reinterpret_cast<EepromSync*>(user);
+        sync->sim->sync_eeprom();
+        Fl::repeat_timeout(sync->period_s, on_eeprom_sync, user);
+    }
+}
+
+void itc::eps::prepare_event_loop(const Config&)
+{
+    prepared_win.reset(new EpsWindow);
+}
+
+int itc::eps::run_event_loop(EpsSim& sim, const Config& config, const RunOptions& options)
+{
+    // simulator window (edits applied directly), shown from the event loop
+    EpsView view(sim.get_frames(), sim.get_history(),
+                 [&sim](const EditCommand& command) {sim.apply_edit(command);}, config.gui.refresh_hz,
+                 prepared_win.release());
+    view.set_frame_time(&sim.get_frame_time());
+    WindowShow window_show = {&view, options.iconized, options.startup};
+    Fl::add_timeout(0.0, on_window_show, &window_show);
+
+    // edits from out of process viewers
+    if(config.shm.enabled) Fl::add_timeout(EDIT_POLL_S, on_edit_poll, &sim);
+
+    // checkpoint and statistics on signal (saved from event loop, not signal handler)
+    Checkpoint checkpoint = {&sim, options.checkpoint, options.stats};
+    Fl::add_timeout(CHECKPOINT_POLL_S, on_checkpoint_poll, &checkpoint);
+
+    // periodic eeprom sync (stores are written through to the mapping)
+    EepromSync eeprom_sync = {&sim, std::max(config.eeprom.sync_ms, 1u) / 1000.0};
+    if(!config.eeprom.file.empty()) Fl::add_timeout(eeprom_sync.period_s, on_eeprom_sync, &eeprom_sync);
+
+    // enable threading and run event loop
+    Fl::lock();
+    Fl::visual(FL_DOUBLE | FL_INDEX);
+    int result = Fl::run();
+    Fl::remove_timeout(on_window_show, &window_show);
+    Fl::remove_timeout(on_checkpoint_poll, &checkpoint);
+    Fl::remove_timeout(on_eeprom_sync, &eeprom_sync);
+    Fl::remove_timeout(on_edit_poll, &sim);
+    sim.dump_stats(options.stats);
+    return result;
+}
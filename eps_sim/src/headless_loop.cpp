@@ -0,0 +1,79 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include "event_loop.hpp"
+
+#include <ItcLogger/Logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+using namespace itc::eps;
+
+namespace
+{
+    ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+
+    volatile std::sig_atomic_t exit_requested = 0; //!< Set by exit signals
+
+    /* request exit (signal handler) */
+    void on_exit_signal(int)
+    {
+        exit_requested = 1;
+    }
+}
+
+void itc::eps::prepare_event_loop(const Config&)
+{
+    // nothing to build without a window
+}
+
+int itc::eps::run_event_loop(EpsSim& sim, const Config& config, const RunOptions& options)
+{
+    // exit cleanly (eeprom sync, simulator thread stop) on interrupt or termination
+    std::signal(SIGINT, on_exit_signal);
+    std::signal(SIGTERM, on_exit_signal);
+    logger->info("eps sim running headless");
+    if(options.startup) options.startup->report();
+
+    // poll checkpoint requests, viewer edits, and sync eeprom, the simulator is driven by nos callbacks
+    const double poll_s = config.shm.enabled ? EDIT_POLL_S : CHECKPOINT_POLL_S;
+    const std::chrono::milliseconds poll_period(static_cast<int>(poll_s * 1000));
+    const std::chrono::milliseconds sync_period(std::max(config.eeprom.sync_ms, 1u));
+    std::chrono::steady_clock::time_point next_sync = std::chrono::steady_clock::now() + sync_period;
+    while(!exit_requested)
+    {
+        std::this_thread::sleep_for(poll_period);
+        sim.poll_edits();
+        poll_checkpoint(sim, options.checkpoint);
+        poll_stats(sim, options.stats);
+        if(std::chrono::steady_clock::now() >= next_sync)
+        {
+            sim.sync_eeprom();
+            next_sync += sync_period;
+        }
+    }
+
+    logger->info("eps sim exiting");
+    sim.sync_eeprom();
+    sim.dump_stats(options.stats);
+    return 0;
+}
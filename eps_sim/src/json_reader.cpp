@@ -0,0 +1,307 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include "json_reader.hpp"
+#include <boost/property_tree/json_parser/error.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+using namespace itc::eps;
+
+JsonReader::JsonReader(const char *data, size_t size, const std::string& filename) :
+    begin(data),
+    pos(data),
+    end(data + size),
+    filename(filename),
+    first()
+{
+}
+
+JsonReader::~JsonReader()
+{
+}
+
+bool JsonReader::begin_object()
+{
+    if(skip_space() != '{')
+    {
+        skip();
+        return false;
+    }
+    pos++;
+    first.push_back(true);
+    return true;
+}
+
+bool JsonReader::next_member(std::string& key)
+{
+    if(first.empty()) error("no object to read");
+
+    char c = skip_space();
+    if(c == '}')
+    {
+        pos++;
+        first.pop_back();
+        return false;
+    }
+    if(!first.back()) expect(',');
+    first.back() = false;
+
+    if(skip_space() != '"') error("expected object key");
+    read_string(key);
+    expect(':');
+    return true;
+}
+
+bool JsonReader::begin_array()
+{
+    if(skip_space() != '[')
+    {
+        skip();
+        return false;
+    }
+    pos++;
+    first.push_back(true);
+    return true;
+}
+
+bool JsonReader::next_element()
+{
+    if(first.empty()) error("no array to read");
+
+    char c = skip_space();
+    if(c == ']')
+    {
+        pos++;
+        first.pop_back();
+        return false;
+    }
+    if(!first.back()) expect(',');
+    first.back() = false;
+    return true;
+}
+
+bool JsonReader::read(std::string& value)
+{
+    return read_text(value);
+}
+
+bool JsonReader::read(bool& value)
+{
+    std::string text;
+    if(!read_text(text)) return false;
+
+    if((text == "true") || (text == "1"))
+    {
+        value = true;
+    }
+    else if((text == "false") || (text == "0"))
+    {
+        value = false;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool JsonReader::read(int& value)
+{
+    long long result;
+    if(!read_integer(result, std::numeric_limits<int>::min(), std::numeric_limits<int>::max())) return false;
+    value = static_cast<int>(result);
+    return true;
+}
+
+bool JsonReader::read(unsigned int& value)
+{
+    long long result;
+    if(!read_integer(result, 0, std::numeric_limits<unsigned int>::max())) return false;
+    value = static_cast<unsigned int>(result);
+    return true;
+}
+
+bool JsonReader::read(uint8_t& value)
+{
+    long long result;
+    if(!read_integer(result, 0, std::numeric_limits<uint8_t>::max())) return false;
+    value = static_cast<uint8_t>(result);
+    return true;
+}
+
+bool JsonReader::read(double& value)
+{
+    std::string text;
+    if(!read_text(text) || text.empty()) return false;
+
+    char *last = nullptr;
+    errno = 0;
+    double result = std::strtod(text.c_str(), &last);
+    if((*last != '\0') || (errno == ERANGE)) return false;
+    value = result;
+    return true;
+}
+
+void JsonReader::skip()
+{
+    char c = skip_space();
+    if(c == '{')
+    {
+        std::string key;
+        begin_object();
+        while(next_member(key)) skip();
+    }
+    else if(c == '[')
+    {
+        begin_array();
+        while(next_element()) skip();
+    }
+    else
+    {
+        std::string text;
+        read_text(text);
+    }
+}
+
+void JsonReader::finish()
+{
+    if(skip_space() != '\0') error("unexpected data after document");
+}
+
+void JsonReader::error(const std::string& message) const
+{
+    unsigned long line = static_cast<unsigned long>(std::count(begin, pos, '\n')) + 1;
+    throw boost::property_tree::json_parser::json_parser_error(message, filename, line);
+}
+
+char JsonReader::skip_space()
+{
+    while((pos < end) && ((*pos == ' ') || (*pos == '\t') || (*pos == '\n') || (*pos == '\r'))) pos++;
+    return (pos < end) ? *pos : '\0';
+}
+
+void JsonReader::expect(char c)
+{
+    if(skip_space() != c) error(std::string("expected '") + c + "'");
+    pos++;
+}
+
+void JsonReader::read_string(std::string& value)
+{
+    value.clear();
+    pos++; // opening quote
+    while(true)
+    {
+        // copy unescaped runs at once
+        const char *run = pos;
+        while((pos < end) && (*pos != '"') && (*pos != '\\') && (static_cast<unsigned char>(*pos) >= 0x20)) pos++;
+        value.append(run, pos);
+        if(pos >= end) error("unterminated string");
+
+        char c = *pos++;
+        if(c == '"') break;
+        if(c != '\\') error("invalid character in string");
+        if(pos >= end) error("unterminated string");
+
+        switch(*pos++)
+        {
+            case '"':  value += '"'; break;
+            case '\\': value += '\\'; break;
+            case '/':  value += '/'; break;
+            case 'b':  value += '\b'; break;
+            case 'f':  value += '\f'; break;
+            case 'n':  value += '\n'; break;
+            case 'r':  value += '\r'; break;
+            case 't':  value += '\t'; break;
+            case 'u':
+            {
+                // basic multilingual plane code point, encoded as utf-8
+                if(end - pos < 4) error("invalid unicode escape");
+                char hex[5] = {pos[0], pos[1], pos[2], pos[3], '\0'};
+                char *last = nullptr;
+                unsigned long cp = std::strtoul(hex, &last, 16);
+                if(*last != '\0') error("invalid unicode escape");
+                pos += 4;
+                if(cp < 0x80)
+                {
+                    value += static_cast<char>(cp);
+                }
+                else if(cp < 0x800)
+                {
+                    value += static_cast<char>(0xc0 | (cp >> 6));
+                    value += static_cast<char>(0x80 | (cp & 0x3f));
+                }
+                else
+                {
+                    value += static_cast<char>(0xe0 | (cp >> 12));
+                    value += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+                    value += static_cast<char>(0x80 | (cp & 0x3f));
+                }
+                break;
+            }
+            default:
+                error("invalid escape in string");
+        }
+    }
+}
+
+bool JsonReader::read_text(std::string& text)
+{
+    char c = skip_space();
+    if(c == '"')
+    {
+        read_string(text);
+        return true;
+    }
+    if((c == '{') || (c == '['))
+    {
+        skip();
+        return false;
+    }
+
+    // literal (number, true, false, null)
+    const char *literal = pos;
+    while((pos < end) && (std::isalnum(static_cast<unsigned char>(*pos)) ||
+                          (*pos == '-') || (*pos == '+') || (*pos == '.'))) pos++;
+    if(pos == literal) error("expected value");
+    text.assign(literal, pos);
+    if((text != "true") && (text != "false") && (text != "null") && (text[0] != '-') &&
+       !std::isdigit(static_cast<unsigned char>(text[0])))
+    {
+        error("invalid literal: " + text);
+    }
+    return true;
+}
+
+bool JsonReader::read_integer(long long& value, long long min, long long max)
+{
+    std::string text;
+    if(!read_text(text) || text.empty()) return false;
+
+    char *last = nullptr;
+    errno = 0;
+    long long result = std::strtoll(text.c_str(), &last, 10);
+    if((*last != '\0') || (errno == ERANGE) || (result < min) || (result > max)) return false;
+    value = result;
+    return true;
+}
@@ -0,0 +1,83 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "log.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+/* parse command line */
+bool parse_command_line(int argc, char **argv, std::string& binary_log)
+{
+    namespace po = boost::program_options;
+
+    // command line options
+    po::variables_map eps_opts;
+    po::positional_options_description eps_pos;
+    eps_pos.add("binary-log", 1);
+    po::options_description eps_desc("STF-1 EPS Log Decoder Options");
+    eps_desc.add_options()
+        ("help,h", "display help")
+        ("binary-log", po::value<std::string>(&binary_log), "binary log file written by the simulator (--binary-log)");
+
+    // parse command line
+    try
+    {
+        po::store(po::command_line_parser(argc, argv).options(eps_desc).positional(eps_pos).run(), eps_opts);
+        po::notify(eps_opts);
+    }
+    catch(const po::error& e)
+    {
+        std::cerr << "eps command line parse error: " << e.what() << std::endl;
+        return false;
+    }
+
+    // print help
+    if(eps_opts.count("help"))
+    {
+        std::cout << "usage: nos3-eps-log-decode <binary log file>" << std::endl << eps_desc;
+        return false;
+    }
+
+    // verify required parameter
+    if(binary_log.empty())
+    {
+        std::cerr << "missing binary log file" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    // parse command line
+    std::string binary_log;
+    if(!parse_command_line(argc, argv, binary_log)) return 1;
+
+    // decoded records as the simulator's text log lines
+    if(!itc::eps::decode_log(binary_log, stdout))
+    {
+        std::cerr << "unable to decode binary log file: " << binary_log << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -19,23 +19,94 @@
 
 #include "eps.hpp"
 #include "config.hpp"
+#include "config_watch.hpp"
 #include "eps_sim.hpp"
+#include "event_loop.hpp"
+#include "fleet.hpp"
+#include "log.hpp"
+#include "metrics.hpp"
+#include "startup.hpp"
+#include "trace.hpp"
 
 #include <ItcLogger/Logger.hpp>
 
-#include <Fl/Fl.H>
 #include <boost/program_options.hpp>
 
+#include <csignal>
+#include <future>
 #include <iostream>
+#include <memory>
 #include <string>
 
 namespace
 {
     ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+
+    volatile std::sig_atomic_t checkpoint_requested = 0; //!< Set by checkpoint signal
+    volatile std::sig_atomic_t stats_requested = 0;      //!< Set by statistics signal
+    std::string trace_file;                              //!< Trace file (empty if not tracing)
+}
+
+/* request checkpoint (signal handler) */
+void on_checkpoint_signal(int)
+{
+    checkpoint_requested = 1;
+}
+
+/* request statistics report (signal handler) */
+void on_stats_signal(int)
+{
+    stats_requested = 1;
+}
+
+/* write trace file (if tracing) */
+void write_trace()
+{
+    if(!trace_file.empty()) itc::eps::Tracer::get().write(trace_file);
+}
+
+void itc::eps::poll_checkpoint(EpsSim& sim, const std::string& file)
+{
+    if(checkpoint_requested)
+    {
+        checkpoint_requested = 0;
+        sim.save_snapshot(file);
+    }
+}
+
+void itc::eps::poll_checkpoint(Fleet& fleet, const std::string& file)
+{
+    if(checkpoint_requested)
+    {
+        checkpoint_requested = 0;
+        fleet.save_snapshots(file);
+    }
+}
+
+void itc::eps::poll_stats(EpsSim& sim, const std::string& file)
+{
+    if(stats_requested)
+    {
+        stats_requested = 0;
+        sim.dump_stats(file);
+        write_trace();
+    }
+}
+
+void itc::eps::poll_stats(Fleet& fleet, const std::string& file)
+{
+    if(stats_requested)
+    {
+        stats_requested = 0;
+        fleet.dump_stats(file);
+        write_trace();
+    }
 }
 
 /* parse command line */
-bool parse_command_line(int argc, char **argv, std::string& cfgfile, bool& iconized)
+bool parse_command_line(int argc, char **argv, std::string& cfgfile, std::string& fleetfile, std::string& cachefile,
+                        bool& iconized, std::string& snapshot, std::string& checkpoint, std::string& stats,
+                        std::string& trace, unsigned int& trace_events, std::string& binary_log, bool& startup_report)
 {
     namespace po = boost::program_options;
 
@@ -45,7 +116,24 @@ bool parse_command_line(int argc, char **argv, std::string& cfgfile, bool& iconi
     eps_desc.add_options()
         ("help,h", "display help")
         ("config,c", po::value<std::string>(&cfgfile), "eps config file (json)")
-        ("iconic,i", "start iconized (default=false)");
+        ("fleet,f", po::value<std::string>(&fleetfile),
+            "eps fleet config file (json, base config plus per board overrides, run without a window)")
+        ("config-cache", po::value<std::string>(&cachefile),
+            "compiled config cache file (loaded if compiled from the same config, otherwise rewritten)")
+        ("snapshot,s", po::value<std::string>(&snapshot),
+            "start from eps snapshot file (fleet: file prefix, suffixed with each board name)")
+        ("checkpoint", po::value<std::string>(&checkpoint)->default_value("eps_sim.snapshot"),
+            "snapshot file written on SIGUSR1 (fleet: file prefix, suffixed with each board name)")
+        ("stats", po::value<std::string>(&stats),
+            "command statistics file written on SIGUSR2 and at exit (default: logged, fleet: file prefix)")
+        ("trace", po::value<std::string>(&trace),
+            "record trace and write it on SIGUSR2 and at exit (chrome trace event json, default: not traced)")
+        ("trace-events", po::value<unsigned int>(&trace_events)->default_value(itc::eps::DEFAULT_TRACE_EVENTS),
+            "latest trace events kept per thread")
+        ("binary-log", po::value<std::string>(&binary_log),
+            "write simulator log records to a binary file (decode with nos3-eps-log-decode, default: formatted as text)")
+        ("iconic,i", "start iconized (default=false)")
+        ("startup-report", "print startup phase timing to stdout (default=false)");
 
     // parse command line
     try
@@ -68,11 +156,12 @@ bool parse_command_line(int argc, char **argv, std::string& cfgfile, bool& iconi
 
     iconized = false;
     if(eps_opts.count("iconic")) iconized = true;
+    startup_report = (eps_opts.count("startup-report") > 0);
 
     // verify required parameter
-    if(cfgfile.empty())
+    if(cfgfile.empty() == fleetfile.empty())
     {
-        std::cerr << "missing required --config option" << std::endl;
+        std::cerr << "one of --config or --fleet options is required" << std::endl;
         return false;
     }
 
@@ -84,34 +173,166 @@ void configure_logger(const std::string& level)
 {
     // create default stdio logger
     logger->set_level(ItcLogger::String2Level(level.c_str()));
+    itc::eps::BinaryLog::get().set_level(itc::eps::to_log_level(level));
     ItcLogger::TargetPtr target(new ItcLogger::Target(STDIO_BUILTIN_TARGET_IMPL, ItcLogger::LogArguments()));
     target->set_format("%t [%l] - %s");
     logger->add_target(target);
 }
 
+/* run fleet of eps simulators forked from one base config */
+int run_fleet(const std::string& fleetfile, const std::string& cachefile, const std::string& snapshot,
+              const std::string& checkpoint_file, const std::string& stats_file, itc::eps::StartupProfile& startup)
+{
+    // load fleet config (base config parsed once)
+    itc::eps::StartupProfile::TimePoint begin = itc::eps::StartupProfile::now();
+    itc::eps::FleetConfig config(fleetfile, cachefile);
+    startup.add("config", begin);
+
+    // initialize logger
+    begin = itc::eps::StartupProfile::now();
+    configure_logger(config.base->log_level);
+    startup.add("logger", begin);
+
+    // create boards (nos connect)
+    logger->info("creating eps fleet: cfg=%s base=%s boards=%u", fleetfile.c_str(), config.base_file.c_str(),
+                 static_cast<unsigned int>(config.boards.size()));
+    itc::eps::Fleet fleet(config, &startup);
+
+    // restore snapshots
+    if(!snapshot.empty())
+    {
+        begin = itc::eps::StartupProfile::now();
+        if(!fleet.load_snapshots(snapshot)) return 1;
+        startup.add("snapshot", begin);
+    }
+
+    // checkpoint and statistics on signal (saved from event loop, not signal handler)
+    std::signal(SIGUSR1, on_checkpoint_signal);
+    std::signal(SIGUSR2, on_stats_signal);
+
+    // apply base config file changes while running (stopped before the fleet is destroyed)
+    std::unique_ptr<itc::eps::ConfigWatcher> watcher;
+    if(config.base->reload.enabled)
+    {
+        itc::eps::Fleet *eps_fleet = &fleet;
+        watcher.reset(new itc::eps::ConfigWatcher(config.base_file, cachefile, *config.base,
+            [eps_fleet](const itc::eps::ConfigDiff& diff) {eps_fleet->apply_config(diff);}));
+        watcher->start();
+    }
+
+    // export operational metrics per board (stopped before the fleet is destroyed)
+    std::unique_ptr<itc::eps::MetricsExporter> metrics;
+    if(config.base->metrics.enabled)
+    {
+        std::vector<itc::eps::MetricsSource> sources;
+        for(size_t i = 0; i < fleet.size(); i++)
+        {
+            itc::eps::MetricsSource source = {config.boards[i].name, config.boards[i].address, &fleet.get_sim(i)};
+            sources.push_back(source);
+        }
+        metrics.reset(new itc::eps::MetricsExporter(config.base->metrics, sources));
+        metrics->start();
+    }
+
+    // run headless fleet loop
+    itc::eps::RunOptions options;
+    options.checkpoint = checkpoint_file;
+    options.stats = stats_file;
+    options.startup = &startup;
+    int result = itc::eps::run_fleet_loop(fleet, options);
+    write_trace();
+    return result;
+}
+
 int main(int argc, char **argv)
 {
     // parse command line
     std::string cfgfile;
+    std::string fleetfile;
+    std::string cachefile;
+    std::string snapshot;
+    std::string checkpoint_file;
+    std::string stats_file;
+    unsigned int trace_events = itc::eps::DEFAULT_TRACE_EVENTS;
+    std::string binary_log;
     bool iconized = false;
-    if(!parse_command_line(argc, argv, cfgfile, iconized)) return 1;
+    bool startup_report = false;
+    if(!parse_command_line(argc, argv, cfgfile, fleetfile, cachefile, iconized, snapshot, checkpoint_file, stats_file,
+                           trace_file, trace_events, binary_log, startup_report)) return 1;
+    itc::eps::StartupProfile startup(startup_report);
+
+    // simulator log records are formatted (or written to the binary log) by a background thread
+    itc::eps::LogWriter log_writer(binary_log);
+
+    // trace from startup (before simulator threads start)
+    if(!trace_file.empty())
+    {
+        itc::eps::Tracer::get().enable(trace_events);
+        itc::eps::Tracer::get().set_thread_name("main");
+    }
+    if(!fleetfile.empty()) return run_fleet(fleetfile, cachefile, snapshot, checkpoint_file, stats_file, startup);
 
     // load config
-    itc::eps::Config config(cfgfile);
+    itc::eps::StartupProfile::TimePoint begin = itc::eps::StartupProfile::now();
+    itc::eps::Config config(cfgfile, cachefile);
+    startup.add("config", begin);
 
     // initialize logger
+    begin = itc::eps::StartupProfile::now();
     configure_logger(config.log_level);
+    startup.add("logger", begin);
 
-    // create and configure eps simulator
+    // create and configure eps simulator (nos connect) while the window is built on this thread
     logger->info("creating eps sim: cfg=%s", cfgfile.c_str());
-    itc::eps::EpsSim sim(config);
-    
-    // minimize window
-    if(iconized) sim.minimize();
-
-    // enable threading and run event loop
-    Fl::lock();
-    Fl::visual(FL_DOUBLE | FL_INDEX);
-    return Fl::run();
-}
+    std::future<std::unique_ptr<itc::eps::EpsSim>> sim_start = std::async(std::launch::async, [&config, &startup]() {
+        itc::eps::StartupProfile::TimePoint sim_begin = itc::eps::StartupProfile::now();
+        std::unique_ptr<itc::eps::EpsSim> sim(new itc::eps::EpsSim(config, &startup));
+        startup.add("simulator", sim_begin);
+        return sim;
+    });
+    begin = itc::eps::StartupProfile::now();
+    itc::eps::prepare_event_loop(config);
+    startup.add("window build", begin);
+    std::unique_ptr<itc::eps::EpsSim> sim = sim_start.get();
+
+    // restore snapshot
+    if(!snapshot.empty())
+    {
+        begin = itc::eps::StartupProfile::now();
+        if(!sim->load_snapshot(snapshot)) return 1;
+        startup.add("snapshot", begin);
+    }
+
+    // checkpoint and statistics on signal (saved from event loop, not signal handler)
+    std::signal(SIGUSR1, on_checkpoint_signal);
+    std::signal(SIGUSR2, on_stats_signal);
 
+    // apply config file changes while running (stopped before the simulator is destroyed)
+    std::unique_ptr<itc::eps::ConfigWatcher> watcher;
+    if(config.reload.enabled)
+    {
+        itc::eps::EpsSim *eps_sim = sim.get();
+        watcher.reset(new itc::eps::ConfigWatcher(cfgfile, cachefile, config,
+            [eps_sim](const itc::eps::ConfigDiff& diff) {eps_sim->apply_config(diff);}));
+        watcher->start();
+    }
+
+    // export operational metrics (stopped before the simulator is destroyed)
+    std::unique_ptr<itc::eps::MetricsExporter> metrics;
+    if(config.metrics.enabled)
+    {
+        itc::eps::MetricsSource source = {"eps", config.eps_address, sim.get()};
+        metrics.reset(new itc::eps::MetricsExporter(config.metrics, std::vector<itc::eps::MetricsSource>(1, source)));
+        metrics->start();
+    }
+
+    // run window or headless event loop
+    itc::eps::RunOptions options;
+    options.checkpoint = checkpoint_file;
+    options.stats = stats_file;
+    options.iconized = iconized;
+    options.startup = &startup;
+    int result = itc::eps::run_event_loop(*sim, config, options);
+    write_trace();
+    return result;
+}
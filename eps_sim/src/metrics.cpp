@@ -0,0 +1,287 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "metrics.hpp"
+#include "config.hpp"
+#include "eps_sim.hpp"
+
+#include <ItcLogger/Logger.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+
+    /* double as shared memory word */
+    uint64_t to_word(double value)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, &value, sizeof(word));
+        return word;
+    }
+
+    /* prometheus label value (backslash, quote, and newline escaped) */
+    std::string escape_label(const std::string& value)
+    {
+        std::string escaped;
+        for(char c : value)
+        {
+            if(c == '\n')
+            {
+                escaped += "\\n";
+                continue;
+            }
+            if((c == '\\') || (c == '"')) escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+MetricsExporter::MetricsExporter(const MetricsConfig& config, const std::vector<MetricsSource>& sources) :
+    period_ms(std::max(config.period_ms, 1u)),
+    textfile(config.textfile),
+    shm_name(config.shm),
+    sources(sources),
+    previous(sources.size()),
+    previous_time(),
+    block(nullptr),
+    block_size(0),
+    stopping(false),
+    mutex(),
+    wake(),
+    thread()
+{
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    stop();
+}
+
+bool MetricsExporter::start()
+{
+    if(thread.joinable()) return true;
+    if(textfile.empty() && shm_name.empty())
+    {
+        logger->error("eps metrics enabled without a text file or shared memory block");
+        return false;
+    }
+    if(!shm_name.empty()) create_shm();
+
+    // rates over the first period start from the current counters
+    double values[NUM_METRICS];
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+        collect(*sources[i].sim, previous[i], 0.0, values);
+    }
+    previous_time = std::chrono::steady_clock::now();
+
+    stopping = false;
+    thread = std::thread(&MetricsExporter::run, this);
+    logger->info("exporting eps metrics every %ums: textfile=%s shm=%s", period_ms, textfile.c_str(), shm_name.c_str());
+    return true;
+}
+
+void MetricsExporter::stop()
+{
+    if(thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        thread.join();
+        export_metrics();
+    }
+    close_shm();
+}
+
+void MetricsExporter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!wake.wait_for(lock, std::chrono::milliseconds(period_ms), [this]() {return stopping;}))
+    {
+        lock.unlock();
+        export_metrics();
+        lock.lock();
+    }
+}
+
+void MetricsExporter::export_metrics()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double period_s = std::chrono::duration<double>(now - previous_time).count();
+    previous_time = now;
+
+    std::vector<double> values(sources.size() * NUM_METRICS, 0.0);
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+        collect(*sources[i].sim, previous[i], period_s, &values[i * NUM_METRICS]);
+    }
+    if(!textfile.empty()) write_textfile(values);
+    if(block) publish(values);
+}
+
+void MetricsExporter::collect(const EpsSim& sim, Sample& previous, double period_s, double *values)
+{
+    // counters are read without locking the eps (errors first, then clamped as counts may lag)
+    std::shared_ptr<const CommandStats> stats = sim.get_stats();
+    uint64_t errors = stats ? stats->get_total_failures() : 0;
+    uint64_t transactions = stats ? stats->get_total_count() : 0;
+    errors = std::max(std::min(errors, transactions), previous.errors);
+    uint64_t sim_time_ms = sim.get_sim_time_ms();
+    uint64_t new_transactions = transactions - previous.transactions;
+    uint64_t new_errors = errors - previous.errors;
+
+    values[METRIC_TRANSACTIONS] = static_cast<double>(transactions);
+    values[METRIC_TRANSACTION_RATE] = (period_s > 0.0) ? (new_transactions / period_s) : 0.0;
+    values[METRIC_ERRORS] = static_cast<double>(errors);
+    values[METRIC_ERROR_RATIO] = (new_transactions > 0) ? std::min(static_cast<double>(new_errors) / new_transactions, 1.0) : 0.0;
+    values[METRIC_WDT_RESETS] = stats ? static_cast<double>(stats->get_events(EVENT_WDT_RESET)) : 0.0;
+    values[METRIC_BUS_RESETS] = stats ? static_cast<double>(stats->get_events(EVENT_BUS_RESET)) : 0.0;
+    values[METRIC_PDM_TRIPS] = stats ? static_cast<double>(stats->get_events(EVENT_PDM_TRIP)) : 0.0;
+    values[METRIC_LOCK_WAITS] = static_cast<double>(sim.get_lock_wait().get_count());
+    values[METRIC_LOCK_WAIT_SECONDS] = sim.get_lock_wait().get_total_ns() / 1e9;
+    values[METRIC_GUI_FRAMES] = static_cast<double>(sim.get_frame_time().get_count());
+    values[METRIC_GUI_FRAME_SECONDS] = sim.get_frame_time().get_total_ns() / 1e9;
+    values[METRIC_SIM_TIME_RATIO] =
+        ((period_s > 0.0) && (sim_time_ms >= previous.sim_time_ms)) ? ((sim_time_ms - previous.sim_time_ms) / (period_s * 1000.0)) : 0.0;
+
+    previous.transactions = transactions;
+    previous.errors = errors;
+    previous.sim_time_ms = sim_time_ms;
+}
+
+bool MetricsExporter::write_textfile(const std::vector<double>& values) const
+{
+    // write whole file to temporary file, then replace (collectors never read a partial file)
+    std::string tmpfile = textfile + ".tmp";
+    FILE *file = std::fopen(tmpfile.c_str(), "w");
+    if(file == nullptr)
+    {
+        logger->error("unable to write eps metrics file %s: %s", tmpfile.c_str(), std::strerror(errno));
+        return false;
+    }
+    for(unsigned int m = 0; m < NUM_METRICS; m++)
+    {
+        const MetricInfo& info = METRIC_INFO[m];
+        std::fprintf(file, "# HELP %s %s\n# TYPE %s %s\n", info.name, info.help, info.name, info.type);
+        for(size_t i = 0; i < sources.size(); i++)
+        {
+            std::fprintf(file, "%s{board=\"%s\",address=\"0x%x\"} %.17g\n", info.name, escape_label(sources[i].name).c_str(),
+                         static_cast<unsigned int>(sources[i].address), values[i * NUM_METRICS + m]);
+        }
+    }
+    bool ok = (std::fflush(file) == 0) && !std::ferror(file);
+    ok = (std::fclose(file) == 0) && ok;
+    if(!ok || (std::rename(tmpfile.c_str(), textfile.c_str()) != 0))
+    {
+        logger->error("unable to write eps metrics file %s: %s", textfile.c_str(), std::strerror(errno));
+        std::remove(tmpfile.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MetricsExporter::create_shm()
+{
+    close_shm();
+    size_t size = sizeof(MetricsBlock) + (std::max<size_t>(sources.size(), 1) - 1) * sizeof(MetricsBoard);
+
+    // replace stale block of a previous run (attached collectors keep the old mapping)
+    shm_unlink(shm_name.c_str());
+    int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if(fd < 0)
+    {
+        logger->error("unable to create eps metrics shared memory %s: %s", shm_name.c_str(), std::strerror(errno));
+        return false;
+    }
+    void *map = (ftruncate(fd, size) == 0) ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if(map == MAP_FAILED)
+    {
+        logger->error("unable to map eps metrics shared memory %s: %s", shm_name.c_str(), std::strerror(errno));
+        shm_unlink(shm_name.c_str());
+        return false;
+    }
+
+    // construct in place, magic last so collectors never see a partial block
+    block = new(map) MetricsBlock;
+    block_size = size;
+    block->magic.store(0, std::memory_order_relaxed);
+    block->version = METRICS_SHM_VERSION;
+    block->num_boards = static_cast<uint32_t>(sources.size());
+    block->num_metrics = NUM_METRICS;
+    block->sequence.store(0, std::memory_order_relaxed);
+    block->time_ns.store(0, std::memory_order_relaxed);
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+        MetricsBoard *board = (i == 0) ? &block->boards[0] : new(&block->boards[i]) MetricsBoard;
+        std::memset(board->name, 0, sizeof(board->name));
+        std::strncpy(board->name, sources[i].name.c_str(), sizeof(board->name) - 1);
+        board->address = sources[i].address;
+        for(unsigned int m = 0; m < NUM_METRICS; m++)
+        {
+            board->values[m].store(0, std::memory_order_relaxed);
+        }
+    }
+    block->magic.store(METRICS_SHM_MAGIC, std::memory_order_release);
+    return true;
+}
+
+void MetricsExporter::close_shm()
+{
+    if(!block) return;
+    block->magic.store(0, std::memory_order_release);
+    munmap(block, block_size);
+    shm_unlink(shm_name.c_str());
+    block = nullptr;
+    block_size = 0;
+}
+
+void MetricsExporter::publish(const std::vector<double>& values)
+{
+    // sequence is odd while values are written
+    uint64_t sequence = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(size_t i = 0; i < sources.size(); i++)
+    {
+        for(unsigned int m = 0; m < NUM_METRICS; m++)
+        {
+            block->boards[i].values[m].store(to_word(values[i * NUM_METRICS + m]), std::memory_order_relaxed);
+        }
+    }
+    uint64_t time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    block->time_ns.store(time_ns, std::memory_order_relaxed);
+    block->sequence.store(sequence + 2, std::memory_order_release);
+}
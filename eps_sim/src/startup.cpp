@@ -0,0 +1,82 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include "startup.hpp"
+#include "types.hpp"
+
+#include <ItcLogger/Logger.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace itc::eps;
+
+namespace
+{
+    ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+}
+
+StartupProfile::StartupProfile(bool print) :
+    mutex(),
+    start(now()),
+    print(print),
+    reported(false),
+    phases()
+{
+}
+
+StartupProfile::TimePoint StartupProfile::now()
+{
+    return Clock::now();
+}
+
+void StartupProfile::add(const std::string& name, TimePoint begin)
+{
+    Phase phase = {name, to_ms(begin), to_ms(now()) - to_ms(begin)};
+    std::lock_guard<std::mutex> lock(mutex);
+    phases.push_back(phase);
+}
+
+void StartupProfile::report()
+{
+    double total_ms = to_ms(now());
+    std::lock_guard<std::mutex> lock(mutex);
+    if(reported) return;
+    reported = true;
+
+    // phases in start order (overlapping phases ran on different threads)
+    std::stable_sort(phases.begin(), phases.end(),
+                     [](const Phase& a, const Phase& b) {return a.start_ms < b.start_ms;});
+    for(std::vector<Phase>::const_iterator it = phases.begin(); it != phases.end(); ++it)
+    {
+        logger->debug("eps startup phase: %s start=%.1f ms duration=%.1f ms", it->name.c_str(), it->start_ms, it->ms);
+        if(print) std::printf("startup %-12s %8.1f %8.1f ms\n", it->name.c_str(), it->start_ms, it->ms);
+    }
+    logger->info("eps sim started: %.1f ms", total_ms);
+    if(print)
+    {
+        std::printf("startup %-12s %8.1f %8s ms\n", "total", total_ms, "");
+        std::fflush(stdout);
+    }
+}
+
+double StartupProfile::to_ms(TimePoint time) const
+{
+    return std::chrono::duration<double, std::milli>(time - start).count();
+}
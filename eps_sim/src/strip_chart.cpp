@@ -0,0 +1,148 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "strip_chart.hpp"
+
+#include <FL/fl_draw.H>
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace itc::eps;
+
+namespace
+{
+    const int CHART_MARGIN = 4;   //!< Plot margin (pixels)
+    const int CHART_LABEL_H = 14; //!< Axis label height (pixels)
+}
+
+StripChart::StripChart(int x, int y, int w, int h, const char *l) :
+    Fl_Widget(x, y, w, h, l),
+    history(),
+    channel(nullptr),
+    code(CHANNEL_INVALID),
+    span_ms(10 * 1000),
+    drawn_count(0),
+    points(HISTORY_SIZE)
+{
+}
+
+StripChart::~StripChart()
+{
+}
+
+void StripChart::set_history(std::shared_ptr<const HistoryStore> history)
+{
+    this->history = history;
+    set_channel(code);
+}
+
+void StripChart::set_channel(ChannelCode code)
+{
+    this->code = code;
+    channel = history ? history->find(code) : nullptr;
+    redraw();
+}
+
+void StripChart::set_span(uint64_t span_ms)
+{
+    this->span_ms = std::max<uint64_t>(span_ms, 1);
+    redraw();
+}
+
+void StripChart::update()
+{
+    if(channel && (channel->get_count(history->get_level(span_ms)) != drawn_count)) redraw();
+}
+
+void StripChart::draw()
+{
+    char text[64];
+    draw_box();
+    fl_push_clip(x(), y(), w(), h());
+    fl_font(FL_HELVETICA, 12);
+
+    // latest points of the level covering the span
+    unsigned int num = 0;
+    if(channel)
+    {
+        unsigned int level = history->get_level(span_ms);
+        drawn_count = channel->get_count(level);
+        num = channel->read(level, points.data(), HISTORY_SIZE);
+    }
+    if(num == 0)
+    {
+        fl_color(FL_FOREGROUND_COLOR);
+        fl_draw(channel ? "No history" : "Select a channel", x(), y(), w(), h(), FL_ALIGN_CENTER);
+        fl_pop_clip();
+        return;
+    }
+
+    // time window and value range of points in window
+    uint64_t end_ms = points[num - 1].time_ms;
+    uint64_t start_ms = (end_ms > span_ms) ? (end_ms - span_ms) : 0;
+    unsigned int first = 0;
+    while((first < num - 1) && (points[first].time_ms < start_ms)) first++;
+    double lo = points[first].min;
+    double hi = points[first].max;
+    for(unsigned int i = first; i < num; i++)
+    {
+        lo = std::min(lo, points[i].min);
+        hi = std::max(hi, points[i].max);
+    }
+    if(hi - lo < 1e-9)
+    {
+        lo -= 0.5;
+        hi += 0.5;
+    }
+
+    // plot area
+    int px = x() + CHART_MARGIN;
+    int py = y() + CHART_MARGIN + CHART_LABEL_H;
+    int pw = w() - 2 * CHART_MARGIN;
+    int ph = h() - 2 * CHART_MARGIN - 2 * CHART_LABEL_H;
+    double xscale = static_cast<double>(pw) / span_ms;
+    double yscale = ph / (hi - lo);
+
+    // min/max band, then mean
+    fl_color(fl_color_average(FL_SELECTION_COLOR, FL_BACKGROUND2_COLOR, 0.4f));
+    for(unsigned int i = first; i < num; i++)
+    {
+        int cx = px + static_cast<int>((points[i].time_ms - start_ms) * xscale);
+        int ymin = py + ph - static_cast<int>((points[i].min - lo) * yscale);
+        int ymax = py + ph - static_cast<int>((points[i].max - lo) * yscale);
+        fl_yxline(cx, ymax, ymin);
+    }
+    fl_color(FL_FOREGROUND_COLOR);
+    fl_begin_line();
+    for(unsigned int i = first; i < num; i++)
+    {
+        fl_vertex(px + (points[i].time_ms - start_ms) * xscale, py + ph - (points[i].mean - lo) * yscale);
+    }
+    fl_end_line();
+
+    // value and time labels
+    std::snprintf(text, sizeof(text), "%.4g", hi);
+    fl_draw(text, px, y() + CHART_MARGIN, pw, CHART_LABEL_H, FL_ALIGN_LEFT);
+    std::snprintf(text, sizeof(text), "%.4g", lo);
+    fl_draw(text, px, py + ph, pw, CHART_LABEL_H, FL_ALIGN_LEFT);
+    std::snprintf(text, sizeof(text), "0x%04x  %.1fs - %.1fs", static_cast<unsigned int>(code),
+                  start_ms / 1000.0, end_ms / 1000.0);
+    fl_draw(text, px, py + ph, pw, CHART_LABEL_H, FL_ALIGN_RIGHT);
+    fl_pop_clip();
+}
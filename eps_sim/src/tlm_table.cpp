@@ -0,0 +1,344 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "tlm_table.hpp"
+#include "layout.hpp"
+
+#include <FL/fl_draw.H>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace itc::eps;
+
+namespace
+{
+    const char *COLUMN_NAMES[] = {"Channel", "Code", "Digital", "Analog", "Set"}; //!< Column headers
+    const int COLUMN_WIDTHS[] = {90, 60, 70, 110, 110};                           //!< Column widths
+
+    /* bus type name of frame channel */
+    const char* bus_name(const FrameChannel& channel)
+    {
+        switch(channel.type)
+        {
+            case BUS_BCR: return "BCR";
+            case BUS_PCM: return "PCM";
+            case BUS_PDM: return "PDM";
+            default:      return "Board";
+        }
+    }
+
+    /* slot name of frame channel (bcr sides A and B) */
+    const char* slot_name(const FrameChannel& channel)
+    {
+        bool bcr = (channel.type == BUS_BCR);
+        switch(channel.slot)
+        {
+            case SLOT_VOLTAGE:   return "V";
+            case SLOT_CURRENT:   return bcr ? "I A" : "I";
+            case SLOT_CURRENT_B: return "I B";
+            case SLOT_TEMP:      return "T A";
+            case SLOT_TEMP_B:    return "T B";
+            case SLOT_SUN:       return "SD A";
+            case SLOT_SUN_B:     return "SD B";
+            default:             return "";
+        }
+    }
+
+    /* group order of frame channel (board channels last) */
+    unsigned int group_order(const FrameChannel& channel)
+    {
+        return (channel.type == FRAME_NO_BUS) ? (BUS_PDM + 1) : channel.type;
+    }
+
+    /* filter match of frame channel */
+    bool is_shown(TlmFilter filter, const FrameChannel& channel)
+    {
+        switch(filter)
+        {
+            case FILTER_BCR:   return channel.type == BUS_BCR;
+            case FILTER_PCM:   return channel.type == BUS_PCM;
+            case FILTER_PDM:   return channel.type == BUS_PDM;
+            case FILTER_BOARD: return channel.type == FRAME_NO_BUS;
+            default:           return true;
+        }
+    }
+}
+
+TlmTable::TlmTable(int x, int y, int w, int h, const char *l) :
+    Fl_Table(x, y, w, h, l),
+    input(nullptr),
+    frame(),
+    index(),
+    filter(FILTER_ALL),
+    edit_row(-1),
+    selected(CHANNEL_INVALID),
+    select_callback(nullptr),
+    select_user(nullptr)
+{
+    rows(0);
+    cols(NUM_COLUMNS);
+    row_header(1);
+    row_header_width(70);
+    col_header(1);
+    col_header_height(20);
+    row_height_all(20);
+    for(int i = 0; i < NUM_COLUMNS; i++)
+    {
+        col_width(i, COLUMN_WIDTHS[i]);
+    }
+    callback(on_click, this);
+    when(FL_WHEN_NOT_CHANGED | when());
+
+    // single analog value input, placed over the edited cell
+    input = new TlmInput(x, y, 0, 0);
+    input->labelsize(12);
+    input->textsize(12);
+    input->hide();
+    end();
+}
+
+TlmTable::~TlmTable()
+{
+}
+
+TlmInput* TlmTable::get_input()
+{
+    return input;
+}
+
+void TlmTable::set_select_callback(Fl_Callback *callback, void *user)
+{
+    select_callback = callback;
+    select_user = user;
+}
+
+ChannelCode TlmTable::get_selected() const
+{
+    return selected;
+}
+
+void TlmTable::set_filter(TlmFilter filter)
+{
+    this->filter = filter;
+    input->hide();
+    build_rows();
+    redraw();
+}
+
+void TlmTable::update(const StateFrame& frame, bool full)
+{
+    // rebuild rows if channels changed
+    bool layout = (frame.num_channels != this->frame.num_channels) ||
+        (std::memcmp(frame.codes, this->frame.codes, frame.num_channels * sizeof(frame.codes[0])) != 0) ||
+        (std::memcmp(frame.channels, this->frame.channels, frame.num_channels * sizeof(frame.channels[0])) != 0);
+
+    // changed visible rows (hidden rows are formatted when scrolled into view)
+    int first = -1;
+    int last = -1;
+    int bottom = std::min(botrow, static_cast<int>(index.size()) - 1);
+    for(int row = std::max(toprow, 0); !layout && (row <= bottom); row++)
+    {
+        unsigned int i = index[row];
+        if(full || (frame.digital[i] != this->frame.digital[i]) || (frame.analog[i] != this->frame.analog[i]))
+        {
+            if(first < 0) first = row;
+            last = row;
+        }
+    }
+
+    this->frame = frame;
+    if(layout)
+    {
+        input->hide();
+        build_rows();
+        redraw();
+    }
+    else if(first >= 0)
+    {
+        redraw_range(first, last, COL_DIGITAL, COL_ANALOG);
+    }
+}
+
+void TlmTable::build_rows()
+{
+    // filtered channels grouped by bus type and bus (channel code order within slot)
+    index.clear();
+    for(unsigned int i = 0; i < frame.num_channels; i++)
+    {
+        if(is_shown(filter, frame.channels[i])) index.push_back(i);
+    }
+    const FrameChannel *channels = frame.channels;
+    std::stable_sort(index.begin(), index.end(), [channels](unsigned int a, unsigned int b) {
+        const FrameChannel& ca = channels[a];
+        const FrameChannel& cb = channels[b];
+        if(group_order(ca) != group_order(cb)) return group_order(ca) < group_order(cb);
+        if(ca.bus != cb.bus) return ca.bus < cb.bus;
+        if(ca.unit != cb.unit) return ca.unit < cb.unit;
+        return ca.slot < cb.slot;
+    });
+    edit_row = -1;
+    rows(static_cast<int>(index.size()));
+}
+
+void TlmTable::start_edit(int row)
+{
+    int x, y, w, h;
+    if((row < 0) || (row >= static_cast<int>(index.size())) ||
+       (find_cell(CONTEXT_CELL, row, COL_SET, x, y, w, h) != 0)) return;
+
+    unsigned int i = index[row];
+    edit_row = row;
+    input->set_channel(static_cast<ChannelCode>(frame.codes[i]));
+    input->value(frame.analog[i]);
+    input->resize(x, y, w, h);
+    input->show();
+    input->take_focus();
+}
+
+void TlmTable::select(int row)
+{
+    if((row < 0) || (row >= static_cast<int>(index.size()))) return;
+
+    selected = static_cast<ChannelCode>(frame.codes[index[row]]);
+    redraw();
+    if(select_callback) select_callback(this, select_user);
+}
+
+void TlmTable::on_click(Fl_Widget *, void *user)
+{
+    TlmTable *table = reinterpret_cast<TlmTable*>(user);
+    switch(table->callback_context())
+    {
+        case CONTEXT_CELL:
+            // clicking elsewhere abandons an edit
+            table->input->hide();
+            if(table->callback_col() == COL_SET)
+            {
+                table->start_edit(table->callback_row());
+            }
+            else
+            {
+                table->select(table->callback_row());
+            }
+            break;
+        case CONTEXT_ROW_HEADER:
+            table->select(table->callback_row());
+            break;
+        case CONTEXT_RC_RESIZE:
+        {
+            // keep input over its cell while scrolling, hide once out of view
+            int x, y, w, h;
+            if(!table->input->visible()) break;
+            if(table->find_cell(CONTEXT_CELL, table->edit_row, COL_SET, x, y, w, h) != 0)
+            {
+                table->input->hide();
+            }
+            else
+            {
+                table->input->resize(x, y, w, h);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void TlmTable::format_cell(int row, int col, char *text, unsigned int size) const
+{
+    unsigned int i = index[row];
+    const FrameChannel& channel = frame.channels[i];
+    switch(col)
+    {
+        case COL_SLOT:    std::snprintf(text, size, "%s", slot_name(channel)); break;
+        case COL_CODE:    std::snprintf(text, size, "0x%04x", frame.codes[i]); break;
+        case COL_DIGITAL: std::snprintf(text, size, "%u", frame.digital[i]); break;
+        case COL_ANALOG:  std::snprintf(text, size, "%.4f", frame.analog[i]); break;
+        default:          text[0] = '\0'; break;
+    }
+}
+
+void TlmTable::draw_cell(TableContext context, int row, int col, int x, int y, int w, int h)
+{
+    char text[32];
+    switch(context)
+    {
+        case CONTEXT_STARTPAGE:
+            fl_font(FL_HELVETICA, 12);
+            break;
+
+        case CONTEXT_COL_HEADER:
+            fl_push_clip(x, y, w, h);
+            fl_draw_box(FL_THIN_UP_BOX, x, y, w, h, col_header_color());
+            fl_color(FL_BLACK);
+            fl_draw(COLUMN_NAMES[col], x, y, w, h, FL_ALIGN_CENTER);
+            fl_pop_clip();
+            break;
+
+        case CONTEXT_ROW_HEADER:
+        {
+            // bus name on first row of each bus
+            const FrameChannel& channel = frame.channels[index[row]];
+            const FrameChannel *prev = (row > 0) ? &frame.channels[index[row - 1]] : nullptr;
+            bool first = !prev || (prev->type != channel.type) || (prev->bus != channel.bus) ||
+                         (prev->unit != channel.unit);
+            text[0] = '\0';
+            if(first && (channel.type == FRAME_NO_BUS))
+            {
+                std::snprintf(text, sizeof(text), "%s", bus_name(channel));
+            }
+            else if(first)
+            {
+                const char *fmt = (channel.unit > 0) ? "%s%u.%u" : "%s%u";
+                std::snprintf(text, sizeof(text), fmt, bus_name(channel), channel.bus + 1u, channel.unit + 1u);
+            }
+            fl_push_clip(x, y, w, h);
+            fl_draw_box(FL_THIN_UP_BOX, x, y, w, h, row_header_color());
+            fl_color(FL_BLACK);
+            fl_draw(text, x + 4, y, w - 8, h, FL_ALIGN_LEFT);
+            fl_pop_clip();
+            break;
+        }
+
+        case CONTEXT_CELL:
+            // input draws itself over the edited cell
+            if((row == edit_row) && (col == COL_SET) && input->visible()) break;
+            format_cell(row, col, text, sizeof(text));
+            fl_push_clip(x, y, w, h);
+            if(frame.codes[index[row]] == selected)
+            {
+                fl_color(fl_color_average(FL_SELECTION_COLOR, FL_BACKGROUND2_COLOR, 0.3f));
+            }
+            else
+            {
+                fl_color((col == COL_SET) ? FL_BACKGROUND2_COLOR : FL_BACKGROUND_COLOR);
+            }
+            fl_rectf(x, y, w, h);
+            fl_color(FL_FOREGROUND_COLOR);
+            fl_draw(text, x + 4, y, w - 8, h, (col == COL_SLOT) ? FL_ALIGN_LEFT : FL_ALIGN_RIGHT);
+            fl_color(FL_GRAY0);
+            fl_rect(x, y, w, h);
+            fl_pop_clip();
+            break;
+
+        default:
+            break;
+    }
+}
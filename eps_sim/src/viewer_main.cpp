@@ -0,0 +1,163 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps_view.hpp"
+#include "log.hpp"
+#include "shm.hpp"
+#include "types.hpp"
+
+#include <ItcLogger/Logger.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <Fl/Fl.H>
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace itc::eps;
+
+namespace
+{
+    ItcLogger::Logger *logger = ItcLogger::Logger::get(itc::eps::LOGGER_NAME.c_str());
+
+    const double ALIVE_POLL_S = 1.0; //!< Simulator liveness poll period (s)
+
+    /**
+     * \brief Simulator liveness poll state
+     */
+    struct AlivePoll
+    {
+        EpsView *view;                     //!< EPS simulator window
+        std::shared_ptr<ShmClient> client; //!< Shared memory segment
+    };
+
+    /* show simulator connection state (fltk timeout) */
+    void on_alive_poll(void *user)
+    {
+        AlivePoll *poll = reinterpret_cast<AlivePoll*>(user);
+        bool alive = poll->client->is_alive();
+        poll->view->set_connected(alive);
+        if(!alive)
+        {
+            // keep last frame on screen, the simulator does not come back to this segment
+            logger->warning("eps sim detached");
+            return;
+        }
+        Fl::repeat_timeout(ALIVE_POLL_S, on_alive_poll, user);
+    }
+}
+
+/* parse command line */
+bool parse_command_line(int argc, char **argv, std::string& name, double& refresh_hz, std::string& log_level)
+{
+    namespace po = boost::program_options;
+
+    // command line options
+    unsigned int address = 0;
+    po::variables_map eps_opts;
+    po::options_description eps_desc("STF-1 EPS Viewer Options");
+    eps_desc.add_options()
+        ("help,h", "display help")
+        ("address,a", po::value<unsigned int>(&address), "eps i2c address (default segment name)")
+        ("shm", po::value<std::string>(&name), "eps shared memory segment name")
+        ("refresh-hz", po::value<double>(&refresh_hz)->default_value(20), "window refresh rate (Hz)")
+        ("log-level", po::value<std::string>(&log_level)->default_value("error"), "log level");
+
+    // parse command line
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, eps_desc), eps_opts);
+        po::notify(eps_opts);
+    }
+    catch(const po::error& e)
+    {
+        std::cerr << "eps command line parse error: " << e.what() << std::endl;
+        return false;
+    }
+
+    // print help
+    if(eps_opts.count("help"))
+    {
+        std::cout << eps_desc;
+        return false;
+    }
+
+    // verify required parameter
+    if(name.empty())
+    {
+        if(!eps_opts.count("address"))
+        {
+            std::cerr << "missing required --shm or --address option" << std::endl;
+            return false;
+        }
+        name = get_shm_name(static_cast<uint8_t>(address));
+    }
+
+    return true;
+}
+
+/* configure logger */
+void configure_logger(const std::string& level)
+{
+    // create default stdio logger
+    logger->set_level(ItcLogger::String2Level(level.c_str()));
+    itc::eps::BinaryLog::get().set_level(itc::eps::to_log_level(level));
+    ItcLogger::TargetPtr target(new ItcLogger::Target(STDIO_BUILTIN_TARGET_IMPL, ItcLogger::LogArguments()));
+    target->set_format("%t [%l] - %s");
+    logger->add_target(target);
+}
+
+int main(int argc, char **argv)
+{
+    // parse command line
+    std::string name;
+    double refresh_hz = 20;
+    std::string log_level;
+    if(!parse_command_line(argc, argv, name, refresh_hz, log_level)) return 1;
+
+    // initialize logger
+    configure_logger(log_level);
+
+    // attach to running simulator
+    std::shared_ptr<ShmClient> client = std::make_shared<ShmClient>();
+    if(!client->open(name))
+    {
+        std::cerr << "unable to attach to eps sim: " << name << std::endl;
+        return 1;
+    }
+    logger->info("eps viewer attached: %s", name.c_str());
+
+    // simulator window (edits sent through the shared memory edit ring, history recorded from frames)
+    std::shared_ptr<const FramePublisher> frames(client, &client->get_frames());
+    EpsView view(frames, nullptr, [client](const EditCommand& command) {
+        if(!client->send(command)) logger->warning("eps edit dropped (sim not responding)");
+    }, refresh_hz);
+
+    // show when the simulator goes away
+    AlivePoll alive = {&view, client};
+    Fl::add_timeout(ALIVE_POLL_S, on_alive_poll, &alive);
+    view.show();
+
+    // run event loop
+    Fl::visual(FL_DOUBLE | FL_INDEX);
+    int result = Fl::run();
+    Fl::remove_timeout(on_alive_poll, &alive);
+    return result;
+}
@@ -0,0 +1,210 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_ACTOR_HPP
+#define ITC_EPS_ACTOR_HPP
+
+#include "eps.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace itc
+{
+    namespace eps
+    {
+        typedef std::function<void(Eps&)> EpsTask; //!< Task run on the EPS simulator thread
+
+        /**
+         * \brief Lock free multiple producer, single consumer task queue
+         *
+         * Producers link a node with one atomic exchange, the consumer pops without
+         * synchronizing with producers. Tasks from one producer run in the order posted.
+         */
+        class TaskQueue
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            TaskQueue();
+
+            /**
+             * \brief Destructor (discards pending tasks)
+             */
+            ~TaskQueue();
+
+            /**
+             * \brief Push task (any thread)
+             *
+             * \param task Task
+             */
+            void push(EpsTask task);
+
+            /**
+             * \brief Pop oldest task (consumer thread only)
+             *
+             * \param task Popped task
+             *
+             * \return False if queue is empty
+             */
+            bool pop(EpsTask& task);
+
+            /**
+             * \brief Get empty state (consumer thread only)
+             *
+             * \return True if no task is ready to pop
+             */
+            bool empty() const;
+
+        private:
+            TaskQueue(const TaskQueue&) = delete;
+            TaskQueue& operator=(const TaskQueue&) = delete;
+
+            /**
+             * \brief Queue node
+             */
+            struct Node
+            {
+                Node() : next(nullptr), task() {}
+
+                std::atomic<Node*> next; //!< Next (newer) node
+                EpsTask task;            //!< Task (empty in current tail node)
+            };
+
+        private:
+            std::atomic<Node*> head; //!< Newest node (producers)
+            Node *tail;              //!< Last popped node (consumer)
+        };
+
+        /**
+         * \brief EPS simulator thread (actor)
+         *
+         * One thread runs every task posted for the EPS, in a single deterministic order, so
+         * the EPS needs no lock. Producers never lock the queue, they only lock to wake the
+         * thread when it is idle. While the thread is not accepting tasks (not started, or
+         * stopping) tasks run in the calling thread, serialized with each other and with the
+         * simulator thread by the inline mutex.
+         */
+        class EpsActor
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param eps EPS simulator (only accessed by tasks once started)
+             */
+            EpsActor(Eps& eps);
+
+            /**
+             * \brief Destructor (stops thread)
+             */
+            ~EpsActor();
+
+            /**
+             * \brief Start simulator thread
+             *
+             * \param cpu CPU to pin the thread to (negative to not pin)
+             *
+             * \return True if thread was started
+             */
+            bool start(int cpu = -1);
+
+            /**
+             * \brief Run pending tasks and stop simulator thread
+             */
+            void stop();
+
+            /**
+             * \brief Get running state
+             *
+             * \return True if simulator thread is running
+             */
+            bool is_running() const;
+
+            /**
+             * \brief Post task without waiting
+             *
+             * Runs in the calling thread if the thread is not accepting tasks.
+             *
+             * \param task Task
+             */
+            void post(EpsTask task);
+
+            /**
+             * \brief Run task and wait for completion
+             *
+             * Runs in the calling thread if called from a task or if the thread is not accepting
+             * tasks.
+             *
+             * \param task Task
+             */
+            void call(EpsTask task);
+
+            /**
+             * \brief Get number of tasks run
+             *
+             * \return Number of tasks run
+             */
+            uint64_t get_num_tasks() const;
+
+        private:
+            EpsActor(const EpsActor&) = delete;
+            EpsActor& operator=(const EpsActor&) = delete;
+
+            /**
+             * \brief Queue task for the simulator thread
+             *
+             * \param task Task (moved if queued)
+             *
+             * \return False if the thread is not accepting tasks
+             */
+            bool push(EpsTask& task);
+
+            /**
+             * \brief Run task in the calling thread (thread not accepting tasks)
+             *
+             * \param task Task
+             */
+            void run_inline(const EpsTask& task);
+
+            /**
+             * \brief Simulator thread loop
+             */
+            void run();
+
+        private:
+            Eps& eps;                    //!< EPS simulator
+            TaskQueue queue;             //!< Posted tasks
+            std::thread thread;          //!< Simulator thread (owner thread only)
+            std::atomic<std::thread::id> thread_id; //!< Simulator thread id (default while not running)
+            std::atomic<bool> accepting; //!< Flag indicating the thread accepts tasks
+            std::atomic<unsigned int> producers; //!< Producers between the accepting check and the push
+            std::atomic<bool> sleeping;  //!< Flag indicating thread is waiting for tasks
+            std::atomic<uint64_t> num_tasks; //!< Number of tasks run
+            std::mutex wake_mutex;       //!< Idle wakeup mutex
+            std::condition_variable wake; //!< Idle wakeup condition
+            std::mutex inline_mutex;     //!< Held by the simulator thread and by tasks run inline
+        };
+    }
+}
+
+#endif
@@ -20,7 +20,11 @@
 #ifndef ITC_EPS_ADC_HPP
 #define ITC_EPS_ADC_HPP
 
+#include "state.hpp"
+#include "change.hpp"
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace itc
@@ -125,6 +129,11 @@ namespace itc
          */
         typedef std::vector<double> ConverterParams;
 
+        /**
+         * \brief Analog channel converter parameters by channel
+         */
+        typedef std::map<ChannelCode, ConverterParams> ConverterConfig;
+
         /**
          * \brief Analog telemetry channel
          */
@@ -141,6 +150,22 @@ namespace itc
              */
             Channel(ConverterType type = ADC_CONV_LINEAR, unsigned int bits = 10);
 
+            /**
+             * \brief Copy constructor (the copy is not tracked)
+             *
+             * \param channel Channel to copy
+             */
+            Channel(const Channel& channel);
+
+            /**
+             * \brief Assignment (keeps change tracker)
+             *
+             * \param channel Channel to copy
+             *
+             * \return This channel
+             */
+            Channel& operator=(const Channel& channel);
+
             /**
              * \brief Destructor
              */
@@ -153,6 +178,14 @@ namespace itc
              */
             void configure(const ConverterParams& params);
 
+            /**
+             * \brief Set change tracker notified of channel changes
+             *
+             * \param tracker Change tracker (null to disable)
+             * \param id Channel id in tracker
+             */
+            void set_change_tracker(ChangeTracker *tracker, unsigned int id);
+
             /**
              * \brief Check if channel is active
              *
@@ -188,7 +221,28 @@ namespace itc
              */
             void set_value(double val);
 
+            /**
+             * \brief Save channel state
+             *
+             * \param writer State writer
+             */
+            void save_state(StateWriter& writer) const;
+
+            /**
+             * \brief Load channel state
+             *
+             * \param reader State reader
+             *
+             * \return True if state was loaded
+             */
+            bool load_state(StateReader& reader);
+
         private:
+            /**
+             * \brief Notify change tracker of channel change
+             */
+            void notify_change();
+
             /**
              * \brief Get maximum digital value
              *
@@ -199,9 +253,11 @@ namespace itc
         private:
             unsigned int resolution; //!< Channel resolution (bits)
             ConverterType type;      //!< Conversion type
-            ConverterParams conv;    //!< Conversion parameters
+            std::shared_ptr<const ConverterParams> conv; //!< Conversion parameters (shared by copies)
             bool active;             //!< Flag indicating whether telemetry channel is active
             double value;            //!< Channel analog value
+            ChangeTracker *tracker;  //!< Change tracker (null if not tracked)
+            unsigned int tracker_id; //!< Channel id in change tracker
         };
     }
 }
@@ -23,12 +23,13 @@
 #include "bus.hpp"
 #include "adc.hpp"
 #include <array>
+#include <vector>
 
 namespace itc
 {
     namespace eps
     {
-        const int NUM_BCRS = 5; //!< Number of battery charge regulators (BCRs)
+        const int NUM_BCRS = 5; //!< Number of battery charge regulators (BCRs) (built-in layout)
 
         /**
          * \brief Battery charge regulator (BCR) bus data
@@ -51,8 +52,10 @@ namespace itc
         public:
             /**
              * \brief Constructor
+             *
+             * \param num_bcrs Number of battery charge regulators (BCRs) on bus
              */
-            BcrBus();
+            BcrBus(unsigned int num_bcrs = NUM_BCRS);
 
             /**
              * \brief Destructor
@@ -68,6 +71,29 @@ namespace itc
              */
             BcrData* get_data(unsigned int bcr);
 
+            /**
+             * \brief Get number of battery charge regulators (BCRs) on bus
+             *
+             * \return Number of battery charge regulators (BCRs)
+             */
+            unsigned int get_num_bcrs() const;
+
+            /**
+             * \brief Save bus state
+             *
+             * \param writer State writer
+             */
+            void save_state(StateWriter& writer) const;
+
+            /**
+             * \brief Load bus state
+             *
+             * \param reader State reader
+             *
+             * \return True if state was loaded
+             */
+            bool load_state(StateReader& reader);
+
         private:
             /**
              * \brief On reset state change
@@ -77,7 +103,7 @@ namespace itc
             void on_reset(bool state);
 
         private:
-            BcrData data[NUM_BCRS]; //!< Battery charge regulator (BCR) bus data
+            std::vector<BcrData> data; //!< Battery charge regulator (BCR) bus data
         };
     }
 }
@@ -20,6 +20,9 @@
 #ifndef ITC_EPS_BUS_HPP
 #define ITC_EPS_BUS_HPP
 
+#include "state.hpp"
+#include "change.hpp"
+#include <memory>
 #include <string>
 #include <set>
 
@@ -27,11 +30,18 @@ namespace itc
 {
     namespace eps
     {
+        class BusTopology;
+
         /**
          * \brief Abstract resettable EPS power bus
+         *
+         * Standalone buses propagate resets through their connected child buses. Buses added
+         * to a BusTopology propagate resets through the compiled topology instead.
          */
         class Bus
         {
+            friend class BusTopology;
+
         public:
             /**
              * \brief Constructor
@@ -40,6 +50,16 @@ namespace itc
              */
             Bus(const std::string& name = "");
 
+            /**
+             * \brief Copy constructor
+             *
+             * Copies name (shared) and reset state. The copy is standalone (no connections,
+             * topology, or change tracker).
+             *
+             * \param bus Bus to copy
+             */
+            Bus(const Bus& bus);
+
             /**
              * \brief Destructor
              */
@@ -87,6 +107,37 @@ namespace itc
              */
             virtual void on_reset(bool state) = 0;
 
+            /**
+             * \brief Set change tracker notified of reset state changes
+             *
+             * \param tracker Change tracker (null to disable)
+             * \param index Bus index reported in change events
+             */
+            void set_change_tracker(ChangeTracker *tracker, unsigned int index);
+
+            /**
+             * \brief Get bus index in compiled topology (layout index in an EPS)
+             *
+             * \return Bus index (0 if standalone)
+             */
+            unsigned int get_index() const;
+
+            /**
+             * \brief Save bus state (excluding reset state, which is saved by topology)
+             *
+             * \param writer State writer
+             */
+            virtual void save_state(StateWriter& writer) const;
+
+            /**
+             * \brief Load bus state
+             *
+             * \param reader State reader
+             *
+             * \return True if state was loaded
+             */
+            virtual bool load_state(StateReader& reader);
+
         private:
             /**
              * \brief Add parent bus as reset source
@@ -95,13 +146,44 @@ namespace itc
              */
             void add_parent(Bus& bus);
 
+            /**
+             * \brief Attach bus to compiled topology
+             *
+             * \param topology Bus topology
+             * \param index Bus index in topology
+             */
+            void attach(BusTopology *topology, unsigned int index);
+
+            /**
+             * \brief Detach bus from compiled topology
+             */
+            void detach();
+
+            /**
+             * \brief Set effective reset state and notify (called by topology)
+             *
+             * \param state Reset state
+             */
+            void set_reset_state(bool state);
+
+            /**
+             * \brief Notify change tracker of reset state change
+             */
+            void notify_reset();
+
         private:
             typedef std::set<Bus*> BusSet; //!< Bus set
 
-            std::string name;    //!< Bus name
+            std::shared_ptr<const std::string> name; //!< Bus name (shared by copies)
             BusSet parent_buses; //!< Parent buses (reset sources)
             BusSet child_buses;  //!< Child buses (reset sinks)
             bool reset_state;    //!< Bus reset state
+
+            BusTopology *topology;       //!< Compiled topology (null if standalone)
+            unsigned int topology_index; //!< Bus index in compiled topology
+
+            ChangeTracker *tracker;  //!< Change tracker (null if not tracked)
+            unsigned int tracker_index; //!< Bus index reported in change events
         };
     }
 }
@@ -0,0 +1,204 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_CHANGE_HPP
+#define ITC_EPS_CHANGE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Change area (versioned separately)
+         */
+        enum ChangeArea
+        {
+            CHANGE_AREA_STATUS,   //!< Board status, reset counters, and last error
+            CHANGE_AREA_SWITCHES, //!< Switch actual, expected, and initial states
+            CHANGE_AREA_RESETS,   //!< Bus reset states and watchdog resets
+            CHANGE_AREA_CHANNELS, //!< Telemetry channels
+            CHANGE_AREA_CONFIG,   //!< Versions, watchdog period, trip configs, and load aggregation
+            NUM_CHANGE_AREAS
+        };
+
+        /**
+         * \brief Change event type
+         */
+        enum ChangeType
+        {
+            CHANGE_STATUS,      //!< Board status updated (num = 0 board, 1 daughterboard)
+            CHANGE_SWITCH,      //!< Switch state toggled or initial state updated (num = switch number)
+            CHANGE_BUS_RESET,   //!< Bus reset enabled (num = bus index in layout)
+            CHANGE_BUS_RELEASE, //!< Bus reset disabled (num = bus index in layout)
+            CHANGE_WDT,         //!< Watchdog timer fired
+            CHANGE_CHANNEL,     //!< Channel value, active state, or converter updated (num = channel code)
+            CHANGE_CONFIG,      //!< Configuration updated
+            NUM_CHANGE_TYPES
+        };
+
+        const uint32_t CHANGE_MASK_ALL = (1u << NUM_CHANGE_TYPES) - 1; //!< Observe all change types
+
+        /**
+         * \brief Get change type mask
+         *
+         * \param type Change type
+         *
+         * \return Observer mask for type
+         */
+        inline uint32_t change_mask(ChangeType type) {return 1u << type;}
+
+        /**
+         * \brief Change event
+         */
+        struct ChangeEvent
+        {
+            ChangeType type;  //!< Change type
+            uint32_t num;     //!< Changed item (see ChangeType)
+            uint64_t version; //!< Global change version after change
+        };
+
+        typedef std::function<void(const ChangeEvent&)> ChangeCallback; //!< Change observer callback
+
+        /**
+         * \brief Simulator change versions and observers
+         *
+         * Every change increments the global version and stamps the area (and channel) with it,
+         * so a consumer that remembers the versions it last saw only has to revisit areas and
+         * channels with newer versions. Observers are called synchronously on the simulator
+         * thread and must not modify the simulator or its observers.
+         */
+        class ChangeTracker
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            ChangeTracker();
+
+            /**
+             * \brief Copy constructor (copies versions, not observers)
+             *
+             * \param tracker Tracker to copy
+             */
+            ChangeTracker(const ChangeTracker& tracker);
+
+            /**
+             * \brief Destructor
+             */
+            ~ChangeTracker();
+
+            /**
+             * \brief Set tracked channel codes
+             *
+             * \param codes Channel codes by channel id (ascending)
+             */
+            void set_channels(const std::vector<uint16_t>& codes);
+
+            /**
+             * \brief Get global change version
+             *
+             * \return Global change version
+             */
+            uint64_t get_version() const;
+
+            /**
+             * \brief Get area change version
+             *
+             * \param area Change area
+             *
+             * \return Global version of last change in area (0 if never changed)
+             */
+            uint64_t get_version(ChangeArea area) const;
+
+            /**
+             * \brief Get channel change version
+             *
+             * \param code Channel code
+             *
+             * \return Global version of last channel change (0 if never changed or not tracked)
+             */
+            uint64_t get_channel_version(uint16_t code) const;
+
+            /**
+             * \brief Add change observer
+             *
+             * \param callback Observer callback
+             * \param mask Change types to observe (see change_mask())
+             *
+             * \return Observer id
+             */
+            unsigned int add_observer(ChangeCallback callback, uint32_t mask = CHANGE_MASK_ALL);
+
+            /**
+             * \brief Remove change observer
+             *
+             * \param id Observer id
+             */
+            void remove_observer(unsigned int id);
+
+            /**
+             * \brief Record change
+             *
+             * \param type Change type
+             * \param num Changed item
+             */
+            void notify(ChangeType type, uint32_t num = 0);
+
+            /**
+             * \brief Record channel change
+             *
+             * \param id Channel id (see set_channels())
+             */
+            void notify_channel(unsigned int id);
+
+        private:
+            ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+            /**
+             * \brief Call observers of change
+             *
+             * \param event Change event
+             */
+            void dispatch(const ChangeEvent& event);
+
+        private:
+            /**
+             * \brief Change observer
+             */
+            struct Observer
+            {
+                unsigned int id;         //!< Observer id
+                uint32_t mask;           //!< Observed change types
+                ChangeCallback callback; //!< Observer callback
+            };
+
+            uint64_t version;                         //!< Global change version
+            uint64_t area_versions[NUM_CHANGE_AREAS]; //!< Area change versions
+            std::vector<uint16_t> channel_codes;      //!< Channel codes by id (ascending)
+            std::vector<uint64_t> channel_versions;   //!< Channel change versions by id
+            std::vector<Observer> observers;          //!< Change observers
+            unsigned int next_id;                     //!< Next observer id
+        };
+    }
+}
+
+#endif
@@ -65,6 +65,21 @@ namespace itc
             CMD_RESET_NODE                 = 0x80
         };
 
+        /**
+         * \brief EPS command types (command number order)
+         */
+        const CommandType CMD_TYPES[] = {
+            CMD_GET_BOARD_STATUS, CMD_GET_LAST_ERROR, CMD_GET_VERSION, CMD_GET_CHECKSUM, CMD_GET_TELEMETRY,
+            CMD_GET_WDT_PERIOD, CMD_SET_WDT_PERIOD, CMD_RESET_WDT, CMD_GET_NUM_BROWN_OUT_RESETS,
+            CMD_GET_NUM_AUTO_SW_RESETS, CMD_GET_NUM_MANUAL_RESETS, CMD_GET_NUM_WDT_RESETS, CMD_SET_PDM_ALL_ON,
+            CMD_SET_PDM_ALL_OFF, CMD_GET_PDM_ALL_ACTUAL_STATE, CMD_GET_PDM_ALL_EXPECTED_STATE,
+            CMD_GET_PDM_ALL_INITIAL_STATE, CMD_SET_PDM_ALL_INITIAL_STATE, CMD_SET_PDM_ON, CMD_SET_PDM_OFF,
+            CMD_SET_PDM_INITIAL_STATE_ON, CMD_SET_PDM_INITIAL_STATE_OFF, CMD_GET_PDM_ACTUAL_STATE,
+            CMD_SET_PDM_TIMER_LIMIT, CMD_GET_PDM_TIMER_LIMIT, CMD_GET_PDM_TIMER_VALUE, CMD_SET_PCM_RESET,
+            CMD_RESET_NODE
+        };
+        const unsigned int NUM_CMD_TYPES = sizeof(CMD_TYPES) / sizeof(CMD_TYPES[0]); //!< Number of EPS command types
+
         /**
          * \brief Generic data range
          */
@@ -0,0 +1,151 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_EEPROM_HPP
+#define ITC_EPS_EEPROM_HPP
+
+#include "status.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace itc
+{
+    namespace eps
+    {
+        const uint32_t EEPROM_MAGIC = 0x45535045;     //!< EEPROM image magic ("EPSE")
+        const uint32_t EEPROM_VERSION = 1;            //!< EEPROM image format version
+        const unsigned int NUM_EEPROM_RESETS = 4;     //!< Reset counters per board
+        const unsigned int MAX_EEPROM_SWITCHES = 256; //!< Switch initial states stored
+
+        /**
+         * \brief Emulated EEPROM image (fixed layout, host byte order)
+         */
+        struct EepromImage
+        {
+            uint32_t magic;                               //!< Image magic
+            uint32_t version;                             //!< Image format version
+            uint32_t num_switches;                        //!< Number of switches in board layout
+            uint16_t wdt_period_min;                      //!< Watchdog timer period (minutes)
+            uint16_t reserved;                            //!< Reserved (zero)
+            uint8_t reset_counts[NUM_EEPROM_RESETS];      //!< Board reset counters
+            uint8_t db_reset_counts[NUM_EEPROM_RESETS];   //!< Daughterboard reset counters
+            uint8_t pdm_initial[MAX_EEPROM_SWITCHES / 8]; //!< Switch initial power on reset (POR) states (bit per switch)
+        };
+
+        /**
+         * \brief Reset types counted in EEPROM image (image counter order)
+         */
+        const ResetType EEPROM_RESET_TYPES[NUM_EEPROM_RESETS] = {RESET_WDT, RESET_POWER_ON, RESET_BROWN_OUT, RESET_MANUAL};
+
+        /**
+         * \brief Memory mapped EEPROM store
+         *
+         * The image is a shared file mapping, so stores to the image reach the file without
+         * explicit I/O. sync() flushes the mapping and is meant to be called periodically (it
+         * is a no-op if nothing changed since the last sync). The image is written by the
+         * simulator thread, sync() may be called from any thread.
+         */
+        class EepromStore
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            EepromStore();
+
+            /**
+             * \brief Destructor (syncs and unmaps image)
+             */
+            ~EepromStore();
+
+            /**
+             * \brief Open (or create) EEPROM file
+             *
+             * A new or invalid file is initialized with an empty image (see is_new()).
+             *
+             * \param filename EEPROM file
+             *
+             * \return True if file was opened and mapped
+             */
+            bool open(const std::string& filename);
+
+            /**
+             * \brief Sync and unmap image
+             */
+            void close();
+
+            /**
+             * \brief Get open state
+             *
+             * \return True if image is mapped
+             */
+            bool is_open() const;
+
+            /**
+             * \brief Get new image state
+             *
+             * \return True if the image was initialized when opened (no stored values)
+             */
+            bool is_new() const;
+
+            /**
+             * \brief Get EEPROM file name
+             *
+             * \return EEPROM file name
+             */
+            const std::string& get_filename() const;
+
+            /**
+             * \brief Get image
+             *
+             * \return Image (must be open)
+             */
+            const EepromImage& get() const;
+
+            /**
+             * \brief Get image for modification (marks image dirty)
+             *
+             * \return Image (must be open)
+             */
+            EepromImage& edit();
+
+            /**
+             * \brief Flush modified image to file
+             *
+             * \param wait If true wait for the write to complete
+             *
+             * \return True if image was flushed or not modified
+             */
+            bool sync(bool wait = false);
+
+        private:
+            EepromStore(const EepromStore&) = delete;
+            EepromStore& operator=(const EepromStore&) = delete;
+
+        private:
+            std::string filename;     //!< EEPROM file name
+            EepromImage *image;       //!< Mapped image (null if closed)
+            bool created;             //!< Flag indicating image was initialized on open
+            std::atomic<bool> dirty;  //!< Flag indicating image was modified since last sync
+        };
+    }
+}
+
+#endif
@@ -40,10 +40,24 @@
 #include "bcr.hpp"
 #include "pcm.hpp"
 #include "pdm.hpp"
+#include "load.hpp"
+#include "topology.hpp"
+#include "layout.hpp"
+#include "command.hpp"
+#include "state.hpp"
+#include "journal.hpp"
+#include "eeprom.hpp"
+#include "rom.hpp"
+#include "change.hpp"
+#include "frame.hpp"
+#include "history.hpp"
+#include "stats.hpp"
 #include <algorithm>
 #include <cstdint>
 #include <set>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace itc
 {
@@ -56,7 +70,7 @@ namespace itc
         {
         public:
             /**
-             * \brief Constructor
+             * \brief Constructor (Clyde Space 3rd generation 3U EPS layout)
              *
              * \param address I2C base address
              * \param daughterboard Flag indicating whether daughterboard is connected
@@ -64,11 +78,45 @@ namespace itc
              */
             Eps(uint8_t address, bool daughterboard, ByteSwapConfig swap_config = ByteSwapConfig());
 
+            /**
+             * \brief Constructor
+             *
+             * An invalid layout is logged and replaced by the built-in Clyde Space 3rd generation
+             * 3U EPS layout.
+             *
+             * \param address I2C base address
+             * \param daughterboard Flag indicating whether daughterboard is connected
+             * \param layout Board layout (bus graph, channel assignments, and command mappings)
+             * \param swap_config Byte swap config for incoming/outgoing I2C data
+             */
+            Eps(uint8_t address, bool daughterboard, const BoardLayout& layout,
+                ByteSwapConfig swap_config = ByteSwapConfig());
+
             /**
              * \brief Destructor
              */
             ~Eps();
 
+            /**
+             * \brief Fork simulator
+             *
+             * The fork shares immutable configuration (board layout, compiled bus topology, bus
+             * names, and channel converter parameters) and copies only mutable state. Forked load
+             * profiles replace switch loads (switches with profiles that cannot be forked have no
+             * load). Pending published loads are not copied. The fork and this simulator may be
+             * run independently on different threads.
+             *
+             * \return Forked simulator
+             */
+            std::unique_ptr<Eps> fork() const;
+
+            /**
+             * \brief Get board layout
+             *
+             * \return Board layout
+             */
+            const BoardLayout& get_layout() const;
+
             /**
              * \brief I2C master write
              *
@@ -90,6 +138,13 @@ namespace itc
              */
             uint8_t get_address() const;
 
+            /**
+             * \brief Set I2C address (fork hosted as another board)
+             *
+             * \param address I2C base address
+             */
+            void set_address(uint8_t address);
+
             /**
              * \brief Get current simulation time
              *
@@ -126,7 +181,7 @@ namespace itc
             Status get_status() const;
 
             /**
-             * \brief Set EPS board status
+             * \brief Set EPS board status (checksum is kept, it is computed from the ROM image)
              *
              * \param status EPS board status
              */
@@ -154,7 +209,7 @@ namespace itc
             Status get_daughterboard_status() const;
 
             /**
-             * \brief Set EPS daughterboard status
+             * \brief Set EPS daughterboard status (checksum is kept, it is computed from the ROM image)
              *
              * \param status EPS daughterboard status
              */
@@ -183,6 +238,22 @@ namespace itc
              */
             void set_telemetry(ChannelCode code, double val);
 
+            /**
+             * \brief Set default telemetry values (bulk initialization)
+             *
+             * Equivalent to setting each value, but logged and published once.
+             *
+             * \param values Analog telemetry values by channel
+             */
+            void set_telemetry(const TelemetryValues& values);
+
+            /**
+             * \brief Get number of power distribution module (PDM) switches
+             *
+             * \return Number of PDM switches
+             */
+            unsigned int get_num_switches() const;
+
             /**
              * \brief Get power distribution module (PDM) switch state
              *
@@ -217,6 +288,67 @@ namespace itc
              */
             void set_switch_initial_state(unsigned int num, bool on);
 
+            /**
+             * \brief Get power distribution module (PDM) switch overcurrent trip config
+             *
+             * \param num PDM switch number
+             *
+             * \return Switch overcurrent trip config
+             */
+            PdmTripConfig get_switch_trip_config(unsigned int num) const;
+
+            /**
+             * \brief Set power distribution module (PDM) switch overcurrent trip config
+             *
+             * \param num PDM switch number
+             * \param config Switch overcurrent trip config
+             */
+            void set_switch_trip_config(unsigned int num, const PdmTripConfig& config);
+
+            /**
+             * \brief Get power distribution module (PDM) switch overcurrent trip state
+             *
+             * \param num PDM switch number
+             *
+             * \return True if switch is tripped off (awaiting retry or latched)
+             */
+            bool is_switch_tripped(unsigned int num) const;
+
+            /**
+             * \brief Set power distribution module (PDM) switch load profile
+             *
+             * \param num PDM switch number
+             * \param load Switch load profile (null to disable)
+             */
+            void set_switch_load(unsigned int num, std::shared_ptr<LoadProfile> load);
+
+            /**
+             * \brief Get load current publisher
+             *
+             * External simulators publish switch load currents through the publisher from any
+             * thread. Pending samples are applied on the next time update.
+             *
+             * \return Load current publisher
+             */
+            LoadPublisher& get_load_publisher();
+
+            /**
+             * \brief Get load aggregation state
+             *
+             * \return True if power conditioning module (PCM) currents are aggregated from switch loads
+             */
+            bool get_load_aggregation() const;
+
+            /**
+             * \brief Set load aggregation state
+             *
+             * When enabled, each power conditioning module (PCM) current channel is set to the sum of
+             * the currents of its connected switches on each time update.
+             *
+             * \param enable Load aggregation state
+             */
+            void set_load_aggregation(bool enable);
+
             /**
              * \brief Get EPS reset state
              *
@@ -232,7 +364,217 @@ namespace itc
              */
             void configure_channel(ChannelCode code, const ConverterParams& params);
 
+            /**
+             * \brief Configure analog telemetry channels (bulk initialization)
+             *
+             * Equivalent to configuring each channel, but journaled and published once.
+             *
+             * \param config Converter parameters by channel
+             */
+            void configure_channels(const ConverterConfig& config);
+
+            /**
+             * \brief Save complete simulator state
+             *
+             * Saves time, watchdog, pending I2C response, versions, status, bus reset states,
+             * channels, switch states and timers, overcurrent trip state, and pending bus reset
+             * releases into a versioned binary blob. Switch load profiles are not saved.
+             *
+             * \param blob Simulator state (replaced)
+             */
+            void save_state(StateBlob& blob) const;
+
+            /**
+             * \brief Load complete simulator state
+             *
+             * The blob must have been saved by a simulator with the same board layout. If the blob
+             * is invalid the current state is left unchanged.
+             *
+             * \param blob Simulator state
+             *
+             * \return True if state was loaded
+             */
+            bool load_state(const StateBlob& blob);
+
+            /**
+             * \brief Enable state journal
+             *
+             * Commands, time advances, telemetry and switch updates, applied published loads, and
+             * bus reset begin/end are appended to a bounded journal, with periodic state keyframes.
+             * Other updates (versions, status, channel and trip configs, load aggregation) add a
+             * keyframe. Loading a state clears the journal. Replaces any existing journal.
+             *
+             * \param config Journal config
+             */
+            void enable_journal(const JournalConfig& config = JournalConfig());
+
+            /**
+             * \brief Disable state journal (discards journal)
+             */
+            void disable_journal();
+
+            /**
+             * \brief Get state journal
+             *
+             * \return State journal (null if disabled)
+             */
+            const Journal* get_journal() const;
+
+            /**
+             * \brief Enable state frame publishing
+             *
+             * A state frame is published after each mutation that changes state or time, so
+             * readers on other threads can snapshot state without locking the EPS.
+             *
+             * \param publisher Publisher to use (e.g. in shared memory), null to keep the current
+             *                  publisher or create one
+             *
+             * \return State frame publisher
+             */
+            std::shared_ptr<const FramePublisher> enable_frames(std::shared_ptr<FramePublisher> publisher = nullptr);
+
+            /**
+             * \brief Disable state frame publishing (readers keep the last frame)
+             */
+            void disable_frames();
+
+            /**
+             * \brief Get state frame publisher
+             *
+             * \return State frame publisher (null if disabled)
+             */
+            std::shared_ptr<const FramePublisher> get_frames() const;
+
+            /**
+             * \brief Enable telemetry channel history
+             *
+             * Channel values are sampled as simulation time advances, at most once per period.
+             * Readers on other threads read the history without locking the EPS.
+             *
+             * \param period_ms Sample period (ms), ignored if history is already enabled
+             *
+             * \return Channel history store
+             */
+            std::shared_ptr<const HistoryStore> enable_history(unsigned int period_ms = DEFAULT_HISTORY_PERIOD_MS);
+
+            /**
+             * \brief Disable telemetry channel history (readers keep the recorded history)
+             */
+            void disable_history();
+
+            /**
+             * \brief Get telemetry channel history store
+             *
+             * \return Channel history store (null if disabled)
+             */
+            std::shared_ptr<const HistoryStore> get_history() const;
+
+            /**
+             * \brief Enable per command statistics
+             *
+             * Commands, error responses by error code, and bytes are counted per command type.
+             * The simulator host records transaction latency in the returned statistics. Readers
+             * on other threads read the statistics without locking the EPS. Statistics are not
+             * copied to forks.
+             *
+             * \return Command statistics
+             */
+            std::shared_ptr<CommandStats> enable_stats();
+
+            /**
+             * \brief Disable per command statistics (readers keep the recorded statistics)
+             */
+            void disable_stats();
+
+            /**
+             * \brief Get per command statistics
+             *
+             * \return Command statistics (null if disabled)
+             */
+            std::shared_ptr<const CommandStats> get_stats() const;
+
+            /**
+             * \brief Fill state frame with current state
+             *
+             * \param frame State frame
+             */
+            void get_frame(StateFrame& frame) const;
+
+            /**
+             * \brief Reconstruct simulator state at a past time from the journal
+             *
+             * The latest keyframe at or before the time is loaded into a fork of this simulator and
+             * the journaled events up to and including the time are replayed. Switch load profiles
+             * are those of the fork (not journaled).
+             *
+             * \param time Simulation time (ms)
+             *
+             * \return Simulator at time (null if journal is disabled or time is before oldest keyframe)
+             */
+            std::unique_ptr<Eps> reconstruct(SimTime time) const;
+
+            /**
+             * \brief Rewind simulator to a past time from the journal
+             *
+             * Journaled events and keyframes after the time are discarded. Load samples that were
+             * pending publication at the time are not restored.
+             *
+             * \param time Simulation time (ms)
+             *
+             * \return True if state was rewound
+             */
+            bool rewind(SimTime time);
+
+            /**
+             * \brief Attach persistent EEPROM store
+             *
+             * Reset counters, switch initial power on reset (POR) states, and the watchdog timer
+             * period are restored from the stored image and written through to the image as they
+             * change. A new image, or one stored for a different number of switches, is initialized
+             * from the current values. Forks are not attached.
+             *
+             * \param store Open EEPROM store (null to detach)
+             */
+            void attach_eeprom(std::shared_ptr<EepromStore> store);
+
+            /**
+             * \brief Get change versions
+             *
+             * Versions are read on the simulator thread (or under the same lock as simulator
+             * updates).
+             *
+             * \return Change tracker
+             */
+            const ChangeTracker& get_changes() const;
+
+            /**
+             * \brief Add change observer
+             *
+             * Observers are called synchronously on the simulator thread as changes are made and
+             * must not modify the simulator. Observers are not copied to forks.
+             *
+             * \param callback Observer callback
+             * \param mask Change types to observe (see change_mask())
+             *
+             * \return Observer id
+             */
+            unsigned int add_observer(ChangeCallback callback, uint32_t mask = CHANGE_MASK_ALL);
+
+            /**
+             * \brief Remove change observer
+             *
+             * \param id Observer id
+             */
+            void remove_observer(unsigned int id);
+
         private:
+            /**
+             * \brief Fork constructor (see fork())
+             *
+             * \param eps Simulator to fork
+             */
+            Eps(const Eps& eps);
+
             /**
              * \brief Get validity of telemetry channel
              *
@@ -267,11 +609,43 @@ namespace itc
             /**
              * \brief Get state of all power distribution module (PDM) switches
              *
-             * \param initial If true get initial state, otherwise get current state
+             * \param type Switch state type
              *
              * \return PDM switch state
              */
-            uint32_t get_pdm_all(bool initial) const;
+            uint32_t get_pdm_all(PdmStateType type) const;
+
+            /**
+             * \brief Set power distribution module (PDM) switch state
+             *
+             * Commanding a switch clears its overcurrent trip and retry state.
+             *
+             * \param num PDM switch number
+             * \param on Switch state
+             */
+            void set_pdm_state(unsigned int num, bool on);
+
+            /**
+             * \brief Clear power distribution module (PDM) switch overcurrent trip and retry state
+             *
+             * \param num PDM switch number
+             */
+            void clear_pdm_trip(unsigned int num);
+
+            /**
+             * \brief Check power distribution module (PDM) switches for overcurrent trips and retries
+             */
+            void check_pdm_trips();
+
+            /**
+             * \brief Apply load currents published by external simulators
+             */
+            void apply_published_loads();
+
+            /**
+             * \brief Aggregate switch load currents into power conditioning module (PCM) currents
+             */
+            void aggregate_loads();
 
             /**
              * \brief Set power distribution module (PDM) switch auto off timer limit
@@ -294,15 +668,122 @@ namespace itc
              */
             void reset_bus(Bus& bus);
 
+            /**
+             * \brief Create power buses
+             *
+             * \param layout Board layout
+             */
+            void create_buses(const BoardLayout& layout);
+
+            /**
+             * \brief Map buses to command and aggregation roles
+             *
+             * \param layout Board layout
+             */
+            void map_buses(const BoardLayout& layout);
+
             /**
              * \brief Connect analog telemetry channels
+             *
+             * \param layout Board layout
              */
-            void connect_channels();
+            void connect_channels(const BoardLayout& layout);
 
             /**
              * \brief Connect power buses
+             *
+             * \param layout Board layout
+             */
+            void connect_buses(const BoardLayout& layout);
+
+            /**
+             * \brief Bind buses, switches, and channels to change tracker
+             */
+            void track_changes();
+
+            /**
+             * \brief Read simulator state (after header)
+             *
+             * \param reader State reader
+             *
+             * \return True if state was read completely
+             */
+            bool read_state(StateReader& reader);
+
+            /**
+             * \brief Replay journaled simulator state up to a time
+             *
+             * \param time Simulation time (ms)
+             * \param end Sequence number of first event not replayed
+             *
+             * \return Simulator at time (null if no keyframe)
+             */
+            std::unique_ptr<Eps> replay_journal(SimTime time, uint64_t& end) const;
+
+            /**
+             * \brief Apply journal event
+             *
+             * \param event Journal event (informational events are ignored)
+             */
+            void replay(const JournalEvent& event);
+
+            /**
+             * \brief Add journal keyframe if due
              */
-            void connect_buses();
+            void update_journal();
+
+            /**
+             * \brief Add journal keyframe of current state
+             */
+            void add_journal_keyframe();
+
+            /**
+             * \brief Publish state frame if state or time changed since last frame
+             */
+            void publish_frame();
+
+            /**
+             * \brief Sample channel values into history
+             */
+            void record_history();
+
+            /**
+             * \brief Count command in statistics (if enabled)
+             *
+             * \param data I2C write data (command and data)
+             * \param error Command error (ERROR_NONE if valid)
+             */
+            void record_command(const I2CData& data, ErrorCode error);
+
+            /**
+             * \brief Restore EEPROM backed values from EEPROM image
+             */
+            void read_eeprom();
+
+            /**
+             * \brief Write EEPROM backed values to EEPROM image
+             */
+            void write_eeprom();
+
+            /**
+             * \brief Write EEPROM backed values to ROM images and EEPROM store (if attached)
+             */
+            void write_config();
+
+            /**
+             * \brief Write EEPROM backed values to ROM image configuration blocks
+             */
+            void write_rom();
+
+            /**
+             * \brief Set ROM image firmware from board versions
+             */
+            void update_firmware();
+
+            /**
+             * \brief Copy ROM image checksums to board status
+             */
+            void update_checksums();
 
             /**
              * \brief Get parameter from I2C command data
@@ -335,6 +816,37 @@ namespace itc
                 SimTime time_ms;
             };
 
+            /**
+             * \brief Power distribution module (PDM) overcurrent trip table
+             *
+             * Trip parameters and state are stored as parallel arrays indexed by switch number
+             * with packed switch mask words (64 switches per word), so all switches are checked
+             * in a single pass per time step.
+             */
+            struct PdmTripTable
+            {
+                typedef uint64_t Mask; //!< Switch mask word type
+
+                /**
+                 * \brief Constructor
+                 *
+                 * \param num Number of switches
+                 */
+                PdmTripTable(unsigned int num = 0);
+
+                std::vector<double> limit;               //!< Overcurrent limit (A)
+                std::vector<SimTime> trip_delay_ms;      //!< Time over limit before trip (ms)
+                std::vector<SimTime> retry_delay_ms;     //!< Time tripped before retry (ms)
+                std::vector<unsigned int> max_retries;   //!< Automatic retries before latching off
+                std::vector<unsigned int> retries;       //!< Automatic retries since last command
+                std::vector<SimTime> over_ms;            //!< Time switch current exceeded limit (ms)
+                std::vector<SimTime> retry_ms;           //!< Time tripped switch is retried (ms)
+                std::vector<double> current;             //!< Sampled switch current (A, scratch)
+                std::vector<Mask> over;    //!< Switches currently over limit
+                std::vector<Mask> tripped; //!< Switches tripped and awaiting retry
+                std::vector<Mask> latched; //!< Switches latched off until commanded
+            };
+
             ByteSwapConfig swap; //!< Byte swap config for incoming/outgoing I2C data
 
             uint8_t address;  //!< I2C address
@@ -344,13 +856,34 @@ namespace itc
 
             Version version; //!< EPS board version
             Status status;   //!< EPS board status
-            BcrBus bcr_bus;  //!< Battery charge regulator (BCR) bus
-            PcmBus pcm_bus[NUM_PCM_BUSES]; //!< Power conditioning module (PCM) buses
-            PdmBus pdm_bus[NUM_SWITCHES];  //!< Power distribution module (PDM) switch buses
+
+            ChangeTracker changes; //!< Change versions and observers (before buses, which refer to it)
+
+            std::shared_ptr<const BoardLayout> layout; //!< Board layout (shared by forks)
+
+            typedef std::vector<std::unique_ptr<Bus>> BusList; //!< Owned bus list type
+            BusList buses;                  //!< Power buses by layout index
+            Bus *node_bus;                  //!< Bus reset by node reset and watchdog
+            std::vector<PcmBus*> pcm_bus;   //!< Power conditioning module (PCM) buses in layout order
+            std::vector<PcmBus*> pcm_reset; //!< Power conditioning module (PCM) buses by reset command bit
+            std::vector<unsigned int> pcm_reset_index;  //!< Topology bus index of each PCM reset command bit
+            std::vector<BusTopology::Mask> pcm_reset_mask; //!< PCM reset command buses (bit per topology bus index)
+            std::vector<PdmBus*> pdm_bus;   //!< Power distribution module (PDM) switch buses by switch number
+            std::vector<unsigned int> pdm_source; //!< PCM bus (pcm_bus index) powering each switch
+            std::vector<double> pcm_load;   //!< Aggregated PCM bus load currents (scratch)
+            PdmTripTable pdm_trips;         //!< Power distribution module (PDM) overcurrent trip table
+            PdmStateWords pdm_words;        //!< Packed power distribution module (PDM) switch states
+            BusTopology topology;           //!< Compiled power bus topology (after buses, detaches them on destruction)
+            CommandDataRangeMap data_ranges;    //!< Valid command data ranges
+            CommandDataRangeMap channel_ranges; //!< Valid command channel ranges (sized to layout)
             bool db_connected;  //!< Flag indicating whether daughterboard is connected
             Version db_version; //!< EPS daughterboard version
             Status db_status;   //!< EPS daughterboard status
 
+            LoadPublisher load_publisher; //!< Published switch load currents
+            LoadBatch load_batch;         //!< Load samples drained from publisher
+            bool load_aggregation;        //!< Flag indicating PCM currents are aggregated from switch loads
+
             typedef std::map<ChannelCode, Channel> MiscChannels; //!< EPS board misc channel map type
             MiscChannels misc_channels; //!< Misc board telemetry channels
 
@@ -362,6 +895,19 @@ namespace itc
             
             typedef std::set<ResetInfo> ResetBusSet; //!< Reset bus set
             ResetBusSet reset_buses; //!< Buses in reset state
+
+            std::unique_ptr<Journal> journal;     //!< State journal (null if disabled)
+            std::shared_ptr<EepromStore> eeprom; //!< Persistent EEPROM store (null if detached)
+            RomImage rom;    //!< EPS motherboard ROM image
+            RomImage db_rom; //!< EPS daughterboard ROM image
+            std::shared_ptr<FramePublisher> frames; //!< State frame publisher (null if disabled)
+            uint64_t frame_version; //!< Change version of last published frame
+            SimTime frame_time;     //!< Time of last published frame
+            std::vector<FrameChannel> frame_channels; //!< State frame channel descriptors (adc order)
+            std::shared_ptr<HistoryStore> history; //!< Channel history (null if disabled)
+            std::vector<double> history_values;    //!< Channel values sampled into history (scratch)
+
+            std::shared_ptr<CommandStats> stats; //!< Per command statistics (null if disabled)
         };
 
         template<typename T>
@@ -0,0 +1,164 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_FRAME_HPP
+#define ITC_EPS_FRAME_HPP
+
+#include "change.hpp"
+#include "eeprom.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace itc
+{
+    namespace eps
+    {
+        const unsigned int MAX_FRAME_CHANNELS = 256; //!< Telemetry channels in state frame
+        const unsigned int MAX_FRAME_SWITCHES = 256; //!< Switches in state frame
+        const unsigned int FRAME_SWITCH_WORDS = MAX_FRAME_SWITCHES / 64; //!< Words per switch mask
+        const uint8_t FRAME_NO_BUS = 0xff; //!< Channel descriptor bus type of board (misc) channels
+
+        /**
+         * \brief Board state in state frame
+         */
+        struct FrameBoard
+        {
+            uint16_t status;                            //!< Board status bits
+            uint16_t last_error;                        //!< Last error code
+            uint16_t checksum;                          //!< Board checksum
+            uint16_t version;                           //!< Board version
+            uint8_t reset_counts[NUM_EEPROM_RESETS];    //!< Reset counters (EEPROM_RESET_TYPES order)
+            uint32_t reserved;                          //!< Reserved (zero)
+        };
+
+        /**
+         * \brief Telemetry channel descriptor in state frame (from board layout)
+         */
+        struct FrameChannel
+        {
+            uint8_t type; //!< Bus type (BusType, FRAME_NO_BUS for board channels)
+            uint8_t bus;  //!< Bus number among buses of the same type
+            uint8_t slot; //!< Channel slot within bus (ChannelSlot)
+            uint8_t unit; //!< Regulator number within bus (BCR only)
+        };
+
+        /**
+         * \brief Fixed layout snapshot of EPS state
+         *
+         * Channels are in channel code order, switches in switch number order. The frame is
+         * trivially copyable and its size is a multiple of 8 bytes (published word by word).
+         */
+        struct StateFrame
+        {
+            uint64_t time_ms;                              //!< Simulator time (ms)
+            uint64_t version;                              //!< EPS change version
+            uint64_t area_versions[NUM_CHANGE_AREAS];      //!< EPS area change versions
+            uint32_t wdt_timeout_ms;                       //!< Watchdog timer timeout (ms)
+            uint32_t db_connected;                         //!< Non zero if daughterboard is connected
+            FrameBoard board;                              //!< Motherboard state
+            FrameBoard db_board;                           //!< Daughterboard state
+            uint32_t num_channels;                         //!< Number of channels in frame
+            uint32_t num_switches;                         //!< Number of switches in frame
+            uint16_t codes[MAX_FRAME_CHANNELS];            //!< Channel codes
+            FrameChannel channels[MAX_FRAME_CHANNELS];     //!< Channel descriptors
+            uint16_t digital[MAX_FRAME_CHANNELS];          //!< Channel digital values (ADC counts)
+            double analog[MAX_FRAME_CHANNELS];             //!< Channel analog values
+            uint64_t switch_actual[FRAME_SWITCH_WORDS];    //!< Switch actual states (bit per switch)
+            uint64_t switch_expected[FRAME_SWITCH_WORDS];  //!< Switch expected states (bit per switch)
+            uint64_t switch_initial[FRAME_SWITCH_WORDS];   //!< Switch initial states (bit per switch)
+
+            /**
+             * \brief Get switch state bit
+             *
+             * \param mask Switch mask
+             * \param num Switch number
+             *
+             * \return True if switch bit is set
+             */
+            static bool is_set(const uint64_t *mask, unsigned int num)
+            {
+                return (num < MAX_FRAME_SWITCHES) && ((mask[num / 64] >> (num % 64)) & 1);
+            }
+        };
+
+        /**
+         * \brief Single writer, lock free multiple reader state frame publisher (seqlock)
+         *
+         * The writer never waits for readers. Readers copy the frame and retry if it was
+         * published during the copy. The frame is stored as atomic words so concurrent copies
+         * are well defined.
+         */
+        class FramePublisher
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            FramePublisher();
+
+            /**
+             * \brief Destructor
+             */
+            ~FramePublisher();
+
+            /**
+             * \brief Publish frame (single writer)
+             *
+             * \param frame State frame
+             */
+            void publish(const StateFrame& frame);
+
+            /**
+             * \brief Try to read consistent frame (single attempt)
+             *
+             * \param frame Frame copy
+             *
+             * \return True if frame was copied without concurrent publish
+             */
+            bool try_read(StateFrame& frame) const;
+
+            /**
+             * \brief Read consistent frame (retries while frame is published)
+             *
+             * \param frame Frame copy
+             *
+             * \return False if no frame was published yet
+             */
+            bool read(StateFrame& frame) const;
+
+            /**
+             * \brief Get number of published frames
+             *
+             * \return Number of published frames
+             */
+            uint64_t get_count() const;
+
+        private:
+            FramePublisher(const FramePublisher&) = delete;
+            FramePublisher& operator=(const FramePublisher&) = delete;
+
+        private:
+            static const unsigned int NUM_WORDS = sizeof(StateFrame) / sizeof(uint64_t); //!< Frame size in words
+
+            std::atomic<uint64_t> sequence;          //!< Sequence number (odd while publishing)
+            std::atomic<uint64_t> words[NUM_WORDS];  //!< Published frame
+        };
+    }
+}
+
+#endif
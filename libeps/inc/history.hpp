@@ -0,0 +1,220 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_HISTORY_HPP
+#define ITC_EPS_HISTORY_HPP
+
+#include "adc.hpp"
+#include "types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        const unsigned int HISTORY_LEVELS = 4;       //!< Decimation (zoom) levels per channel
+        const unsigned int HISTORY_SIZE = 512;       //!< Points per level
+        const unsigned int HISTORY_DECIMATION = 16;  //!< Points of a level merged into one point of the next level
+        const unsigned int DEFAULT_HISTORY_PERIOD_MS = 10; //!< Default history sample period (ms)
+
+        /**
+         * \brief Decimated history point
+         */
+        struct HistoryPoint
+        {
+            uint64_t time_ms; //!< Time of last sample in point (ms)
+            double min;       //!< Minimum sample value
+            double max;       //!< Maximum sample value
+            double mean;      //!< Mean sample value
+        };
+
+        /**
+         * \brief Single writer, lock free multiple reader channel history
+         *
+         * Samples are kept in fixed size rings at several levels, each point of a level
+         * merging HISTORY_DECIMATION points of the level below (min, max, and mean). Reading
+         * a level costs at most HISTORY_SIZE points, whatever time span it covers. Points are
+         * stored as atomic words so concurrent reads are well defined.
+         */
+        class ChannelHistory
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            ChannelHistory();
+
+            /**
+             * \brief Destructor
+             */
+            ~ChannelHistory();
+
+            /**
+             * \brief Add sample (single writer)
+             *
+             * \param time_ms Sample time (ms)
+             * \param value Sample value
+             */
+            void add(uint64_t time_ms, double value);
+
+            /**
+             * \brief Read latest points of a level
+             *
+             * Points overwritten during the copy are dropped.
+             *
+             * \param level Decimation level
+             * \param points Points (oldest first)
+             * \param max Maximum number of points to read
+             *
+             * \return Number of points read
+             */
+            unsigned int read(unsigned int level, HistoryPoint *points, unsigned int max) const;
+
+            /**
+             * \brief Get number of points written to a level
+             *
+             * \param level Decimation level
+             *
+             * \return Number of points written
+             */
+            uint64_t get_count(unsigned int level) const;
+
+        private:
+            ChannelHistory(const ChannelHistory&) = delete;
+            ChannelHistory& operator=(const ChannelHistory&) = delete;
+
+            static const unsigned int POINT_WORDS = sizeof(HistoryPoint) / sizeof(uint64_t); //!< Words per point
+
+            /**
+             * \brief Append point to level (merging completed groups into the next level)
+             *
+             * \param level Decimation level
+             * \param point Point
+             */
+            void append(unsigned int level, const HistoryPoint& point);
+
+            /**
+             * \brief Level being merged (writer only)
+             */
+            struct Pending
+            {
+                HistoryPoint point;  //!< Merged point
+                double sum;          //!< Sum of merged means
+                unsigned int num;    //!< Number of merged points
+            };
+
+        private:
+            std::atomic<uint64_t> counts[HISTORY_LEVELS];                                //!< Points published per level
+            std::atomic<uint64_t> claims[HISTORY_LEVELS];                                //!< Points claimed (being written) per level
+            std::atomic<uint64_t> words[HISTORY_LEVELS][HISTORY_SIZE][POINT_WORDS];      //!< Point rings
+            Pending pending[HISTORY_LEVELS];                                             //!< Points being merged per level
+        };
+
+        /**
+         * \brief Telemetry channel histories, sampled at a fixed period
+         *
+         * Memory is bounded by the number of channels, whatever the run time.
+         */
+        class HistoryStore
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param codes Channel codes (sample order)
+             * \param period_ms Sample period (ms)
+             */
+            HistoryStore(const std::vector<ChannelCode>& codes, unsigned int period_ms = DEFAULT_HISTORY_PERIOD_MS);
+
+            /**
+             * \brief Destructor
+             */
+            ~HistoryStore();
+
+            /**
+             * \brief Record channel values (single writer)
+             *
+             * Values are sampled if at least a sample period passed since the last sample.
+             *
+             * \param time_ms Time (ms)
+             * \param values Channel values (sample order)
+             * \param num Number of values
+             *
+             * \return True if values were sampled
+             */
+            bool record(uint64_t time_ms, const double *values, unsigned int num);
+
+            /**
+             * \brief Get sample due state
+             *
+             * \param time_ms Time (ms)
+             *
+             * \return True if a sample period passed since the last sample
+             */
+            bool is_due(uint64_t time_ms) const;
+
+            /**
+             * \brief Get sample period
+             *
+             * \return Sample period (ms)
+             */
+            unsigned int get_period() const;
+
+            /**
+             * \brief Get channel codes
+             *
+             * \return Channel codes (sample order)
+             */
+            const std::vector<ChannelCode>& get_codes() const;
+
+            /**
+             * \brief Find channel history
+             *
+             * \param code Channel code
+             *
+             * \return Channel history (null if channel is not recorded)
+             */
+            const ChannelHistory* find(ChannelCode code) const;
+
+            /**
+             * \brief Get lowest decimation level covering a time span
+             *
+             * \param span_ms Time span (ms)
+             *
+             * \return Decimation level (highest level if no level covers the span)
+             */
+            unsigned int get_level(uint64_t span_ms) const;
+
+        private:
+            HistoryStore(const HistoryStore&) = delete;
+            HistoryStore& operator=(const HistoryStore&) = delete;
+
+        private:
+            unsigned int period_ms;                                //!< Sample period (ms)
+            std::vector<ChannelCode> codes;                        //!< Channel codes (sample order)
+            std::vector<std::unique_ptr<ChannelHistory>> channels; //!< Channel histories (sample order)
+            bool sampled;                                          //!< Flag indicating a sample was recorded
+            uint64_t sample_ms;                                    //!< Time of last sample (ms)
+        };
+    }
+}
+
+#endif
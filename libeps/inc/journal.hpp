@@ -0,0 +1,260 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_JOURNAL_HPP
+#define ITC_EPS_JOURNAL_HPP
+
+#include "types.hpp"
+#include "state.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Journal event type
+         */
+        enum JournalEventType : uint8_t
+        {
+            JOURNAL_I2C_WRITE,          //!< I2C master write (replayed)
+            JOURNAL_SET_TIME,           //!< Simulation time advance (replayed)
+            JOURNAL_SET_TELEMETRY,      //!< Default telemetry value update (replayed)
+            JOURNAL_SET_SWITCH,         //!< PDM switch state update (replayed)
+            JOURNAL_SET_SWITCH_INITIAL, //!< PDM switch initial state update (replayed)
+            JOURNAL_LOAD_SAMPLE,        //!< Published load sample applied on next time advance (replayed)
+            JOURNAL_BUS_RESET,          //!< Bus reset enabled (informational)
+            JOURNAL_BUS_RELEASE         //!< Bus reset disabled (informational)
+        };
+
+        const std::size_t JOURNAL_I2C_SIZE = 8; //!< Maximum journaled I2C write size (longer writes are truncated)
+
+        /**
+         * \brief Journal event (fixed size)
+         */
+        struct JournalEvent
+        {
+            uint64_t seq;                   //!< Event sequence number
+            SimTime time_ms;                //!< Simulation time of event (ms)
+            JournalEventType type;          //!< Event type
+            uint8_t size;                   //!< I2C write size
+            uint8_t data[JOURNAL_I2C_SIZE]; //!< I2C write data
+            uint32_t num;                   //!< Channel code, switch number, or bus index (layout order)
+            double value;                   //!< Telemetry value, switch state, or load current (A)
+        };
+
+        /**
+         * \brief Journal config
+         */
+        struct JournalConfig
+        {
+            JournalConfig() : max_events(65536), max_keyframes(64), keyframe_interval_ms(10000), keyframe_events(0) {}
+            std::size_t max_events;        //!< Event ring capacity
+            std::size_t max_keyframes;     //!< Keyframe ring capacity
+            SimTime keyframe_interval_ms;  //!< Simulation time between keyframes (ms, 0 to disable)
+            std::size_t keyframe_events;   //!< Events between keyframes (0 for a quarter of the event ring)
+        };
+
+        /**
+         * \brief Journal keyframe
+         */
+        struct JournalKeyframe
+        {
+            uint64_t seq;    //!< Sequence number of first event after keyframe
+            SimTime time_ms; //!< Simulation time of keyframe (ms)
+            StateBlob state; //!< Simulator state
+        };
+
+        /**
+         * \brief Bounded simulator state journal
+         *
+         * Events are kept in a fixed size ring and simulator state keyframes in a second fixed
+         * size ring, so memory use is bounded by the config. The state at a past time is
+         * reconstructed by loading the latest keyframe before that time and replaying the events
+         * recorded after it. Keyframes whose following events have been overwritten are dropped.
+         */
+        class Journal
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param config Journal config
+             */
+            Journal(const JournalConfig& config = JournalConfig());
+
+            /**
+             * \brief Destructor
+             */
+            ~Journal();
+
+            /**
+             * \brief Get journal config
+             *
+             * \return Journal config
+             */
+            const JournalConfig& get_config() const;
+
+            /**
+             * \brief Record event
+             *
+             * \param type Event type
+             * \param time Simulation time (ms)
+             * \param num Channel code, switch number, or bus index
+             * \param value Telemetry value, switch state, or load current
+             */
+            void record(JournalEventType type, SimTime time, uint32_t num = 0, double value = 0.0);
+
+            /**
+             * \brief Record I2C master write event
+             *
+             * \param time Simulation time (ms)
+             * \param data I2C write data
+             */
+            void record(SimTime time, const I2CData& data);
+
+            /**
+             * \brief Get keyframe due state
+             *
+             * \param time Simulation time (ms)
+             *
+             * \return True if a keyframe should be added
+             */
+            bool is_keyframe_due(SimTime time) const;
+
+            /**
+             * \brief Add keyframe (replaces oldest keyframe if full)
+             *
+             * \param time Simulation time (ms)
+             *
+             * \return Keyframe state to fill
+             */
+            StateBlob& add_keyframe(SimTime time);
+
+            /**
+             * \brief Find latest keyframe at or before a time
+             *
+             * \param time Simulation time (ms)
+             *
+             * \return Keyframe (null if time is before oldest keyframe)
+             */
+            const JournalKeyframe* find_keyframe(SimTime time) const;
+
+            /**
+             * \brief Discard events and keyframes after a point
+             *
+             * \param seq Sequence number of first event to discard
+             * \param time Simulation time (ms), later keyframes are discarded
+             */
+            void truncate(uint64_t seq, SimTime time);
+
+            /**
+             * \brief Discard all events and keyframes
+             */
+            void clear();
+
+            /**
+             * \brief Get oldest retained event sequence number
+             *
+             * \return Oldest event sequence number
+             */
+            uint64_t get_first_seq() const;
+
+            /**
+             * \brief Get sequence number of next recorded event
+             *
+             * \return Next event sequence number
+             */
+            uint64_t get_next_seq() const;
+
+            /**
+             * \brief Get retained event
+             *
+             * \param seq Event sequence number (first to next - 1)
+             *
+             * \return Event
+             */
+            const JournalEvent& get_event(uint64_t seq) const;
+
+            /**
+             * \brief Get number of retained keyframes
+             *
+             * \return Number of keyframes
+             */
+            std::size_t get_num_keyframes() const;
+
+            /**
+             * \brief Get earliest reconstructable simulation time
+             *
+             * \param time Earliest time (ms)
+             *
+             * \return True if any keyframe is retained
+             */
+            bool get_begin_time(SimTime& time) const;
+
+            /**
+             * \brief Get approximate memory used by events and keyframes
+             *
+             * \return Memory use (bytes)
+             */
+            std::size_t get_memory_usage() const;
+
+        private:
+            /**
+             * \brief Append event slot (overwrites oldest event if full)
+             *
+             * \param type Event type
+             * \param time Simulation time (ms)
+             *
+             * \return Event to fill
+             */
+            JournalEvent& append(JournalEventType type, SimTime time);
+
+            /**
+             * \brief Get keyframe by age
+             *
+             * \param index Keyframe index (0 is oldest)
+             *
+             * \return Keyframe
+             */
+            JournalKeyframe& keyframe(std::size_t index);
+
+            /**
+             * \brief Get keyframe by age
+             *
+             * \param index Keyframe index (0 is oldest)
+             *
+             * \return Keyframe
+             */
+            const JournalKeyframe& keyframe(std::size_t index) const;
+
+        private:
+            JournalConfig config;                   //!< Journal config
+            std::vector<JournalEvent> events;       //!< Event ring
+            uint64_t first_seq;                     //!< Oldest retained event sequence number
+            uint64_t next_seq;                      //!< Next event sequence number
+            std::vector<JournalKeyframe> keyframes; //!< Keyframe ring (state buffers reused)
+            std::size_t keyframe_first;             //!< Oldest keyframe ring index
+            std::size_t keyframe_count;             //!< Number of retained keyframes
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,246 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_LAYOUT_HPP
+#define ITC_EPS_LAYOUT_HPP
+
+#include "adc.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Board layout power bus type
+         */
+        enum BusType
+        {
+            BUS_BCR, //!< Battery charge regulator (BCR) bus
+            BUS_PCM, //!< Power conditioning module (PCM) bus
+            BUS_PDM  //!< Power distribution module (PDM) switch bus
+        };
+
+        /**
+         * \brief Analog telemetry channel slot within a bus
+         */
+        enum ChannelSlot
+        {
+            SLOT_VOLTAGE,   //!< Bus voltage (BCR, PCM, PDM)
+            SLOT_CURRENT,   //!< Bus current (BCR side A, PCM, PDM)
+            SLOT_CURRENT_B, //!< BCR side B current
+            SLOT_TEMP,      //!< BCR side A temperature
+            SLOT_TEMP_B,    //!< BCR side B temperature
+            SLOT_SUN,       //!< BCR side A sun sensor
+            SLOT_SUN_B,     //!< BCR side B sun sensor
+            SLOT_MISC       //!< Board telemetry not connected to a bus
+        };
+
+        /**
+         * \brief Board layout bus
+         */
+        struct BusInfo
+        {
+            BusInfo(const std::string& name = "", BusType type = BUS_PDM, unsigned int units = 1) :
+                name(name), type(type), units(units) {}
+
+            std::string name;   //!< Bus name
+            BusType type;       //!< Bus type
+            unsigned int units; //!< Number of regulators on bus (BCR only)
+        };
+
+        /**
+         * \brief Board layout telemetry channel assignment
+         */
+        struct ChannelInfo
+        {
+            ChannelInfo(ChannelCode code = CHANNEL_INVALID, unsigned int bus = 0, ChannelSlot slot = SLOT_MISC,
+                        unsigned int unit = 0) :
+                code(code), bus(bus), slot(slot), unit(unit) {}
+
+            ChannelCode code;  //!< Telemetry channel code
+            unsigned int bus;  //!< Bus index (ignored for misc channels)
+            ChannelSlot slot;  //!< Channel slot within bus
+            unsigned int unit; //!< Regulator number within bus (BCR only)
+        };
+
+        /**
+         * \brief EPS board layout
+         *
+         * Describes the power bus graph, telemetry channel assignments, and command mappings
+         * (PDM switch numbers, PCM reset bits, and node reset bus) of an EPS board.
+         */
+        class BoardLayout
+        {
+        public:
+            typedef std::pair<unsigned int, unsigned int> Connection; //!< Parent/child bus connection
+
+            static const unsigned int NO_BUS = 0xffffffff; //!< Invalid bus index
+
+            /**
+             * \brief Constructor (empty layout)
+             */
+            BoardLayout();
+
+            /**
+             * \brief Destructor
+             */
+            ~BoardLayout();
+
+            /**
+             * \brief Get built-in Clyde Space 3rd generation 3U EPS layout
+             *
+             * \return Board layout
+             */
+            static const BoardLayout& clyde_3g();
+
+            /**
+             * \brief Add bus
+             *
+             * \param name Unique bus name
+             * \param type Bus type
+             * \param units Number of regulators on bus (BCR only)
+             *
+             * \return Bus index
+             */
+            unsigned int add_bus(const std::string& name, BusType type, unsigned int units = 1);
+
+            /**
+             * \brief Find bus by name
+             *
+             * \param name Bus name
+             *
+             * \return Bus index (NO_BUS if not found)
+             */
+            unsigned int find_bus(const std::string& name) const;
+
+            /**
+             * \brief Connect child bus as reset target of parent bus
+             *
+             * \param parent Parent bus index
+             * \param child Child bus index
+             */
+            void connect(unsigned int parent, unsigned int child);
+
+            /**
+             * \brief Assign telemetry channel
+             *
+             * \param code Telemetry channel code
+             * \param bus Bus index (ignored for misc channels)
+             * \param slot Channel slot within bus
+             * \param unit Regulator number within bus (BCR only)
+             */
+            void add_channel(ChannelCode code, unsigned int bus, ChannelSlot slot, unsigned int unit = 0);
+
+            /**
+             * \brief Map next power distribution module (PDM) switch number to bus
+             *
+             * \param bus PDM bus index
+             */
+            void add_switch(unsigned int bus);
+
+            /**
+             * \brief Map next power conditioning module (PCM) reset command bit to bus
+             *
+             * \param bus PCM bus index
+             */
+            void add_pcm_reset(unsigned int bus);
+
+            /**
+             * \brief Set bus reset by node reset and watchdog (also gates I2C communication)
+             *
+             * \param bus Bus index
+             */
+            void set_node_reset(unsigned int bus);
+
+            /**
+             * \brief Validate layout
+             *
+             * \param error Description of first problem found
+             *
+             * \return True if layout is valid
+             */
+            bool validate(std::string& error) const;
+
+            /**
+             * \brief Find telemetry channel assigned to bus slot
+             *
+             * \param bus Bus index
+             * \param slot Channel slot within bus
+             * \param unit Regulator number within bus (BCR only)
+             *
+             * \return Telemetry channel code (CHANNEL_INVALID if not assigned)
+             */
+            ChannelCode find_channel(unsigned int bus, ChannelSlot slot, unsigned int unit = 0) const;
+
+            /**
+             * \brief Get buses
+             *
+             * \return Buses by index
+             */
+            const std::vector<BusInfo>& get_buses() const;
+
+            /**
+             * \brief Get bus connections
+             *
+             * \return Parent/child bus connections
+             */
+            const std::vector<Connection>& get_connections() const;
+
+            /**
+             * \brief Get telemetry channel assignments
+             *
+             * \return Channel assignments
+             */
+            const std::vector<ChannelInfo>& get_channels() const;
+
+            /**
+             * \brief Get power distribution module (PDM) switch mapping
+             *
+             * \return Bus index per switch number
+             */
+            const std::vector<unsigned int>& get_switches() const;
+
+            /**
+             * \brief Get power conditioning module (PCM) reset mapping
+             *
+             * \return Bus index per reset command bit
+             */
+            const std::vector<unsigned int>& get_pcm_resets() const;
+
+            /**
+             * \brief Get node reset bus
+             *
+             * \return Node reset bus index
+             */
+            unsigned int get_node_reset() const;
+
+        private:
+            std::vector<BusInfo> buses;          //!< Buses by index
+            std::vector<Connection> connections; //!< Bus connections
+            std::vector<ChannelInfo> channels;   //!< Channel assignments
+            std::vector<unsigned int> switches;  //!< Bus per PDM switch number
+            std::vector<unsigned int> pcm_resets; //!< Bus per PCM reset command bit
+            unsigned int node_reset;             //!< Node reset bus
+        };
+    }
+}
+
+#endif
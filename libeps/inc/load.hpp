@@ -0,0 +1,220 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_LOAD_HPP
+#define ITC_EPS_LOAD_HPP
+
+#include "types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Power distribution module (PDM) switch load profile
+         *
+         * Provides the current drawn by the load connected to a switch.
+         */
+        class LoadProfile
+        {
+        public:
+            /**
+             * \brief Destructor
+             */
+            virtual ~LoadProfile() {}
+
+            /**
+             * \brief Get load current
+             *
+             * \param time Simulation time (ms)
+             *
+             * \return Load current (A)
+             */
+            virtual double get_current(SimTime time) = 0;
+
+            /**
+             * \brief Fork load profile for a forked simulator
+             *
+             * The fork must be safe to use from a different thread than this profile.
+             *
+             * \return Independent load profile (null if profile cannot be forked)
+             */
+            virtual std::shared_ptr<LoadProfile> fork() const {return std::shared_ptr<LoadProfile>();}
+        };
+
+        /**
+         * \brief Load profile played back from a file
+         *
+         * The file contains one "<time_ms> <current_A>" sample per line (comma or whitespace
+         * separated, '#' starts a comment) in increasing time order. The current is held at
+         * each sample value until the next sample time.
+         */
+        class FileLoadProfile : public LoadProfile
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param loop Flag indicating whether playback repeats after the last sample
+             */
+            FileLoadProfile(bool loop = false);
+
+            /**
+             * \brief Destructor
+             */
+            ~FileLoadProfile();
+
+            /**
+             * \brief Load profile samples from file
+             *
+             * \param filename Load profile file
+             *
+             * \return True if file was loaded successfully
+             */
+            bool load(const std::string& filename);
+
+            /**
+             * \brief Add load profile sample
+             *
+             * \param time Sample time (ms)
+             * \param current Load current (A)
+             */
+            void add_sample(SimTime time, double current);
+
+            /**
+             * \brief Get load current
+             *
+             * \param time Simulation time (ms)
+             *
+             * \return Load current (A)
+             */
+            double get_current(SimTime time);
+
+            /**
+             * \brief Fork load profile (shares samples, copies playback position)
+             *
+             * \return Independent load profile
+             */
+            std::shared_ptr<LoadProfile> fork() const;
+
+        private:
+            /**
+             * \brief Load profile samples
+             */
+            struct Samples
+            {
+                std::vector<SimTime> times;   //!< Sample times (ms)
+                std::vector<double> currents; //!< Sample currents (A)
+            };
+
+            /**
+             * \brief Get samples for modification (copied if shared with a fork)
+             *
+             * \return Samples
+             */
+            Samples& get_samples();
+
+        private:
+            bool loop;                        //!< Repeat playback flag
+            std::shared_ptr<Samples> samples; //!< Samples (shared by forks until modified)
+            std::size_t cursor;               //!< Index of last sample played
+        };
+
+        /**
+         * \brief Load current sample pushed by an external simulator
+         */
+        struct LoadSample
+        {
+            LoadSample(unsigned int num = 0, double current = 0) : num(num), current(current) {}
+
+            unsigned int num; //!< PDM switch number
+            double current;   //!< Load current (A)
+        };
+
+        typedef std::vector<LoadSample> LoadBatch; //!< Batch of load samples
+
+        const unsigned int MAX_PUBLISHED_LOADS = 1024; //!< Switch numbers accepted by the load publisher
+
+        /**
+         * \brief Thread safe load current publisher
+         *
+         * External simulators publish batches of load samples from any thread, the EPS drains
+         * them once per time step. Each publish and drain takes the lock once per batch. Only the
+         * latest sample per switch is kept, so pending samples are bounded while time is paused.
+         */
+        class LoadPublisher
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            LoadPublisher();
+
+            /**
+             * \brief Destructor
+             */
+            ~LoadPublisher();
+
+            /**
+             * \brief Publish load sample batch
+             *
+             * \param batch Load samples
+             */
+            void publish(const LoadBatch& batch);
+
+            /**
+             * \brief Publish single load sample
+             *
+             * \param num PDM switch number
+             * \param current Load current (A)
+             */
+            void publish(unsigned int num, double current);
+
+            /**
+             * \brief Take all pending load samples
+             *
+             * \param batch Pending load samples (latest per switch, in switch order)
+             *
+             * \return True if any samples were pending
+             */
+            bool drain(LoadBatch& batch);
+
+        private:
+            /**
+             * \brief Keep sample as the pending sample of its switch (lock held)
+             *
+             * \param sample Load sample
+             */
+            void add(const LoadSample& sample);
+
+        private:
+            std::mutex mutex;                  //!< Pending sample mutex
+            std::atomic<bool> dirty;           //!< Flag indicating samples are pending
+            std::vector<double> currents;      //!< Pending load current by switch number (A)
+            std::vector<uint64_t> pending;     //!< Switches with a pending sample (bit per switch number)
+        };
+    }
+}
+
+#endif
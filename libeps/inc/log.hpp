@@ -0,0 +1,533 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_LOG_HPP
+#define ITC_EPS_LOG_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// highest log level compiled in (0=off, 1=error, 2=warning, 3=info, 4=debug), higher levels compile away
+#ifndef EPS_LOG_MAX_LEVEL
+#define EPS_LOG_MAX_LEVEL 4
+#endif
+
+/**
+ * \brief Log record (compiled away above EPS_LOG_MAX_LEVEL, otherwise one branch if below the runtime level)
+ *
+ * Arguments are only evaluated if the level is enabled.
+ */
+#define EPS_LOG(level, ...) \
+    do \
+    { \
+        if(((level) <= EPS_LOG_MAX_LEVEL) && ::itc::eps::BinaryLog::get().is_enabled(level)) \
+        { \
+            static ::itc::eps::LogSite eps_log_site; \
+            ::itc::eps::BinaryLog::get().write(eps_log_site, level, __VA_ARGS__); \
+        } \
+    } while(0)
+
+#define EPS_LOG_ERROR(...)   EPS_LOG(::itc::eps::LEVEL_ERROR, __VA_ARGS__)   //!< Error log record
+#define EPS_LOG_WARNING(...) EPS_LOG(::itc::eps::LEVEL_WARNING, __VA_ARGS__) //!< Warning log record
+#define EPS_LOG_INFO(...)    EPS_LOG(::itc::eps::LEVEL_INFO, __VA_ARGS__)    //!< Info log record
+#define EPS_LOG_DEBUG(...)   EPS_LOG(::itc::eps::LEVEL_DEBUG, __VA_ARGS__)   //!< Debug log record
+
+namespace itc
+{
+    namespace eps
+    {
+        const unsigned int DEFAULT_LOG_ENTRIES = 4096;  //!< Default log ring size (entries, power of 2)
+        const unsigned int LOG_PAYLOAD_SIZE = 240;      //!< Encoded argument bytes per log entry
+        const uint32_t MAX_LOG_SITES = 1 << 16;         //!< Call site IDs accepted from binary log files (one per EPS_LOG statement)
+        const char LOG_FILE_MAGIC[8] = {'E', 'P', 'S', 'L', 'O', 'G', '1', '\0'}; //!< Binary log file magic
+
+        /**
+         * \brief Log level
+         */
+        enum LogLevel
+        {
+            LEVEL_OFF     = 0, //!< Nothing logged
+            LEVEL_ERROR   = 1, //!< Errors
+            LEVEL_WARNING = 2, //!< Warnings
+            LEVEL_INFO    = 3, //!< Information
+            LEVEL_DEBUG   = 4  //!< Debug
+        };
+
+        /**
+         * \brief Encoded argument type (tag byte before each argument)
+         */
+        enum LogArgType
+        {
+            LOG_ARG_INT    = 'i', //!< Signed integer (8 bytes)
+            LOG_ARG_UINT   = 'u', //!< Unsigned integer (8 bytes)
+            LOG_ARG_DOUBLE = 'f', //!< Floating point (8 bytes)
+            LOG_ARG_STRING = 's'  //!< String (length byte, then characters)
+        };
+
+        /**
+         * \brief Fixed size log entry (format is identified by call site)
+         */
+        struct LogEntry
+        {
+            uint64_t time_ns;                  //!< Wall clock time (ns since epoch)
+            uint32_t site;                     //!< Call site ID
+            uint16_t size;                     //!< Encoded argument bytes
+            uint8_t level;                     //!< Log level
+            uint8_t truncated;                 //!< Nonzero if arguments did not fit
+            uint8_t payload[LOG_PAYLOAD_SIZE]; //!< Encoded arguments
+        };
+
+        /**
+         * \brief Log call site (one static per EPS_LOG use, registered on its first record)
+         */
+        struct LogSite
+        {
+            LogSite() : id(0) {}
+            std::atomic<uint32_t> id; //!< Call site ID (0 until registered)
+        };
+
+        /**
+         * \brief Log argument encoder
+         */
+        class LogEncoder
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param entry Log entry to encode arguments into
+             */
+            LogEncoder(LogEntry& entry) : entry(entry) {entry.size = 0; entry.truncated = 0;}
+
+            /**
+             * \brief Add signed integer
+             *
+             * \param value Value
+             */
+            void add_int(int64_t value) {add(LOG_ARG_INT, &value, sizeof(value));}
+
+            /**
+             * \brief Add unsigned integer
+             *
+             * \param value Value
+             */
+            void add_uint(uint64_t value) {add(LOG_ARG_UINT, &value, sizeof(value));}
+
+            /**
+             * \brief Add floating point value
+             *
+             * \param value Value
+             */
+            void add_double(double value) {add(LOG_ARG_DOUBLE, &value, sizeof(value));}
+
+            /**
+             * \brief Add string (truncated to the remaining space)
+             *
+             * \param value String
+             * \param length String length
+             */
+            void add_string(const char *value, size_t length);
+
+        private:
+            /**
+             * \brief Add fixed size argument
+             *
+             * \param type Argument type
+             * \param value Argument value
+             * \param size Argument size
+             */
+            void add(LogArgType type, const void *value, size_t size);
+
+        private:
+            LogEntry& entry; //!< Log entry
+        };
+
+        /**
+         * \brief Encode signed integer or enum argument
+         */
+        template<typename T>
+        typename std::enable_if<(std::is_integral<T>::value && std::is_signed<T>::value) || std::is_enum<T>::value>::type
+        encode_arg(LogEncoder& encoder, T value)
+        {
+            encoder.add_int(static_cast<int64_t>(value));
+        }
+
+        /**
+         * \brief Encode unsigned integer argument
+         */
+        template<typename T>
+        typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+        encode_arg(LogEncoder& encoder, T value)
+        {
+            encoder.add_uint(static_cast<uint64_t>(value));
+        }
+
+        /**
+         * \brief Encode floating point argument
+         */
+        template<typename T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type
+        encode_arg(LogEncoder& encoder, T value)
+        {
+            encoder.add_double(static_cast<double>(value));
+        }
+
+        /**
+         * \brief Encode string argument
+         */
+        inline void encode_arg(LogEncoder& encoder, const char *value)
+        {
+            if(value == nullptr) value = "(null)";
+            encoder.add_string(value, std::strlen(value));
+        }
+
+        /**
+         * \brief Encode string argument
+         */
+        inline void encode_arg(LogEncoder& encoder, const std::string& value)
+        {
+            encoder.add_string(value.data(), value.size());
+        }
+
+        /**
+         * \brief Encode arguments (end of list)
+         */
+        inline void encode_args(LogEncoder&)
+        {
+        }
+
+        /**
+         * \brief Encode arguments
+         */
+        template<typename T, typename... Args>
+        void encode_args(LogEncoder& encoder, const T& value, const Args&... args)
+        {
+            encode_arg(encoder, value);
+            encode_args(encoder, args...);
+        }
+
+        /**
+         * \brief Bounded lock free multiple producer, single consumer log entry ring
+         *
+         * Producers claim a cell with one compare and swap, a full ring drops the entry
+         * rather than blocking the caller.
+         */
+        class LogRing
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param capacity Number of entries (rounded up to a power of 2)
+             */
+            LogRing(unsigned int capacity);
+
+            /**
+             * \brief Destructor
+             */
+            ~LogRing();
+
+            /**
+             * \brief Claim entry to fill (any thread)
+             *
+             * \param ticket Ticket to publish the entry with
+             *
+             * \return Entry, null if the ring is full
+             */
+            LogEntry *claim(uint64_t& ticket);
+
+            /**
+             * \brief Publish filled entry
+             *
+             * \param ticket Ticket returned by claim
+             */
+            void publish(uint64_t ticket);
+
+            /**
+             * \brief Pop oldest entry (consumer thread only)
+             *
+             * \param entry Popped entry
+             *
+             * \return False if ring is empty
+             */
+            bool pop(LogEntry& entry);
+
+        private:
+            LogRing(const LogRing&) = delete;
+            LogRing& operator=(const LogRing&) = delete;
+
+            /**
+             * \brief Get ring size for a capacity
+             *
+             * \param capacity Requested number of entries
+             *
+             * \return Ring size (power of 2, at least 2)
+             */
+            static uint64_t get_ring_size(unsigned int capacity);
+
+            /**
+             * \brief Ring cell
+             */
+            struct Cell
+            {
+                std::atomic<uint64_t> sequence; //!< Cell sequence (ticket + 1 when published)
+                LogEntry entry;                 //!< Entry
+            };
+
+        private:
+            const uint64_t mask;             //!< Index mask (capacity - 1)
+            std::unique_ptr<Cell[]> cells;   //!< Cells
+            std::atomic<uint64_t> enqueue;   //!< Next ticket to claim (producers)
+            uint64_t dequeue;                //!< Next ticket to pop (consumer)
+        };
+
+        class LogWriter;
+
+        /**
+         * \brief Process log (binary records, formatted off the calling thread)
+         *
+         * Without a running LogWriter records are formatted and logged immediately, as
+         * with ItcLogger directly.
+         */
+        class BinaryLog
+        {
+        public:
+            /**
+             * \brief Get process log
+             *
+             * \return Process log
+             */
+            static BinaryLog& get();
+
+            /**
+             * \brief Get runtime log level
+             *
+             * \return Log level
+             */
+            LogLevel get_level() const;
+
+            /**
+             * \brief Set runtime log level (default: debug, filtered by ItcLogger)
+             *
+             * \param level Log level
+             */
+            void set_level(LogLevel level);
+
+            /**
+             * \brief Get level state
+             *
+             * \param level Log level
+             *
+             * \return True if records of this level are logged
+             */
+            bool is_enabled(LogLevel level) const
+            {
+                return static_cast<int>(level) <= level_threshold.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * \brief Write log record
+             *
+             * \param site Call site
+             * \param level Log level
+             * \param format Printf format (static string)
+             * \param args Format arguments
+             */
+            template<typename... Args>
+            void write(LogSite& site, LogLevel level, const char *format, const Args&... args)
+            {
+                uint32_t id = site.id.load(std::memory_order_acquire);
+                if(id == 0) id = register_site(site, level, format);
+                uint64_t ticket = 0;
+                LogRing *queue = active.load(std::memory_order_acquire) ? ring.get() : nullptr;
+                LogEntry local;
+                LogEntry *entry = queue ? queue->claim(ticket) : &local;
+                if(entry == nullptr)
+                {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                entry->time_ns = get_time_ns();
+                entry->site = id;
+                entry->level = static_cast<uint8_t>(level);
+                LogEncoder encoder(*entry);
+                encode_args(encoder, args...);
+                if(queue) queue->publish(ticket);
+                else forward(*entry, format);
+            }
+
+            /**
+             * \brief Get call site format
+             *
+             * \param id Call site ID
+             * \param level Call site log level
+             *
+             * \return Printf format, null if the ID is not registered
+             */
+            const char *get_site(uint32_t id, LogLevel& level) const;
+
+            /**
+             * \brief Get number of records dropped because the ring was full
+             *
+             * \return Number of dropped records
+             */
+            uint64_t get_dropped() const;
+
+            /**
+             * \brief Log formatted record through ItcLogger
+             *
+             * \param entry Log entry
+             * \param format Printf format
+             */
+            static void forward(const LogEntry& entry, const char *format);
+
+            /**
+             * \brief Get wall clock time
+             *
+             * \return Time (ns since epoch)
+             */
+            static uint64_t get_time_ns();
+
+        private:
+            friend class LogWriter;
+
+            /**
+             * \brief Constructor
+             */
+            BinaryLog();
+
+            BinaryLog(const BinaryLog&) = delete;
+            BinaryLog& operator=(const BinaryLog&) = delete;
+
+            /**
+             * \brief Register call site
+             *
+             * \param site Call site
+             * \param level Log level
+             * \param format Printf format
+             *
+             * \return Call site ID
+             */
+            uint32_t register_site(LogSite& site, LogLevel level, const char *format);
+
+        private:
+            std::atomic<int> level_threshold; //!< Runtime log level
+            std::atomic<bool> active;         //!< Records queued for a log writer
+            std::unique_ptr<LogRing> ring;    //!< Queued records (kept once allocated)
+            std::atomic<uint64_t> dropped;    //!< Records dropped because the ring was full
+            mutable std::mutex site_mutex;    //!< Mutex for call sites
+            std::vector<std::pair<LogLevel, const char*>> sites; //!< Call site levels and formats (ID - 1)
+        };
+
+        /**
+         * \brief Background log writer (records are queued while it exists)
+         *
+         * Formats records through ItcLogger, or writes them to a binary log file that
+         * decode_log turns into text.
+         */
+        class LogWriter
+        {
+        public:
+            /**
+             * \brief Constructor (starts writer thread)
+             *
+             * \param binary_file Binary log file (empty to format through ItcLogger)
+             * \param capacity Log ring size (entries, only used by the first writer)
+             */
+            LogWriter(const std::string& binary_file = "", unsigned int capacity = DEFAULT_LOG_ENTRIES);
+
+            /**
+             * \brief Destructor (writes queued records and stops writer thread)
+             */
+            ~LogWriter();
+
+        private:
+            LogWriter(const LogWriter&) = delete;
+            LogWriter& operator=(const LogWriter&) = delete;
+
+            /**
+             * \brief Writer thread loop
+             */
+            void run();
+
+            /**
+             * \brief Write record
+             *
+             * \param entry Log entry
+             */
+            void write(const LogEntry& entry);
+
+        private:
+            BinaryLog& log;              //!< Process log
+            FILE *file;                  //!< Binary log file (null to format through ItcLogger)
+            std::vector<bool> written;   //!< Call sites written to the binary log file
+            uint64_t reported_dropped;   //!< Dropped records already reported
+            std::atomic<bool> running;   //!< Flag indicating thread should keep running
+            std::thread thread;          //!< Writer thread
+        };
+
+        /**
+         * \brief Get log level by name
+         *
+         * \param name Level name (off, error, warning, info or debug, any case)
+         *
+         * \return Log level (info if unknown)
+         */
+        LogLevel to_log_level(const std::string& name);
+
+        /**
+         * \brief Format log message
+         *
+         * \param format Printf format
+         * \param entry Log entry with encoded arguments
+         *
+         * \return Message
+         */
+        std::string format_log_message(const char *format, const LogEntry& entry);
+
+        /**
+         * \brief Format log line ("time [level] - message", as the simulator's text log)
+         *
+         * \param format Printf format
+         * \param entry Log entry with encoded arguments
+         *
+         * \return Line (without newline)
+         */
+        std::string format_log_line(const char *format, const LogEntry& entry);
+
+        /**
+         * \brief Decode binary log file to text lines
+         *
+         * \param filename Binary log file
+         * \param out Output
+         *
+         * \return True if the whole file was decoded
+         */
+        bool decode_log(const std::string& filename, FILE *out);
+    }
+}
+
+#endif
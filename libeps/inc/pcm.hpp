@@ -74,6 +74,22 @@ namespace itc
              */
             PcmData* get_data();
 
+            /**
+             * \brief Save bus state
+             *
+             * \param writer State writer
+             */
+            void save_state(StateWriter& writer) const;
+
+            /**
+             * \brief Load bus state
+             *
+             * \param reader State reader
+             *
+             * \return True if state was loaded
+             */
+            bool load_state(StateReader& reader);
+
         private:
             /**
              * \brief On reset state change
@@ -23,13 +23,16 @@
 #include "bus.hpp"
 #include "adc.hpp"
 #include "types.hpp"
+#include "load.hpp"
 #include <cstdint>
+#include <limits>
+#include <memory>
 
 namespace itc
 {
     namespace eps
     {
-        const int NUM_SWITCHES = 10; //!< Number of power distribution module (PDM) switches
+        const int NUM_SWITCHES = 10; //!< Number of power distribution module (PDM) switches (built-in layout)
 
         /**
          * \brief Power distribution module (PDM) bus data
@@ -42,6 +45,48 @@ namespace itc
             Channel current;     //!< Current
         };
 
+        /**
+         * \brief Power distribution module (PDM) switch state type
+         */
+        enum PdmStateType
+        {
+            PDM_STATE_ACTUAL,   //!< Actual switch state (includes overcurrent trips)
+            PDM_STATE_EXPECTED, //!< Expected (commanded) switch state
+            PDM_STATE_INITIAL   //!< Initial power on reset (POR) switch state
+        };
+
+        /**
+         * \brief Packed power distribution module (PDM) switch state words
+         *
+         * Each switch owns one bit in every word and keeps it current as its state changes.
+         */
+        struct PdmStateWords
+        {
+            PdmStateWords() : actual(0), expected(0), initial(0) {}
+
+            uint32_t actual;   //!< Actual switch states
+            uint32_t expected; //!< Expected (commanded) switch states
+            uint32_t initial;  //!< Initial power on reset (POR) switch states
+        };
+
+        /**
+         * \brief Power distribution module (PDM) switch overcurrent trip config
+         */
+        struct PdmTripConfig
+        {
+            PdmTripConfig() :
+                current_limit(std::numeric_limits<double>::infinity()),
+                trip_delay_ms(0),
+                retry_delay_ms(0),
+                max_retries(0)
+            {}
+
+            double current_limit;        //!< Overcurrent trip limit (A)
+            unsigned int trip_delay_ms;  //!< Time over current limit before switch trips (ms)
+            unsigned int retry_delay_ms; //!< Time before tripped switch is automatically re-enabled (ms)
+            unsigned int max_retries;    //!< Automatic retries before switch latches off (0 = latch on first trip)
+        };
+
         /**
          * \brief Power distribution module (PDM) bus
          */
@@ -86,6 +131,13 @@ namespace itc
              */
             bool get_state() const;
 
+            /**
+             * \brief Get expected (commanded) switch state
+             *
+             * \return Expected switch state, ignoring overcurrent trips
+             */
+            bool get_expected_state() const;
+
             /**
              * \brief Set switch state
              *
@@ -114,6 +166,55 @@ namespace itc
              */
             uint8_t get_timer_value() const;
 
+            /**
+             * \brief Get switch overcurrent trip state
+             *
+             * \return True if switch has been tripped off by overcurrent protection
+             */
+            bool is_tripped() const;
+
+            /**
+             * \brief Set switch overcurrent trip state
+             *
+             * Tripping a switch turns it off without changing the expected (commanded) state,
+             * clearing the trip restores the expected state.
+             *
+             * \param tripped Switch trip state
+             */
+            void set_tripped(bool tripped);
+
+            /**
+             * \brief Get switch load profile
+             *
+             * \return Switch load profile (null if none)
+             */
+            std::shared_ptr<LoadProfile> get_load() const;
+
+            /**
+             * \brief Set switch load profile
+             *
+             * When set, the switch current channel follows the load profile each time step.
+             *
+             * \param load Switch load profile (null to disable)
+             */
+            void set_load(std::shared_ptr<LoadProfile> load);
+
+            /**
+             * \brief Set packed switch state words to keep updated
+             *
+             * \param words Packed switch state words
+             * \param mask Switch bit in state words
+             */
+            void set_state_words(PdmStateWords *words, uint32_t mask);
+
+            /**
+             * \brief Set change tracker notified of switch state changes
+             *
+             * \param tracker Change tracker (null to disable)
+             * \param num Switch number reported in change events
+             */
+            void set_switch_tracker(ChangeTracker *tracker, unsigned int num);
+
             /**
              * \brief Get power distribution module (PDM) bus data
              *
@@ -121,6 +222,22 @@ namespace itc
              */
             PdmData* get_data();
 
+            /**
+             * \brief Save bus state (excluding load profile)
+             *
+             * \param writer State writer
+             */
+            void save_state(StateWriter& writer) const;
+
+            /**
+             * \brief Load bus state
+             *
+             * \param reader State reader
+             *
+             * \return True if state was loaded
+             */
+            bool load_state(StateReader& reader);
+
         private:
             /**
              * \brief Get state of switch
@@ -150,14 +267,41 @@ namespace itc
              */
             void on_reset(bool state);
 
+            /**
+             * \brief Update telemetry channel active state
+             */
+            void update_channels();
+
+            /**
+             * \brief Update switch bit in packed state words and notify switch changes
+             */
+            void update_state_words();
+
+            /**
+             * \brief Get packed switch state bits (actual, expected, and initial)
+             *
+             * \return Switch state bits
+             */
+            uint8_t get_state_bits() const;
+
         private:
             bool initial_state;  //!< Initial power on reset (POR) switch state
             bool state;          //!< Switch state
+            bool tripped;        //!< Switch overcurrent trip state
 
             uint8_t timer_limit; //!< Switch timer limit
             SimTime time_ms;     //!< Current simulation time (ms)
             SimTime start_ms;    //!< Switch timer start time (ms)
 
+            std::shared_ptr<LoadProfile> load; //!< Switch load profile
+
+            PdmStateWords *state_words; //!< Packed switch state words (null if none)
+            uint32_t state_mask;        //!< Switch bit in packed state words
+
+            ChangeTracker *switch_tracker; //!< Change tracker (null if not tracked)
+            unsigned int switch_num;       //!< Switch number reported in change events
+            uint8_t reported_bits;         //!< Switch state bits last reported to tracker
+
             PdmData data; //!< Power distribution module (PDM) bus data
         };
     }
@@ -0,0 +1,142 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_ROM_HPP
+#define ITC_EPS_ROM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        const uint16_t CRC16_INIT = 0xffff;              //!< CRC-16/CCITT-FALSE initial value
+        const uint16_t CRC16_POLY = 0x1021;              //!< CRC-16/CCITT-FALSE polynomial
+        const std::size_t ROM_FIRMWARE_SIZE = 32 * 1024; //!< Emulated firmware size (bytes)
+        const std::size_t ROM_CONFIG_SIZE = 64;          //!< EEPROM backed configuration block size (bytes)
+
+        /**
+         * \brief ROM configuration block layout (byte offsets, little endian)
+         */
+        enum RomConfigOffset
+        {
+            ROM_WDT_PERIOD   = 0,  //!< Watchdog timer period in minutes (2 bytes)
+            ROM_RESET_COUNTS = 2,  //!< Reset counters in EEPROM_RESET_TYPES order (4 bytes)
+            ROM_PDM_INITIAL  = 6,  //!< Switch initial states, bit per switch (32 bytes)
+            ROM_CONFIG_USED  = 38  //!< End of used configuration bytes (remainder is zero)
+        };
+
+        /**
+         * \brief Compute CRC-16/CCITT-FALSE (slicing-by-8)
+         *
+         * \param data Data to checksum
+         * \param size Data size (bytes)
+         * \param crc CRC of preceding data (or initial value)
+         *
+         * \return CRC of data
+         */
+        uint16_t crc16(const uint8_t *data, std::size_t size, uint16_t crc = CRC16_INIT);
+
+        /**
+         * \brief Advance CRC over zero bytes
+         *
+         * Equivalent to crc16() over size zero bytes, in O(log size).
+         *
+         * \param crc CRC of preceding data
+         * \param size Number of zero bytes
+         *
+         * \return CRC after zero bytes
+         */
+        uint16_t crc16_shift(uint16_t crc, std::size_t size);
+
+        /**
+         * \brief Emulated board ROM image (firmware followed by EEPROM backed configuration)
+         *
+         * The checksum covers the whole image. It is computed once when the firmware is set and
+         * updated from the changed bytes when the configuration block is written, so reading it
+         * is free. The firmware is immutable and shared between copies.
+         */
+        class RomImage
+        {
+        public:
+            /**
+             * \brief Constructor (empty firmware, zero configuration)
+             */
+            RomImage();
+
+            /**
+             * \brief Destructor
+             */
+            ~RomImage();
+
+            /**
+             * \brief Generate firmware contents and recompute checksum
+             *
+             * Does nothing if the firmware for this version and board is already set.
+             *
+             * \param version Firmware version word
+             * \param board Board number (0 motherboard, 1 daughterboard)
+             */
+            void set_firmware(uint16_t version, uint8_t board);
+
+            /**
+             * \brief Write configuration bytes and update checksum
+             *
+             * \param offset Offset in configuration block
+             * \param data Data to write
+             * \param size Data size (bytes)
+             */
+            void write(std::size_t offset, const uint8_t *data, std::size_t size);
+
+            /**
+             * \brief Get image checksum
+             *
+             * \return CRC-16 of firmware and configuration block
+             */
+            uint16_t get_checksum() const;
+
+            /**
+             * \brief Get firmware contents
+             *
+             * \return Firmware contents
+             */
+            const std::vector<uint8_t>& get_firmware() const;
+
+            /**
+             * \brief Get configuration block
+             *
+             * \return Configuration block
+             */
+            const std::array<uint8_t, ROM_CONFIG_SIZE>& get_config() const;
+
+        private:
+            std::shared_ptr<const std::vector<uint8_t>> firmware; //!< Firmware contents (shared)
+            uint16_t firmware_version;                            //!< Firmware version word
+            uint8_t firmware_board;                               //!< Firmware board number
+            uint16_t firmware_crc;                                //!< CRC of firmware contents
+            std::array<uint8_t, ROM_CONFIG_SIZE> config;          //!< EEPROM backed configuration block
+            uint16_t checksum;                                    //!< CRC of complete image
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,271 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_SHM_HPP
+#define ITC_EPS_SHM_HPP
+
+#include "frame.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace itc
+{
+    namespace eps
+    {
+        const uint32_t SHM_MAGIC = 0x4d535045;     //!< Shared memory segment magic ("EPSM")
+        const uint32_t SHM_VERSION = 2;            //!< Shared memory segment format version
+        const unsigned int EDIT_RING_SIZE = 256;   //!< Edit commands queued in shared memory
+
+        /**
+         * \brief Edit command type
+         */
+        enum EditType : uint32_t
+        {
+            EDIT_TELEMETRY = 1, //!< Set channel analog value (num is channel code)
+            EDIT_SWITCH    = 2  //!< Set switch state (num is switch number, value non zero for on)
+        };
+
+        /**
+         * \brief Edit command sent by a viewer
+         */
+        struct EditCommand
+        {
+            EditCommand(EditType type = EDIT_TELEMETRY, uint32_t num = 0, double value = 0) :
+                type(type), num(num), value(value) {}
+
+            uint32_t type; //!< Edit type (EditType)
+            uint32_t num;  //!< Channel code or switch number
+            double value;  //!< Analog value or switch state
+        };
+
+        /**
+         * \brief Bounded lock free multiple producer, single consumer edit command ring
+         *
+         * Lives in shared memory, so it only uses address free atomics.
+         */
+        class EditRing
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            EditRing();
+
+            /**
+             * \brief Push edit command (any process)
+             *
+             * \param command Edit command
+             *
+             * \return False if ring is full
+             */
+            bool push(const EditCommand& command);
+
+            /**
+             * \brief Pop oldest edit command (single consumer)
+             *
+             * \param command Edit command
+             *
+             * \return False if ring is empty
+             */
+            bool pop(EditCommand& command);
+
+        private:
+            EditRing(const EditRing&) = delete;
+            EditRing& operator=(const EditRing&) = delete;
+
+            /**
+             * \brief Ring slot
+             */
+            struct Slot
+            {
+                std::atomic<uint64_t> sequence; //!< Slot sequence (position when free, position + 1 when full)
+                EditCommand command;            //!< Edit command
+            };
+
+        private:
+            std::atomic<uint64_t> head; //!< Next push position (producers)
+            std::atomic<uint64_t> tail; //!< Next pop position (consumer)
+            Slot slots[EDIT_RING_SIZE]; //!< Ring slots
+        };
+
+        /**
+         * \brief Shared memory state segment (one per board)
+         */
+        struct ShmSegment
+        {
+            std::atomic<uint32_t> magic; //!< Segment magic (written last when created)
+            uint32_t version;            //!< Segment format version
+            uint32_t size;               //!< Segment size (bytes)
+            uint32_t pid;                //!< Simulator process id
+            uint32_t address;            //!< Board I2C address
+            uint32_t reserved;           //!< Reserved (zero)
+            FramePublisher frames;       //!< Published state frames
+            EditRing edits;              //!< Edit commands from viewers
+        };
+
+        /**
+         * \brief Get default shared memory segment name for a board
+         *
+         * \param address Board I2C address
+         *
+         * \return Segment name
+         */
+        std::string get_shm_name(uint8_t address);
+
+        /**
+         * \brief Shared memory segment owner (simulator side)
+         */
+        class ShmServer
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            ShmServer();
+
+            /**
+             * \brief Destructor (removes segment)
+             */
+            ~ShmServer();
+
+            /**
+             * \brief Create (or replace) shared memory segment
+             *
+             * \param name Segment name
+             * \param address Board I2C address
+             *
+             * \return True if segment was created
+             */
+            bool create(const std::string& name, uint8_t address);
+
+            /**
+             * \brief Unmap and remove segment
+             */
+            void close();
+
+            /**
+             * \brief Get open state
+             *
+             * \return True if segment is mapped
+             */
+            bool is_open() const;
+
+            /**
+             * \brief Get state frame publisher in segment
+             *
+             * \return State frame publisher (must be open)
+             */
+            FramePublisher& get_frames();
+
+            /**
+             * \brief Take next edit command from viewers
+             *
+             * \param command Edit command
+             *
+             * \return False if no edit is pending
+             */
+            bool poll(EditCommand& command);
+
+        private:
+            ShmServer(const ShmServer&) = delete;
+            ShmServer& operator=(const ShmServer&) = delete;
+
+        private:
+            std::string name;     //!< Segment name
+            ShmSegment *segment;  //!< Mapped segment (null if closed)
+        };
+
+        /**
+         * \brief Shared memory segment viewer (client side)
+         */
+        class ShmClient
+        {
+        public:
+            /**
+             * \brief Constructor
+             */
+            ShmClient();
+
+            /**
+             * \brief Destructor
+             */
+            ~ShmClient();
+
+            /**
+             * \brief Attach to simulator segment
+             *
+             * \param name Segment name
+             *
+             * \return True if segment was attached
+             */
+            bool open(const std::string& name);
+
+            /**
+             * \brief Detach from segment
+             */
+            void close();
+
+            /**
+             * \brief Get open state
+             *
+             * \return True if segment is attached
+             */
+            bool is_open() const;
+
+            /**
+             * \brief Get simulator process state
+             *
+             * \return True if the simulator process is running
+             */
+            bool is_alive() const;
+
+            /**
+             * \brief Get board I2C address
+             *
+             * \return Board I2C address
+             */
+            uint8_t get_address() const;
+
+            /**
+             * \brief Get state frame publisher in segment
+             *
+             * \return State frame publisher (must be open)
+             */
+            const FramePublisher& get_frames() const;
+
+            /**
+             * \brief Send edit command to simulator
+             *
+             * \param command Edit command
+             *
+             * \return False if not attached or edit ring is full
+             */
+            bool send(const EditCommand& command);
+
+        private:
+            ShmClient(const ShmClient&) = delete;
+            ShmClient& operator=(const ShmClient&) = delete;
+
+        private:
+            ShmSegment *segment; //!< Mapped segment (null if closed)
+        };
+    }
+}
+
+#endif
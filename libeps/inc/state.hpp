@@ -0,0 +1,195 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_STATE_HPP
+#define ITC_EPS_STATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        typedef std::vector<uint8_t> StateBlob; //!< Serialized simulator state type
+
+        /**
+         * \brief Binary state writer
+         *
+         * Values are appended in host byte order, so blobs are only portable between hosts with
+         * the same byte order.
+         */
+        class StateWriter
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param blob State blob to append to
+             */
+            StateWriter(StateBlob& blob);
+
+            /**
+             * \brief Destructor
+             */
+            ~StateWriter();
+
+            /**
+             * \brief Write value
+             *
+             * \param value Trivially copyable value
+             */
+            template<typename T>
+            void write(const T& value);
+
+            /**
+             * \brief Write array of values
+             *
+             * \param values Trivially copyable values
+             */
+            template<typename T>
+            void write(const std::vector<T>& values);
+
+        private:
+            StateBlob& blob; //!< State blob
+        };
+
+        /**
+         * \brief Binary state reader
+         *
+         * Reads fail (and all subsequent reads fail) once the end of the blob is reached.
+         */
+        class StateReader
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param blob State blob to read from
+             */
+            StateReader(const StateBlob& blob);
+
+            /**
+             * \brief Constructor (state in memory not owned by a blob, e.g. a mapped file)
+             *
+             * \param data State bytes to read from (not copied)
+             * \param size Number of state bytes
+             */
+            StateReader(const uint8_t *data, size_t size);
+
+            /**
+             * \brief Destructor
+             */
+            ~StateReader();
+
+            /**
+             * \brief Read value
+             *
+             * \param value Trivially copyable value
+             *
+             * \return True if value was read
+             */
+            template<typename T>
+            bool read(T& value);
+
+            /**
+             * \brief Read array of values
+             *
+             * \param values Trivially copyable values
+             *
+             * \return True if values were read
+             */
+            template<typename T>
+            bool read(std::vector<T>& values);
+
+            /**
+             * \brief Get reader state
+             *
+             * \return True if no read has failed
+             */
+            bool is_valid() const;
+
+            /**
+             * \brief Get end of blob state
+             *
+             * \return True if all bytes have been read
+             */
+            bool is_done() const;
+
+        private:
+            /**
+             * \brief Read raw bytes
+             *
+             * \param dest Destination
+             * \param count Number of bytes
+             *
+             * \return True if bytes were read
+             */
+            bool read_raw(void *dest, size_t count);
+
+        private:
+            const uint8_t *data; //!< State bytes
+            size_t size;         //!< Number of state bytes
+            size_t offset;       //!< Read offset
+            bool valid;          //!< Flag indicating no read has failed
+        };
+
+        template<typename T>
+        void StateWriter::write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "state values must be trivially copyable");
+            const uint8_t *raw = reinterpret_cast<const uint8_t*>(&value);
+            blob.insert(blob.end(), raw, raw + sizeof(value));
+        }
+
+        template<typename T>
+        void StateWriter::write(const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "state values must be trivially copyable");
+            write(static_cast<uint32_t>(values.size()));
+            const uint8_t *raw = reinterpret_cast<const uint8_t*>(values.data());
+            blob.insert(blob.end(), raw, raw + values.size() * sizeof(T));
+        }
+
+        template<typename T>
+        bool StateReader::read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "state values must be trivially copyable");
+            return read_raw(&value, sizeof(value));
+        }
+
+        template<typename T>
+        bool StateReader::read(std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "state values must be trivially copyable");
+            uint32_t count = 0;
+            if(!read(count) || (count > (size - offset) / sizeof(T)))
+            {
+                valid = false;
+                return false;
+            }
+            values.resize(count);
+            return read_raw(values.data(), count * sizeof(T));
+        }
+    }
+}
+
+#endif
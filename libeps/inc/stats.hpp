@@ -0,0 +1,329 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_STATS_HPP
+#define ITC_EPS_STATS_HPP
+
+#include "command.hpp"
+#include "status.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace itc
+{
+    namespace eps
+    {
+        const unsigned int LATENCY_SUB_BITS = 5;                         //!< Latency histogram sub bucket bits (1/32 relative precision)
+        const unsigned int LATENCY_SUB_BUCKETS = 1u << LATENCY_SUB_BITS; //!< Latency histogram sub buckets per power of two
+        const unsigned int LATENCY_MAX_BITS = 36;                        //!< Latency histogram value bits (ns, larger values are clamped)
+        const unsigned int LATENCY_BUCKETS =
+            (LATENCY_MAX_BITS - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS; //!< Latency histogram buckets
+
+        /**
+         * \brief Lock free latency histogram (HDR style, log linear buckets)
+         *
+         * Values below 2 * LATENCY_SUB_BUCKETS ns are counted exactly, larger values in buckets
+         * of 1/LATENCY_SUB_BUCKETS relative width, so the recorded value is known to about 3%
+         * from 1 ns to about a minute. Recording is a few relaxed atomic adds, it never
+         * allocates or locks and may be called from several threads.
+         */
+        class LatencyHistogram
+        {
+        public:
+            /**
+             * \brief Constructor (empty histogram)
+             */
+            LatencyHistogram();
+
+            /**
+             * \brief Destructor
+             */
+            ~LatencyHistogram();
+
+            /**
+             * \brief Record latency
+             *
+             * \param ns Latency (ns)
+             */
+            void record(uint64_t ns);
+
+            /**
+             * \brief Get number of recorded latencies
+             *
+             * \return Number of recorded latencies
+             */
+            uint64_t get_count() const;
+
+            /**
+             * \brief Get minimum recorded latency
+             *
+             * \return Minimum latency (ns, 0 if none recorded)
+             */
+            uint64_t get_min() const;
+
+            /**
+             * \brief Get maximum recorded latency
+             *
+             * \return Maximum latency (ns, 0 if none recorded)
+             */
+            uint64_t get_max() const;
+
+            /**
+             * \brief Get mean recorded latency
+             *
+             * \return Mean latency (ns, 0 if none recorded)
+             */
+            double get_mean() const;
+
+            /**
+             * \brief Get latency percentile
+             *
+             * \param percent Percentile (0 to 100)
+             *
+             * \return Highest latency of the bucket holding the percentile, at most the maximum
+             *         (ns, 0 if none recorded)
+             */
+            uint64_t get_percentile(double percent) const;
+
+            /**
+             * \brief Get number of latencies recorded in a bucket
+             *
+             * \param bucket Bucket index
+             *
+             * \return Number of latencies recorded in bucket
+             */
+            uint64_t get_bucket_count(unsigned int bucket) const;
+
+            /**
+             * \brief Get bucket of a latency
+             *
+             * \param ns Latency (ns)
+             *
+             * \return Bucket index
+             */
+            static unsigned int get_bucket(uint64_t ns);
+
+            /**
+             * \brief Get lowest latency of a bucket
+             *
+             * \param bucket Bucket index
+             *
+             * \return Lowest latency counted in bucket (ns)
+             */
+            static uint64_t get_lowest(unsigned int bucket);
+
+            /**
+             * \brief Get highest latency of a bucket
+             *
+             * \param bucket Bucket index
+             *
+             * \return Highest latency counted in bucket (ns)
+             */
+            static uint64_t get_highest(unsigned int bucket);
+
+        private:
+            LatencyHistogram(const LatencyHistogram&) = delete;
+            LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        private:
+            std::atomic<uint64_t> buckets[LATENCY_BUCKETS]; //!< Latencies recorded per bucket
+            std::atomic<uint64_t> count;                    //!< Number of recorded latencies
+            std::atomic<uint64_t> sum;                      //!< Sum of recorded latencies (ns)
+            std::atomic<uint64_t> min;                      //!< Minimum recorded latency (ns)
+            std::atomic<uint64_t> max;                      //!< Maximum recorded latency (ns)
+        };
+
+        /**
+         * \brief Counted EPS events
+         */
+        enum EpsEvent
+        {
+            EVENT_WDT_RESET = 0, //!< Watchdog timer reset
+            EVENT_BUS_RESET,     //!< Bus reset (any cause)
+            EVENT_PDM_TRIP,      //!< PDM switch overcurrent trip
+            NUM_EPS_EVENTS       //!< Number of counted events
+        };
+
+        /**
+         * \brief Lock free per command counters and latency histograms
+         *
+         * The EPS counts commands, error responses by error code, and bytes per command type.
+         * The simulator host records transaction latency (NOS request to response ready).
+         * Memory is fixed at construction, recording never allocates, and readers on other
+         * threads read the statistics without locking the EPS. Unknown command numbers are
+         * counted together. Watchdog resets, bus resets and PDM trips are counted as events.
+         */
+        class CommandStats
+        {
+        public:
+            /**
+             * \brief Constructor (no commands recorded)
+             */
+            CommandStats();
+
+            /**
+             * \brief Destructor
+             */
+            ~CommandStats();
+
+            /**
+             * \brief Record command
+             *
+             * \param command Command number
+             * \param bytes_in Command bytes received
+             * \param bytes_out Response bytes
+             * \param error Command error (ERROR_NONE if valid)
+             */
+            void record_command(uint8_t command, size_t bytes_in, size_t bytes_out, ErrorCode error);
+
+            /**
+             * \brief Record command transaction latency
+             *
+             * \param command Command number
+             * \param ns Latency (ns)
+             */
+            void record_latency(uint8_t command, uint64_t ns);
+
+            /**
+             * \brief Record event
+             *
+             * \param event Event
+             */
+            void record_event(EpsEvent event);
+
+            /**
+             * \brief Get number of commands
+             *
+             * \param command Command number
+             *
+             * \return Number of commands received (all unknown commands if unknown)
+             */
+            uint64_t get_count(uint8_t command) const;
+
+            /**
+             * \brief Get number of command errors
+             *
+             * \param command Command number
+             * \param error Error code (ERROR_NONE for valid commands)
+             *
+             * \return Number of commands with error
+             */
+            uint64_t get_errors(uint8_t command, ErrorCode error) const;
+
+            /**
+             * \brief Get number of commands of all types
+             *
+             * \return Number of commands received
+             */
+            uint64_t get_total_count() const;
+
+            /**
+             * \brief Get number of command errors of all types
+             *
+             * \param error Error code (ERROR_NONE for valid commands)
+             *
+             * \return Number of commands with error
+             */
+            uint64_t get_total_errors(ErrorCode error) const;
+
+            /**
+             * \brief Get number of commands of all types answered with any error
+             *
+             * \return Number of commands with an error other than ERROR_NONE
+             */
+            uint64_t get_total_failures() const;
+
+            /**
+             * \brief Get number of events
+             *
+             * \param event Event
+             *
+             * \return Number of events
+             */
+            uint64_t get_events(EpsEvent event) const;
+
+            /**
+             * \brief Get command bytes received
+             *
+             * \param command Command number
+             *
+             * \return Command bytes received
+             */
+            uint64_t get_bytes_in(uint8_t command) const;
+
+            /**
+             * \brief Get response bytes
+             *
+             * \param command Command number
+             *
+             * \return Response bytes
+             */
+            uint64_t get_bytes_out(uint8_t command) const;
+
+            /**
+             * \brief Get command latency histogram
+             *
+             * \param command Command number
+             *
+             * \return Latency histogram
+             */
+            const LatencyHistogram& get_latency(uint8_t command) const;
+
+            /**
+             * \brief Get text report (one line per command received, latencies in us)
+             *
+             * \return Report
+             */
+            std::string get_report() const;
+
+        private:
+            CommandStats(const CommandStats&) = delete;
+            CommandStats& operator=(const CommandStats&) = delete;
+
+            /**
+             * \brief Command type statistics
+             */
+            struct Counters
+            {
+                std::atomic<uint64_t> count;                   //!< Commands received
+                std::atomic<uint64_t> errors[NUM_ERROR_CODES]; //!< Commands by error code (ERROR_CODES order)
+                std::atomic<uint64_t> bytes_in;                //!< Command bytes received
+                std::atomic<uint64_t> bytes_out;               //!< Response bytes
+                LatencyHistogram latency;                      //!< Transaction latency
+            };
+
+            /**
+             * \brief Get error code index
+             *
+             * \param error Error code
+             *
+             * \return Index in ERROR_CODES (ERROR_NONE index if unknown)
+             */
+            static unsigned int get_error_index(ErrorCode error);
+
+        private:
+            uint8_t slots[256];                   //!< Counters index by command number (unknown commands last)
+            Counters counters[NUM_CMD_TYPES + 1]; //!< Counters in CMD_TYPES order, then unknown commands
+            std::atomic<uint64_t> events[NUM_EPS_EVENTS]; //!< Events by EpsEvent
+        };
+    }
+}
+
+#endif
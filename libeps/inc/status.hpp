@@ -20,6 +20,7 @@
 #ifndef ITC_EPS_STATUS_HPP
 #define ITC_EPS_STATUS_HPP
 
+#include "state.hpp"
 #include <cstdint>
 #include <bitset>
 #include <map>
@@ -28,7 +29,7 @@ namespace itc
 {
     namespace eps
     {
-        const uint16_t CHECKSUM = 0xdead; //!< Default checksum value
+        const uint16_t CHECKSUM = 0xdead; //!< Default checksum value (board without ROM image)
 
         /**
          * \brief Board status bits
@@ -73,6 +74,15 @@ namespace itc
             ERROR_INTERNAL_SPI     = 0x30
         };
 
+        /**
+         * \brief EPS error codes (code order)
+         */
+        const ErrorCode ERROR_CODES[] = {
+            ERROR_NONE, ERROR_INVALID_CMD, ERROR_INVALID_DATA, ERROR_INVALID_CHANNEL, ERROR_INACTIVE_CHANNEL,
+            ERROR_INVALID_CRC, ERROR_RESET, ERROR_ADC, ERROR_EEPROM_READ, ERROR_INTERNAL_SPI
+        };
+        const unsigned int NUM_ERROR_CODES = sizeof(ERROR_CODES) / sizeof(ERROR_CODES[0]); //!< Number of EPS error codes
+
         /**
          * \brief EPS board status
          */
@@ -103,6 +113,13 @@ namespace itc
              */
             uint16_t get_checksum() const;
 
+            /**
+             * \brief Set board checksum
+             *
+             * \param checksum Board checksum
+             */
+            void set_checksum(uint16_t checksum);
+
             /**
              * \brief Get raw board status data
              *
@@ -174,6 +191,14 @@ namespace itc
              */
             uint8_t get_num_resets(ResetType type) const;
 
+            /**
+             * \brief Set total number of system resets
+             *
+             * \param type Reset type
+             * \param num Total number of system resets
+             */
+            void set_num_resets(ResetType type, uint8_t num);
+
             /**
              * \brief Get last error code
              *
@@ -181,6 +206,22 @@ namespace itc
              */
             ErrorCode get_last_error() const;
 
+            /**
+             * \brief Save status state
+             *
+             * \param writer State writer
+             */
+            void save_state(StateWriter& writer) const;
+
+            /**
+             * \brief Load status state
+             *
+             * \param reader State reader
+             *
+             * \return True if state was loaded
+             */
+            bool load_state(StateReader& reader);
+
         private:
             typedef std::map<ResetType, uint8_t> ResetCount;
 
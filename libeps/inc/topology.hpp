@@ -0,0 +1,259 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_TOPOLOGY_HPP
+#define ITC_EPS_TOPOLOGY_HPP
+
+#include "bus.hpp"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        /**
+         * \brief Compiled power bus topology
+         *
+         * Buses are assigned indices in the order they are added. Connections are compiled into
+         * compressed sparse row (CSR) child and parent adjacency arrays with a topological rank
+         * per bus, and reset state is kept in packed bit words. Reset propagation only visits the
+         * affected subgraph, and only buses whose effective reset state changes are notified.
+         * Compiled adjacency is immutable and shared between topologies forked from each other.
+         */
+        class BusTopology
+        {
+        public:
+            typedef uint64_t Mask; //!< Reset state word type (bit per bus index)
+
+            static const unsigned int INVALID_INDEX = 0xffffffff; //!< Invalid bus index
+
+            /**
+             * \brief Constructor
+             */
+            BusTopology();
+
+            /**
+             * \brief Destructor
+             */
+            ~BusTopology();
+
+            /**
+             * \brief Add bus to topology
+             *
+             * \param bus Bus to add
+             *
+             * \return Bus index
+             */
+            unsigned int add(Bus& bus);
+
+            /**
+             * \brief Connect child bus as reset target of parent bus
+             *
+             * Connections are compiled on the next reset or adjacency query.
+             *
+             * \param parent Parent bus index
+             * \param child Child bus index
+             */
+            void connect(unsigned int parent, unsigned int child);
+
+            /**
+             * \brief Get number of buses
+             *
+             * \return Number of buses
+             */
+            unsigned int size() const;
+
+            /**
+             * \brief Get bus reset state
+             *
+             * \param index Bus index
+             *
+             * \return True if bus is in reset state
+             */
+            bool is_reset(unsigned int index) const;
+
+            /**
+             * \brief Get reset state words
+             *
+             * \return Effective reset state of all buses (bit per bus index)
+             */
+            const std::vector<Mask>& get_reset_state() const;
+
+            /**
+             * \brief Set bus reset state
+             *
+             * Resetting a bus resets all of its descendants. Releasing a bus has no effect while
+             * any ancestor is in reset, otherwise it releases the bus and all of its descendants.
+             *
+             * \param index Bus index
+             * \param state Reset state
+             */
+            void reset(unsigned int index, bool state);
+
+            /**
+             * \brief Get bus children
+             *
+             * \param index Bus index
+             *
+             * \return Direct child bus indices
+             */
+            std::vector<unsigned int> get_children(unsigned int index) const;
+
+            /**
+             * \brief Get bus parents
+             *
+             * \param index Bus index
+             *
+             * \return Direct parent bus indices
+             */
+            std::vector<unsigned int> get_parents(unsigned int index) const;
+
+            /**
+             * \brief Get bus descendants
+             *
+             * \param index Bus index
+             *
+             * \return Descendant bus indices in ascending order (excluding bus)
+             */
+            std::vector<unsigned int> get_descendants(unsigned int index) const;
+
+            /**
+             * \brief Get bus topological rank
+             *
+             * \param index Bus index
+             *
+             * \return Rank (parents always rank lower than children)
+             */
+            unsigned int get_rank(unsigned int index) const;
+
+            /**
+             * \brief Save reset state
+             *
+             * \param writer State writer
+             */
+            void save_state(StateWriter& writer) const;
+
+            /**
+             * \brief Load reset state
+             *
+             * Buses whose effective reset state changes are notified.
+             *
+             * \param reader State reader
+             *
+             * \return True if state was loaded (topology must have the same number of buses)
+             */
+            bool load_state(StateReader& reader);
+
+            /**
+             * \brief Share compiled connections and copy reset state of another topology
+             *
+             * Used when forking a simulator. Both topologies must have the same number of buses,
+             * whose reset states already match (buses are not notified).
+             *
+             * \param topology Topology to share
+             *
+             * \return True if topology was shared
+             */
+            bool share(const BusTopology& topology);
+
+        private:
+            /**
+             * \brief Compile CSR adjacency and ranks from connections (if changed)
+             *
+             * \return True if adjacency was recompiled
+             */
+            bool compile() const;
+
+            /**
+             * \brief Recompute effective reset state of all buses in topological order
+             */
+            void resync();
+
+            /**
+             * \brief Collect bus and its descendants into subgraph scratch list
+             *
+             * \param index Bus index
+             */
+            void collect_subgraph(unsigned int index) const;
+
+            /**
+             * \brief Get reset state bit
+             *
+             * \param words Reset state words
+             * \param index Bus index
+             *
+             * \return Bit value
+             */
+            static bool get_bit(const std::vector<Mask>& words, unsigned int index);
+
+            /**
+             * \brief Set reset state bit
+             *
+             * \param words Reset state words
+             * \param index Bus index
+             * \param value Bit value
+             */
+            static void set_bit(std::vector<Mask>& words, unsigned int index, bool value);
+
+            /**
+             * \brief Set effective reset state of bus and notify if changed
+             *
+             * \param index Bus index
+             * \param state Effective reset state
+             */
+            void set_effective(unsigned int index, bool state);
+
+        private:
+            typedef std::pair<unsigned int, unsigned int> Connection; //!< Parent/child connection
+
+            /**
+             * \brief Compiled adjacency
+             */
+            struct Adjacency
+            {
+                Adjacency() : child_offsets(1, 0), child_targets(), parent_offsets(1, 0),
+                              parent_targets(), order(), rank() {}
+
+                std::vector<unsigned int> child_offsets;  //!< CSR child row offsets (size + 1)
+                std::vector<unsigned int> child_targets;  //!< CSR child bus indices
+                std::vector<unsigned int> parent_offsets; //!< CSR parent row offsets (size + 1)
+                std::vector<unsigned int> parent_targets; //!< CSR parent bus indices
+                std::vector<unsigned int> order;          //!< Bus indices in topological order
+                std::vector<unsigned int> rank;           //!< Topological rank by bus index
+            };
+
+            std::vector<Bus*> buses;             //!< Buses by index
+            std::vector<Connection> connections; //!< Connections (compiled into adjacency arrays)
+
+            mutable bool dirty;                                  //!< Connections changed since last compile
+            mutable std::shared_ptr<const Adjacency> adjacency;  //!< Compiled adjacency (shared by forks)
+
+            std::vector<Mask> requested; //!< Buses with an active reset request
+            std::vector<Mask> effective; //!< Buses in reset (requested or descendant of requested)
+
+            mutable std::vector<Mask> visited;         //!< Subgraph traversal marks (scratch)
+            mutable std::vector<unsigned int> subgraph; //!< Subgraph bus indices (scratch)
+            mutable std::vector<unsigned int> stack;    //!< Traversal stack (scratch)
+        };
+    }
+}
+
+#endif
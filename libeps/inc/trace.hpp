@@ -0,0 +1,297 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#ifndef ITC_EPS_TRACE_HPP
+#define ITC_EPS_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itc
+{
+    namespace eps
+    {
+        const unsigned int DEFAULT_TRACE_EVENTS = 16384; //!< Default trace events kept per thread
+
+        /**
+         * \brief Trace event phase (Chrome trace event format)
+         */
+        enum TracePhase
+        {
+            TRACE_COMPLETE = 'X', //!< Span with duration
+            TRACE_INSTANT  = 'i'  //!< Point in time
+        };
+
+        /**
+         * \brief Trace event (names are static strings, so recording never copies or allocates)
+         */
+        struct TraceEvent
+        {
+            const char *name;     //!< Event name
+            const char *category; //!< Event category
+            const char *arg_name; //!< Argument name (null if no argument)
+            uint64_t start_ns;    //!< Start time (ns since tracer start)
+            uint64_t duration_ns; //!< Duration (ns, 0 for instant events)
+            int64_t arg;          //!< Argument value
+            uint64_t phase;       //!< Event phase (TracePhase)
+        };
+
+        /**
+         * \brief Single writer, lock free reader trace event ring (one per thread)
+         *
+         * The latest events are kept, older events are overwritten. Events are stored as atomic
+         * words so concurrent reads are well defined.
+         */
+        class TraceBuffer
+        {
+        public:
+            /**
+             * \brief Constructor
+             *
+             * \param capacity Number of events kept
+             * \param tid Thread ID
+             */
+            TraceBuffer(unsigned int capacity, uint64_t tid);
+
+            /**
+             * \brief Destructor
+             */
+            ~TraceBuffer();
+
+            /**
+             * \brief Add event (writer thread only)
+             *
+             * \param event Event
+             */
+            void add(const TraceEvent& event);
+
+            /**
+             * \brief Read kept events
+             *
+             * Events overwritten during the copy are dropped.
+             *
+             * \param events Events (oldest first)
+             */
+            void read(std::vector<TraceEvent>& events) const;
+
+            /**
+             * \brief Drop kept events
+             */
+            void clear();
+
+            /**
+             * \brief Get thread ID
+             *
+             * \return Thread ID
+             */
+            uint64_t get_tid() const;
+
+            /**
+             * \brief Get thread name
+             *
+             * \return Thread name (empty if not named)
+             */
+            std::string get_name() const;
+
+            /**
+             * \brief Set thread name
+             *
+             * \param name Thread name
+             */
+            void set_name(const std::string& name);
+
+        private:
+            TraceBuffer(const TraceBuffer&) = delete;
+            TraceBuffer& operator=(const TraceBuffer&) = delete;
+
+            static const unsigned int EVENT_WORDS = sizeof(TraceEvent) / sizeof(uint64_t); //!< Words per event
+
+        private:
+            const unsigned int capacity;                 //!< Number of events kept
+            const uint64_t tid;                          //!< Thread ID
+            std::unique_ptr<std::atomic<uint64_t>[]> words; //!< Event ring
+            std::atomic<uint64_t> count;                 //!< Events published
+            std::atomic<uint64_t> claims;                //!< Events claimed (being written)
+            std::atomic<uint64_t> floor;                 //!< Events dropped by clear
+            mutable std::mutex name_mutex;               //!< Mutex for thread name
+            std::string name;                            //!< Thread name
+        };
+
+        /**
+         * \brief Process trace recorder (Chrome trace event JSON, also loaded by Perfetto)
+         *
+         * Disabled by default, checking whether tracing is enabled is one relaxed load. When
+         * enabled, each thread records into its own buffer (allocated on the thread's first
+         * event), so recording takes no locks and keeps bounded memory however long it runs.
+         */
+        class Tracer
+        {
+        public:
+            typedef std::chrono::steady_clock Clock;
+
+            /**
+             * \brief Get process tracer
+             *
+             * \return Process tracer
+             */
+            static Tracer& get();
+
+            /**
+             * \brief Enable tracing
+             *
+             * \param events_per_thread Number of latest events kept per thread (for buffers not yet allocated)
+             */
+            void enable(unsigned int events_per_thread = DEFAULT_TRACE_EVENTS);
+
+            /**
+             * \brief Disable tracing (recorded events are kept)
+             */
+            void disable();
+
+            /**
+             * \brief Get tracing state
+             *
+             * \return True if tracing is enabled
+             */
+            bool is_enabled() const
+            {
+                return enabled.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * \brief Get trace time
+             *
+             * \return Time since tracer start (ns)
+             */
+            uint64_t now() const;
+
+            /**
+             * \brief Record event in the calling thread's buffer
+             *
+             * \param event Event
+             */
+            void record(const TraceEvent& event);
+
+            /**
+             * \brief Name the calling thread in the trace
+             *
+             * \param name Thread name
+             */
+            void set_thread_name(const std::string& name);
+
+            /**
+             * \brief Drop recorded events
+             */
+            void clear();
+
+            /**
+             * \brief Get recorded events of all threads
+             *
+             * \param events Events (thread ID and event, oldest first per thread)
+             */
+            void read(std::vector<std::pair<uint64_t, TraceEvent>>& events) const;
+
+            /**
+             * \brief Write recorded events to file (Chrome trace event JSON)
+             *
+             * \param filename Trace file
+             *
+             * \return True if the trace was written
+             */
+            bool write(const std::string& filename) const;
+
+        private:
+            /**
+             * \brief Constructor (disabled)
+             */
+            Tracer();
+
+            Tracer(const Tracer&) = delete;
+            Tracer& operator=(const Tracer&) = delete;
+
+            /**
+             * \brief Get calling thread's buffer (allocated on first use)
+             *
+             * \return Trace buffer
+             */
+            TraceBuffer& get_buffer();
+
+        private:
+            std::atomic<bool> enabled;          //!< Tracing enabled
+            std::atomic<unsigned int> capacity; //!< Events kept per thread (new buffers)
+            const Clock::time_point start;      //!< Tracer start time
+            mutable std::mutex mutex;           //!< Mutex for buffer list
+            std::vector<std::shared_ptr<TraceBuffer>> buffers; //!< Thread buffers (kept after threads exit)
+        };
+
+        /**
+         * \brief Traced span (records a complete event from construction to destruction)
+         */
+        class TraceSpan
+        {
+        public:
+            /**
+             * \brief Constructor (span begins, if tracing is enabled)
+             *
+             * \param name Span name (static string)
+             * \param category Span category (static string)
+             * \param arg_name Argument name (static string, null if no argument)
+             * \param arg Argument value
+             */
+            TraceSpan(const char *name, const char *category, const char *arg_name = nullptr, int64_t arg = 0) :
+                name(name), category(category), arg_name(arg_name), arg(arg),
+                start_ns(Tracer::get().is_enabled() ? Tracer::get().now() : NOT_TRACED)
+            {}
+
+            /**
+             * \brief Destructor (span ends)
+             */
+            ~TraceSpan();
+
+        private:
+            TraceSpan(const TraceSpan&) = delete;
+            TraceSpan& operator=(const TraceSpan&) = delete;
+
+            static const uint64_t NOT_TRACED = ~0ull; //!< Start time of spans begun with tracing disabled
+
+        private:
+            const char *name;     //!< Span name
+            const char *category; //!< Span category
+            const char *arg_name; //!< Argument name (null if no argument)
+            int64_t arg;          //!< Argument value
+            uint64_t start_ns;    //!< Start time (ns since tracer start, NOT_TRACED if not traced)
+        };
+
+        /**
+         * \brief Record instant event (if tracing is enabled)
+         *
+         * \param name Event name (static string)
+         * \param category Event category (static string)
+         * \param arg_name Argument name (static string, null if no argument)
+         * \param arg Argument value
+         */
+        void trace_instant(const char *name, const char *category, const char *arg_name = nullptr, int64_t arg = 0);
+    }
+}
+
+#endif
@@ -61,6 +61,7 @@ namespace itc
         };
 
         typedef std::map<ChannelCode, ChannelTelemetry> Telemetry; //!< EPS channel telemetry map
+        typedef std::map<ChannelCode, double> TelemetryValues;     //!< EPS analog telemetry value map
     }
 }
 
@@ -0,0 +1,235 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "actor.hpp"
+#include "log.hpp"
+#include "trace.hpp"
+#include <future>
+#include <pthread.h>
+#include <sched.h>
+
+using namespace itc::eps;
+
+static const unsigned int IDLE_SPINS = 64; //!< Empty polls before the simulator thread sleeps
+
+TaskQueue::TaskQueue() :
+    head(nullptr),
+    tail(new Node)
+{
+    head.store(tail, std::memory_order_relaxed);
+}
+
+TaskQueue::~TaskQueue()
+{
+    while(tail)
+    {
+        Node *next = tail->next.load(std::memory_order_relaxed);
+        delete tail;
+        tail = next;
+    }
+}
+
+void TaskQueue::push(EpsTask task)
+{
+    Node *node = new Node;
+    node->task = std::move(task);
+    Node *prev = head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_seq_cst);
+}
+
+bool TaskQueue::pop(EpsTask& task)
+{
+    // the popped node becomes the new tail (its task is moved out)
+    Node *next = tail->next.load(std::memory_order_acquire);
+    if(!next) return false;
+    task = std::move(next->task);
+    next->task = nullptr;
+    delete tail;
+    tail = next;
+    return true;
+}
+
+bool TaskQueue::empty() const
+{
+    return tail->next.load(std::memory_order_seq_cst) == nullptr;
+}
+
+EpsActor::EpsActor(Eps& eps) :
+    eps(eps),
+    queue(),
+    thread(),
+    thread_id(),
+    accepting(false),
+    producers(0),
+    sleeping(false),
+    num_tasks(0),
+    wake_mutex(),
+    wake(),
+    inline_mutex()
+{
+}
+
+EpsActor::~EpsActor()
+{
+    stop();
+}
+
+bool EpsActor::start(int cpu)
+{
+    if(thread.joinable()) return true;
+
+    accepting = true;
+    thread = std::thread(&EpsActor::run, this);
+    if(cpu >= 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        if(pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus) != 0)
+        {
+            EPS_LOG_WARNING("unable to pin eps simulator thread to cpu %d", cpu);
+        }
+    }
+    EPS_LOG_INFO("eps simulator thread started");
+    return true;
+}
+
+void EpsActor::stop()
+{
+    if(!thread.joinable()) return;
+
+    // later tasks run inline, the thread drains tasks already queued
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        accepting = false;
+    }
+    wake.notify_one();
+    thread.join();
+    EPS_LOG_INFO("eps simulator thread stopped");
+}
+
+bool EpsActor::is_running() const
+{
+    return accepting;
+}
+
+void EpsActor::post(EpsTask task)
+{
+    // tasks posted by a task are run before the thread exits
+    if(std::this_thread::get_id() == thread_id.load())
+    {
+        queue.push(std::move(task));
+        return;
+    }
+    if(!push(task)) run_inline(task);
+}
+
+void EpsActor::call(EpsTask task)
+{
+    if(std::this_thread::get_id() == thread_id.load())
+    {
+        task(eps);
+        return;
+    }
+
+    std::promise<void> done;
+    std::future<void> result = done.get_future();
+    EpsTask wrapper = [&task, &done](Eps& eps) {
+        task(eps);
+        done.set_value();
+    };
+    if(!push(wrapper))
+    {
+        run_inline(task);
+        return;
+    }
+    result.wait();
+}
+
+bool EpsActor::push(EpsTask& task)
+{
+    // producer counted before checking, so a stopping thread drains every accepted task
+    producers.fetch_add(1, std::memory_order_seq_cst);
+    bool accepted = accepting.load(std::memory_order_seq_cst);
+    if(accepted)
+    {
+        queue.push(std::move(task));
+
+        // wake idle thread (producers only lock when the thread sleeps)
+        if(sleeping.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            wake.notify_one();
+        }
+    }
+    producers.fetch_sub(1, std::memory_order_seq_cst);
+    return accepted;
+}
+
+void EpsActor::run_inline(const EpsTask& task)
+{
+    std::lock_guard<std::mutex> lock(inline_mutex);
+    task(eps);
+}
+
+uint64_t EpsActor::get_num_tasks() const
+{
+    return num_tasks;
+}
+
+void EpsActor::run()
+{
+    // inline tasks wait for the thread to exit
+    std::lock_guard<std::mutex> inline_lock(inline_mutex);
+    thread_id.store(std::this_thread::get_id());
+
+    if(Tracer::get().is_enabled()) Tracer::get().set_thread_name("eps actor");
+    unsigned int idle = 0;
+    EpsTask task;
+    while(true)
+    {
+        if(queue.pop(task))
+        {
+            task(eps);
+            task = nullptr;
+            num_tasks.fetch_add(1, std::memory_order_relaxed);
+            idle = 0;
+            continue;
+        }
+
+        // pending tasks and tasks of producers still pushing run before stopping
+        if(!accepting && (producers.load(std::memory_order_seq_cst) == 0) && queue.empty()) break;
+        if(!accepting)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if(++idle < IDLE_SPINS)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        sleeping.store(true, std::memory_order_seq_cst);
+        wake.wait(lock, [this]() {return !queue.empty() || !accepting;});
+        sleeping.store(false, std::memory_order_relaxed);
+        idle = 0;
+    }
+    thread_id.store(std::thread::id());
+}
@@ -22,26 +22,67 @@
 
 using namespace itc::eps;
 
+/**
+ * \brief Get shared default (no conversion) parameters
+ */
+static const std::shared_ptr<const ConverterParams>& default_params()
+{
+    static const std::shared_ptr<const ConverterParams> params(new ConverterParams{1, 0});
+    return params;
+}
+
 Channel::Channel(ConverterType type, unsigned int bits) :
     resolution(bits),
     type(type),
-    conv{1, 0},
+    conv(default_params()),
     active(true),
-    value(0)
+    value(0),
+    tracker(nullptr),
+    tracker_id(0)
+{
+}
+
+Channel::Channel(const Channel& channel) :
+    resolution(channel.resolution),
+    type(channel.type),
+    conv(channel.conv),
+    active(channel.active),
+    value(channel.value),
+    tracker(nullptr),
+    tracker_id(0)
 {
 }
 
+Channel& Channel::operator=(const Channel& channel)
+{
+    resolution = channel.resolution;
+    type = channel.type;
+    conv = channel.conv;
+    active = channel.active;
+    value = channel.value;
+    notify_change();
+    return *this;
+}
+
 Channel::~Channel()
 {
 }
 
 void Channel::configure(const ConverterParams& params)
 {
-    conv = params;
-    if(conv.size() < 2)
+    ConverterParams *conv_params = new ConverterParams(params);
+    if(conv_params->size() < 2)
     {
-        conv.resize(2, 0);
+        conv_params->resize(2, 0);
     }
+    conv.reset(conv_params);
+    notify_change();
+}
+
+void Channel::set_change_tracker(ChangeTracker *tracker, unsigned int id)
+{
+    this->tracker = tracker;
+    tracker_id = id;
 }
 
 bool Channel::is_active() const
@@ -51,7 +92,9 @@ bool Channel::is_active() const
 
 void Channel::set_active(bool active)
 {
+    if(this->active == active) return;
     this->active = active;
+    notify_change();
 }
 
 uint16_t Channel::sample() const
@@ -63,8 +106,9 @@ uint16_t Channel::sample() const
         {
             case ADC_CONV_LINEAR:
             {
-                double den = conv[0] + std::numeric_limits<double>::min(); // ensure non-zero value
-                double count = ((value - conv[1]) / den) + 0.5;
+                const ConverterParams& params = *conv;
+                double den = params[0] + std::numeric_limits<double>::min(); // ensure non-zero value
+                double count = ((value - params[1]) / den) + 0.5;
                 if(count >= 0)
                 {
                     sample = static_cast<uint16_t>(count) & get_max_count();
@@ -89,7 +133,14 @@ double Channel::get_value() const
 
 void Channel::set_value(double val)
 {
+    if(value == val) return;
     value = val;
+    notify_change();
+}
+
+void Channel::notify_change()
+{
+    if(tracker) tracker->notify_channel(tracker_id);
 }
 
 unsigned int Channel::get_max_count() const
@@ -97,3 +148,30 @@ unsigned int Channel::get_max_count() const
     return (1 << resolution) - 1;
 }
 
+void Channel::save_state(StateWriter& writer) const
+{
+    writer.write(static_cast<uint8_t>(type));
+    writer.write(static_cast<uint8_t>(resolution));
+    writer.write(*conv);
+    writer.write(active);
+    writer.write(value);
+}
+
+bool Channel::load_state(StateReader& reader)
+{
+    uint8_t state_type = 0;
+    uint8_t state_resolution = 0;
+    ConverterParams state_conv;
+    reader.read(state_type);
+    reader.read(state_resolution);
+    reader.read(state_conv);
+    reader.read(active);
+    reader.read(value);
+    if(!reader.is_valid() || (state_conv.size() < 2)) return false;
+
+    type = static_cast<ConverterType>(state_type);
+    resolution = state_resolution;
+    if(state_conv != *conv) conv.reset(new ConverterParams(state_conv));
+    notify_change();
+    return true;
+}
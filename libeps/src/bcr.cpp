@@ -21,9 +21,9 @@
 
 using namespace itc::eps;
 
-BcrBus::BcrBus() :
+BcrBus::BcrBus(unsigned int num_bcrs) :
     Bus(),
-    data()
+    data(num_bcrs)
 {
 }
 
@@ -33,12 +33,17 @@ BcrBus::~BcrBus()
 
 BcrData* BcrBus::get_data(unsigned int bcr)
 {
-    return (bcr < NUM_BCRS) ? &data[bcr] : nullptr; 
+    return (bcr < data.size()) ? &data[bcr] : nullptr; 
+}
+
+unsigned int BcrBus::get_num_bcrs() const
+{
+    return static_cast<unsigned int>(data.size());
 }
 
 void BcrBus::on_reset(bool state)
 {
-    for(int i = 0; i < NUM_BCRS; i++)
+    for(unsigned int i = 0; i < data.size(); i++)
     {
         data[i].voltage.set_active(!state);
         for(int j = 0; j < 2; j++)
@@ -50,3 +55,36 @@ void BcrBus::on_reset(bool state)
     }
 }
 
+void BcrBus::save_state(StateWriter& writer) const
+{
+    writer.write(static_cast<uint32_t>(data.size()));
+    for(unsigned int i = 0; i < data.size(); i++)
+    {
+        data[i].voltage.save_state(writer);
+        for(int j = 0; j < 2; j++)
+        {
+            data[i].current[j].save_state(writer);
+            data[i].temp[j].save_state(writer);
+            data[i].sun[j].save_state(writer);
+        }
+    }
+}
+
+bool BcrBus::load_state(StateReader& reader)
+{
+    uint32_t num = 0;
+    if(!reader.read(num) || (num != data.size())) return false;
+
+    bool loaded = true;
+    for(unsigned int i = 0; i < data.size(); i++)
+    {
+        loaded &= data[i].voltage.load_state(reader);
+        for(int j = 0; j < 2; j++)
+        {
+            loaded &= data[i].current[j].load_state(reader);
+            loaded &= data[i].temp[j].load_state(reader);
+            loaded &= data[i].sun[j].load_state(reader);
+        }
+    }
+    return loaded;
+}
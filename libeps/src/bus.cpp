@@ -18,14 +18,31 @@
 */
 
 #include "bus.hpp"
+#include "topology.hpp"
 
 using namespace itc::eps;
 
 Bus::Bus(const std::string& name) :
-    name(name),
+    name(std::make_shared<const std::string>(name)),
     parent_buses(),
     child_buses(),
-    reset_state(false)
+    reset_state(false),
+    topology(nullptr),
+    topology_index(0),
+    tracker(nullptr),
+    tracker_index(0)
+{
+}
+
+Bus::Bus(const Bus& bus) :
+    name(bus.name),
+    parent_buses(),
+    child_buses(),
+    reset_state(bus.reset_state),
+    topology(nullptr),
+    topology_index(0),
+    tracker(nullptr),
+    tracker_index(0)
 {
 }
 
@@ -35,12 +52,12 @@ Bus::~Bus()
 
 void Bus::set_name(const std::string& name)
 {
-    this->name = name;
+    this->name = std::make_shared<const std::string>(name);
 }
 
 std::string Bus::get_name() const
 {
-    return name;
+    return *name;
 }
 
 void Bus::connect(Bus& bus)
@@ -56,6 +73,13 @@ bool Bus::is_reset() const
 
 void Bus::reset(bool state)
 {
+    // propagate through compiled topology
+    if(topology)
+    {
+        topology->reset(topology_index, state);
+        return;
+    }
+
     // if reset state change
     if(reset_state != state)
     {
@@ -82,12 +106,56 @@ void Bus::reset(bool state)
 
             // notify reset state change
             on_reset(reset_state);
+            notify_reset();
         }
     }
 }
 
+void Bus::set_change_tracker(ChangeTracker *tracker, unsigned int index)
+{
+    this->tracker = tracker;
+    tracker_index = index;
+}
+
+unsigned int Bus::get_index() const
+{
+    return topology_index;
+}
+
+void Bus::save_state(StateWriter&) const
+{
+    // base bus has no state of its own (reset state is saved by the topology)
+}
+
+bool Bus::load_state(StateReader& reader)
+{
+    return reader.is_valid();
+}
+
 void Bus::add_parent(Bus& bus)
 {
     parent_buses.insert(&bus);
 }
 
+void Bus::attach(BusTopology *topology, unsigned int index)
+{
+    this->topology = topology;
+    topology_index = index;
+}
+
+void Bus::detach()
+{
+    topology = nullptr;
+}
+
+void Bus::set_reset_state(bool state)
+{
+    reset_state = state;
+    on_reset(reset_state);
+    notify_reset();
+}
+
+void Bus::notify_reset()
+{
+    if(tracker) tracker->notify(reset_state ? CHANGE_BUS_RESET : CHANGE_BUS_RELEASE, tracker_index);
+}
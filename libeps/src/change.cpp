@@ -0,0 +1,134 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "change.hpp"
+#include <algorithm>
+
+using namespace itc::eps;
+
+/**
+ * \brief Change area of each change type
+ */
+static const ChangeArea CHANGE_AREAS[NUM_CHANGE_TYPES] = {
+    CHANGE_AREA_STATUS,   // CHANGE_STATUS
+    CHANGE_AREA_SWITCHES, // CHANGE_SWITCH
+    CHANGE_AREA_RESETS,   // CHANGE_BUS_RESET
+    CHANGE_AREA_RESETS,   // CHANGE_BUS_RELEASE
+    CHANGE_AREA_RESETS,   // CHANGE_WDT
+    CHANGE_AREA_CHANNELS, // CHANGE_CHANNEL
+    CHANGE_AREA_CONFIG    // CHANGE_CONFIG
+};
+
+ChangeTracker::ChangeTracker() :
+    version(0),
+    area_versions(),
+    channel_codes(),
+    channel_versions(),
+    observers(),
+    next_id(1)
+{
+}
+
+ChangeTracker::ChangeTracker(const ChangeTracker& tracker) :
+    version(tracker.version),
+    area_versions(),
+    channel_codes(tracker.channel_codes),
+    channel_versions(tracker.channel_versions),
+    observers(),
+    next_id(1)
+{
+    std::copy(tracker.area_versions, tracker.area_versions + NUM_CHANGE_AREAS, area_versions);
+}
+
+ChangeTracker::~ChangeTracker()
+{
+}
+
+void ChangeTracker::set_channels(const std::vector<uint16_t>& codes)
+{
+    if(codes == channel_codes) return;
+    channel_codes = codes;
+    channel_versions.assign(codes.size(), 0);
+}
+
+uint64_t ChangeTracker::get_version() const
+{
+    return version;
+}
+
+uint64_t ChangeTracker::get_version(ChangeArea area) const
+{
+    return (area < NUM_CHANGE_AREAS) ? area_versions[area] : 0;
+}
+
+uint64_t ChangeTracker::get_channel_version(uint16_t code) const
+{
+    std::vector<uint16_t>::const_iterator it = std::lower_bound(channel_codes.begin(), channel_codes.end(), code);
+    if((it == channel_codes.end()) || (*it != code)) return 0;
+    return channel_versions[it - channel_codes.begin()];
+}
+
+unsigned int ChangeTracker::add_observer(ChangeCallback callback, uint32_t mask)
+{
+    Observer observer = {next_id++, mask, callback};
+    observers.push_back(observer);
+    return observer.id;
+}
+
+void ChangeTracker::remove_observer(unsigned int id)
+{
+    for(std::vector<Observer>::iterator it = observers.begin(); it != observers.end(); ++it)
+    {
+        if(it->id == id)
+        {
+            observers.erase(it);
+            return;
+        }
+    }
+}
+
+void ChangeTracker::notify(ChangeType type, uint32_t num)
+{
+    area_versions[CHANGE_AREAS[type]] = ++version;
+    if(!observers.empty())
+    {
+        ChangeEvent event = {type, num, version};
+        dispatch(event);
+    }
+}
+
+void ChangeTracker::notify_channel(unsigned int id)
+{
+    area_versions[CHANGE_AREA_CHANNELS] = ++version;
+    if(id >= channel_versions.size()) return;
+    channel_versions[id] = version;
+    if(!observers.empty())
+    {
+        ChangeEvent event = {CHANGE_CHANNEL, channel_codes[id], version};
+        dispatch(event);
+    }
+}
+
+void ChangeTracker::dispatch(const ChangeEvent& event)
+{
+    uint32_t mask = change_mask(event.type);
+    for(std::vector<Observer>::const_iterator it = observers.begin(); it != observers.end(); ++it)
+    {
+        if(it->mask & mask) it->callback(event);
+    }
+}
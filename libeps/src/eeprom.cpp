@@ -0,0 +1,126 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eeprom.hpp"
+#include "log.hpp"
+#include "types.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+EepromStore::EepromStore() :
+    filename(),
+    image(nullptr),
+    created(false),
+    dirty(false)
+{
+}
+
+EepromStore::~EepromStore()
+{
+    close();
+}
+
+bool EepromStore::open(const std::string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if(fd < 0)
+    {
+        EPS_LOG_ERROR("unable to open eeprom file %s: %s", filename.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    // size file to image (new bytes are zero)
+    struct stat info;
+    bool sized = (fstat(fd, &info) == 0) &&
+                 ((info.st_size == sizeof(EepromImage)) || (ftruncate(fd, sizeof(EepromImage)) == 0));
+    void *map = sized ? mmap(nullptr, sizeof(EepromImage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if(map == MAP_FAILED)
+    {
+        EPS_LOG_ERROR("unable to map eeprom file %s: %s", filename.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    this->filename = filename;
+    image = static_cast<EepromImage*>(map);
+    created = (image->magic != EEPROM_MAGIC) || (image->version != EEPROM_VERSION);
+    if(created)
+    {
+        EPS_LOG_INFO("initializing eeprom file: %s", filename.c_str());
+        std::memset(image, 0, sizeof(EepromImage));
+        image->magic = EEPROM_MAGIC;
+        image->version = EEPROM_VERSION;
+        dirty = true;
+        sync(true);
+    }
+    return true;
+}
+
+void EepromStore::close()
+{
+    if(!image) return;
+    sync(true);
+    munmap(image, sizeof(EepromImage));
+    image = nullptr;
+}
+
+bool EepromStore::is_open() const
+{
+    return image != nullptr;
+}
+
+bool EepromStore::is_new() const
+{
+    return created;
+}
+
+const std::string& EepromStore::get_filename() const
+{
+    return filename;
+}
+
+const EepromImage& EepromStore::get() const
+{
+    return *image;
+}
+
+EepromImage& EepromStore::edit()
+{
+    dirty.store(true, std::memory_order_release);
+    return *image;
+}
+
+bool EepromStore::sync(bool wait)
+{
+    if(!image || !dirty.exchange(false, std::memory_order_acq_rel)) return true;
+    if(msync(image, sizeof(EepromImage), wait ? MS_SYNC : MS_ASYNC) != 0)
+    {
+        EPS_LOG_ERROR("unable to sync eeprom file %s: %s", filename.c_str(), std::strerror(errno));
+        dirty = true;
+        return false;
+    }
+    return true;
+}
@@ -19,68 +19,241 @@
 
 #include "eps.hpp"
 #include "command.hpp"
+#include "log.hpp"
+#include "trace.hpp"
 #include "util.hpp"
-#include <ItcLogger/Logger.hpp>
-#include <bitset>
 #include <algorithm>
+#include <cstring>
 
 using namespace itc::eps;
 
-static ItcLogger::Logger *logger = ItcLogger::Logger::get(LOGGER_NAME.c_str());
+static const uint32_t STATE_MAGIC = 0x53535045;   //!< Simulator state blob magic ("EPSS")
+static const uint32_t STATE_VERSION = 1;          //!< Simulator state blob format version
+static const unsigned int NO_SOURCE = 0xffffffff; //!< Switch not powered by a pcm bus
+static const unsigned int MAX_STATE_SWITCHES = 31;   //!< Switches reported in 32-bit state words
+
+/**
+ * \brief Get layout to build (falls back to built-in layout if invalid)
+ */
+static std::shared_ptr<const BoardLayout> select_layout(const BoardLayout& layout)
+{
+    // built-in layout shared by all simulators
+    static const std::shared_ptr<const BoardLayout> builtin(new BoardLayout(BoardLayout::clyde_3g()));
+    if(&layout == &BoardLayout::clyde_3g()) return builtin;
+
+    std::string error;
+    if(!layout.validate(error))
+    {
+        EPS_LOG_ERROR("invalid eps board layout (%s), using built-in layout", error.c_str());
+        return builtin;
+    }
+    return std::make_shared<const BoardLayout>(layout);
+}
 
 Eps::Eps(uint8_t address, bool daughterboard, ByteSwapConfig swap_config) :
+    Eps(address, daughterboard, BoardLayout::clyde_3g(), swap_config)
+{
+}
+
+Eps::Eps(uint8_t address, bool daughterboard, const BoardLayout& layout, ByteSwapConfig swap_config) :
     swap(swap_config),
     address(address),
     response(),
     time_ms(0),
     version(),
     status(),
-    bcr_bus(),
+    changes(),
+    layout(select_layout(layout)),
+    buses(),
+    node_bus(nullptr),
     pcm_bus(),
+    pcm_reset(),
+    pcm_reset_index(),
+    pcm_reset_mask(),
     pdm_bus(),
+    pdm_source(),
+    pcm_load(),
+    pdm_trips(),
+    pdm_words(),
+    topology(),
+    data_ranges(CMD_DATA_RANGES),
+    channel_ranges(CMD_CHANNEL_RANGES),
     db_connected(daughterboard),
     db_version(),
     db_status(),
+    load_publisher(),
+    load_batch(),
+    load_aggregation(false),
     misc_channels(),
     adc(),
     wdt_time_ms(0),
     wdt_timeout_ms(DEFAULT_WDT_TIMEOUT_MS),
-    reset_buses()
+    reset_buses(),
+    journal(),
+    eeprom(),
+    rom(),
+    db_rom(),
+    frames(),
+    frame_version(0),
+    frame_time(0),
+    frame_channels(),
+    history(),
+    history_values(),
+    stats()
+{
+    const BoardLayout& board = *this->layout;
+
+    // create named buses and command mappings
+    create_buses(board);
+
+    // connect analog telemetry channels
+    connect_channels(board); 
+
+    // connect power buses (to propagate reset signals)
+    connect_buses(board);
+
+    // emulated ROM images and checksums
+    update_firmware();
+    write_rom();
+
+    track_changes();
+}
+
+Eps::Eps(const Eps& eps) :
+    swap(eps.swap),
+    address(eps.address),
+    response(eps.response),
+    time_ms(eps.time_ms),
+    version(eps.version),
+    status(eps.status),
+    changes(eps.changes),
+    layout(eps.layout),
+    buses(),
+    node_bus(nullptr),
+    pcm_bus(),
+    pcm_reset(),
+    pcm_reset_index(),
+    pcm_reset_mask(),
+    pdm_bus(),
+    pdm_source(eps.pdm_source),
+    pcm_load(eps.pcm_load),
+    pdm_trips(eps.pdm_trips),
+    pdm_words(eps.pdm_words),
+    topology(),
+    data_ranges(eps.data_ranges),
+    channel_ranges(eps.channel_ranges),
+    db_connected(eps.db_connected),
+    db_version(eps.db_version),
+    db_status(eps.db_status),
+    load_publisher(),
+    load_batch(),
+    load_aggregation(eps.load_aggregation),
+    misc_channels(eps.misc_channels),
+    adc(),
+    wdt_time_ms(eps.wdt_time_ms),
+    wdt_timeout_ms(eps.wdt_timeout_ms),
+    reset_buses(),
+    journal(),
+    eeprom(),
+    rom(eps.rom),
+    db_rom(eps.db_rom),
+    frames(),
+    frame_version(0),
+    frame_time(0),
+    frame_channels(),
+    history(),
+    history_values(),
+    stats()
 {
-    // name buses to improve logging
-    bcr_bus.set_name("BCR");
-    for(int i = 0; i < NUM_PCM_BUSES; i++)
+    const BoardLayout& board = *layout;
+    const std::vector<BusInfo>& info = board.get_buses();
+
+    // copy bus state (names and channel converter params are shared)
+    for(unsigned int i = 0; i < info.size(); i++)
     {
-        PcmBusType type = static_cast<PcmBusType>(i);
-        pcm_bus[type].set_name(to_string(type));
+        const Bus *bus = eps.buses[i].get();
+        switch(info[i].type)
+        {
+            case BUS_BCR:
+                buses.push_back(std::unique_ptr<Bus>(new BcrBus(*static_cast<const BcrBus*>(bus))));
+                break;
+            case BUS_PCM:
+                buses.push_back(std::unique_ptr<Bus>(new PcmBus(*static_cast<const PcmBus*>(bus))));
+                break;
+            case BUS_PDM:
+                buses.push_back(std::unique_ptr<Bus>(new PdmBus(*static_cast<const PdmBus*>(bus))));
+                break;
+        }
     }
-    for(int i = 0; i < NUM_SWITCHES; i++)
+    map_buses(board);
+
+    // switch loads are forked (profiles hold playback state)
+    for(unsigned int i = 0; i < pdm_bus.size(); i++)
     {
-        pdm_bus[i].set_name("PDM_SWITCH_" + to_string(i));
+        std::shared_ptr<LoadProfile> load = pdm_bus[i]->get_load();
+        if(load) pdm_bus[i]->set_load(load->fork());
     }
 
     // connect analog telemetry channels
-    connect_channels(); 
+    connect_channels(board);
 
-    // connect power buses (to propagate reset signals)
-    connect_buses();
+    // share compiled topology and rebind switch state words
+    for(unsigned int i = 0; i < buses.size(); i++)
+    {
+        topology.add(*buses[i]);
+    }
+    topology.share(eps.topology);
+    for(unsigned int i = 0; i < pdm_bus.size(); i++)
+    {
+        pdm_bus[i]->set_state_words(&pdm_words, (i < MAX_STATE_SWITCHES) ? (1u << (i+1)) : 0);
+    }
+
+    // pending bus reset releases
+    for(ResetBusSet::const_iterator it = eps.reset_buses.begin(); it != eps.reset_buses.end(); ++it)
+    {
+        reset_buses.insert(ResetInfo(buses[it->bus->get_index()].get(), it->time_ms));
+    }
+
+    track_changes();
 }
 
 Eps::~Eps()
 {
 }
 
+std::unique_ptr<Eps> Eps::fork() const
+{
+    return std::unique_ptr<Eps>(new Eps(*this));
+}
+
+const BoardLayout& Eps::get_layout() const
+{
+    return *layout;
+}
+
 void Eps::i2c_write(const I2CData& data)
 {
+    TraceSpan span("i2c_write", "eps", "cmd", data.empty() ? -1 : data[0]);
+    if(journal)
+    {
+        update_journal();
+        journal->record(time_ms, data);
+    }
+
     // no response if in reset
     response.clear();
-    if(is_reset()) return;
+    if(is_reset())
+    {
+        record_command(data, ERROR_RESET);
+        return;
+    }
 
     // verify command
     if(data.size() < 2)
     {
-        logger->error("invalid eps command");
+        EPS_LOG_ERROR("invalid eps command");
         set_response(CMD_RESP_ERROR);
+        record_command(data, ERROR_INVALID_CMD);
         return;
     }
 
@@ -90,19 +263,21 @@ void Eps::i2c_write(const I2CData& data)
 
     CommandType type = static_cast<CommandType>(data[0]);
     uint32_t param = get_command_param(data);
+    uint16_t prev_status = status.get_status();
+    ErrorCode prev_error = status.get_last_error();
 
-    logger->info("eps cmd %s: cmd=0x%x, param=0x%x", to_string(type).c_str(), static_cast<uint8_t>(type), param);
+    EPS_LOG_DEBUG("eps cmd: cmd=0x%x, param=0x%x", static_cast<uint8_t>(type), param);
 
     // data/channel range checks
     CommandDataRangeMap::const_iterator it;
 
-    it = CMD_DATA_RANGES.find(type); 
-    cmd_data_valid = (it != CMD_DATA_RANGES.end()) ? it->second.is_valid(param) : true;
-    if(!cmd_data_valid) logger->error("eps cmd data out of range");
+    it = data_ranges.find(type); 
+    cmd_data_valid = (it != data_ranges.end()) ? it->second.is_valid(param) : true;
+    if(!cmd_data_valid) EPS_LOG_ERROR("eps cmd data out of range");
 
-    it = CMD_CHANNEL_RANGES.find(type); 
-    cmd_channel_valid = (it != CMD_CHANNEL_RANGES.end()) ? it->second.is_valid(param) : true;
-    if(!cmd_channel_valid) logger->error("eps cmd channel out of range");
+    it = channel_ranges.find(type); 
+    cmd_channel_valid = (it != channel_ranges.end()) ? it->second.is_valid(param) : true;
+    if(!cmd_channel_valid) EPS_LOG_ERROR("eps cmd channel out of range");
     
     // execute commands
     if(cmd_data_valid && cmd_channel_valid)
@@ -151,7 +326,7 @@ void Eps::i2c_write(const I2CData& data)
                 if(db_connected)
                 {
                     uint32_t xsum = (static_cast<uint32_t>(db_status.get_checksum()) << 16) |
-                                     static_cast<uint32_t>(db_status.get_checksum());
+                                     static_cast<uint32_t>(status.get_checksum());
                     set_response(xsum);
                 }
                 else
@@ -168,6 +343,8 @@ void Eps::i2c_write(const I2CData& data)
                 break;
             case CMD_SET_WDT_PERIOD:
                 wdt_timeout_ms = param * 60 * 1000; // data provided in minutes
+                write_config();
+                changes.notify(CHANGE_CONFIG);
                 break;
             case CMD_RESET_WDT:
                 break;
@@ -217,41 +394,44 @@ void Eps::i2c_write(const I2CData& data)
                 set_pdm_all(false, false);
                 break;
             case CMD_GET_PDM_ALL_ACTUAL_STATE:
-                set_response(get_pdm_all(false));
+                set_response(get_pdm_all(PDM_STATE_ACTUAL));
                 break;
             case CMD_GET_PDM_ALL_EXPECTED_STATE:
-                set_response(get_pdm_all(false));
+                set_response(get_pdm_all(PDM_STATE_EXPECTED));
                 break;
             case CMD_GET_PDM_ALL_INITIAL_STATE:
-                set_response(get_pdm_all(true));
+                set_response(get_pdm_all(PDM_STATE_INITIAL));
                 break;
             case CMD_SET_PDM_ALL_INITIAL_STATE:
                 // TODO how is the state flag sent??
                 set_pdm_all(true, true);
+                write_config();
                 break;
             case CMD_SET_PDM_ON:
-                pdm_bus[param-1].set_state(true);
+                set_pdm_state(param-1, true);
                 break;
             case CMD_SET_PDM_OFF:
-                pdm_bus[param-1].set_state(false);
+                set_pdm_state(param-1, false);
                 break;
             case CMD_SET_PDM_INITIAL_STATE_ON:
-                pdm_bus[param-1].set_initial_state(true);
+                pdm_bus[param-1]->set_initial_state(true);
+                write_config();
                 break;
             case CMD_SET_PDM_INITIAL_STATE_OFF:
-                pdm_bus[param-1].set_initial_state(false);
+                pdm_bus[param-1]->set_initial_state(false);
+                write_config();
                 break;
             case CMD_GET_PDM_ACTUAL_STATE:
-                set_response(static_cast<uint16_t>(pdm_bus[param-1].get_state() ? 1 : 0));
+                set_response(static_cast<uint16_t>(pdm_bus[param-1]->get_state() ? 1 : 0));
                 break;
             case CMD_SET_PDM_TIMER_LIMIT:
                 set_pdm_timer_limit(static_cast<uint16_t>(param));
                 break;
             case CMD_GET_PDM_TIMER_LIMIT:
-                set_response(static_cast<uint16_t>(pdm_bus[param-1].get_timer_limit()));
+                set_response(static_cast<uint16_t>(pdm_bus[param-1]->get_timer_limit()));
                 break;
             case CMD_GET_PDM_TIMER_VALUE:
-                set_response(static_cast<uint16_t>(pdm_bus[param-1].get_timer_value()));
+                set_response(static_cast<uint16_t>(pdm_bus[param-1]->get_timer_value()));
                 break;
             case CMD_SET_PCM_RESET:
                 set_pcm_reset(static_cast<uint8_t>(param));
@@ -259,11 +439,13 @@ void Eps::i2c_write(const I2CData& data)
             case CMD_RESET_NODE:
                 // TODO proper reset
                 status.set(RESET_MANUAL);
-                reset_bus(bcr_bus);
+                reset_bus(*node_bus);
                 wdt_time_ms = 0;
+                write_config();
+                changes.notify(CHANGE_STATUS, 0);
                 break;
             default:
-                logger->error("unknown eps command");
+                EPS_LOG_ERROR("unknown eps command");
                 cmd_valid = false;
                 break;
         }
@@ -277,14 +459,23 @@ void Eps::i2c_write(const I2CData& data)
     // error response
     bool valid = (cmd_valid && cmd_data_valid && cmd_channel_valid);
     if(!valid) set_response(CMD_RESP_ERROR);
+    record_command(data, !cmd_valid ? ERROR_INVALID_CMD : !cmd_data_valid ? ERROR_INVALID_DATA :
+                         !cmd_channel_valid ? ERROR_INVALID_CHANNEL : ERROR_NONE);
 
     // reset wdt on valid command
     // TODO should this be reset on any traffic or only valid commands?
     if(valid) wdt_time_ms = 0;
+
+    if((status.get_status() != prev_status) || (status.get_last_error() != prev_error))
+    {
+        changes.notify(CHANGE_STATUS, 0);
+    }
+    if(frames) publish_frame();
 }
 
 void Eps::i2c_read(I2CData& data)
 {
+    TraceSpan span("i2c_read", "eps");
     data = response;
 }
 
@@ -293,6 +484,11 @@ uint8_t Eps::get_address() const
     return address;
 }
 
+void Eps::set_address(uint8_t address)
+{
+    this->address = address;
+}
+
 SimTime Eps::get_time() const
 {
     return time_ms;
@@ -300,24 +496,37 @@ SimTime Eps::get_time() const
 
 void Eps::set_time(SimTime time)
 {
+    TraceSpan span("set_time", "eps", "time_ms", static_cast<int64_t>(time));
+    if(journal) update_journal();
+
     // set watchdog timer time
     if(!is_reset()) wdt_time_ms += (time - time_ms);
 
     // set current sim time
     time_ms = time;
 
-    // set pdm bus times for auto-shutoff timers
-    for(int i = 0; i < NUM_SWITCHES; i++)
+    // set pdm bus times for auto-shutoff timers (switches turned off drop their trip and retry state)
+    for(unsigned int i = 0; i < pdm_bus.size(); i++)
     {
-        pdm_bus[i].set_time(time);
+        bool on = pdm_bus[i]->get_expected_state();
+        pdm_bus[i]->set_time(time);
+        if(on && !pdm_bus[i]->get_expected_state()) clear_pdm_trip(i);
     }
 
+    // apply external switch loads, check overcurrent trips, and update pcm loads
+    apply_published_loads();
+    if(journal) journal->record(JOURNAL_SET_TIME, time_ms);
+    check_pdm_trips();
+    if(load_aggregation) aggregate_loads();
+
     // find all buses with expired reset times and release reset
     ResetBusSet::iterator erase_it = reset_buses.upper_bound(ResetInfo(NULL, time_ms));
     for(ResetBusSet::iterator it = reset_buses.begin(); it != erase_it; ++it)
     {
-        logger->info("bus %s reset disabled (time=%fs)", it->bus->get_name().c_str(), time_ms/1000.0);
+        EPS_LOG_INFO("bus %s reset disabled (time=%fs)", it->bus->get_name().c_str(), time_ms/1000.0);
         it->bus->reset(false);
+        trace_instant("bus_reset_end", "eps", "bus", it->bus->get_index());
+        if(journal) journal->record(JOURNAL_BUS_RELEASE, time_ms, it->bus->get_index());
     }
 
     // remove expired buses from set
@@ -326,11 +535,18 @@ void Eps::set_time(SimTime time)
     // check state of watchdog timer
     if(wdt_time_ms >= wdt_timeout_ms)
     {
-        logger->warning("watchdog timer reset (time=%fs)", time_ms/1000.0);
+        EPS_LOG_WARNING("watchdog timer reset (time=%fs)", time_ms/1000.0);
+        trace_instant("wdt_reset", "eps");
+        if(stats) stats->record_event(EVENT_WDT_RESET);
         wdt_time_ms = 0;
-        reset_bus(bcr_bus);
+        reset_bus(*node_bus);
         status.set(RESET_WDT);
+        write_config();
+        changes.notify(CHANGE_WDT);
+        changes.notify(CHANGE_STATUS, 0);
     }
+    if(history) record_history();
+    if(frames) publish_frame();
 }
 
 Version Eps::get_version() const
@@ -341,6 +557,11 @@ Version Eps::get_version() const
 void Eps::set_version(const Version& version)
 {
     this->version = version;
+    update_firmware();
+    update_checksums();
+    if(journal) add_journal_keyframe();
+    changes.notify(CHANGE_CONFIG);
+    if(frames) publish_frame();
 }
 
 Status Eps::get_status() const
@@ -351,6 +572,11 @@ Status Eps::get_status() const
 void Eps::set_status(const Status& status)
 {
     this->status = status;
+    this->status.set_checksum(rom.get_checksum());
+    write_config();
+    changes.notify(CHANGE_STATUS, 0);
+    if(journal) add_journal_keyframe();
+    if(frames) publish_frame();
 }
 
 Version Eps::get_daughterboard_version() const
@@ -361,6 +587,11 @@ Version Eps::get_daughterboard_version() const
 void Eps::set_daughterboard_version(const Version& version)
 {
     this->db_version = version;
+    update_firmware();
+    update_checksums();
+    if(journal) add_journal_keyframe();
+    changes.notify(CHANGE_CONFIG);
+    if(frames) publish_frame();
 }
 
 Status Eps::get_daughterboard_status() const
@@ -371,6 +602,11 @@ Status Eps::get_daughterboard_status() const
 void Eps::set_daughterboard_status(const Status& status)
 {
     this->db_status = status;
+    this->db_status.set_checksum(db_rom.get_checksum());
+    write_config();
+    changes.notify(CHANGE_STATUS, 1);
+    if(journal) add_journal_keyframe();
+    if(frames) publish_frame();
 }
 
 void Eps::get_telemetry(Telemetry& tlm) const
@@ -394,85 +630,209 @@ void Eps::get_telemetry(ChannelCode code, ChannelTelemetry& tlm) const
     }
     else
     {
-        logger->error("invalid telemetry channel: 0x%x", code);
+        EPS_LOG_ERROR("invalid telemetry channel: 0x%x", code);
     }
 }
 
 void Eps::set_telemetry(ChannelCode code, double val)
 {
-    logger->info("updating eps telemetry channel: 0x%x", code);
+    EPS_LOG_INFO("updating eps telemetry channel: 0x%x", code);
 
+    // only valid changes are journaled
     Converter::iterator it = adc.find(code);
     if(it != adc.end())
     {
+        if(journal)
+        {
+            update_journal();
+            journal->record(JOURNAL_SET_TELEMETRY, time_ms, code, val);
+        }
         it->second->set_value(val);
+        if(frames) publish_frame();
     }
     else
     {
-        logger->error("invalid telemetry channel: 0x%x", code);
+        EPS_LOG_ERROR("invalid telemetry channel: 0x%x", code);
     }
 }
 
+void Eps::set_telemetry(const TelemetryValues& values)
+{
+    if(journal) update_journal();
+
+    unsigned int count = 0;
+    for(TelemetryValues::const_iterator it = values.begin(); it != values.end(); ++it)
+    {
+        Converter::iterator ch = adc.find(it->first);
+        if(ch != adc.end())
+        {
+            if(journal) journal->record(JOURNAL_SET_TELEMETRY, time_ms, it->first, it->second);
+            ch->second->set_value(it->second);
+            count++;
+        }
+        else
+        {
+            EPS_LOG_ERROR("invalid telemetry channel: 0x%x", it->first);
+        }
+    }
+
+    EPS_LOG_INFO("updating eps telemetry channels: %u", count);
+    if(frames && (count > 0)) publish_frame();
+}
+
+unsigned int Eps::get_num_switches() const
+{
+    return static_cast<unsigned int>(pdm_bus.size());
+}
+
 bool Eps::get_switch_state(unsigned int num) const
 {
     bool state = false;
-    if(num < NUM_SWITCHES)
+    if(num < pdm_bus.size())
     {
-        state = pdm_bus[num].get_state();
+        state = pdm_bus[num]->get_state();
     }
     else
     {
-        logger->error("invalid switch number: %d", num);
+        EPS_LOG_ERROR("invalid switch number: %d", num);
     }
     return state;
 }
 
 void Eps::set_switch_state(unsigned int num, bool on)
 {
-    logger->info("updating eps pdm switch %d state: %s", num, on ? "on" : "off");
-
-    if(num < NUM_SWITCHES)
+    EPS_LOG_INFO("updating eps pdm switch %d state: %s", num, on ? "on" : "off");
+    if(num < pdm_bus.size())
     {
-        pdm_bus[num].set_state(on);
+        if(journal)
+        {
+            update_journal();
+            journal->record(JOURNAL_SET_SWITCH, time_ms, num, on ? 1.0 : 0.0);
+        }
+        set_pdm_state(num, on);
+        if(frames) publish_frame();
     }
     else
     {
-        logger->error("invalid switch number: %d", num);
+        EPS_LOG_ERROR("invalid switch number: %d", num);
     }
 }
 
 bool Eps::get_switch_initial_state(unsigned int num) const
 {
     bool state = false;
-    if(num < NUM_SWITCHES)
+    if(num < pdm_bus.size())
     {
-        state = pdm_bus[num].get_initial_state();
+        state = pdm_bus[num]->get_initial_state();
     }
     else
     {
-        logger->error("invalid switch number: %d", num);
+        EPS_LOG_ERROR("invalid switch number: %d", num);
     }
     return state;
 }
 
 void Eps::set_switch_initial_state(unsigned int num, bool on)
 {
-    logger->info("updating eps pdm switch %d initial state: %s", num, on ? "on" : "off");
+    EPS_LOG_INFO("updating eps pdm switch %d initial state: %s", num, on ? "on" : "off");
+    if(num < pdm_bus.size())
+    {
+        if(journal)
+        {
+            update_journal();
+            journal->record(JOURNAL_SET_SWITCH_INITIAL, time_ms, num, on ? 1.0 : 0.0);
+        }
+        pdm_bus[num]->set_initial_state(on);
+        write_config();
+        if(frames) publish_frame();
+    }
+    else
+    {
+        EPS_LOG_ERROR("invalid switch number: %d", num);
+    }
+}
+
+PdmTripConfig Eps::get_switch_trip_config(unsigned int num) const
+{
+    PdmTripConfig config;
+    if(num < pdm_bus.size())
+    {
+        config.current_limit = pdm_trips.limit[num];
+        config.trip_delay_ms = static_cast<unsigned int>(pdm_trips.trip_delay_ms[num]);
+        config.retry_delay_ms = static_cast<unsigned int>(pdm_trips.retry_delay_ms[num]);
+        config.max_retries = pdm_trips.max_retries[num];
+    }
+    else
+    {
+        EPS_LOG_ERROR("invalid switch number: %d", num);
+    }
+    return config;
+}
+
+void Eps::set_switch_trip_config(unsigned int num, const PdmTripConfig& config)
+{
+    if(num < pdm_bus.size())
+    {
+        pdm_trips.limit[num] = config.current_limit;
+        pdm_trips.trip_delay_ms[num] = config.trip_delay_ms;
+        pdm_trips.retry_delay_ms[num] = config.retry_delay_ms;
+        pdm_trips.max_retries[num] = config.max_retries;
+        if(journal) add_journal_keyframe();
+        changes.notify(CHANGE_CONFIG);
+    }
+    else
+    {
+        EPS_LOG_ERROR("invalid switch number: %d", num);
+    }
+}
+
+bool Eps::is_switch_tripped(unsigned int num) const
+{
+    bool tripped = false;
+    if(num < pdm_bus.size())
+    {
+        tripped = pdm_bus[num]->is_tripped();
+    }
+    else
+    {
+        EPS_LOG_ERROR("invalid switch number: %d", num);
+    }
+    return tripped;
+}
 
-    if(num < NUM_SWITCHES)
+void Eps::set_switch_load(unsigned int num, std::shared_ptr<LoadProfile> load)
+{
+    if(num < pdm_bus.size())
     {
-        pdm_bus[num].set_initial_state(on);
+        pdm_bus[num]->set_load(load);
     }
     else
     {
-        logger->error("invalid switch number: %d", num);
+        EPS_LOG_ERROR("invalid switch number: %d", num);
     }
 }
 
+LoadPublisher& Eps::get_load_publisher()
+{
+    return load_publisher;
+}
+
+bool Eps::get_load_aggregation() const
+{
+    return load_aggregation;
+}
+
+void Eps::set_load_aggregation(bool enable)
+{
+    load_aggregation = enable;
+    if(journal) add_journal_keyframe();
+    changes.notify(CHANGE_CONFIG);
+}
+
 bool Eps::is_reset() const
 {
     // TODO i2c reset is actually different than bcr - need to read manual but 3.3v reset
-    return bcr_bus.is_reset();
+    return node_bus->is_reset();
 }
 
 void Eps::configure_channel(ChannelCode code, const ConverterParams& params)
@@ -481,108 +841,385 @@ void Eps::configure_channel(ChannelCode code, const ConverterParams& params)
     if(it != adc.end())
     {
         it->second->configure(params);
+        if(journal) add_journal_keyframe();
+        if(frames) publish_frame();
     }
     else
     {
-        logger->error("invalid telemetry channel: 0x%x", code);
+        EPS_LOG_ERROR("invalid telemetry channel: 0x%x", code);
     }
 }
 
-bool Eps::is_channel_valid(uint16_t code) const
+void Eps::configure_channels(const ConverterConfig& config)
 {
-    return adc.count(static_cast<ChannelCode>(code));
+    unsigned int count = 0;
+    for(ConverterConfig::const_iterator it = config.begin(); it != config.end(); ++it)
+    {
+        Converter::iterator ch = adc.find(it->first);
+        if(ch != adc.end())
+        {
+            ch->second->configure(it->second);
+            count++;
+        }
+        else
+        {
+            EPS_LOG_ERROR("invalid telemetry channel: 0x%x", it->first);
+        }
+    }
+
+    if(count > 0)
+    {
+        if(journal) add_journal_keyframe();
+        if(frames) publish_frame();
+    }
 }
 
-uint16_t Eps::read_telemetry(uint16_t param)
+void Eps::save_state(StateBlob& blob) const
 {
-    uint16_t data = CMD_RESP_ERROR;
-    ChannelCode code = static_cast<ChannelCode>(param);
-    Converter::const_iterator it = adc.find(code);
-    if(it != adc.end())
+    blob.clear();
+    StateWriter writer(blob);
+
+    // header (format and layout)
+    writer.write(STATE_MAGIC);
+    writer.write(STATE_VERSION);
+    writer.write(static_cast<uint32_t>(buses.size()));
+    writer.write(static_cast<uint32_t>(pdm_bus.size()));
+    writer.write(static_cast<uint32_t>(misc_channels.size()));
+
+    // board
+    writer.write(time_ms);
+    writer.write(static_cast<uint32_t>(wdt_time_ms));
+    writer.write(static_cast<uint32_t>(wdt_timeout_ms));
+    writer.write(response);
+    writer.write(version.version);
+    writer.write(db_version.version);
+    writer.write(db_connected);
+    status.save_state(writer);
+    db_status.save_state(writer);
+    writer.write(load_aggregation);
+
+    // buses and channels
+    topology.save_state(writer);
+    for(unsigned int i = 0; i < buses.size(); i++)
     {
-        data = it->second->sample();
+        buses[i]->save_state(writer);
+    }
+    for(MiscChannels::const_iterator it = misc_channels.begin(); it != misc_channels.end(); ++it)
+    {
+        writer.write(static_cast<uint16_t>(it->first));
+        it->second.save_state(writer);
+    }
+
+    // overcurrent trips
+    writer.write(pdm_trips.limit);
+    writer.write(pdm_trips.trip_delay_ms);
+    writer.write(pdm_trips.retry_delay_ms);
+    writer.write(pdm_trips.max_retries);
+    writer.write(pdm_trips.retries);
+    writer.write(pdm_trips.over_ms);
+    writer.write(pdm_trips.retry_ms);
+    writer.write(pdm_trips.over);
+    writer.write(pdm_trips.tripped);
+    writer.write(pdm_trips.latched);
+
+    // pending bus reset releases
+    writer.write(static_cast<uint32_t>(reset_buses.size()));
+    for(ResetBusSet::const_iterator it = reset_buses.begin(); it != reset_buses.end(); ++it)
+    {
+        writer.write(static_cast<uint32_t>(it->bus->get_index()));
+        writer.write(it->time_ms);
     }
-    return data;
 }
 
-void Eps::set_pcm_reset(uint8_t data)
+bool Eps::load_state(const StateBlob& blob)
 {
-    std::bitset<4> pcm_reset(data);
+    StateReader reader(blob);
+
+    // verify header
+    uint32_t magic = 0;
+    uint32_t format = 0;
+    uint32_t num_buses = 0;
+    uint32_t num_switches = 0;
+    uint32_t num_misc = 0;
+    reader.read(magic);
+    reader.read(format);
+    reader.read(num_buses);
+    reader.read(num_switches);
+    reader.read(num_misc);
+    if(!reader.is_valid() || (magic != STATE_MAGIC) || (format != STATE_VERSION))
+    {
+        EPS_LOG_ERROR("invalid eps state (format version %u, expected %u)", format, STATE_VERSION);
+        return false;
+    }
+    if((num_buses != buses.size()) || (num_switches != pdm_bus.size()) || (num_misc != misc_channels.size()))
+    {
+        EPS_LOG_ERROR("eps state board layout mismatch");
+        return false;
+    }
 
-    if(pcm_reset[PCM_BUS_BAT])
+    // restore previous state if blob is truncated or inconsistent
+    StateBlob backup;
+    save_state(backup);
+    if(!read_state(reader) || !reader.is_done())
     {
-        reset_bus(pcm_bus[PCM_BUS_BAT]);
+        EPS_LOG_ERROR("invalid eps state, state unchanged");
+        StateReader restore(backup);
+        restore.read(magic);
+        restore.read(format);
+        restore.read(num_buses);
+        restore.read(num_switches);
+        restore.read(num_misc);
+        read_state(restore);
+        return false;
     }
 
-    if(pcm_reset[PCM_BUS_5V])
+    update_firmware();
+    write_config();
+    changes.notify(CHANGE_STATUS, 0);
+    changes.notify(CHANGE_STATUS, 1);
+    changes.notify(CHANGE_CONFIG);
+
+    // loaded state starts a new journal timeline
+    if(journal)
     {
-        reset_bus(pcm_bus[PCM_BUS_5V]);
+        journal->clear();
+        add_journal_keyframe();
     }
+    if(frames) publish_frame();
+    return true;
+}
+
+void Eps::enable_journal(const JournalConfig& config)
+{
+    journal.reset(new Journal(config));
+    add_journal_keyframe();
+}
+
+void Eps::disable_journal()
+{
+    journal.reset();
+}
+
+const Journal* Eps::get_journal() const
+{
+    return journal.get();
+}
+
+std::unique_ptr<Eps> Eps::reconstruct(SimTime time) const
+{
+    uint64_t end = 0;
+    return replay_journal(time, end);
+}
+
+bool Eps::rewind(SimTime time)
+{
+    uint64_t end = 0;
+    std::unique_ptr<Eps> past = replay_journal(time, end);
+    if(!past) return false;
+
+    StateBlob blob;
+    past->save_state(blob);
+
+    // load without starting a new journal timeline, then discard the rewound events
+    std::unique_ptr<Journal> history(std::move(journal));
+    bool loaded = load_state(blob);
+    journal = std::move(history);
+    if(loaded) journal->truncate(end, past->time_ms);
+    return loaded;
+}
+
+bool Eps::is_channel_valid(uint16_t code) const
+{
+    return adc.count(static_cast<ChannelCode>(code));
+}
 
-    if(pcm_reset[PCM_BUS_3V3])
+uint16_t Eps::read_telemetry(uint16_t param)
+{
+    uint16_t data = CMD_RESP_ERROR;
+    ChannelCode code = static_cast<ChannelCode>(param);
+    Converter::const_iterator it = adc.find(code);
+    if(it != adc.end())
     {
-        reset_bus(pcm_bus[PCM_BUS_3V3]);
+        data = it->second->sample();
     }
+    return data;
+}
 
-    if(pcm_reset[PCM_BUS_12V])
+void Eps::set_pcm_reset(uint8_t data)
+{
+    for(unsigned int i = 0; i < pcm_reset.size(); i++)
     {
-        reset_bus(pcm_bus[PCM_BUS_12V]);
+        if((data >> i) & 1)
+        {
+            reset_bus(*pcm_reset[i]);
+        }
     }
 }
 
 void Eps::set_pdm_all(bool initial, bool state)
 {
-    for(int i = 0; i < NUM_SWITCHES; i++)
+    for(unsigned int i = 0; i < pdm_bus.size(); i++)
     {
         if(initial)
         {
-            pdm_bus[i].set_initial_state(state);
+            pdm_bus[i]->set_initial_state(state);
         }
         else
         {
-            pdm_bus[i].set_state(state);
+            set_pdm_state(i, state);
         }
     }
 }
 
-uint32_t Eps::get_pdm_all(bool initial) const
+uint32_t Eps::get_pdm_all(PdmStateType type) const
 {
     uint32_t state = 0;
-    for(int i = 0; i < NUM_SWITCHES; i++)
+    switch(type)
     {
-        if(initial)
+        case PDM_STATE_ACTUAL:
+            state = pdm_words.actual;
+            break;
+        case PDM_STATE_EXPECTED:
+            state = pdm_words.expected;
+            break;
+        case PDM_STATE_INITIAL:
+            state = pdm_words.initial;
+            break;
+    }
+    return state;
+}
+
+void Eps::set_pdm_state(unsigned int num, bool on)
+{
+    pdm_bus[num]->set_state(on);
+    clear_pdm_trip(num);
+}
+
+void Eps::clear_pdm_trip(unsigned int num)
+{
+    unsigned int word = num / 64;
+    PdmTripTable::Mask mask = ~(PdmTripTable::Mask(1) << (num % 64));
+    pdm_trips.over[word] &= mask;
+    pdm_trips.tripped[word] &= mask;
+    pdm_trips.latched[word] &= mask;
+    pdm_trips.retries[num] = 0;
+}
+
+void Eps::check_pdm_trips()
+{
+    typedef PdmTripTable::Mask Mask;
+    PdmTripTable& trips = pdm_trips;
+    unsigned int num = static_cast<unsigned int>(pdm_bus.size());
+
+    // sample switch currents (inactive channels read zero, so off/reset switches never trip)
+    for(unsigned int i = 0; i < num; i++)
+    {
+        trips.current[i] = pdm_bus[i]->get_data()->current.get_value();
+    }
+
+    // check switches a mask word at a time
+    for(unsigned int w = 0; w < trips.over.size(); w++)
+    {
+        unsigned int base = w * 64;
+        unsigned int count = std::min(64u, num - base);
+
+        // compare switches against limits and record when each went over
+        Mask over = 0;
+        for(unsigned int b = 0; b < count; b++)
         {
-            state |= (pdm_bus[i].get_initial_state() ? 1 : 0) << i+1;
+            over |= static_cast<Mask>(trips.current[base + b] > trips.limit[base + b]) << b;
         }
-        else
+        Mask rising = over & ~trips.over[w];
+        for(unsigned int b = 0; b < count; b++)
+        {
+            SimTime& over_ms = trips.over_ms[base + b];
+            over_ms = ((rising >> b) & 1) ? time_ms : over_ms;
+        }
+        trips.over[w] = over;
+
+        // switches over limit longer than trip delay, and tripped switches due for retry
+        Mask trip = 0;
+        Mask retry = 0;
+        for(unsigned int b = 0; b < count; b++)
+        {
+            unsigned int i = base + b;
+            trip |= static_cast<Mask>(time_ms >= trips.over_ms[i] + trips.trip_delay_ms[i]) << b;
+            retry |= static_cast<Mask>(time_ms >= trips.retry_ms[i]) << b;
+        }
+        trip &= over;
+        retry &= trips.tripped[w];
+
+        // nothing changed (common case)
+        if(!(trip | retry)) continue;
+
+        for(unsigned int b = 0; b < count; b++)
         {
-            state |= (pdm_bus[i].get_state() ? 1 : 0) << i+1;
+            unsigned int i = base + b;
+            Mask bit = Mask(1) << b;
+            if(retry & bit)
+            {
+                EPS_LOG_INFO("pdm switch %d overcurrent retry (time=%fs)", i, time_ms/1000.0);
+                trips.tripped[w] &= ~bit;
+                pdm_bus[i]->set_tripped(false);
+            }
+            if(trip & bit)
+            {
+                trips.over[w] &= ~bit;
+                pdm_bus[i]->set_tripped(true);
+                if(stats) stats->record_event(EVENT_PDM_TRIP);
+                if(trips.retries[i] < trips.max_retries[i])
+                {
+                    EPS_LOG_WARNING("pdm switch %d overcurrent trip: current=%fA, retry %u/%u (time=%fs)",
+                                    i, trips.current[i], trips.retries[i] + 1, trips.max_retries[i], time_ms/1000.0);
+                    trips.retries[i]++;
+                    trips.retry_ms[i] = time_ms + trips.retry_delay_ms[i];
+                    trips.tripped[w] |= bit;
+                }
+                else
+                {
+                    EPS_LOG_WARNING("pdm switch %d overcurrent trip: current=%fA, latched off (time=%fs)",
+                                    i, trips.current[i], time_ms/1000.0);
+                    trips.latched[w] |= bit;
+                }
+            }
         }
     }
-    return state;
 }
 
 void Eps::set_pdm_timer_limit(uint16_t data)
 {
     uint8_t period = (data & 0xff);
     uint8_t pdm = ((data >> 8) & 0xff) - 1;
-    if(pdm < NUM_SWITCHES)
+    if(pdm < pdm_bus.size())
     {
-        pdm_bus[pdm].set_timer_limit(period);
+        pdm_bus[pdm]->set_timer_limit(period);
+        if(!pdm_bus[pdm]->get_expected_state()) clear_pdm_trip(pdm);
     }
     else
     {
-        logger->error("invalid switch number: %d", pdm);
+        EPS_LOG_ERROR("invalid switch number: %d", pdm);
     }
 }
 
 uint16_t Eps::get_pcm_state() const
 {
-    uint16_t state = 0;
-    for(int i = 0; i < NUM_PCM_BUSES; i++)
+    typedef BusTopology::Mask Mask;
+    const std::vector<Mask>& reset = topology.get_reset_state();
+
+    // all pcm buses on unless one is in reset (common case)
+    unsigned int num = std::min(static_cast<unsigned int>(pcm_reset_index.size()), 16u);
+    uint16_t state = static_cast<uint16_t>((1u << num) - 1);
+    Mask in_reset = 0;
+    for(unsigned int w = 0; w < pcm_reset_mask.size(); w++)
     {
-        PcmBusType type = static_cast<PcmBusType>(i);
-        if(!pcm_bus[type].is_reset()) state |= 1 << i;
+        in_reset |= reset[w] & pcm_reset_mask[w];
+    }
+    if(!in_reset) return state;
+
+    for(unsigned int i = 0; i < num; i++)
+    {
+        unsigned int index = pcm_reset_index[i];
+        state &= ~static_cast<uint16_t>(((reset[index / 64] >> (index % 64)) & 1) << i);
     }
     return state;
 }
@@ -591,119 +1228,677 @@ void Eps::reset_bus(Bus& bus)
 {
     if(!bus.is_reset())
     {
-        logger->info("bus %s reset enabled (time=%fs)", bus.get_name().c_str(), time_ms/1000.0);
+        EPS_LOG_INFO("bus %s reset enabled (time=%fs)", bus.get_name().c_str(), time_ms/1000.0);
         bus.reset(true);
         reset_buses.insert(ResetInfo(&bus, time_ms + DEFAULT_BUS_RESET_TIME_MS));
+        trace_instant("bus_reset_begin", "eps", "bus", bus.get_index());
+        if(stats) stats->record_event(EVENT_BUS_RESET);
+        if(journal) journal->record(JOURNAL_BUS_RESET, time_ms, bus.get_index());
+    }
+    else
+    {
+        EPS_LOG_WARNING("bus %s already in reset state", bus.get_name().c_str());
+    }
+}
+
+void Eps::apply_published_loads()
+{
+    if(!load_publisher.drain(load_batch)) return;
+
+    // latest published sample per switch
+    for(LoadBatch::const_iterator it = load_batch.begin(); it != load_batch.end(); ++it)
+    {
+        if(it->num < pdm_bus.size())
+        {
+            if(journal) journal->record(JOURNAL_LOAD_SAMPLE, time_ms, it->num, it->current);
+            pdm_bus[it->num]->get_data()->current.set_value(it->current);
+        }
+        else
+        {
+            EPS_LOG_ERROR("invalid published load switch number: %d", it->num);
+        }
+    }
+}
+
+void Eps::aggregate_loads()
+{
+    // sum active switch currents (off, tripped, and reset switches read zero)
+    std::fill(pcm_load.begin(), pcm_load.end(), 0.0);
+    for(unsigned int i = 0; i < pdm_bus.size(); i++)
+    {
+        if(pdm_source[i] != NO_SOURCE)
+        {
+            pcm_load[pdm_source[i]] += pdm_bus[i]->get_data()->current.get_value();
+        }
+    }
+
+    // only pcm buses feeding switches are driven by loads
+    for(unsigned int i = 0; i < pdm_source.size(); i++)
+    {
+        if(pdm_source[i] != NO_SOURCE)
+        {
+            pcm_bus[pdm_source[i]]->get_data()->current.set_value(pcm_load[pdm_source[i]]);
+        }
+    }
+}
+
+Eps::PdmTripTable::PdmTripTable(unsigned int num) :
+    limit(num, PdmTripConfig().current_limit),
+    trip_delay_ms(num, PdmTripConfig().trip_delay_ms),
+    retry_delay_ms(num, PdmTripConfig().retry_delay_ms),
+    max_retries(num, PdmTripConfig().max_retries),
+    retries(num, 0),
+    over_ms(num, 0),
+    retry_ms(num, 0),
+    current(num, 0.0),
+    over((num + 63) / 64, 0),
+    tripped((num + 63) / 64, 0),
+    latched((num + 63) / 64, 0)
+{
+}
+
+void Eps::create_buses(const BoardLayout& layout)
+{
+    const std::vector<BusInfo>& info = layout.get_buses();
+
+    // create buses (named to improve logging)
+    for(unsigned int i = 0; i < info.size(); i++)
+    {
+        Bus *bus = nullptr;
+        switch(info[i].type)
+        {
+            case BUS_BCR:
+                bus = new BcrBus(info[i].units);
+                break;
+            case BUS_PCM:
+                bus = new PcmBus();
+                break;
+            case BUS_PDM:
+                bus = new PdmBus();
+                break;
+        }
+        bus->set_name(info[i].name);
+        buses.push_back(std::unique_ptr<Bus>(bus));
+    }
+    map_buses(layout);
+
+    // power distribution module (pdm) switches are powered by their first pcm parent
+    std::vector<unsigned int> pcm_index(info.size(), NO_SOURCE);
+    for(unsigned int i = 0, pcm = 0; i < info.size(); i++)
+    {
+        if(info[i].type == BUS_PCM) pcm_index[i] = pcm++;
+    }
+    const std::vector<unsigned int>& switches = layout.get_switches();
+    const std::vector<unsigned int>& resets = layout.get_pcm_resets();
+    const std::vector<BoardLayout::Connection>& connections = layout.get_connections();
+    pdm_source.assign(switches.size(), NO_SOURCE);
+    for(unsigned int i = 0; i < switches.size(); i++)
+    {
+        for(unsigned int j = 0; (j < connections.size()) && (pdm_source[i] == NO_SOURCE); j++)
+        {
+            if(connections[j].second == switches[i]) pdm_source[i] = pcm_index[connections[j].first];
+        }
+    }
+    pcm_load.assign(pcm_bus.size(), 0.0);
+    pdm_trips = PdmTripTable(static_cast<unsigned int>(switches.size()));
+
+    // size switch and pcm reset command ranges to layout
+    uint8_t max_switch = static_cast<uint8_t>(std::min<size_t>(switches.size(), 0xff));
+    for(CommandDataRangeMap::iterator it = channel_ranges.begin(); it != channel_ranges.end(); ++it)
+    {
+        it->second.max = max_switch;
+    }
+    data_ranges[CMD_SET_PCM_RESET] = CommandDataRange(0x01, static_cast<uint8_t>((1u << resets.size()) - 1));
+}
+
+void Eps::map_buses(const BoardLayout& layout)
+{
+    const std::vector<BusInfo>& info = layout.get_buses();
+
+    node_bus = buses[layout.get_node_reset()].get();
+
+    // power conditioning module (pcm) buses in layout order
+    for(unsigned int i = 0; i < info.size(); i++)
+    {
+        if(info[i].type == BUS_PCM) pcm_bus.push_back(static_cast<PcmBus*>(buses[i].get()));
+    }
+
+    // power conditioning module (pcm) reset command bits
+    // (layout indices are topology bus indices, so reset state is read from the topology words)
+    const std::vector<unsigned int>& resets = layout.get_pcm_resets();
+    pcm_reset_mask.assign((buses.size() + 63) / 64, 0);
+    for(unsigned int i = 0; i < resets.size(); i++)
+    {
+        pcm_reset.push_back(static_cast<PcmBus*>(buses[resets[i]].get()));
+        pcm_reset_index.push_back(resets[i]);
+        pcm_reset_mask[resets[i] / 64] |= BusTopology::Mask(1) << (resets[i] % 64);
+    }
+
+    // power distribution module (pdm) switch numbers
+    const std::vector<unsigned int>& switches = layout.get_switches();
+    for(unsigned int i = 0; i < switches.size(); i++)
+    {
+        pdm_bus.push_back(static_cast<PdmBus*>(buses[switches[i]].get()));
+    }
+}
+
+void Eps::connect_channels(const BoardLayout& layout)
+{
+    const std::vector<ChannelInfo>& channels = layout.get_channels();
+    for(unsigned int i = 0; i < channels.size(); i++)
+    {
+        const ChannelInfo& ch = channels[i];
+        Channel *channel = nullptr;
+        if(ch.slot == SLOT_MISC)
+        {
+            // misc board telemetry
+            channel = &misc_channels[ch.code];
+        }
+        else if(BcrBus *bcr = dynamic_cast<BcrBus*>(buses[ch.bus].get()))
+        {
+            // battery charge regulators (bcr)
+            BcrData *data = bcr->get_data(ch.unit);
+            switch(ch.slot)
+            {
+                case SLOT_VOLTAGE:   channel = &data->voltage;    break;
+                case SLOT_CURRENT:   channel = &data->current[0]; break;
+                case SLOT_CURRENT_B: channel = &data->current[1]; break;
+                case SLOT_TEMP:      channel = &data->temp[0];    break;
+                case SLOT_TEMP_B:    channel = &data->temp[1];    break;
+                case SLOT_SUN:       channel = &data->sun[0];     break;
+                case SLOT_SUN_B:     channel = &data->sun[1];     break;
+                default: break;
+            }
+        }
+        else if(PcmBus *pcm = dynamic_cast<PcmBus*>(buses[ch.bus].get()))
+        {
+            // power conditioning module (pcm) buses
+            channel = (ch.slot == SLOT_VOLTAGE) ? &pcm->get_data()->voltage : &pcm->get_data()->current;
+        }
+        else if(PdmBus *pdm = dynamic_cast<PdmBus*>(buses[ch.bus].get()))
+        {
+            // power distribution module (pdm) switches
+            channel = (ch.slot == SLOT_VOLTAGE) ? &pdm->get_data()->voltage : &pdm->get_data()->current;
+        }
+        adc[ch.code] = channel;
+    }
+
+    // state frame channel descriptors (bus numbered among buses of the same type)
+    const std::vector<BusInfo>& info = layout.get_buses();
+    std::vector<uint8_t> bus_num(info.size(), 0);
+    unsigned int type_count[BUS_PDM + 1] = {0, 0, 0};
+    for(unsigned int i = 0; i < info.size(); i++)
+    {
+        bus_num[i] = static_cast<uint8_t>(type_count[info[i].type]++);
+    }
+    std::map<ChannelCode, FrameChannel> descriptors;
+    for(unsigned int i = 0; i < channels.size(); i++)
+    {
+        const ChannelInfo& ch = channels[i];
+        bool misc = (ch.slot == SLOT_MISC);
+        FrameChannel& desc = descriptors[ch.code];
+        desc.type = misc ? FRAME_NO_BUS : static_cast<uint8_t>(info[ch.bus].type);
+        desc.bus = misc ? 0 : bus_num[ch.bus];
+        desc.slot = static_cast<uint8_t>(ch.slot);
+        desc.unit = static_cast<uint8_t>(ch.unit);
+    }
+    frame_channels.clear();
+    for(std::map<ChannelCode, FrameChannel>::const_iterator it = descriptors.begin(); it != descriptors.end(); ++it)
+    {
+        frame_channels.push_back(it->second);
+    }
+}
+
+void Eps::connect_buses(const BoardLayout& layout)
+{
+    // add buses to topology (layout order defines bus indices)
+    for(unsigned int i = 0; i < buses.size(); i++)
+    {
+        topology.add(*buses[i]);
+    }
+
+    // switches beyond the 32-bit state words are not reported by the all-switch commands
+    for(unsigned int i = 0; i < pdm_bus.size(); i++)
+    {
+        pdm_bus[i]->set_state_words(&pdm_words, (i < MAX_STATE_SWITCHES) ? (1u << (i+1)) : 0);
+    }
+
+    // connect parent buses to child buses
+    const std::vector<BoardLayout::Connection>& connections = layout.get_connections();
+    for(unsigned int i = 0; i < connections.size(); i++)
+    {
+        topology.connect(connections[i].first, connections[i].second);
+    }
+}
+
+bool Eps::read_state(StateReader& reader)
+{
+    // board
+    uint32_t wdt_time = 0;
+    uint32_t wdt_timeout = 0;
+    reader.read(time_ms);
+    reader.read(wdt_time);
+    reader.read(wdt_timeout);
+    reader.read(response);
+    reader.read(version.version);
+    reader.read(db_version.version);
+    reader.read(db_connected);
+    wdt_time_ms = wdt_time;
+    wdt_timeout_ms = wdt_timeout;
+    bool loaded = status.load_state(reader);
+    loaded = db_status.load_state(reader) && loaded;
+    reader.read(load_aggregation);
+
+    // buses (reset states first, since reset notifications update channels and timers)
+    loaded = topology.load_state(reader) && loaded;
+    for(unsigned int i = 0; i < buses.size(); i++)
+    {
+        loaded = buses[i]->load_state(reader) && loaded;
+    }
+    for(unsigned int i = 0; i < misc_channels.size(); i++)
+    {
+        uint16_t code = 0;
+        reader.read(code);
+        MiscChannels::iterator it = misc_channels.find(static_cast<ChannelCode>(code));
+        loaded = (it != misc_channels.end()) && it->second.load_state(reader) && loaded;
+    }
+
+    // overcurrent trips
+    PdmTripTable trips;
+    reader.read(trips.limit);
+    reader.read(trips.trip_delay_ms);
+    reader.read(trips.retry_delay_ms);
+    reader.read(trips.max_retries);
+    reader.read(trips.retries);
+    reader.read(trips.over_ms);
+    reader.read(trips.retry_ms);
+    reader.read(trips.over);
+    reader.read(trips.tripped);
+    reader.read(trips.latched);
+    trips.current = pdm_trips.current;
+    size_t num = pdm_bus.size();
+    size_t words = pdm_trips.over.size();
+    loaded = loaded && (trips.limit.size() == num) && (trips.trip_delay_ms.size() == num) &&
+             (trips.retry_delay_ms.size() == num) && (trips.max_retries.size() == num) &&
+             (trips.retries.size() == num) && (trips.over_ms.size() == num) && (trips.retry_ms.size() == num) &&
+             (trips.over.size() == words) && (trips.tripped.size() == words) && (trips.latched.size() == words);
+    if(loaded) pdm_trips = trips;
+
+    // pending bus reset releases
+    uint32_t num_resets = 0;
+    reader.read(num_resets);
+    reset_buses.clear();
+    for(unsigned int i = 0; reader.is_valid() && (i < num_resets); i++)
+    {
+        uint32_t index = 0;
+        SimTime release_ms = 0;
+        reader.read(index);
+        reader.read(release_ms);
+        loaded = loaded && (index < buses.size());
+        if(loaded) reset_buses.insert(ResetInfo(buses[index].get(), release_ms));
+    }
+
+    return loaded && reader.is_valid();
+}
+
+void Eps::attach_eeprom(std::shared_ptr<EepromStore> store)
+{
+    eeprom.reset();
+    if(!store) return;
+    if(!store->is_open())
+    {
+        EPS_LOG_ERROR("eps eeprom store not open");
+        return;
+    }
+
+    eeprom = store;
+    if(!eeprom->is_new() && (eeprom->get().num_switches == pdm_bus.size()))
+    {
+        EPS_LOG_INFO("restoring eps eeprom: %s", eeprom->get_filename().c_str());
+        read_eeprom();
+        write_rom();
+        if(journal) add_journal_keyframe();
+        changes.notify(CHANGE_STATUS, 0);
+        changes.notify(CHANGE_STATUS, 1);
+        changes.notify(CHANGE_CONFIG);
     }
     else
     {
-        logger->warning("bus %s already in reset state", bus.get_name().c_str());
-    }
-}
-
-void Eps::connect_channels()
-{
-    // battery charge regulators (bcr)
-    adc[CHANNEL_VBCR1]   = &bcr_bus.get_data(0)->voltage;
-    adc[CHANNEL_IBCR1A]  = &bcr_bus.get_data(0)->current[0];
-    adc[CHANNEL_IBCR1B]  = &bcr_bus.get_data(0)->current[1];
-    adc[CHANNEL_TBCR1A]  = &bcr_bus.get_data(0)->temp[0];
-    adc[CHANNEL_TBCR1B]  = &bcr_bus.get_data(0)->temp[1];
-    adc[CHANNEL_SDBCR1A] = &bcr_bus.get_data(0)->sun[0];
-    adc[CHANNEL_SDBCR1B] = &bcr_bus.get_data(0)->sun[1];
-
-    adc[CHANNEL_VBCR2]   = &bcr_bus.get_data(1)->voltage;
-    adc[CHANNEL_IBCR2A]  = &bcr_bus.get_data(1)->current[0];
-    adc[CHANNEL_IBCR2B]  = &bcr_bus.get_data(1)->current[1];
-    adc[CHANNEL_TBCR2A]  = &bcr_bus.get_data(1)->temp[0];
-    adc[CHANNEL_TBCR2B]  = &bcr_bus.get_data(1)->temp[1];
-    adc[CHANNEL_SDBCR2A] = &bcr_bus.get_data(1)->sun[0];
-    adc[CHANNEL_SDBCR2B] = &bcr_bus.get_data(1)->sun[1];
-
-    adc[CHANNEL_VBCR3]   = &bcr_bus.get_data(2)->voltage;
-    adc[CHANNEL_IBCR3A]  = &bcr_bus.get_data(2)->current[0];
-    adc[CHANNEL_IBCR3B]  = &bcr_bus.get_data(2)->current[1];
-    adc[CHANNEL_TBCR3A]  = &bcr_bus.get_data(2)->temp[0];
-    adc[CHANNEL_TBCR3B]  = &bcr_bus.get_data(2)->temp[1];
-    adc[CHANNEL_SDBCR3A] = &bcr_bus.get_data(2)->sun[0];
-    adc[CHANNEL_SDBCR3B] = &bcr_bus.get_data(2)->sun[1];
-
-    adc[CHANNEL_VBCR4]   = &bcr_bus.get_data(3)->voltage;
-    adc[CHANNEL_IBCR4A]  = &bcr_bus.get_data(3)->current[0];
-    adc[CHANNEL_IBCR4B]  = &bcr_bus.get_data(3)->current[1];
-    adc[CHANNEL_TBCR4A]  = &bcr_bus.get_data(3)->temp[0];
-    adc[CHANNEL_TBCR4B]  = &bcr_bus.get_data(3)->temp[1];
-    adc[CHANNEL_SDBCR4A] = &bcr_bus.get_data(3)->sun[0];
-    adc[CHANNEL_SDBCR4B] = &bcr_bus.get_data(3)->sun[1];
-
-    adc[CHANNEL_VBCR5]   = &bcr_bus.get_data(4)->voltage;
-    adc[CHANNEL_IBCR5A]  = &bcr_bus.get_data(4)->current[0];
-    adc[CHANNEL_IBCR5B]  = &bcr_bus.get_data(4)->current[1];
-    adc[CHANNEL_TBCR5A]  = &bcr_bus.get_data(4)->temp[0];
-    adc[CHANNEL_TBCR5B]  = &bcr_bus.get_data(4)->temp[1];
-    adc[CHANNEL_SDBCR5A] = &bcr_bus.get_data(4)->sun[0];
-    adc[CHANNEL_SDBCR5B] = &bcr_bus.get_data(4)->sun[1];
-
-
-    // power conditioning module (pcm) buses
-    adc[CHANNEL_VPCMBATV] = &pcm_bus[PCM_BUS_BAT].get_data()->voltage;
-    adc[CHANNEL_IPCMBATV] = &pcm_bus[PCM_BUS_BAT].get_data()->current;
-    adc[CHANNEL_VPCM12V]  = &pcm_bus[PCM_BUS_12V].get_data()->voltage;
-    adc[CHANNEL_IPCM12V]  = &pcm_bus[PCM_BUS_12V].get_data()->current;
-    adc[CHANNEL_VPCM5V]   = &pcm_bus[PCM_BUS_5V].get_data()->voltage;
-    adc[CHANNEL_IPCM5V]   = &pcm_bus[PCM_BUS_5V].get_data()->current;
-    adc[CHANNEL_VPCM3V3]  = &pcm_bus[PCM_BUS_3V3].get_data()->voltage;
-    adc[CHANNEL_IPCM3V3]  = &pcm_bus[PCM_BUS_3V3].get_data()->current;
-
-    // power distribution module (pdm) switches
-    adc[CHANNEL_VSW1]  = &pdm_bus[0].get_data()->voltage;
-    adc[CHANNEL_ISW1]  = &pdm_bus[0].get_data()->current;
-    adc[CHANNEL_VSW2]  = &pdm_bus[1].get_data()->voltage;
-    adc[CHANNEL_ISW2]  = &pdm_bus[1].get_data()->current;
-    adc[CHANNEL_VSW3]  = &pdm_bus[2].get_data()->voltage;
-    adc[CHANNEL_ISW3]  = &pdm_bus[2].get_data()->current;
-    adc[CHANNEL_VSW4]  = &pdm_bus[3].get_data()->voltage;
-    adc[CHANNEL_ISW4]  = &pdm_bus[3].get_data()->current;
-    adc[CHANNEL_VSW5]  = &pdm_bus[4].get_data()->voltage;
-    adc[CHANNEL_ISW5]  = &pdm_bus[4].get_data()->current;
-    adc[CHANNEL_VSW6]  = &pdm_bus[5].get_data()->voltage;
-    adc[CHANNEL_ISW6]  = &pdm_bus[5].get_data()->current;
-    adc[CHANNEL_VSW7]  = &pdm_bus[6].get_data()->voltage;
-    adc[CHANNEL_ISW7]  = &pdm_bus[6].get_data()->current;
-    adc[CHANNEL_VSW8]  = &pdm_bus[7].get_data()->voltage;
-    adc[CHANNEL_ISW8]  = &pdm_bus[7].get_data()->current;
-    adc[CHANNEL_VSW9]  = &pdm_bus[8].get_data()->voltage;
-    adc[CHANNEL_ISW9]  = &pdm_bus[8].get_data()->current;
-    adc[CHANNEL_VSW10] = &pdm_bus[9].get_data()->voltage;
-    adc[CHANNEL_ISW10] = &pdm_bus[9].get_data()->current;
-
-    // misc board telemetry
-    adc[CHANNEL_IIDIODE]  = &misc_channels[CHANNEL_IIDIODE];
-    adc[CHANNEL_VIDIODE]  = &misc_channels[CHANNEL_VIDIODE];
-    adc[CHANNEL_I3V3_DRW] = &misc_channels[CHANNEL_I3V3_DRW];
-    adc[CHANNEL_I5V_DRW]  = &misc_channels[CHANNEL_I5V_DRW];
-    adc[CHANNEL_TBRD]     = &misc_channels[CHANNEL_TBRD];
-}
-
-void Eps::connect_buses()
-{
-    // connect main battery charge regulator (bcr) bus to power conditioning module (pcm) buses
-    for(int i = 0; i < NUM_PCM_BUSES; i++)
-    {
-        bcr_bus.connect(pcm_bus[i]); 
-    }
-
-    // connect power conditioning module (pcm) buses to power distribution module (pdm) switch buses
-    pcm_bus[PCM_BUS_12V].connect(pdm_bus[0]);
-    pcm_bus[PCM_BUS_12V].connect(pdm_bus[1]);
-    pcm_bus[PCM_BUS_5V].connect(pdm_bus[2]);
-    pcm_bus[PCM_BUS_3V3].connect(pdm_bus[3]);
-    pcm_bus[PCM_BUS_5V].connect(pdm_bus[4]);
-    pcm_bus[PCM_BUS_5V].connect(pdm_bus[5]);
-    pcm_bus[PCM_BUS_5V].connect(pdm_bus[6]);
-    pcm_bus[PCM_BUS_3V3].connect(pdm_bus[7]);
-    pcm_bus[PCM_BUS_3V3].connect(pdm_bus[8]);
-    pcm_bus[PCM_BUS_3V3].connect(pdm_bus[9]);
+        if(!eeprom->is_new()) EPS_LOG_WARNING("eps eeprom switch count mismatch, reinitializing: %s", eeprom->get_filename().c_str());
+        write_eeprom();
+    }
+    if(frames) publish_frame();
+}
+
+std::shared_ptr<const FramePublisher> Eps::enable_frames(std::shared_ptr<FramePublisher> publisher)
+{
+    if(!frames || (publisher && (publisher != frames)))
+    {
+        frames = publisher ? publisher : std::make_shared<FramePublisher>();
+        StateFrame frame;
+        get_frame(frame);
+        frames->publish(frame);
+        frame_version = frame.version;
+        frame_time = time_ms;
+    }
+    return frames;
+}
+
+void Eps::disable_frames()
+{
+    frames.reset();
+}
+
+std::shared_ptr<const FramePublisher> Eps::get_frames() const
+{
+    return frames;
+}
+
+std::shared_ptr<const HistoryStore> Eps::enable_history(unsigned int period_ms)
+{
+    if(!history)
+    {
+        std::vector<ChannelCode> codes;
+        for(Converter::const_iterator it = adc.begin(); it != adc.end(); ++it)
+        {
+            codes.push_back(it->first);
+        }
+        history = std::make_shared<HistoryStore>(codes, period_ms);
+        history_values.assign(codes.size(), 0.0);
+        record_history();
+    }
+    return history;
+}
+
+void Eps::disable_history()
+{
+    history.reset();
+}
+
+std::shared_ptr<const HistoryStore> Eps::get_history() const
+{
+    return history;
+}
+
+std::shared_ptr<CommandStats> Eps::enable_stats()
+{
+    if(!stats) stats = std::make_shared<CommandStats>();
+    return stats;
+}
+
+void Eps::disable_stats()
+{
+    stats.reset();
+}
+
+std::shared_ptr<const CommandStats> Eps::get_stats() const
+{
+    return stats;
+}
+
+void Eps::get_frame(StateFrame& frame) const
+{
+    std::memset(&frame, 0, sizeof(frame));
+    frame.time_ms = time_ms;
+    frame.version = changes.get_version();
+    for(unsigned int i = 0; i < NUM_CHANGE_AREAS; i++)
+    {
+        frame.area_versions[i] = changes.get_version(static_cast<ChangeArea>(i));
+    }
+    frame.wdt_timeout_ms = wdt_timeout_ms;
+    frame.db_connected = db_connected ? 1 : 0;
+
+    // board status
+    const Status *board_status[2] = {&status, &db_status};
+    const Version *board_version[2] = {&version, &db_version};
+    FrameBoard *board[2] = {&frame.board, &frame.db_board};
+    for(unsigned int b = 0; b < 2; b++)
+    {
+        board[b]->status = board_status[b]->get_status();
+        board[b]->last_error = static_cast<uint16_t>(board_status[b]->get_last_error());
+        board[b]->checksum = board_status[b]->get_checksum();
+        board[b]->version = board_version[b]->version;
+        for(unsigned int i = 0; i < NUM_EEPROM_RESETS; i++)
+        {
+            board[b]->reset_counts[i] = board_status[b]->get_num_resets(EEPROM_RESET_TYPES[i]);
+        }
+    }
+
+    // telemetry channels (code order)
+    for(Converter::const_iterator it = adc.begin(); (it != adc.end()) && (frame.num_channels < MAX_FRAME_CHANNELS); ++it)
+    {
+        frame.codes[frame.num_channels] = it->first;
+        frame.channels[frame.num_channels] = frame_channels[frame.num_channels];
+        frame.digital[frame.num_channels] = it->second->sample();
+        frame.analog[frame.num_channels] = it->second->get_value();
+        frame.num_channels++;
+    }
+
+    // switch state masks
+    frame.num_switches = static_cast<uint32_t>(std::min<std::size_t>(pdm_bus.size(), MAX_FRAME_SWITCHES));
+    for(unsigned int i = 0; i < frame.num_switches; i++)
+    {
+        uint64_t bit = static_cast<uint64_t>(1) << (i % 64);
+        if(pdm_bus[i]->get_state()) frame.switch_actual[i / 64] |= bit;
+        if(pdm_bus[i]->get_expected_state()) frame.switch_expected[i / 64] |= bit;
+        if(pdm_bus[i]->get_initial_state()) frame.switch_initial[i / 64] |= bit;
+    }
+}
+
+const ChangeTracker& Eps::get_changes() const
+{
+    return changes;
+}
+
+unsigned int Eps::add_observer(ChangeCallback callback, uint32_t mask)
+{
+    return changes.add_observer(callback, mask);
+}
+
+void Eps::remove_observer(unsigned int id)
+{
+    changes.remove_observer(id);
+}
+
+std::unique_ptr<Eps> Eps::replay_journal(SimTime time, uint64_t& end) const
+{
+    std::unique_ptr<Eps> eps;
+    const JournalKeyframe *keyframe = journal ? journal->find_keyframe(time) : nullptr;
+    if(!keyframe)
+    {
+        EPS_LOG_ERROR("no eps journal keyframe at or before time=%fs", time/1000.0);
+        return eps;
+    }
+
+    // forks are not journaled
+    eps = fork();
+    if(!eps->load_state(keyframe->state))
+    {
+        eps.reset();
+        return eps;
+    }
+
+    for(end = keyframe->seq; end < journal->get_next_seq(); end++)
+    {
+        const JournalEvent& event = journal->get_event(end);
+        if(event.time_ms > time) break;
+        eps->replay(event);
+    }
+    return eps;
+}
+
+void Eps::replay(const JournalEvent& event)
+{
+    switch(event.type)
+    {
+        case JOURNAL_I2C_WRITE:
+            i2c_write(I2CData(event.data, event.data + event.size));
+            break;
+        case JOURNAL_SET_TIME:
+            set_time(event.time_ms);
+            break;
+        case JOURNAL_SET_TELEMETRY:
+            set_telemetry(static_cast<ChannelCode>(event.num), event.value);
+            break;
+        case JOURNAL_SET_SWITCH:
+            set_switch_state(event.num, event.value != 0.0);
+            break;
+        case JOURNAL_SET_SWITCH_INITIAL:
+            set_switch_initial_state(event.num, event.value != 0.0);
+            break;
+        case JOURNAL_LOAD_SAMPLE:
+            // applied by the following time advance
+            load_publisher.publish(event.num, event.value);
+            break;
+        default:
+            // bus resets are reproduced by replay
+            break;
+    }
+}
+
+void Eps::update_journal()
+{
+    if(journal->is_keyframe_due(time_ms)) add_journal_keyframe();
+}
+
+void Eps::add_journal_keyframe()
+{
+    save_state(journal->add_keyframe(time_ms));
+}
+
+void Eps::track_changes()
+{
+    for(unsigned int i = 0; i < buses.size(); i++)
+    {
+        buses[i]->set_change_tracker(&changes, i);
+    }
+    for(unsigned int i = 0; i < pdm_bus.size(); i++)
+    {
+        pdm_bus[i]->set_switch_tracker(&changes, i);
+    }
+
+    // channel ids in code order
+    std::vector<uint16_t> codes;
+    for(Converter::const_iterator it = adc.begin(); it != adc.end(); ++it)
+    {
+        it->second->set_change_tracker(&changes, static_cast<unsigned int>(codes.size()));
+        codes.push_back(static_cast<uint16_t>(it->first));
+    }
+    changes.set_channels(codes);
+}
+
+void Eps::read_eeprom()
+{
+    const EepromImage& image = eeprom->get();
+    for(unsigned int i = 0; i < NUM_EEPROM_RESETS; i++)
+    {
+        status.set_num_resets(EEPROM_RESET_TYPES[i], image.reset_counts[i]);
+        db_status.set_num_resets(EEPROM_RESET_TYPES[i], image.db_reset_counts[i]);
+    }
+    for(unsigned int i = 0; (i < pdm_bus.size()) && (i < MAX_EEPROM_SWITCHES); i++)
+    {
+        pdm_bus[i]->set_initial_state((image.pdm_initial[i / 8] >> (i % 8)) & 1);
+    }
+    if(image.wdt_period_min > 0) wdt_timeout_ms = image.wdt_period_min * 60 * 1000;
+}
+
+void Eps::write_eeprom()
+{
+    EepromImage& image = eeprom->edit();
+    image.num_switches = static_cast<uint32_t>(pdm_bus.size());
+    image.wdt_period_min = static_cast<uint16_t>(wdt_timeout_ms / (60 * 1000));
+    for(unsigned int i = 0; i < NUM_EEPROM_RESETS; i++)
+    {
+        image.reset_counts[i] = status.get_num_resets(EEPROM_RESET_TYPES[i]);
+        image.db_reset_counts[i] = db_status.get_num_resets(EEPROM_RESET_TYPES[i]);
+    }
+    for(unsigned int i = 0; (i < pdm_bus.size()) && (i < MAX_EEPROM_SWITCHES); i++)
+    {
+        uint8_t bit = static_cast<uint8_t>(1 << (i % 8));
+        image.pdm_initial[i / 8] = pdm_bus[i]->get_initial_state() ? (image.pdm_initial[i / 8] | bit) :
+                                                                     (image.pdm_initial[i / 8] & ~bit);
+    }
+}
+
+void Eps::publish_frame()
+{
+    if((changes.get_version() == frame_version) && (time_ms == frame_time)) return;
+
+    StateFrame frame;
+    get_frame(frame);
+    frames->publish(frame);
+    frame_version = frame.version;
+    frame_time = time_ms;
+}
+
+void Eps::record_history()
+{
+    if(!history->is_due(time_ms)) return;
+
+    unsigned int i = 0;
+    for(Converter::const_iterator it = adc.begin(); it != adc.end(); ++it)
+    {
+        history_values[i++] = it->second->get_value();
+    }
+    history->record(time_ms, history_values.data(), static_cast<unsigned int>(history_values.size()));
+}
+
+void Eps::record_command(const I2CData& data, ErrorCode error)
+{
+    if(stats) stats->record_command(data.empty() ? 0 : data[0], data.size(), response.size(), error);
+}
+
+void Eps::write_config()
+{
+    write_rom();
+    if(eeprom) write_eeprom();
+}
+
+void Eps::write_rom()
+{
+    // motherboard: watchdog period, reset counters, and switch initial states
+    uint16_t wdt_period = static_cast<uint16_t>(wdt_timeout_ms / (60 * 1000));
+    uint8_t wdt[2] = {static_cast<uint8_t>(wdt_period & 0xff), static_cast<uint8_t>(wdt_period >> 8)};
+    uint8_t resets[NUM_EEPROM_RESETS];
+    uint8_t db_resets[NUM_EEPROM_RESETS];
+    for(unsigned int i = 0; i < NUM_EEPROM_RESETS; i++)
+    {
+        resets[i] = status.get_num_resets(EEPROM_RESET_TYPES[i]);
+        db_resets[i] = db_status.get_num_resets(EEPROM_RESET_TYPES[i]);
+    }
+    uint8_t initial[ROM_CONFIG_USED - ROM_PDM_INITIAL] = {0};
+    for(unsigned int i = 0; (i < pdm_bus.size()) && (i < 8 * sizeof(initial)); i++)
+    {
+        if(pdm_bus[i]->get_initial_state()) initial[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+    }
+    rom.write(ROM_WDT_PERIOD, wdt, sizeof(wdt));
+    rom.write(ROM_RESET_COUNTS, resets, sizeof(resets));
+    rom.write(ROM_PDM_INITIAL, initial, sizeof(initial));
+
+    // daughterboard: reset counters
+    db_rom.write(ROM_RESET_COUNTS, db_resets, sizeof(db_resets));
+
+    update_checksums();
+}
+
+void Eps::update_firmware()
+{
+    rom.set_firmware(version.version, 0);
+    db_rom.set_firmware(db_version.version, 1);
+}
+
+void Eps::update_checksums()
+{
+    if(status.get_checksum() != rom.get_checksum())
+    {
+        status.set_checksum(rom.get_checksum());
+        changes.notify(CHANGE_STATUS, 0);
+    }
+    if(db_status.get_checksum() != db_rom.get_checksum())
+    {
+        db_status.set_checksum(db_rom.get_checksum());
+        changes.notify(CHANGE_STATUS, 1);
+    }
 }
 
 uint32_t Eps::get_command_param(const I2CData& data)
@@ -0,0 +1,87 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "frame.hpp"
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+using namespace itc::eps;
+
+static_assert(std::is_trivially_copyable<StateFrame>::value, "state frame must be trivially copyable");
+static_assert(sizeof(StateFrame) % sizeof(uint64_t) == 0, "state frame must be a whole number of words");
+
+FramePublisher::FramePublisher() :
+    sequence(0)
+{
+    for(unsigned int i = 0; i < NUM_WORDS; i++)
+    {
+        words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+FramePublisher::~FramePublisher()
+{
+}
+
+void FramePublisher::publish(const StateFrame& frame)
+{
+    uint64_t data[NUM_WORDS];
+    std::memcpy(data, &frame, sizeof(data));
+
+    uint64_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(unsigned int i = 0; i < NUM_WORDS; i++)
+    {
+        words[i].store(data[i], std::memory_order_relaxed);
+    }
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool FramePublisher::try_read(StateFrame& frame) const
+{
+    uint64_t before = sequence.load(std::memory_order_acquire);
+    if(before & 1) return false;
+
+    uint64_t data[NUM_WORDS];
+    for(unsigned int i = 0; i < NUM_WORDS; i++)
+    {
+        data[i] = words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(sequence.load(std::memory_order_relaxed) != before) return false;
+
+    std::memcpy(&frame, data, sizeof(data));
+    return true;
+}
+
+bool FramePublisher::read(StateFrame& frame) const
+{
+    if(sequence.load(std::memory_order_acquire) == 0) return false;
+    while(!try_read(frame))
+    {
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+uint64_t FramePublisher::get_count() const
+{
+    return sequence.load(std::memory_order_acquire) / 2;
+}
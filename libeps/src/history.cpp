@@ -0,0 +1,188 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "history.hpp"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+using namespace itc::eps;
+
+static_assert(std::is_trivially_copyable<HistoryPoint>::value, "history point must be trivially copyable");
+static_assert(sizeof(HistoryPoint) % sizeof(uint64_t) == 0, "history point must be a whole number of words");
+
+ChannelHistory::ChannelHistory() :
+    pending()
+{
+    for(unsigned int level = 0; level < HISTORY_LEVELS; level++)
+    {
+        counts[level].store(0, std::memory_order_relaxed);
+        claims[level].store(0, std::memory_order_relaxed);
+        for(unsigned int i = 0; i < HISTORY_SIZE; i++)
+        {
+            for(unsigned int w = 0; w < POINT_WORDS; w++)
+            {
+                words[level][i][w].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+ChannelHistory::~ChannelHistory()
+{
+}
+
+void ChannelHistory::add(uint64_t time_ms, double value)
+{
+    HistoryPoint point = {time_ms, value, value, value};
+    append(0, point);
+}
+
+void ChannelHistory::append(unsigned int level, const HistoryPoint& point)
+{
+    // claim slot of the oldest point, store point, then publish it
+    uint64_t data[POINT_WORDS];
+    std::memcpy(data, &point, sizeof(data));
+    uint64_t count = counts[level].load(std::memory_order_relaxed);
+    std::atomic<uint64_t> *slot = words[level][count % HISTORY_SIZE];
+    claims[level].store(count + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(unsigned int w = 0; w < POINT_WORDS; w++)
+    {
+        slot[w].store(data[w], std::memory_order_relaxed);
+    }
+    counts[level].store(count + 1, std::memory_order_release);
+
+    // merge into next level
+    if(level + 1 >= HISTORY_LEVELS) return;
+    Pending& merge = pending[level + 1];
+    if(merge.num == 0)
+    {
+        merge.point = point;
+        merge.sum = 0;
+    }
+    merge.point.time_ms = point.time_ms;
+    merge.point.min = std::min(merge.point.min, point.min);
+    merge.point.max = std::max(merge.point.max, point.max);
+    merge.sum += point.mean;
+    if(++merge.num == HISTORY_DECIMATION)
+    {
+        merge.point.mean = merge.sum / merge.num;
+        merge.num = 0;
+        append(level + 1, merge.point);
+    }
+}
+
+unsigned int ChannelHistory::read(unsigned int level, HistoryPoint *points, unsigned int max) const
+{
+    if(level >= HISTORY_LEVELS) return 0;
+
+    // copy latest published points
+    uint64_t end = counts[level].load(std::memory_order_acquire);
+    uint64_t num = std::min<uint64_t>(std::min<uint64_t>(end, max), HISTORY_SIZE);
+    uint64_t begin = end - num;
+    uint64_t data[POINT_WORDS];
+    for(uint64_t i = begin; i < end; i++)
+    {
+        const std::atomic<uint64_t> *slot = words[level][i % HISTORY_SIZE];
+        for(unsigned int w = 0; w < POINT_WORDS; w++)
+        {
+            data[w] = slot[w].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&points[i - begin], data, sizeof(data));
+    }
+
+    // drop points overwritten during the copy (writer claims a slot before writing it)
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t claimed = claims[level].load(std::memory_order_relaxed);
+    uint64_t valid = (claimed >= HISTORY_SIZE) ? (claimed - HISTORY_SIZE) : 0;
+    if(valid <= begin) return static_cast<unsigned int>(num);
+    if(valid >= end) return 0;
+    unsigned int dropped = static_cast<unsigned int>(valid - begin);
+    std::memmove(points, points + dropped, (num - dropped) * sizeof(HistoryPoint));
+    return static_cast<unsigned int>(num - dropped);
+}
+
+uint64_t ChannelHistory::get_count(unsigned int level) const
+{
+    return (level < HISTORY_LEVELS) ? counts[level].load(std::memory_order_acquire) : 0;
+}
+
+HistoryStore::HistoryStore(const std::vector<ChannelCode>& codes, unsigned int period_ms) :
+    period_ms(std::max(period_ms, 1u)),
+    codes(codes),
+    channels(),
+    sampled(false),
+    sample_ms(0)
+{
+    for(unsigned int i = 0; i < codes.size(); i++)
+    {
+        channels.push_back(std::unique_ptr<ChannelHistory>(new ChannelHistory()));
+    }
+}
+
+HistoryStore::~HistoryStore()
+{
+}
+
+bool HistoryStore::record(uint64_t time_ms, const double *values, unsigned int num)
+{
+    if(!is_due(time_ms)) return false;
+
+    num = std::min<unsigned int>(num, static_cast<unsigned int>(channels.size()));
+    for(unsigned int i = 0; i < num; i++)
+    {
+        channels[i]->add(time_ms, values[i]);
+    }
+    sampled = true;
+    sample_ms = time_ms;
+    return true;
+}
+
+bool HistoryStore::is_due(uint64_t time_ms) const
+{
+    return !sampled || (time_ms >= sample_ms + period_ms);
+}
+
+unsigned int HistoryStore::get_period() const
+{
+    return period_ms;
+}
+
+const std::vector<ChannelCode>& HistoryStore::get_codes() const
+{
+    return codes;
+}
+
+const ChannelHistory* HistoryStore::find(ChannelCode code) const
+{
+    std::vector<ChannelCode>::const_iterator it = std::find(codes.begin(), codes.end(), code);
+    return (it != codes.end()) ? channels[it - codes.begin()].get() : nullptr;
+}
+
+unsigned int HistoryStore::get_level(uint64_t span_ms) const
+{
+    uint64_t cover_ms = static_cast<uint64_t>(period_ms) * (HISTORY_SIZE - 1);
+    unsigned int level = 0;
+    while((level + 1 < HISTORY_LEVELS) && (cover_ms < span_ms))
+    {
+        cover_ms *= HISTORY_DECIMATION;
+        level++;
+    }
+    return level;
+}
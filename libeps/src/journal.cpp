@@ -0,0 +1,183 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "journal.hpp"
+#include <algorithm>
+
+using namespace itc::eps;
+
+Journal::Journal(const JournalConfig& config) :
+    config(config),
+    events(std::max<std::size_t>(config.max_events, 1)),
+    first_seq(0),
+    next_seq(0),
+    keyframes(std::max<std::size_t>(config.max_keyframes, 1)),
+    keyframe_first(0),
+    keyframe_count(0)
+{
+    // keyframe often enough that replayable events are never all overwritten
+    if(this->config.keyframe_events == 0) this->config.keyframe_events = std::max<std::size_t>(events.size() / 4, 1);
+}
+
+Journal::~Journal()
+{
+}
+
+const JournalConfig& Journal::get_config() const
+{
+    return config;
+}
+
+void Journal::record(JournalEventType type, SimTime time, uint32_t num, double value)
+{
+    JournalEvent& event = append(type, time);
+    event.num = num;
+    event.value = value;
+}
+
+void Journal::record(SimTime time, const I2CData& data)
+{
+    JournalEvent& event = append(JOURNAL_I2C_WRITE, time);
+    event.size = static_cast<uint8_t>(std::min(data.size(), JOURNAL_I2C_SIZE));
+    std::copy(data.begin(), data.begin() + event.size, event.data);
+}
+
+bool Journal::is_keyframe_due(SimTime time) const
+{
+    if(keyframe_count == 0) return true;
+
+    const JournalKeyframe& last = keyframe(keyframe_count - 1);
+    if(next_seq - last.seq >= config.keyframe_events) return true;
+    return (config.keyframe_interval_ms > 0) && (time >= last.time_ms + config.keyframe_interval_ms);
+}
+
+StateBlob& Journal::add_keyframe(SimTime time)
+{
+    // replace latest keyframe if no events were recorded since
+    if((keyframe_count == 0) || (keyframe(keyframe_count - 1).seq != next_seq))
+    {
+        if(keyframe_count == keyframes.size())
+        {
+            keyframe_first = (keyframe_first + 1) % keyframes.size();
+            keyframe_count--;
+        }
+        keyframe_count++;
+    }
+
+    JournalKeyframe& slot = keyframe(keyframe_count - 1);
+    slot.seq = next_seq;
+    slot.time_ms = time;
+    slot.state.clear();
+    return slot.state;
+}
+
+const JournalKeyframe* Journal::find_keyframe(SimTime time) const
+{
+    for(std::size_t i = keyframe_count; i > 0; i--)
+    {
+        const JournalKeyframe& slot = keyframe(i - 1);
+        if(slot.time_ms <= time) return &slot;
+    }
+    return nullptr;
+}
+
+void Journal::truncate(uint64_t seq, SimTime time)
+{
+    next_seq = std::max(first_seq, std::min(seq, next_seq));
+    while((keyframe_count > 0) &&
+          ((keyframe(keyframe_count - 1).seq > next_seq) || (keyframe(keyframe_count - 1).time_ms > time)))
+    {
+        keyframe_count--;
+    }
+}
+
+void Journal::clear()
+{
+    first_seq = next_seq;
+    keyframe_count = 0;
+}
+
+uint64_t Journal::get_first_seq() const
+{
+    return first_seq;
+}
+
+uint64_t Journal::get_next_seq() const
+{
+    return next_seq;
+}
+
+const JournalEvent& Journal::get_event(uint64_t seq) const
+{
+    return events[seq % events.size()];
+}
+
+std::size_t Journal::get_num_keyframes() const
+{
+    return keyframe_count;
+}
+
+bool Journal::get_begin_time(SimTime& time) const
+{
+    if(keyframe_count == 0) return false;
+    time = keyframe(0).time_ms;
+    return true;
+}
+
+std::size_t Journal::get_memory_usage() const
+{
+    std::size_t size = events.size() * sizeof(JournalEvent) + keyframes.size() * sizeof(JournalKeyframe);
+    for(std::size_t i = 0; i < keyframes.size(); i++)
+    {
+        size += keyframes[i].state.capacity();
+    }
+    return size;
+}
+
+JournalEvent& Journal::append(JournalEventType type, SimTime time)
+{
+    // overwrite oldest event and drop keyframes that can no longer be replayed
+    if(next_seq - first_seq == events.size())
+    {
+        first_seq++;
+        while((keyframe_count > 0) && (keyframe(0).seq < first_seq))
+        {
+            keyframe_first = (keyframe_first + 1) % keyframes.size();
+            keyframe_count--;
+        }
+    }
+
+    JournalEvent& event = events[next_seq % events.size()];
+    event.seq = next_seq++;
+    event.time_ms = time;
+    event.type = type;
+    event.size = 0;
+    event.num = 0;
+    event.value = 0.0;
+    return event;
+}
+
+JournalKeyframe& Journal::keyframe(std::size_t index)
+{
+    return keyframes[(keyframe_first + index) % keyframes.size()];
+}
+
+const JournalKeyframe& Journal::keyframe(std::size_t index) const
+{
+    return keyframes[(keyframe_first + index) % keyframes.size()];
+}
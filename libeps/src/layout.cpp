@@ -0,0 +1,320 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "layout.hpp"
+#include "bcr.hpp"
+#include "pcm.hpp"
+#include "pdm.hpp"
+#include "util.hpp"
+#include <set>
+
+using namespace itc::eps;
+
+namespace
+{
+    /**
+     * \brief Build Clyde Space 3rd generation 3U EPS layout
+     */
+    BoardLayout build_clyde_3g()
+    {
+        BoardLayout layout;
+
+        // battery charge regulators (bcr)
+        unsigned int bcr = layout.add_bus("BCR", BUS_BCR, NUM_BCRS);
+        const ChannelCode BCR_CHANNELS[NUM_BCRS][7] = {
+            {CHANNEL_VBCR1, CHANNEL_IBCR1A, CHANNEL_IBCR1B, CHANNEL_TBCR1A, CHANNEL_TBCR1B, CHANNEL_SDBCR1A, CHANNEL_SDBCR1B},
+            {CHANNEL_VBCR2, CHANNEL_IBCR2A, CHANNEL_IBCR2B, CHANNEL_TBCR2A, CHANNEL_TBCR2B, CHANNEL_SDBCR2A, CHANNEL_SDBCR2B},
+            {CHANNEL_VBCR3, CHANNEL_IBCR3A, CHANNEL_IBCR3B, CHANNEL_TBCR3A, CHANNEL_TBCR3B, CHANNEL_SDBCR3A, CHANNEL_SDBCR3B},
+            {CHANNEL_VBCR4, CHANNEL_IBCR4A, CHANNEL_IBCR4B, CHANNEL_TBCR4A, CHANNEL_TBCR4B, CHANNEL_SDBCR4A, CHANNEL_SDBCR4B},
+            {CHANNEL_VBCR5, CHANNEL_IBCR5A, CHANNEL_IBCR5B, CHANNEL_TBCR5A, CHANNEL_TBCR5B, CHANNEL_SDBCR5A, CHANNEL_SDBCR5B}
+        };
+        const ChannelSlot BCR_SLOTS[7] = {
+            SLOT_VOLTAGE, SLOT_CURRENT, SLOT_CURRENT_B, SLOT_TEMP, SLOT_TEMP_B, SLOT_SUN, SLOT_SUN_B
+        };
+        for(unsigned int i = 0; i < NUM_BCRS; i++)
+        {
+            for(unsigned int j = 0; j < 7; j++)
+            {
+                layout.add_channel(BCR_CHANNELS[i][j], bcr, BCR_SLOTS[j], i);
+            }
+        }
+        layout.set_node_reset(bcr);
+
+        // power conditioning module (pcm) buses (reset bits in bus type order)
+        const ChannelCode PCM_CHANNELS[NUM_PCM_BUSES][2] = {
+            {CHANNEL_VPCMBATV, CHANNEL_IPCMBATV},
+            {CHANNEL_VPCM5V,   CHANNEL_IPCM5V},
+            {CHANNEL_VPCM3V3,  CHANNEL_IPCM3V3},
+            {CHANNEL_VPCM12V,  CHANNEL_IPCM12V}
+        };
+        unsigned int pcm[NUM_PCM_BUSES];
+        for(int i = 0; i < NUM_PCM_BUSES; i++)
+        {
+            pcm[i] = layout.add_bus(to_string(static_cast<PcmBusType>(i)), BUS_PCM);
+            layout.connect(bcr, pcm[i]);
+            layout.add_channel(PCM_CHANNELS[i][0], pcm[i], SLOT_VOLTAGE);
+            layout.add_channel(PCM_CHANNELS[i][1], pcm[i], SLOT_CURRENT);
+            layout.add_pcm_reset(pcm[i]);
+        }
+
+        // power distribution module (pdm) switches
+        const PcmBusType PDM_SOURCE[NUM_SWITCHES] = {
+            PCM_BUS_12V, PCM_BUS_12V, PCM_BUS_5V, PCM_BUS_3V3, PCM_BUS_5V,
+            PCM_BUS_5V,  PCM_BUS_5V,  PCM_BUS_3V3, PCM_BUS_3V3, PCM_BUS_3V3
+        };
+        const ChannelCode PDM_CHANNELS[NUM_SWITCHES][2] = {
+            {CHANNEL_VSW1, CHANNEL_ISW1}, {CHANNEL_VSW2, CHANNEL_ISW2}, {CHANNEL_VSW3, CHANNEL_ISW3},
+            {CHANNEL_VSW4, CHANNEL_ISW4}, {CHANNEL_VSW5, CHANNEL_ISW5}, {CHANNEL_VSW6, CHANNEL_ISW6},
+            {CHANNEL_VSW7, CHANNEL_ISW7}, {CHANNEL_VSW8, CHANNEL_ISW8}, {CHANNEL_VSW9, CHANNEL_ISW9},
+            {CHANNEL_VSW10, CHANNEL_ISW10}
+        };
+        for(int i = 0; i < NUM_SWITCHES; i++)
+        {
+            unsigned int pdm = layout.add_bus("PDM_SWITCH_" + to_string(i), BUS_PDM);
+            layout.connect(pcm[PDM_SOURCE[i]], pdm);
+            layout.add_channel(PDM_CHANNELS[i][0], pdm, SLOT_VOLTAGE);
+            layout.add_channel(PDM_CHANNELS[i][1], pdm, SLOT_CURRENT);
+            layout.add_switch(pdm);
+        }
+
+        // misc board telemetry
+        layout.add_channel(CHANNEL_IIDIODE, BoardLayout::NO_BUS, SLOT_MISC);
+        layout.add_channel(CHANNEL_VIDIODE, BoardLayout::NO_BUS, SLOT_MISC);
+        layout.add_channel(CHANNEL_I3V3_DRW, BoardLayout::NO_BUS, SLOT_MISC);
+        layout.add_channel(CHANNEL_I5V_DRW, BoardLayout::NO_BUS, SLOT_MISC);
+        layout.add_channel(CHANNEL_TBRD, BoardLayout::NO_BUS, SLOT_MISC);
+
+        return layout;
+    }
+}
+
+BoardLayout::BoardLayout() :
+    buses(),
+    connections(),
+    channels(),
+    switches(),
+    pcm_resets(),
+    node_reset(NO_BUS)
+{
+}
+
+BoardLayout::~BoardLayout()
+{
+}
+
+const BoardLayout& BoardLayout::clyde_3g()
+{
+    static const BoardLayout layout = build_clyde_3g();
+    return layout;
+}
+
+unsigned int BoardLayout::add_bus(const std::string& name, BusType type, unsigned int units)
+{
+    buses.push_back(BusInfo(name, type, units));
+    return static_cast<unsigned int>(buses.size() - 1);
+}
+
+unsigned int BoardLayout::find_bus(const std::string& name) const
+{
+    for(unsigned int i = 0; i < buses.size(); i++)
+    {
+        if(buses[i].name == name) return i;
+    }
+    return NO_BUS;
+}
+
+void BoardLayout::connect(unsigned int parent, unsigned int child)
+{
+    connections.push_back(Connection(parent, child));
+}
+
+void BoardLayout::add_channel(ChannelCode code, unsigned int bus, ChannelSlot slot, unsigned int unit)
+{
+    channels.push_back(ChannelInfo(code, (slot == SLOT_MISC) ? NO_BUS : bus, slot, unit));
+}
+
+void BoardLayout::add_switch(unsigned int bus)
+{
+    switches.push_back(bus);
+}
+
+void BoardLayout::add_pcm_reset(unsigned int bus)
+{
+    pcm_resets.push_back(bus);
+}
+
+void BoardLayout::set_node_reset(unsigned int bus)
+{
+    node_reset = bus;
+}
+
+bool BoardLayout::validate(std::string& error) const
+{
+    unsigned int num = static_cast<unsigned int>(buses.size());
+
+    // buses
+    std::set<std::string> names;
+    for(unsigned int i = 0; i < num; i++)
+    {
+        if(!names.insert(buses[i].name).second)
+        {
+            error = "duplicate bus name: " + buses[i].name;
+            return false;
+        }
+        if((buses[i].type == BUS_BCR) && (buses[i].units == 0))
+        {
+            error = "bcr bus has no regulators: " + buses[i].name;
+            return false;
+        }
+    }
+
+    // connections (must form an acyclic graph)
+    std::vector<unsigned int> in_degree(num, 0);
+    for(unsigned int i = 0; i < connections.size(); i++)
+    {
+        if((connections[i].first >= num) || (connections[i].second >= num) ||
+           (connections[i].first == connections[i].second))
+        {
+            error = "invalid bus connection";
+            return false;
+        }
+        in_degree[connections[i].second]++;
+    }
+    std::vector<unsigned int> ready;
+    for(unsigned int i = 0; i < num; i++)
+    {
+        if(in_degree[i] == 0) ready.push_back(i);
+    }
+    unsigned int visited = 0;
+    while(!ready.empty())
+    {
+        unsigned int bus = ready.back();
+        ready.pop_back();
+        visited++;
+        for(unsigned int i = 0; i < connections.size(); i++)
+        {
+            if((connections[i].first == bus) && (--in_degree[connections[i].second] == 0))
+            {
+                ready.push_back(connections[i].second);
+            }
+        }
+    }
+    if(visited != num)
+    {
+        error = "bus connections contain a cycle";
+        return false;
+    }
+
+    // channels
+    std::set<unsigned int> codes;
+    for(unsigned int i = 0; i < channels.size(); i++)
+    {
+        const ChannelInfo& ch = channels[i];
+        std::string code = to_string(static_cast<unsigned int>(ch.code), true);
+        if(!codes.insert(ch.code).second)
+        {
+            error = "duplicate telemetry channel: 0x" + code;
+            return false;
+        }
+        if(ch.slot == SLOT_MISC) continue;
+        if(ch.bus >= num)
+        {
+            error = "telemetry channel assigned to invalid bus: 0x" + code;
+            return false;
+        }
+        const BusInfo& bus = buses[ch.bus];
+        bool bcr_slot = (bus.type == BUS_BCR) && (ch.unit < bus.units);
+        bool bus_slot = (ch.slot == SLOT_VOLTAGE) || (ch.slot == SLOT_CURRENT);
+        if(!bcr_slot && !((bus.type != BUS_BCR) && bus_slot))
+        {
+            error = "invalid telemetry channel slot for bus " + bus.name + ": 0x" + code;
+            return false;
+        }
+    }
+
+    // command mappings
+    std::set<unsigned int> mapped;
+    for(unsigned int i = 0; i < switches.size(); i++)
+    {
+        if((switches[i] >= num) || (buses[switches[i]].type != BUS_PDM) || !mapped.insert(switches[i]).second)
+        {
+            error = "invalid pdm switch mapping: " + to_string(i + 1);
+            return false;
+        }
+    }
+    for(unsigned int i = 0; i < pcm_resets.size(); i++)
+    {
+        if((pcm_resets[i] >= num) || (buses[pcm_resets[i]].type != BUS_PCM))
+        {
+            error = "invalid pcm reset mapping: bit " + to_string(i);
+            return false;
+        }
+    }
+    if(pcm_resets.size() > 8)
+    {
+        error = "too many pcm reset bits (max 8)";
+        return false;
+    }
+    if(node_reset >= num)
+    {
+        error = "missing node reset bus";
+        return false;
+    }
+
+    return true;
+}
+
+ChannelCode BoardLayout::find_channel(unsigned int bus, ChannelSlot slot, unsigned int unit) const
+{
+    for(unsigned int i = 0; i < channels.size(); i++)
+    {
+        const ChannelInfo& ch = channels[i];
+        if((ch.bus == bus) && (ch.slot == slot) && (ch.unit == unit)) return ch.code;
+    }
+    return CHANNEL_INVALID;
+}
+
+const std::vector<BusInfo>& BoardLayout::get_buses() const
+{
+    return buses;
+}
+
+const std::vector<BoardLayout::Connection>& BoardLayout::get_connections() const
+{
+    return connections;
+}
+
+const std::vector<ChannelInfo>& BoardLayout::get_channels() const
+{
+    return channels;
+}
+
+const std::vector<unsigned int>& BoardLayout::get_switches() const
+{
+    return switches;
+}
+
+const std::vector<unsigned int>& BoardLayout::get_pcm_resets() const
+{
+    return pcm_resets;
+}
+
+unsigned int BoardLayout::get_node_reset() const
+{
+    return node_reset;
+}
@@ -0,0 +1,192 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "load.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace itc::eps;
+
+FileLoadProfile::FileLoadProfile(bool loop) :
+    loop(loop),
+    samples(std::make_shared<Samples>()),
+    cursor(0)
+{
+}
+
+FileLoadProfile::~FileLoadProfile()
+{
+}
+
+bool FileLoadProfile::load(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if(!file)
+    {
+        EPS_LOG_ERROR("unable to open load profile: %s", filename.c_str());
+        return false;
+    }
+
+    samples = std::make_shared<Samples>();
+    cursor = 0;
+
+    std::string line;
+    unsigned int num = 0;
+    while(std::getline(file, line))
+    {
+        num++;
+
+        // strip comments and separators
+        line = line.substr(0, line.find('#'));
+        std::replace(line.begin(), line.end(), ',', ' ');
+
+        std::istringstream ss(line);
+        SimTime time;
+        double current;
+        if(!(ss >> time)) continue; // blank line
+        if(!(ss >> current) || (!samples->times.empty() && time < samples->times.back()))
+        {
+            EPS_LOG_ERROR("invalid load profile sample: %s:%u", filename.c_str(), num);
+            return false;
+        }
+        add_sample(time, current);
+    }
+
+    EPS_LOG_INFO("loaded load profile %s: %lu samples", filename.c_str(), static_cast<unsigned long>(samples->times.size()));
+    return true;
+}
+
+void FileLoadProfile::add_sample(SimTime time, double current)
+{
+    Samples& data = get_samples();
+    if(!data.times.empty() && time < data.times.back())
+    {
+        EPS_LOG_ERROR("load profile sample out of order: time=%lums", static_cast<unsigned long>(time));
+        return;
+    }
+    data.times.push_back(time);
+    data.currents.push_back(current);
+}
+
+double FileLoadProfile::get_current(SimTime time)
+{
+    const std::vector<SimTime>& times = samples->times;
+    const std::vector<double>& currents = samples->currents;
+    if(times.empty()) return 0.0;
+
+    // last sample time is the loop period
+    if(loop && (times.back() > 0)) time %= times.back();
+
+    // no load before first sample
+    if(time < times.front()) return 0.0;
+
+    // time normally advances so step forward from last sample, otherwise search
+    if(time < times[cursor])
+    {
+        cursor = (std::upper_bound(times.begin(), times.end(), time) - times.begin()) - 1;
+    }
+    while((cursor + 1 < times.size()) && (times[cursor + 1] <= time))
+    {
+        cursor++;
+    }
+    return currents[cursor];
+}
+
+std::shared_ptr<LoadProfile> FileLoadProfile::fork() const
+{
+    std::shared_ptr<FileLoadProfile> profile(new FileLoadProfile(loop));
+    profile->samples = samples;
+    profile->cursor = cursor;
+    return profile;
+}
+
+FileLoadProfile::Samples& FileLoadProfile::get_samples()
+{
+    if(samples.use_count() > 1) samples = std::make_shared<Samples>(*samples);
+    return *samples;
+}
+
+LoadPublisher::LoadPublisher() :
+    mutex(),
+    dirty(false),
+    currents(),
+    pending()
+{
+}
+
+LoadPublisher::~LoadPublisher()
+{
+}
+
+void LoadPublisher::publish(const LoadBatch& batch)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(LoadBatch::const_iterator it = batch.begin(); it != batch.end(); ++it)
+    {
+        add(*it);
+    }
+    dirty.store(true, std::memory_order_release);
+}
+
+void LoadPublisher::publish(unsigned int num, double current)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    add(LoadSample(num, current));
+    dirty.store(true, std::memory_order_release);
+}
+
+void LoadPublisher::add(const LoadSample& sample)
+{
+    if(sample.num >= MAX_PUBLISHED_LOADS)
+    {
+        EPS_LOG_ERROR("invalid published load switch number: %d", sample.num);
+        return;
+    }
+
+    // later samples replace pending sample of the same switch
+    if(sample.num >= currents.size())
+    {
+        currents.resize(sample.num + 1, 0.0);
+        pending.resize(sample.num / 64 + 1, 0);
+    }
+    currents[sample.num] = sample.current;
+    pending[sample.num / 64] |= uint64_t(1) << (sample.num % 64);
+}
+
+bool LoadPublisher::drain(LoadBatch& batch)
+{
+    batch.clear();
+
+    // skip lock when nothing published
+    if(!dirty.load(std::memory_order_acquire)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for(unsigned int w = 0; w < pending.size(); w++)
+    {
+        for(uint64_t bits = pending[w]; bits; bits &= bits - 1)
+        {
+            unsigned int num = w * 64 + __builtin_ctzll(bits);
+            batch.push_back(LoadSample(num, currents[num]));
+        }
+        pending[w] = 0;
+    }
+    dirty.store(false, std::memory_order_relaxed);
+    return !batch.empty();
+}
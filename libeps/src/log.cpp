@@ -0,0 +1,522 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "log.hpp"
+#include "types.hpp"
+#include <ItcLogger/Logger.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+
+using namespace itc::eps;
+
+static ItcLogger::Logger *logger = ItcLogger::Logger::get(LOGGER_NAME.c_str());
+
+static_assert(sizeof(LogEntry) == 256, "log entry must be 256 bytes");
+
+static const char *LEVEL_NAMES[] = {"OFF", "ERROR", "WARNING", "INFO", "DEBUG"}; //!< Level names (by LogLevel)
+static const std::chrono::milliseconds WRITER_IDLE(1); //!< Writer thread sleep when no records are queued
+
+void LogEncoder::add(LogArgType type, const void *value, size_t size)
+{
+    if(static_cast<size_t>(entry.size) + 1 + size > LOG_PAYLOAD_SIZE)
+    {
+        entry.truncated = 1;
+        return;
+    }
+    entry.payload[entry.size] = static_cast<uint8_t>(type);
+    std::memcpy(&entry.payload[entry.size + 1], value, size);
+    entry.size = static_cast<uint16_t>(entry.size + 1 + size);
+}
+
+void LogEncoder::add_string(const char *value, size_t length)
+{
+    // tag and length byte, then as much of the string as fits
+    if(static_cast<size_t>(entry.size) + 2 > LOG_PAYLOAD_SIZE)
+    {
+        entry.truncated = 1;
+        return;
+    }
+    size_t space = std::min<size_t>(LOG_PAYLOAD_SIZE - entry.size - 2, 0xff);
+    if(length > space)
+    {
+        length = space;
+        entry.truncated = 1;
+    }
+    entry.payload[entry.size] = LOG_ARG_STRING;
+    entry.payload[entry.size + 1] = static_cast<uint8_t>(length);
+    std::memcpy(&entry.payload[entry.size + 2], value, length);
+    entry.size = static_cast<uint16_t>(entry.size + 2 + length);
+}
+
+LogRing::LogRing(unsigned int capacity) :
+    mask(get_ring_size(capacity) - 1),
+    cells(new Cell[mask + 1]),
+    enqueue(0),
+    dequeue(0)
+{
+    for(uint64_t i = 0; i <= mask; i++)
+    {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+LogRing::~LogRing()
+{
+}
+
+uint64_t LogRing::get_ring_size(unsigned int capacity)
+{
+    uint64_t size = 2;
+    while(size < capacity) size <<= 1;
+    return size;
+}
+
+LogEntry *LogRing::claim(uint64_t& ticket)
+{
+    // a cell is free when its sequence equals the ticket claiming it
+    uint64_t pos = enqueue.load(std::memory_order_relaxed);
+    while(true)
+    {
+        Cell& cell = cells[pos & mask];
+        int64_t diff = static_cast<int64_t>(cell.sequence.load(std::memory_order_acquire) - pos);
+        if(diff == 0)
+        {
+            if(enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                ticket = pos;
+                return &cell.entry;
+            }
+        }
+        else if(diff < 0)
+        {
+            return nullptr; // full
+        }
+        else
+        {
+            pos = enqueue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void LogRing::publish(uint64_t ticket)
+{
+    cells[ticket & mask].sequence.store(ticket + 1, std::memory_order_release);
+}
+
+bool LogRing::pop(LogEntry& entry)
+{
+    Cell& cell = cells[dequeue & mask];
+    if(cell.sequence.load(std::memory_order_acquire) != dequeue + 1) return false;
+    entry = cell.entry;
+    cell.sequence.store(dequeue + mask + 1, std::memory_order_release);
+    dequeue++;
+    return true;
+}
+
+BinaryLog& BinaryLog::get()
+{
+    static BinaryLog log;
+    return log;
+}
+
+BinaryLog::BinaryLog() :
+    level_threshold(LEVEL_DEBUG),
+    active(false),
+    ring(),
+    dropped(0),
+    site_mutex(),
+    sites()
+{
+}
+
+LogLevel BinaryLog::get_level() const
+{
+    return static_cast<LogLevel>(level_threshold.load(std::memory_order_relaxed));
+}
+
+void BinaryLog::set_level(LogLevel level)
+{
+    level_threshold.store(level, std::memory_order_relaxed);
+}
+
+uint32_t BinaryLog::register_site(LogSite& site, LogLevel level, const char *format)
+{
+    std::lock_guard<std::mutex> lock(site_mutex);
+    uint32_t id = site.id.load(std::memory_order_relaxed);
+    if(id != 0) return id; // registered by another thread
+    sites.push_back(std::make_pair(level, format));
+    id = static_cast<uint32_t>(sites.size());
+    site.id.store(id, std::memory_order_release);
+    return id;
+}
+
+const char *BinaryLog::get_site(uint32_t id, LogLevel& level) const
+{
+    std::lock_guard<std::mutex> lock(site_mutex);
+    if((id == 0) || (id > sites.size())) return nullptr;
+    level = sites[id - 1].first;
+    return sites[id - 1].second;
+}
+
+uint64_t BinaryLog::get_dropped() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void BinaryLog::forward(const LogEntry& entry, const char *format)
+{
+    std::string message = format_log_message(format, entry);
+    switch(entry.level)
+    {
+        case LEVEL_ERROR:
+            logger->error("%s", message.c_str());
+            break;
+        case LEVEL_WARNING:
+            logger->warning("%s", message.c_str());
+            break;
+        case LEVEL_INFO:
+            logger->info("%s", message.c_str());
+            break;
+        default:
+            logger->debug("%s", message.c_str());
+            break;
+    }
+}
+
+uint64_t BinaryLog::get_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+LogWriter::LogWriter(const std::string& binary_file, unsigned int capacity) :
+    log(BinaryLog::get()),
+    file(nullptr),
+    written(),
+    reported_dropped(log.get_dropped()),
+    running(true),
+    thread()
+{
+    if(!binary_file.empty())
+    {
+        file = std::fopen(binary_file.c_str(), "wb");
+        if(file == nullptr)
+        {
+            EPS_LOG_ERROR("unable to open binary log file %s: %s", binary_file, std::strerror(errno));
+        }
+        else
+        {
+            std::fwrite(LOG_FILE_MAGIC, sizeof(LOG_FILE_MAGIC), 1, file);
+        }
+    }
+
+    // queue records from now on
+    if(!log.ring) log.ring.reset(new LogRing(capacity));
+    log.active.store(true, std::memory_order_release);
+    thread = std::thread(&LogWriter::run, this);
+}
+
+LogWriter::~LogWriter()
+{
+    // write queued records, then stop queueing (records queued meanwhile are written here)
+    running.store(false, std::memory_order_release);
+    thread.join();
+    log.active.store(false, std::memory_order_release);
+    LogEntry entry;
+    while(log.ring->pop(entry)) write(entry);
+    if(file != nullptr) std::fclose(file);
+}
+
+void LogWriter::run()
+{
+    LogEntry entry;
+    while(true)
+    {
+        if(log.ring->pop(entry))
+        {
+            write(entry);
+            continue;
+        }
+
+        // report dropped records once there is room again
+        uint64_t dropped = log.get_dropped();
+        if(dropped != reported_dropped)
+        {
+            EPS_LOG_WARNING("log ring full, %lu records dropped", static_cast<unsigned long>(dropped - reported_dropped));
+            reported_dropped = dropped;
+            continue;
+        }
+
+        if(file != nullptr) std::fflush(file);
+        if(!running.load(std::memory_order_acquire)) break;
+        std::this_thread::sleep_for(WRITER_IDLE);
+    }
+}
+
+void LogWriter::write(const LogEntry& entry)
+{
+    LogLevel level = LEVEL_OFF;
+    const char *format = log.get_site(entry.site, level);
+    if(format == nullptr) return;
+    if(file == nullptr)
+    {
+        BinaryLog::forward(entry, format);
+        return;
+    }
+
+    // call site record before its first entry: 'S', id, level, format length, format
+    if(entry.site >= written.size()) written.resize(entry.site + 1, false);
+    if(!written[entry.site])
+    {
+        uint8_t site_level = static_cast<uint8_t>(level);
+        uint16_t length = static_cast<uint16_t>(std::min<size_t>(std::strlen(format), 0xffff));
+        std::fputc('S', file);
+        std::fwrite(&entry.site, sizeof(entry.site), 1, file);
+        std::fwrite(&site_level, sizeof(site_level), 1, file);
+        std::fwrite(&length, sizeof(length), 1, file);
+        std::fwrite(format, 1, length, file);
+        written[entry.site] = true;
+    }
+
+    // entry record: 'E', entry
+    std::fputc('E', file);
+    std::fwrite(&entry, sizeof(entry), 1, file);
+}
+
+LogLevel itc::eps::to_log_level(const std::string& name)
+{
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {return std::tolower(c);});
+    if(lower == "off") return LEVEL_OFF;
+    if(lower == "error") return LEVEL_ERROR;
+    if((lower == "warning") || (lower == "warn")) return LEVEL_WARNING;
+    if(lower == "debug") return LEVEL_DEBUG;
+    return LEVEL_INFO;
+}
+
+namespace
+{
+    /**
+     * \brief Decoded log argument
+     */
+    struct LogArg
+    {
+        LogArgType type;   //!< Argument type
+        int64_t i;         //!< Signed integer value
+        uint64_t u;        //!< Unsigned integer value
+        double f;          //!< Floating point value
+        std::string s;     //!< String value
+    };
+
+    // next encoded argument
+    bool read_arg(const LogEntry& entry, size_t& offset, LogArg& arg)
+    {
+        if(offset >= entry.size) return false;
+        arg.type = static_cast<LogArgType>(entry.payload[offset]);
+        if(arg.type == LOG_ARG_STRING)
+        {
+            if(offset + 2 > entry.size) return false;
+            size_t length = entry.payload[offset + 1];
+            if(offset + 2 + length > entry.size) return false;
+            arg.s.assign(reinterpret_cast<const char*>(&entry.payload[offset + 2]), length);
+            offset += 2 + length;
+            return true;
+        }
+        if(offset + 1 + sizeof(uint64_t) > entry.size) return false;
+        const uint8_t *value = &entry.payload[offset + 1];
+        offset += 1 + sizeof(uint64_t);
+        switch(arg.type)
+        {
+            case LOG_ARG_INT:
+                std::memcpy(&arg.i, value, sizeof(arg.i));
+                arg.u = static_cast<uint64_t>(arg.i);
+                arg.f = static_cast<double>(arg.i);
+                return true;
+            case LOG_ARG_UINT:
+                std::memcpy(&arg.u, value, sizeof(arg.u));
+                arg.i = static_cast<int64_t>(arg.u);
+                arg.f = static_cast<double>(arg.u);
+                return true;
+            case LOG_ARG_DOUBLE:
+                std::memcpy(&arg.f, value, sizeof(arg.f));
+                arg.i = static_cast<int64_t>(arg.f);
+                arg.u = static_cast<uint64_t>(arg.i);
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+std::string itc::eps::format_log_message(const char *format, const LogEntry& entry)
+{
+    std::string message;
+    size_t offset = 0;
+    char buffer[256];
+    const char *p = format;
+    while(*p != '\0')
+    {
+        if(*p != '%')
+        {
+            message += *p++;
+            continue;
+        }
+        if(p[1] == '%')
+        {
+            message += '%';
+            p += 2;
+            continue;
+        }
+
+        // conversion (flags, width and precision kept, length replaced by the encoded width)
+        const char *begin = p++;
+        std::string spec("%");
+        while((*p != '\0') && (std::strchr("-+ #0", *p) != nullptr)) spec += *p++;
+        while((*p != '\0') && (std::isdigit(static_cast<unsigned char>(*p)) || (*p == '.'))) spec += *p++;
+        while((*p != '\0') && (std::strchr("hlLqjzt", *p) != nullptr)) p++;
+        char conversion = *p;
+        if(conversion != '\0') p++;
+
+        LogArg arg;
+        if((conversion == '\0') || !read_arg(entry, offset, arg))
+        {
+            message.append(begin, p);
+            continue;
+        }
+        switch(conversion)
+        {
+            case 'd':
+            case 'i':
+                std::snprintf(buffer, sizeof(buffer), (spec + "lld").c_str(), static_cast<long long>(arg.i));
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                std::snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(),
+                              static_cast<unsigned long long>(arg.u));
+                break;
+            case 'c':
+                std::snprintf(buffer, sizeof(buffer), (spec + "c").c_str(), static_cast<int>(arg.i));
+                break;
+            case 'e':
+            case 'E':
+            case 'f':
+            case 'F':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                std::snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), arg.f);
+                break;
+            case 's':
+                if(arg.type != LOG_ARG_STRING) arg.s = (arg.type == LOG_ARG_DOUBLE) ? std::to_string(arg.f) : std::to_string(arg.i);
+                std::snprintf(buffer, sizeof(buffer), (spec + "s").c_str(), arg.s.c_str());
+                break;
+            default:
+                std::snprintf(buffer, sizeof(buffer), "%s", std::string(begin, p).c_str());
+                break;
+        }
+        message += buffer;
+    }
+    if(entry.truncated) message += "...";
+    return message;
+}
+
+std::string itc::eps::format_log_line(const char *format, const LogEntry& entry)
+{
+    std::time_t seconds = static_cast<std::time_t>(entry.time_ns / 1000000000ull);
+    std::tm local;
+    localtime_r(&seconds, &local);
+    char time[64];
+    std::size_t length = std::strftime(time, sizeof(time), "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(time + length, sizeof(time) - length, ".%06u", static_cast<unsigned int>((entry.time_ns / 1000) % 1000000));
+    const char *level = (entry.level <= LEVEL_DEBUG) ? LEVEL_NAMES[entry.level] : "UNKNOWN";
+    return std::string(time) + " [" + level + "] - " + format_log_message(format, entry);
+}
+
+bool itc::eps::decode_log(const std::string& filename, FILE *out)
+{
+    FILE *file = std::fopen(filename.c_str(), "rb");
+    if(file == nullptr)
+    {
+        EPS_LOG_ERROR("unable to open binary log file %s: %s", filename, std::strerror(errno));
+        return false;
+    }
+    char magic[sizeof(LOG_FILE_MAGIC)];
+    if((std::fread(magic, sizeof(magic), 1, file) != 1) || (std::memcmp(magic, LOG_FILE_MAGIC, sizeof(magic)) != 0))
+    {
+        EPS_LOG_ERROR("invalid binary log file: %s", filename);
+        std::fclose(file);
+        return false;
+    }
+
+    // call site formats by ID, then entries formatted as text lines
+    std::vector<std::string> formats;
+    bool ok = true;
+    int type = 0;
+    while((type = std::fgetc(file)) != EOF)
+    {
+        if(type == 'S')
+        {
+            uint32_t id = 0;
+            uint8_t level = 0;
+            uint16_t length = 0;
+            if((std::fread(&id, sizeof(id), 1, file) != 1) || (std::fread(&level, sizeof(level), 1, file) != 1) ||
+               (std::fread(&length, sizeof(length), 1, file) != 1))
+            {
+                ok = false;
+                break;
+            }
+            std::string format(length, '\0');
+            if(((length > 0) && (std::fread(&format[0], 1, length, file) != length)) ||
+               (id == 0) || (id > MAX_LOG_SITES))
+            {
+                ok = false;
+                break;
+            }
+            if(id >= formats.size()) formats.resize(id + 1);
+            formats[id] = format;
+        }
+        else if(type == 'E')
+        {
+            LogEntry entry;
+            if(std::fread(&entry, sizeof(entry), 1, file) != 1)
+            {
+                ok = false;
+                break;
+            }
+            std::size_t size = std::min<std::size_t>(entry.size, LOG_PAYLOAD_SIZE);
+            entry.size = static_cast<uint16_t>(size);
+            const std::string unknown("(unknown log format)");
+            const std::string& format = (entry.site < formats.size()) ? formats[entry.site] : unknown;
+            std::fprintf(out, "%s\n", format_log_line(format.c_str(), entry).c_str());
+        }
+        else
+        {
+            ok = false;
+            break;
+        }
+    }
+    if(!ok) EPS_LOG_ERROR("binary log file has an invalid or partial record: %s", filename);
+    std::fclose(file);
+    return ok;
+}
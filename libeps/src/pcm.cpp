@@ -42,3 +42,14 @@ void PcmBus::on_reset(bool state)
     data.current.set_active(!state);
 }
 
+void PcmBus::save_state(StateWriter& writer) const
+{
+    data.voltage.save_state(writer);
+    data.current.save_state(writer);
+}
+
+bool PcmBus::load_state(StateReader& reader)
+{
+    bool loaded = data.voltage.load_state(reader);
+    return data.current.load_state(reader) && loaded;
+}
@@ -18,6 +18,7 @@
 */
 
 #include "pdm.hpp"
+#include "trace.hpp"
 
 using namespace itc::eps;
 
@@ -25,9 +26,16 @@ PdmBus::PdmBus() :
     Bus(),
     initial_state(false),
     state(false),
+    tripped(false),
     timer_limit(0xff),
     time_ms(0),
     start_ms(0),
+    load(),
+    state_words(nullptr),
+    state_mask(0),
+    switch_tracker(nullptr),
+    switch_num(0),
+    reported_bits(0),
     data()
 {
 }
@@ -39,10 +47,14 @@ PdmBus::~PdmBus()
 void PdmBus::set_time(SimTime time)
 {
     time_ms = time;
+
+    // update load current
+    if(load) data.current.set_value(load->get_current(time_ms));
     
     // check auto-off time
     if(is_timer_active() && (time_ms >= get_off_time()))
     {
+        trace_instant("pdm_auto_off", "eps", "switch", switch_num);
         set_state(false);
     }
 }
@@ -55,32 +67,31 @@ bool PdmBus::get_initial_state() const
 void PdmBus::set_initial_state(bool state)
 {
     initial_state = state;
+    update_state_words();
 }
 
 bool PdmBus::get_state() const
+{
+    return is_switch_disabled() ? false : (state && !tripped);
+}
+
+bool PdmBus::get_expected_state() const
 {
     return is_switch_disabled() ? false : state;
 }
 
 void PdmBus::set_state(bool state)
 {
-    // activate tlm channel if switch on and not in reset
-    bool active = false;
-
+    // commanding switch clears any overcurrent trip
     this->state = state;
-    if(this->state && !is_reset())
-    {
-        // verify not permanently disabled
-        if(!is_switch_disabled())
-        {
-            // reset timer
-            if(is_timer_active()) start_ms = time_ms;
+    tripped = false;
 
-            active = true;
-        }
+    // reset timer if switch on and not in reset
+    if(this->state && !is_reset() && !is_switch_disabled())
+    {
+        if(is_timer_active()) start_ms = time_ms;
     }
-    data.voltage.set_active(active);
-    data.current.set_active(active);
+    update_channels();
 }
 
 uint8_t PdmBus::get_timer_limit() const
@@ -101,6 +112,8 @@ void PdmBus::set_timer_limit(uint8_t limit)
     // reset timer if switch enabled
     // TODO should timer be reset when limit changed?
     if(state) start_ms = time_ms;
+
+    update_state_words();
 }
 
 uint8_t PdmBus::get_timer_value() const
@@ -110,6 +123,41 @@ uint8_t PdmBus::get_timer_value() const
     return static_cast<uint8_t>(delta_s / 30.0);
 }
 
+bool PdmBus::is_tripped() const
+{
+    return tripped;
+}
+
+void PdmBus::set_tripped(bool tripped)
+{
+    this->tripped = tripped;
+    update_channels();
+}
+
+std::shared_ptr<LoadProfile> PdmBus::get_load() const
+{
+    return load;
+}
+
+void PdmBus::set_load(std::shared_ptr<LoadProfile> load)
+{
+    this->load = load;
+}
+
+void PdmBus::set_state_words(PdmStateWords *words, uint32_t mask)
+{
+    state_words = words;
+    state_mask = mask;
+    update_state_words();
+}
+
+void PdmBus::set_switch_tracker(ChangeTracker *tracker, unsigned int num)
+{
+    switch_tracker = tracker;
+    switch_num = num;
+    reported_bits = get_state_bits();
+}
+
 PdmData* PdmBus::get_data()
 {
     return &data;
@@ -133,22 +181,74 @@ SimTime PdmBus::get_off_time() const
 
 void PdmBus::on_reset(bool state)
 {
-    // activate tlm channel if switch on and not in reset
-    bool active = false;
-    if(this->state && !state)
+    // TODO switch state should equal initial state after reset
+
+    // reset timer if switch on and reset released
+    if(this->state && !state && !is_switch_disabled())
     {
-        // TODO switch state should equal initial state after reset
+        if(is_timer_active()) start_ms = time_ms;
+    }
+    update_channels();
+}
 
-        // verify not permanently disabled
-        if(!is_switch_disabled())
-        {
-            // reset timer
-            if(is_timer_active()) start_ms = time_ms;
+void PdmBus::update_channels()
+{
+    // activate tlm channel if switch on, not tripped, not in reset, and not permanently disabled
+    bool active = state && !tripped && !is_reset() && !is_switch_disabled();
+    data.voltage.set_active(active);
+    data.current.set_active(active);
+    update_state_words();
+}
 
-            active = true;
+void PdmBus::update_state_words()
+{
+    if(state_words)
+    {
+        // set or clear switch bit without branching on state
+        uint32_t keep = ~state_mask;
+        state_words->actual = (state_words->actual & keep) | (-static_cast<uint32_t>(get_state()) & state_mask);
+        state_words->expected = (state_words->expected & keep) | (-static_cast<uint32_t>(get_expected_state()) & state_mask);
+        state_words->initial = (state_words->initial & keep) | (-static_cast<uint32_t>(initial_state) & state_mask);
+    }
+
+    if(switch_tracker)
+    {
+        uint8_t bits = get_state_bits();
+        if(bits != reported_bits)
+        {
+            reported_bits = bits;
+            switch_tracker->notify(CHANGE_SWITCH, switch_num);
         }
     }
-    data.voltage.set_active(active);
-    data.current.set_active(active);
 }
 
+uint8_t PdmBus::get_state_bits() const
+{
+    return static_cast<uint8_t>((get_state() ? 1 : 0) | (get_expected_state() ? 2 : 0) | (initial_state ? 4 : 0));
+}
+
+void PdmBus::save_state(StateWriter& writer) const
+{
+    writer.write(initial_state);
+    writer.write(state);
+    writer.write(tripped);
+    writer.write(timer_limit);
+    writer.write(time_ms);
+    writer.write(start_ms);
+    data.voltage.save_state(writer);
+    data.current.save_state(writer);
+}
+
+bool PdmBus::load_state(StateReader& reader)
+{
+    reader.read(initial_state);
+    reader.read(state);
+    reader.read(tripped);
+    reader.read(timer_limit);
+    reader.read(time_ms);
+    reader.read(start_ms);
+    bool loaded = data.voltage.load_state(reader);
+    loaded = data.current.load_state(reader) && loaded;
+    update_state_words();
+    return loaded;
+}
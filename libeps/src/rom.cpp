@@ -0,0 +1,194 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "rom.hpp"
+#include "log.hpp"
+#include "types.hpp"
+#include <cstring>
+
+using namespace itc::eps;
+
+namespace
+{
+    const unsigned int NUM_CRC_SLICES = 8; // bytes per slicing step
+    const unsigned int NUM_CRC_POWERS = 8 * sizeof(std::size_t);
+
+    /**
+     * \brief Multiply polynomials modulo CRC polynomial
+     *
+     * \param a First polynomial
+     * \param b Second polynomial
+     *
+     * \return Product modulo CRC polynomial
+     */
+    uint16_t crc16_multiply(uint16_t a, uint16_t b)
+    {
+        uint16_t product = 0;
+        for(int i = 15; i >= 0; i--)
+        {
+            product = (product & 0x8000) ? static_cast<uint16_t>((product << 1) ^ CRC16_POLY) : static_cast<uint16_t>(product << 1);
+            if((b >> i) & 1) product ^= a;
+        }
+        return product;
+    }
+
+    /**
+     * \brief CRC lookup tables (built on first use)
+     */
+    struct CrcTables
+    {
+        uint16_t slice[NUM_CRC_SLICES][256]; //!< CRC of byte followed by (index) zero bytes
+        uint16_t power[NUM_CRC_POWERS];      //!< x^(8 * 2^index) modulo CRC polynomial
+
+        CrcTables()
+        {
+            for(unsigned int b = 0; b < 256; b++)
+            {
+                uint16_t crc = static_cast<uint16_t>(b << 8);
+                for(unsigned int i = 0; i < 8; i++)
+                {
+                    crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ CRC16_POLY) : static_cast<uint16_t>(crc << 1);
+                }
+                slice[0][b] = crc;
+            }
+            for(unsigned int k = 1; k < NUM_CRC_SLICES; k++)
+            {
+                for(unsigned int b = 0; b < 256; b++)
+                {
+                    uint16_t crc = slice[k-1][b];
+                    slice[k][b] = static_cast<uint16_t>(crc << 8) ^ slice[0][crc >> 8];
+                }
+            }
+
+            power[0] = 0x0100; // x^8
+            for(unsigned int k = 1; k < NUM_CRC_POWERS; k++)
+            {
+                power[k] = crc16_multiply(power[k-1], power[k-1]);
+            }
+        }
+    };
+
+    const CrcTables& get_crc_tables()
+    {
+        static const CrcTables tables;
+        return tables;
+    }
+}
+
+uint16_t itc::eps::crc16(const uint8_t *data, std::size_t size, uint16_t crc)
+{
+    const CrcTables& tables = get_crc_tables();
+    const uint16_t (*t)[256] = tables.slice;
+
+    // eight bytes per step (table index is number of following bytes)
+    while(size >= NUM_CRC_SLICES)
+    {
+        uint16_t x = crc ^ static_cast<uint16_t>((data[0] << 8) | data[1]);
+        crc = t[7][x >> 8] ^ t[6][x & 0xff] ^ t[5][data[2]] ^ t[4][data[3]] ^
+              t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+        data += NUM_CRC_SLICES;
+        size -= NUM_CRC_SLICES;
+    }
+    while(size-- > 0)
+    {
+        crc = static_cast<uint16_t>(crc << 8) ^ t[0][(crc >> 8) ^ *data++];
+    }
+    return crc;
+}
+
+uint16_t itc::eps::crc16_shift(uint16_t crc, std::size_t size)
+{
+    const CrcTables& tables = get_crc_tables();
+    for(unsigned int k = 0; (k < NUM_CRC_POWERS) && (size > 0); k++, size >>= 1)
+    {
+        if(size & 1) crc = crc16_multiply(crc, tables.power[k]);
+    }
+    return crc;
+}
+
+RomImage::RomImage() :
+    firmware(std::make_shared<const std::vector<uint8_t>>()),
+    firmware_version(0),
+    firmware_board(0),
+    firmware_crc(CRC16_INIT),
+    config(),
+    checksum(0)
+{
+    config.fill(0);
+    checksum = crc16(config.data(), config.size(), firmware_crc);
+}
+
+RomImage::~RomImage()
+{
+}
+
+void RomImage::set_firmware(uint16_t version, uint8_t board)
+{
+    if(!firmware->empty() && (version == firmware_version) && (board == firmware_board)) return;
+
+    // deterministic pseudo random contents per version and board (xorshift)
+    std::shared_ptr<std::vector<uint8_t>> data = std::make_shared<std::vector<uint8_t>>(ROM_FIRMWARE_SIZE);
+    uint32_t x = 0x9e3779b9u ^ (static_cast<uint32_t>(version) << 8) ^ board;
+    for(std::size_t i = 0; i < data->size(); i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        (*data)[i] = static_cast<uint8_t>(x >> 24);
+    }
+
+    firmware = data;
+    firmware_version = version;
+    firmware_board = board;
+    firmware_crc = crc16(firmware->data(), firmware->size());
+    checksum = crc16(config.data(), config.size(), firmware_crc);
+}
+
+void RomImage::write(std::size_t offset, const uint8_t *data, std::size_t size)
+{
+    if((offset > ROM_CONFIG_SIZE) || (size > ROM_CONFIG_SIZE - offset))
+    {
+        EPS_LOG_ERROR("rom config write out of range (offset %u, size %u)", static_cast<unsigned int>(offset), static_cast<unsigned int>(size));
+        return;
+    }
+    if((size == 0) || (std::memcmp(&config[offset], data, size) == 0)) return;
+
+    // CRC is linear: apply CRC of changed bits, shifted past the remaining bytes
+    uint8_t delta[ROM_CONFIG_SIZE];
+    for(std::size_t i = 0; i < size; i++)
+    {
+        delta[i] = config[offset + i] ^ data[i];
+    }
+    checksum ^= crc16_shift(crc16(delta, size, 0), ROM_CONFIG_SIZE - offset - size);
+    std::memcpy(&config[offset], data, size);
+}
+
+uint16_t RomImage::get_checksum() const
+{
+    return checksum;
+}
+
+const std::vector<uint8_t>& RomImage::get_firmware() const
+{
+    return *firmware;
+}
+
+const std::array<uint8_t, ROM_CONFIG_SIZE>& RomImage::get_config() const
+{
+    return config;
+}
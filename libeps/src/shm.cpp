@@ -0,0 +1,241 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "shm.hpp"
+#include "log.hpp"
+#include "types.hpp"
+#include "util.hpp"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared memory requires lock free 64-bit atomics");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "shared memory requires lock free 32-bit atomics");
+
+EditRing::EditRing() :
+    head(0),
+    tail(0)
+{
+    for(unsigned int i = 0; i < EDIT_RING_SIZE; i++)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool EditRing::push(const EditCommand& command)
+{
+    // reserve a free slot (producers race on head)
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while(true)
+    {
+        slot = &slots[pos % EDIT_RING_SIZE];
+        int64_t diff = static_cast<int64_t>(slot->sequence.load(std::memory_order_acquire) - pos);
+        if(diff == 0)
+        {
+            if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        }
+        else if(diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->command = command;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool EditRing::pop(EditCommand& command)
+{
+    uint64_t pos = tail.load(std::memory_order_relaxed);
+    Slot& slot = slots[pos % EDIT_RING_SIZE];
+    if(slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+    command = slot.command;
+    slot.sequence.store(pos + EDIT_RING_SIZE, std::memory_order_release);
+    tail.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+std::string itc::eps::get_shm_name(uint8_t address)
+{
+    return "/eps_sim_" + to_string(static_cast<unsigned int>(address), true);
+}
+
+ShmServer::ShmServer() :
+    name(),
+    segment(nullptr)
+{
+}
+
+ShmServer::~ShmServer()
+{
+    close();
+}
+
+bool ShmServer::create(const std::string& name, uint8_t address)
+{
+    close();
+
+    // replace stale segment of a previous run (attached viewers keep the old mapping)
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if(fd < 0)
+    {
+        EPS_LOG_ERROR("unable to create shared memory %s: %s", name.c_str(), std::strerror(errno));
+        return false;
+    }
+    void *map = (ftruncate(fd, sizeof(ShmSegment)) == 0) ?
+        mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if(map == MAP_FAILED)
+    {
+        EPS_LOG_ERROR("unable to map shared memory %s: %s", name.c_str(), std::strerror(errno));
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // construct in place, magic last so viewers never see a partial segment
+    segment = static_cast<ShmSegment*>(map);
+    segment->magic.store(0, std::memory_order_relaxed);
+    segment->version = SHM_VERSION;
+    segment->size = sizeof(ShmSegment);
+    segment->pid = static_cast<uint32_t>(getpid());
+    segment->address = address;
+    segment->reserved = 0;
+    new (&segment->frames) FramePublisher();
+    new (&segment->edits) EditRing();
+    segment->magic.store(SHM_MAGIC, std::memory_order_release);
+
+    this->name = name;
+    EPS_LOG_INFO("eps shared memory created: %s", name.c_str());
+    return true;
+}
+
+void ShmServer::close()
+{
+    if(!segment) return;
+    segment->magic.store(0, std::memory_order_release);
+    segment->frames.~FramePublisher();
+    munmap(segment, sizeof(ShmSegment));
+    shm_unlink(name.c_str());
+    segment = nullptr;
+}
+
+bool ShmServer::is_open() const
+{
+    return segment != nullptr;
+}
+
+FramePublisher& ShmServer::get_frames()
+{
+    return segment->frames;
+}
+
+bool ShmServer::poll(EditCommand& command)
+{
+    return segment && segment->edits.pop(command);
+}
+
+ShmClient::ShmClient() :
+    segment(nullptr)
+{
+}
+
+ShmClient::~ShmClient()
+{
+    close();
+}
+
+bool ShmClient::open(const std::string& name)
+{
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if(fd < 0)
+    {
+        EPS_LOG_ERROR("unable to open shared memory %s: %s", name.c_str(), std::strerror(errno));
+        return false;
+    }
+    struct stat info;
+    bool sized = (fstat(fd, &info) == 0) && (info.st_size == sizeof(ShmSegment));
+    void *map = sized ? mmap(nullptr, sizeof(ShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if(map == MAP_FAILED)
+    {
+        EPS_LOG_ERROR("invalid shared memory segment: %s", name.c_str());
+        return false;
+    }
+
+    ShmSegment *shm = static_cast<ShmSegment*>(map);
+    if((shm->magic.load(std::memory_order_acquire) != SHM_MAGIC) || (shm->version != SHM_VERSION) ||
+       (shm->size != sizeof(ShmSegment)))
+    {
+        EPS_LOG_ERROR("invalid shared memory segment: %s", name.c_str());
+        munmap(map, sizeof(ShmSegment));
+        return false;
+    }
+
+    segment = shm;
+    return true;
+}
+
+void ShmClient::close()
+{
+    if(!segment) return;
+    munmap(segment, sizeof(ShmSegment));
+    segment = nullptr;
+}
+
+bool ShmClient::is_open() const
+{
+    return segment != nullptr;
+}
+
+bool ShmClient::is_alive() const
+{
+    return segment && (segment->magic.load(std::memory_order_acquire) == SHM_MAGIC) &&
+           ((kill(static_cast<pid_t>(segment->pid), 0) == 0) || (errno == EPERM));
+}
+
+uint8_t ShmClient::get_address() const
+{
+    return static_cast<uint8_t>(segment->address);
+}
+
+const FramePublisher& ShmClient::get_frames() const
+{
+    return segment->frames;
+}
+
+bool ShmClient::send(const EditCommand& command)
+{
+    return segment && segment->edits.push(command);
+}
@@ -0,0 +1,72 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "state.hpp"
+
+using namespace itc::eps;
+
+StateWriter::StateWriter(StateBlob& blob) :
+    blob(blob)
+{
+}
+
+StateWriter::~StateWriter()
+{
+}
+
+StateReader::StateReader(const StateBlob& blob) :
+    data(blob.data()),
+    size(blob.size()),
+    offset(0),
+    valid(true)
+{
+}
+
+StateReader::StateReader(const uint8_t *data, size_t size) :
+    data(data),
+    size(size),
+    offset(0),
+    valid(true)
+{
+}
+
+StateReader::~StateReader()
+{
+}
+
+bool StateReader::is_valid() const
+{
+    return valid;
+}
+
+bool StateReader::is_done() const
+{
+    return offset == size;
+}
+
+bool StateReader::read_raw(void *dest, size_t count)
+{
+    if(!valid || (count > size - offset))
+    {
+        valid = false;
+        return false;
+    }
+    if(count > 0) std::memcpy(dest, data + offset, count);
+    offset += count;
+    return true;
+}
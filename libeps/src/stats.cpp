@@ -0,0 +1,290 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "stats.hpp"
+#include "util.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+using namespace itc::eps;
+
+static_assert(LATENCY_MAX_BITS < 64, "latency histogram values must fit 64 bits");
+
+LatencyHistogram::LatencyHistogram()
+{
+    for(unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+}
+
+void LatencyHistogram::record(uint64_t ns)
+{
+    buckets[get_bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(ns, std::memory_order_relaxed);
+
+    // extremes (retry only while another recorder moved them the wrong way)
+    uint64_t prev = min.load(std::memory_order_relaxed);
+    while((ns < prev) && !min.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+    prev = max.load(std::memory_order_relaxed);
+    while((ns > prev) && !max.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+}
+
+uint64_t LatencyHistogram::get_count() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::get_min() const
+{
+    return (get_count() > 0) ? min.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t LatencyHistogram::get_max() const
+{
+    return max.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::get_mean() const
+{
+    uint64_t num = get_count();
+    return (num > 0) ? static_cast<double>(sum.load(std::memory_order_relaxed)) / num : 0.0;
+}
+
+uint64_t LatencyHistogram::get_percentile(double percent) const
+{
+    // buckets are read one at a time, so the total is summed from the same reads
+    uint64_t counts[LATENCY_BUCKETS];
+    uint64_t total = 0;
+    for(unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if(total == 0) return 0;
+
+    double rank = std::ceil(std::min(std::max(percent, 0.0), 100.0) / 100.0 * total);
+    uint64_t target = std::max<uint64_t>(static_cast<uint64_t>(rank), 1);
+    uint64_t seen = 0;
+    for(unsigned int i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        seen += counts[i];
+        if(seen >= target) return std::min(get_highest(i), get_max());
+    }
+    return get_max();
+}
+
+uint64_t LatencyHistogram::get_bucket_count(unsigned int bucket) const
+{
+    return (bucket < LATENCY_BUCKETS) ? buckets[bucket].load(std::memory_order_relaxed) : 0;
+}
+
+unsigned int LatencyHistogram::get_bucket(uint64_t ns)
+{
+    if(ns < LATENCY_SUB_BUCKETS) return static_cast<unsigned int>(ns);
+    if(ns >> LATENCY_MAX_BITS) return LATENCY_BUCKETS - 1;
+
+    // LATENCY_SUB_BUCKETS buckets per power of two above the exact range
+    unsigned int msb = 63 - __builtin_clzll(ns);
+    unsigned int shift = msb - LATENCY_SUB_BITS;
+    return shift * LATENCY_SUB_BUCKETS + static_cast<unsigned int>(ns >> shift);
+}
+
+uint64_t LatencyHistogram::get_lowest(unsigned int bucket)
+{
+    if(bucket < LATENCY_SUB_BUCKETS) return bucket;
+    unsigned int shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    return static_cast<uint64_t>(bucket % LATENCY_SUB_BUCKETS + LATENCY_SUB_BUCKETS) << shift;
+}
+
+uint64_t LatencyHistogram::get_highest(unsigned int bucket)
+{
+    if(bucket + 1 >= LATENCY_BUCKETS) return std::numeric_limits<uint64_t>::max();
+    return get_lowest(bucket + 1) - 1;
+}
+
+CommandStats::CommandStats()
+{
+    // command numbers map to counters in CMD_TYPES order, others to the unknown counters
+    for(unsigned int i = 0; i < 256; i++)
+    {
+        slots[i] = NUM_CMD_TYPES;
+    }
+    for(unsigned int i = 0; i < NUM_CMD_TYPES; i++)
+    {
+        slots[static_cast<uint8_t>(CMD_TYPES[i])] = static_cast<uint8_t>(i);
+    }
+
+    for(unsigned int i = 0; i <= NUM_CMD_TYPES; i++)
+    {
+        Counters& c = counters[i];
+        c.count.store(0, std::memory_order_relaxed);
+        c.bytes_in.store(0, std::memory_order_relaxed);
+        c.bytes_out.store(0, std::memory_order_relaxed);
+        for(unsigned int e = 0; e < NUM_ERROR_CODES; e++)
+        {
+            c.errors[e].store(0, std::memory_order_relaxed);
+        }
+    }
+    for(unsigned int i = 0; i < NUM_EPS_EVENTS; i++)
+    {
+        events[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+CommandStats::~CommandStats()
+{
+}
+
+unsigned int CommandStats::get_error_index(ErrorCode error)
+{
+    for(unsigned int i = 0; i < NUM_ERROR_CODES; i++)
+    {
+        if(ERROR_CODES[i] == error) return i;
+    }
+    return 0;
+}
+
+void CommandStats::record_command(uint8_t command, size_t bytes_in, size_t bytes_out, ErrorCode error)
+{
+    Counters& c = counters[slots[command]];
+    c.count.fetch_add(1, std::memory_order_relaxed);
+    c.errors[get_error_index(error)].fetch_add(1, std::memory_order_relaxed);
+    c.bytes_in.fetch_add(bytes_in, std::memory_order_relaxed);
+    c.bytes_out.fetch_add(bytes_out, std::memory_order_relaxed);
+}
+
+void CommandStats::record_latency(uint8_t command, uint64_t ns)
+{
+    counters[slots[command]].latency.record(ns);
+}
+
+void CommandStats::record_event(EpsEvent event)
+{
+    if(event < NUM_EPS_EVENTS) events[event].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t CommandStats::get_count(uint8_t command) const
+{
+    return counters[slots[command]].count.load(std::memory_order_relaxed);
+}
+
+uint64_t CommandStats::get_errors(uint8_t command, ErrorCode error) const
+{
+    return counters[slots[command]].errors[get_error_index(error)].load(std::memory_order_relaxed);
+}
+
+uint64_t CommandStats::get_total_count() const
+{
+    uint64_t total = 0;
+    for(unsigned int i = 0; i <= NUM_CMD_TYPES; i++)
+    {
+        total += counters[i].count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t CommandStats::get_total_errors(ErrorCode error) const
+{
+    unsigned int e = get_error_index(error);
+    uint64_t total = 0;
+    for(unsigned int i = 0; i <= NUM_CMD_TYPES; i++)
+    {
+        total += counters[i].errors[e].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t CommandStats::get_total_failures() const
+{
+    // every error code except ERROR_NONE (first in ERROR_CODES order)
+    uint64_t total = 0;
+    for(unsigned int i = 0; i <= NUM_CMD_TYPES; i++)
+    {
+        for(unsigned int e = 1; e < NUM_ERROR_CODES; e++)
+        {
+            total += counters[i].errors[e].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+uint64_t CommandStats::get_events(EpsEvent event) const
+{
+    return (event < NUM_EPS_EVENTS) ? events[event].load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t CommandStats::get_bytes_in(uint8_t command) const
+{
+    return counters[slots[command]].bytes_in.load(std::memory_order_relaxed);
+}
+
+uint64_t CommandStats::get_bytes_out(uint8_t command) const
+{
+    return counters[slots[command]].bytes_out.load(std::memory_order_relaxed);
+}
+
+const LatencyHistogram& CommandStats::get_latency(uint8_t command) const
+{
+    return counters[slots[command]].latency;
+}
+
+std::string CommandStats::get_report() const
+{
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-30s %10s %8s %10s %10s %10s %10s %10s %10s\n", "command", "count", "errors",
+                  "bytes_in", "bytes_out", "p50_us", "p99_us", "p99.9_us", "max_us");
+    std::string report(line);
+    for(unsigned int i = 0; i <= NUM_CMD_TYPES; i++)
+    {
+        const Counters& c = counters[i];
+        uint64_t num = c.count.load(std::memory_order_relaxed);
+        if((num == 0) && (c.latency.get_count() == 0)) continue;
+
+        std::string errors;
+        uint64_t num_errors = 0;
+        for(unsigned int e = 1; e < NUM_ERROR_CODES; e++)
+        {
+            uint64_t n = c.errors[e].load(std::memory_order_relaxed);
+            if(n == 0) continue;
+            num_errors += n;
+            errors += " " + to_string(ERROR_CODES[e]) + "=" + to_string(n);
+        }
+
+        std::string name = (i < NUM_CMD_TYPES) ? to_string(CMD_TYPES[i]) : std::string("UNKNOWN");
+        std::snprintf(line, sizeof(line), "%-30s %10llu %8llu %10llu %10llu %10.3f %10.3f %10.3f %10.3f%s\n",
+                      name.c_str(), static_cast<unsigned long long>(num), static_cast<unsigned long long>(num_errors),
+                      static_cast<unsigned long long>(c.bytes_in.load(std::memory_order_relaxed)),
+                      static_cast<unsigned long long>(c.bytes_out.load(std::memory_order_relaxed)),
+                      c.latency.get_percentile(50.0) / 1000.0, c.latency.get_percentile(99.0) / 1000.0,
+                      c.latency.get_percentile(99.9) / 1000.0, c.latency.get_max() / 1000.0, errors.c_str());
+        report += line;
+    }
+    return report;
+}
@@ -48,6 +48,11 @@ uint16_t Status::get_checksum() const
     return checksum;
 }
 
+void Status::set_checksum(uint16_t checksum)
+{
+    this->checksum = checksum;
+}
+
 uint16_t Status::get_status() const
 {
     return static_cast<uint16_t>(status.to_ulong());
@@ -154,8 +159,59 @@ uint8_t Status::get_num_resets(ResetType type) const
     return num_resets;
 }
 
+void Status::set_num_resets(ResetType type, uint8_t num)
+{
+    if(num > 0)
+    {
+        reset_counts[type] = num;
+    }
+    else
+    {
+        reset_counts.erase(type);
+    }
+}
+
 ErrorCode Status::get_last_error() const
 {
     return last_error;
 }
 
+void Status::save_state(StateWriter& writer) const
+{
+    writer.write(checksum);
+    writer.write(get_status());
+    writer.write(manual_reset);
+    writer.write(static_cast<uint8_t>(reset_counts.size()));
+    for(ResetCount::const_iterator it = reset_counts.begin(); it != reset_counts.end(); ++it)
+    {
+        writer.write(static_cast<uint8_t>(it->first));
+        writer.write(it->second);
+    }
+    writer.write(static_cast<uint8_t>(last_error));
+}
+
+bool Status::load_state(StateReader& reader)
+{
+    uint16_t bits = 0;
+    uint8_t num_counts = 0;
+    reader.read(checksum);
+    reader.read(bits);
+    reader.read(manual_reset);
+    reader.read(num_counts);
+
+    reset_counts.clear();
+    for(unsigned int i = 0; i < num_counts; i++)
+    {
+        uint8_t type = 0;
+        uint8_t count = 0;
+        reader.read(type);
+        reader.read(count);
+        reset_counts[static_cast<ResetType>(type)] = count;
+    }
+
+    uint8_t error = 0;
+    reader.read(error);
+    status = bits;
+    last_error = static_cast<ErrorCode>(error);
+    return reader.is_valid();
+}
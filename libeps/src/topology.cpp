@@ -0,0 +1,396 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "topology.hpp"
+#include "log.hpp"
+#include "types.hpp"
+#include <algorithm>
+
+using namespace itc::eps;
+
+static const unsigned int WORD_BITS = 64; //!< Bits per reset state word
+
+BusTopology::BusTopology() :
+    buses(),
+    connections(),
+    dirty(false),
+    adjacency(std::make_shared<const Adjacency>()),
+    requested(),
+    effective(),
+    visited(),
+    subgraph(),
+    stack()
+{
+}
+
+BusTopology::~BusTopology()
+{
+    for(unsigned int i = 0; i < buses.size(); i++)
+    {
+        buses[i]->detach();
+    }
+}
+
+unsigned int BusTopology::add(Bus& bus)
+{
+    unsigned int index = static_cast<unsigned int>(buses.size());
+    buses.push_back(&bus);
+    if(index % WORD_BITS == 0)
+    {
+        requested.push_back(0);
+        effective.push_back(0);
+        visited.push_back(0);
+    }
+    dirty = true;
+    bus.attach(this, index);
+
+    // initial state of bus
+    if(bus.is_reset())
+    {
+        set_bit(requested, index, true);
+        set_bit(effective, index, true);
+    }
+    return index;
+}
+
+void BusTopology::connect(unsigned int parent, unsigned int child)
+{
+    if((parent >= buses.size()) || (child >= buses.size()) || (parent == child))
+    {
+        EPS_LOG_ERROR("invalid bus topology connection: %u -> %u", parent, child);
+        return;
+    }
+    connections.push_back(Connection(parent, child));
+    dirty = true;
+}
+
+unsigned int BusTopology::size() const
+{
+    return static_cast<unsigned int>(buses.size());
+}
+
+bool BusTopology::is_reset(unsigned int index) const
+{
+    return (index < buses.size()) && get_bit(effective, index);
+}
+
+const std::vector<BusTopology::Mask>& BusTopology::get_reset_state() const
+{
+    return effective;
+}
+
+void BusTopology::reset(unsigned int index, bool state)
+{
+    if(index >= buses.size()) return;
+    if(compile()) resync();
+    const Adjacency& adj = *adjacency;
+
+    if(state)
+    {
+        // already in reset (directly or from ancestor), so descendants are too
+        if(get_bit(effective, index)) return;
+        set_bit(requested, index, true);
+
+        // depth first over children, pruning subgraphs already in reset
+        stack.clear();
+        stack.push_back(index);
+        set_effective(index, true);
+        while(!stack.empty())
+        {
+            unsigned int bus = stack.back();
+            stack.pop_back();
+            for(unsigned int i = adj.child_offsets[bus]; i < adj.child_offsets[bus + 1]; i++)
+            {
+                unsigned int child = adj.child_targets[i];
+                if(!get_bit(effective, child))
+                {
+                    set_effective(child, true);
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+    else
+    {
+        // not in reset, or held in reset by ancestor
+        if(!get_bit(effective, index)) return;
+        for(unsigned int i = adj.parent_offsets[index]; i < adj.parent_offsets[index + 1]; i++)
+        {
+            if(get_bit(effective, adj.parent_targets[i])) return;
+        }
+
+        // clear requests in subgraph and recompute it in topological order (parents outside the
+        // subgraph are unchanged, so descendants with another path to a reset bus stay in reset)
+        collect_subgraph(index);
+        for(unsigned int i = 0; i < subgraph.size(); i++)
+        {
+            set_bit(requested, subgraph[i], false);
+        }
+        for(unsigned int i = 0; i < subgraph.size(); i++)
+        {
+            unsigned int bus = subgraph[i];
+            bool held = false;
+            for(unsigned int j = adj.parent_offsets[bus]; !held && (j < adj.parent_offsets[bus + 1]); j++)
+            {
+                held = get_bit(effective, adj.parent_targets[j]);
+            }
+            set_effective(bus, held && (bus != index));
+        }
+    }
+}
+
+std::vector<unsigned int> BusTopology::get_children(unsigned int index) const
+{
+    compile();
+    const Adjacency& adj = *adjacency;
+    std::vector<unsigned int> children;
+    if(index < buses.size())
+    {
+        children.assign(adj.child_targets.begin() + adj.child_offsets[index],
+                        adj.child_targets.begin() + adj.child_offsets[index + 1]);
+    }
+    return children;
+}
+
+std::vector<unsigned int> BusTopology::get_parents(unsigned int index) const
+{
+    compile();
+    const Adjacency& adj = *adjacency;
+    std::vector<unsigned int> parents;
+    if(index < buses.size())
+    {
+        parents.assign(adj.parent_targets.begin() + adj.parent_offsets[index],
+                       adj.parent_targets.begin() + adj.parent_offsets[index + 1]);
+    }
+    return parents;
+}
+
+std::vector<unsigned int> BusTopology::get_descendants(unsigned int index) const
+{
+    std::vector<unsigned int> descendants;
+    if(index < buses.size())
+    {
+        compile();
+        collect_subgraph(index);
+        for(unsigned int i = 0; i < subgraph.size(); i++)
+        {
+            if(subgraph[i] != index) descendants.push_back(subgraph[i]);
+        }
+        std::sort(descendants.begin(), descendants.end());
+    }
+    return descendants;
+}
+
+unsigned int BusTopology::get_rank(unsigned int index) const
+{
+    compile();
+    return (index < buses.size()) ? adjacency->rank[index] : INVALID_INDEX;
+}
+
+void BusTopology::save_state(StateWriter& writer) const
+{
+    writer.write(static_cast<uint32_t>(buses.size()));
+    writer.write(requested);
+    writer.write(effective);
+}
+
+bool BusTopology::load_state(StateReader& reader)
+{
+    uint32_t num = 0;
+    std::vector<Mask> state_requested;
+    std::vector<Mask> state_effective;
+    reader.read(num);
+    reader.read(state_requested);
+    reader.read(state_effective);
+    if(!reader.is_valid() || (num != buses.size()) || (state_requested.size() != requested.size()) ||
+       (state_effective.size() != effective.size()))
+    {
+        return false;
+    }
+
+    compile();
+    requested = state_requested;
+    for(unsigned int i = 0; i < num; i++)
+    {
+        set_effective(i, get_bit(state_effective, i));
+    }
+    return true;
+}
+
+bool BusTopology::share(const BusTopology& topology)
+{
+    if(topology.buses.size() != buses.size())
+    {
+        EPS_LOG_ERROR("unable to share bus topology: %u buses, expected %u",
+                      topology.size(), size());
+        return false;
+    }
+
+    topology.compile();
+    connections = topology.connections;
+    adjacency = topology.adjacency;
+    dirty = false;
+    requested = topology.requested;
+    effective = topology.effective;
+    return true;
+}
+
+bool BusTopology::compile() const
+{
+    if(!dirty) return false;
+    dirty = false;
+
+    unsigned int num = static_cast<unsigned int>(buses.size());
+    std::shared_ptr<Adjacency> compiled = std::make_shared<Adjacency>();
+    Adjacency& adj = *compiled;
+
+    // sorted unique connections give children in ascending order per row
+    std::vector<Connection> edges(connections);
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // children: rows of sorted edges
+    adj.child_offsets.assign(num + 1, 0);
+    adj.child_targets.resize(edges.size());
+    for(unsigned int i = 0; i < edges.size(); i++)
+    {
+        adj.child_offsets[edges[i].first + 1]++;
+        adj.child_targets[i] = edges[i].second;
+    }
+    for(unsigned int i = 0; i < num; i++)
+    {
+        adj.child_offsets[i + 1] += adj.child_offsets[i];
+    }
+
+    // parents: counting sort of edges by child
+    adj.parent_offsets.assign(num + 1, 0);
+    adj.parent_targets.resize(edges.size());
+    for(unsigned int i = 0; i < edges.size(); i++)
+    {
+        adj.parent_offsets[edges[i].second + 1]++;
+    }
+    for(unsigned int i = 0; i < num; i++)
+    {
+        adj.parent_offsets[i + 1] += adj.parent_offsets[i];
+    }
+    std::vector<unsigned int> fill(adj.parent_offsets.begin(), adj.parent_offsets.end() - 1);
+    for(unsigned int i = 0; i < edges.size(); i++)
+    {
+        adj.parent_targets[fill[edges[i].second]++] = edges[i].first;
+    }
+
+    // topological order (kahn)
+    std::vector<unsigned int> in_degree(num);
+    adj.order.clear();
+    for(unsigned int i = 0; i < num; i++)
+    {
+        in_degree[i] = adj.parent_offsets[i + 1] - adj.parent_offsets[i];
+        if(in_degree[i] == 0) adj.order.push_back(i);
+    }
+    for(unsigned int head = 0; head < adj.order.size(); head++)
+    {
+        unsigned int bus = adj.order[head];
+        for(unsigned int i = adj.child_offsets[bus]; i < adj.child_offsets[bus + 1]; i++)
+        {
+            if(--in_degree[adj.child_targets[i]] == 0) adj.order.push_back(adj.child_targets[i]);
+        }
+    }
+    if(adj.order.size() != num)
+    {
+        EPS_LOG_ERROR("bus topology contains a cycle, reset propagation is undefined");
+        for(unsigned int i = 0; i < num; i++)
+        {
+            if(in_degree[i] != 0) adj.order.push_back(i);
+        }
+    }
+
+    adj.rank.assign(num, 0);
+    for(unsigned int i = 0; i < num; i++)
+    {
+        adj.rank[adj.order[i]] = i;
+    }
+    adjacency = compiled;
+    return true;
+}
+
+void BusTopology::resync()
+{
+    const Adjacency& adj = *adjacency;
+    for(unsigned int i = 0; i < adj.order.size(); i++)
+    {
+        unsigned int bus = adj.order[i];
+        bool state = get_bit(requested, bus);
+        for(unsigned int j = adj.parent_offsets[bus]; !state && (j < adj.parent_offsets[bus + 1]); j++)
+        {
+            state = get_bit(effective, adj.parent_targets[j]);
+        }
+        set_effective(bus, state);
+    }
+}
+
+void BusTopology::collect_subgraph(unsigned int index) const
+{
+    const Adjacency& adj = *adjacency;
+    subgraph.clear();
+    stack.clear();
+    stack.push_back(index);
+    set_bit(visited, index, true);
+    while(!stack.empty())
+    {
+        unsigned int bus = stack.back();
+        stack.pop_back();
+        subgraph.push_back(bus);
+        for(unsigned int i = adj.child_offsets[bus]; i < adj.child_offsets[bus + 1]; i++)
+        {
+            unsigned int child = adj.child_targets[i];
+            if(!get_bit(visited, child))
+            {
+                set_bit(visited, child, true);
+                stack.push_back(child);
+            }
+        }
+    }
+
+    // clear marks and sort parents before children
+    for(unsigned int i = 0; i < subgraph.size(); i++)
+    {
+        set_bit(visited, subgraph[i], false);
+    }
+    const std::vector<unsigned int>& ranks = adj.rank;
+    std::sort(subgraph.begin(), subgraph.end(),
+              [&ranks](unsigned int a, unsigned int b) {return ranks[a] < ranks[b];});
+}
+
+bool BusTopology::get_bit(const std::vector<Mask>& words, unsigned int index)
+{
+    return (words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+void BusTopology::set_bit(std::vector<Mask>& words, unsigned int index, bool value)
+{
+    Mask bit = Mask(1) << (index % WORD_BITS);
+    Mask& word = words[index / WORD_BITS];
+    word = value ? (word | bit) : (word & ~bit);
+}
+
+void BusTopology::set_effective(unsigned int index, bool state)
+{
+    if(get_bit(effective, index) == state) return;
+    set_bit(effective, index, state);
+    buses[index]->set_reset_state(state);
+}
@@ -0,0 +1,293 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "trace.hpp"
+#include "log.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+static_assert(std::is_trivially_copyable<TraceEvent>::value, "trace event must be trivially copyable");
+static_assert(sizeof(TraceEvent) % sizeof(uint64_t) == 0, "trace event must be a whole number of words");
+
+// calling thread's buffer (owned by the tracer)
+static thread_local TraceBuffer *thread_buffer = nullptr;
+
+TraceBuffer::TraceBuffer(unsigned int capacity, uint64_t tid) :
+    capacity(std::max(capacity, 1u)),
+    tid(tid),
+    words(new std::atomic<uint64_t>[static_cast<size_t>(this->capacity) * EVENT_WORDS]),
+    count(0),
+    claims(0),
+    floor(0),
+    name_mutex(),
+    name()
+{
+    for(size_t i = 0; i < static_cast<size_t>(this->capacity) * EVENT_WORDS; i++)
+    {
+        words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+TraceBuffer::~TraceBuffer()
+{
+}
+
+void TraceBuffer::add(const TraceEvent& event)
+{
+    // claim slot of the oldest event, store event, then publish it
+    uint64_t data[EVENT_WORDS];
+    std::memcpy(data, &event, sizeof(data));
+    uint64_t n = count.load(std::memory_order_relaxed);
+    std::atomic<uint64_t> *slot = &words[(n % capacity) * EVENT_WORDS];
+    claims.store(n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(unsigned int w = 0; w < EVENT_WORDS; w++)
+    {
+        slot[w].store(data[w], std::memory_order_relaxed);
+    }
+    count.store(n + 1, std::memory_order_release);
+}
+
+void TraceBuffer::read(std::vector<TraceEvent>& events) const
+{
+    // copy latest published events
+    uint64_t end = count.load(std::memory_order_acquire);
+    uint64_t begin = std::max<uint64_t>(floor.load(std::memory_order_relaxed), (end > capacity) ? (end - capacity) : 0);
+    if(begin >= end) return;
+    size_t first = events.size();
+    events.resize(first + (end - begin));
+    uint64_t data[EVENT_WORDS];
+    for(uint64_t i = begin; i < end; i++)
+    {
+        const std::atomic<uint64_t> *slot = &words[(i % capacity) * EVENT_WORDS];
+        for(unsigned int w = 0; w < EVENT_WORDS; w++)
+        {
+            data[w] = slot[w].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&events[first + (i - begin)], data, sizeof(data));
+    }
+
+    // drop events overwritten during the copy (writer claims a slot before writing it)
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t claimed = claims.load(std::memory_order_relaxed);
+    uint64_t valid = (claimed >= capacity) ? (claimed - capacity) : 0;
+    if(valid <= begin) return;
+    uint64_t dropped = std::min(valid, end) - begin;
+    events.erase(events.begin() + first, events.begin() + first + dropped);
+}
+
+void TraceBuffer::clear()
+{
+    floor.store(count.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+uint64_t TraceBuffer::get_tid() const
+{
+    return tid;
+}
+
+std::string TraceBuffer::get_name() const
+{
+    std::lock_guard<std::mutex> lock(name_mutex);
+    return name;
+}
+
+void TraceBuffer::set_name(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(name_mutex);
+    this->name = name;
+}
+
+Tracer& Tracer::get()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() :
+    enabled(false),
+    capacity(DEFAULT_TRACE_EVENTS),
+    start(Clock::now()),
+    mutex(),
+    buffers()
+{
+}
+
+void Tracer::enable(unsigned int events_per_thread)
+{
+    capacity.store(events_per_thread, std::memory_order_relaxed);
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::disable()
+{
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+void Tracer::record(const TraceEvent& event)
+{
+    get_buffer().add(event);
+}
+
+void Tracer::set_thread_name(const std::string& name)
+{
+    get_buffer().set_name(name);
+}
+
+TraceBuffer& Tracer::get_buffer()
+{
+    if(thread_buffer == nullptr)
+    {
+        // first event of this thread, buffer is kept after the thread exits
+        std::shared_ptr<TraceBuffer> buffer = std::make_shared<TraceBuffer>(capacity.load(std::memory_order_relaxed),
+                                                                            static_cast<uint64_t>(syscall(SYS_gettid)));
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(buffer);
+        thread_buffer = buffer.get();
+    }
+    return *thread_buffer;
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(const std::shared_ptr<TraceBuffer>& buffer : buffers)
+    {
+        buffer->clear();
+    }
+}
+
+void Tracer::read(std::vector<std::pair<uint64_t, TraceEvent>>& events) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<TraceEvent> thread_events;
+    for(const std::shared_ptr<TraceBuffer>& buffer : buffers)
+    {
+        thread_events.clear();
+        buffer->read(thread_events);
+        for(const TraceEvent& event : thread_events)
+        {
+            events.push_back(std::make_pair(buffer->get_tid(), event));
+        }
+    }
+}
+
+// json string (names are identifiers, thread names may be anything)
+static void write_string(FILE *file, const std::string& value)
+{
+    std::fputc('"', file);
+    for(char c : value)
+    {
+        if((c == '"') || (c == '\\')) std::fputc('\\', file);
+        if(static_cast<unsigned char>(c) >= 0x20) std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+bool Tracer::write(const std::string& filename) const
+{
+    // write whole trace to temporary file, then replace
+    std::string tmpfile = filename + ".tmp";
+    FILE *file = std::fopen(tmpfile.c_str(), "w");
+    if(file == nullptr)
+    {
+        EPS_LOG_ERROR("unable to write trace file %s: %s", tmpfile.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> names;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(const std::shared_ptr<TraceBuffer>& buffer : buffers)
+        {
+            names.push_back(std::make_pair(buffer->get_tid(), buffer->get_name()));
+        }
+    }
+    std::vector<std::pair<uint64_t, TraceEvent>> events;
+    read(events);
+
+    long pid = static_cast<long>(getpid());
+    const char *separator = "\n";
+    std::fprintf(file, "{\"traceEvents\":[");
+    for(const std::pair<uint64_t, std::string>& name : names)
+    {
+        if(name.second.empty()) continue;
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%" PRIu64 ",\"args\":{\"name\":",
+                     separator, pid, name.first);
+        write_string(file, name.second);
+        std::fprintf(file, "}}");
+        separator = ",\n";
+    }
+    for(const std::pair<uint64_t, TraceEvent>& entry : events)
+    {
+        const TraceEvent& event = entry.second;
+        std::fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,", separator, event.name,
+                     event.category, static_cast<char>(event.phase), event.start_ns / 1000.0);
+        if(event.phase == TRACE_COMPLETE) std::fprintf(file, "\"dur\":%.3f,", event.duration_ns / 1000.0);
+        else std::fprintf(file, "\"s\":\"t\",");
+        std::fprintf(file, "\"pid\":%ld,\"tid\":%" PRIu64, pid, entry.first);
+        if(event.arg_name != nullptr) std::fprintf(file, ",\"args\":{\"%s\":%" PRId64 "}", event.arg_name, event.arg);
+        std::fprintf(file, "}");
+        separator = ",\n";
+    }
+    std::fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    bool ok = (std::fflush(file) == 0) && !std::ferror(file);
+    ok = (std::fclose(file) == 0) && ok;
+    if(!ok || (std::rename(tmpfile.c_str(), filename.c_str()) != 0))
+    {
+        EPS_LOG_ERROR("unable to write trace file %s: %s", filename.c_str(), std::strerror(errno));
+        std::remove(tmpfile.c_str());
+        return false;
+    }
+    EPS_LOG_INFO("wrote %u trace events to %s", static_cast<unsigned int>(events.size()), filename.c_str());
+    return true;
+}
+
+const uint64_t TraceSpan::NOT_TRACED;
+
+TraceSpan::~TraceSpan()
+{
+    if(start_ns == NOT_TRACED) return;
+    Tracer& tracer = Tracer::get();
+    uint64_t end_ns = tracer.now();
+    TraceEvent event = {name, category, arg_name, start_ns, end_ns - start_ns, arg, TRACE_COMPLETE};
+    tracer.record(event);
+}
+
+void itc::eps::trace_instant(const char *name, const char *category, const char *arg_name, int64_t arg)
+{
+    Tracer& tracer = Tracer::get();
+    if(!tracer.is_enabled()) return;
+    TraceEvent event = {name, category, arg_name, tracer.now(), 0, arg, TRACE_INSTANT};
+    tracer.record(event);
+}
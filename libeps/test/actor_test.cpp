@@ -0,0 +1,152 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "actor.hpp"
+#include "eps.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    TEST(ActorTest, Queue)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        TaskQueue queue;
+        EpsTask task;
+        EXPECT_TRUE(queue.empty());
+        EXPECT_FALSE(queue.pop(task));
+
+        std::vector<int> order;
+        for(int i = 0; i < 3; i++) queue.push([&order, i](Eps&) {order.push_back(i);});
+        EXPECT_FALSE(queue.empty());
+        while(queue.pop(task)) task(eps);
+        EXPECT_EQ((std::vector<int>{0, 1, 2}), order);
+        EXPECT_TRUE(queue.empty());
+    }
+
+    TEST(ActorTest, ProducerOrder)
+    {
+        const unsigned int NUM_PRODUCERS = 4;
+        const unsigned int NUM_TASKS = 20000;
+
+        Eps eps(I2C_ADDRESS, false);
+        EpsActor actor(eps);
+        ASSERT_TRUE(actor.start());
+
+        // tasks only run on the simulator thread, no lock needed
+        std::vector<unsigned int> last(NUM_PRODUCERS, 0);
+        unsigned int out_of_order = 0;
+        std::vector<std::thread> producers;
+        for(unsigned int p = 0; p < NUM_PRODUCERS; p++)
+        {
+            producers.push_back(std::thread([&actor, &last, &out_of_order, p, NUM_TASKS]() {
+                for(unsigned int i = 1; i <= NUM_TASKS; i++)
+                {
+                    actor.post([&last, &out_of_order, p, i](Eps&) {
+                        if(last[p] + 1 != i) out_of_order++;
+                        last[p] = i;
+                    });
+                }
+            }));
+        }
+        for(unsigned int p = 0; p < producers.size(); p++) producers[p].join();
+        actor.stop();
+
+        EXPECT_EQ(0u, out_of_order);
+        EXPECT_EQ(NUM_PRODUCERS * NUM_TASKS, actor.get_num_tasks());
+        for(unsigned int p = 0; p < NUM_PRODUCERS; p++) EXPECT_EQ(NUM_TASKS, last[p]);
+    }
+
+    TEST(ActorTest, Call)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        EpsActor actor(eps);
+
+        // stopped actor runs calls in caller thread
+        std::thread::id caller = std::this_thread::get_id();
+        std::thread::id runner;
+        actor.call([&runner](Eps&) {runner = std::this_thread::get_id();});
+        EXPECT_EQ(caller, runner);
+
+        ASSERT_TRUE(actor.start());
+        actor.post([](Eps& eps) {eps.set_telemetry(CHANNEL_TBRD, 25.0);});
+        ChannelTelemetry tlm;
+        actor.call([&tlm, &runner](Eps& eps) {
+            eps.get_telemetry(CHANNEL_TBRD, tlm);
+            runner = std::this_thread::get_id();
+        });
+        EXPECT_NE(caller, runner);
+        EXPECT_DOUBLE_EQ(25.0, tlm.analog);
+
+        // nested call runs inline
+        bool nested = false;
+        actor.call([&actor, &nested](Eps&) {actor.call([&nested](Eps&) {nested = true;});});
+        EXPECT_TRUE(nested);
+    }
+
+    TEST(ActorTest, StopRunsPending)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        EpsActor actor(eps);
+        std::atomic<unsigned int> count(0);
+        for(unsigned int i = 0; i < 100; i++) actor.post([&count](Eps&) {count++;});
+        ASSERT_TRUE(actor.start());
+        actor.stop();
+        EXPECT_FALSE(actor.is_running());
+        EXPECT_EQ(100u, count.load());
+
+        // restart after stop
+        ASSERT_TRUE(actor.start());
+        actor.call([&count](Eps&) {count++;});
+        EXPECT_EQ(101u, count.load());
+    }
+
+    TEST(ActorTest, StopWhileCalling)
+    {
+        // producers racing with stop never wait on a stopped thread
+        Eps eps(I2C_ADDRESS, false);
+        EpsActor actor(eps);
+        ASSERT_TRUE(actor.start());
+        unsigned int count = 0;
+        std::vector<std::thread> producers;
+        for(unsigned int p = 0; p < 4; p++)
+        {
+            producers.push_back(std::thread([&actor, &count]() {
+                for(unsigned int i = 0; i < 2000; i++)
+                {
+                    if(i % 2) actor.call([&count](Eps&) {count++;});
+                    else actor.post([&count](Eps&) {count++;});
+                }
+            }));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        actor.stop();
+        for(unsigned int p = 0; p < producers.size(); p++) producers[p].join();
+
+        // every task ran once, queued or inline (count is not atomic, tasks are serialized)
+        EXPECT_FALSE(actor.is_running());
+        EXPECT_EQ(8000u, count);
+    }
+}
@@ -0,0 +1,178 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    class ChangeTest : public ::testing::Test
+    {
+    public:
+        ChangeTest() :
+            ::testing::Test(),
+            eps(I2C_ADDRESS, false),
+            events()
+        {
+        }
+
+        // simple i2c write/read transaction
+        I2CData send_command(CommandType type, uint8_t param)
+        {
+            I2CData data{type, param};
+            eps.i2c_write(data);
+            eps.i2c_read(data);
+            return data;
+        }
+
+        // count recorded events of type (and item)
+        unsigned int count(ChangeType type, uint32_t num = 0xffffffff) const
+        {
+            unsigned int n = 0;
+            for(unsigned int i = 0; i < events.size(); i++)
+            {
+                if((events[i].type == type) && ((num == 0xffffffff) || (events[i].num == num))) n++;
+            }
+            return n;
+        }
+
+        // record all events
+        void observe(uint32_t mask = CHANGE_MASK_ALL)
+        {
+            eps.add_observer([this](const ChangeEvent& event) {events.push_back(event);}, mask);
+        }
+
+        Eps eps;
+        std::vector<ChangeEvent> events;
+    };
+
+    TEST_F(ChangeTest, ChannelVersions)
+    {
+        const ChangeTracker& changes = eps.get_changes();
+        uint64_t before = changes.get_version();
+        EXPECT_EQ(0u, changes.get_channel_version(CHANNEL_TBRD));
+
+        eps.set_telemetry(CHANNEL_TBRD, 25.0);
+        uint64_t tbrd = changes.get_channel_version(CHANNEL_TBRD);
+        EXPECT_GT(tbrd, before);
+        EXPECT_EQ(tbrd, changes.get_version(CHANGE_AREA_CHANNELS));
+        EXPECT_EQ(0u, changes.get_channel_version(CHANNEL_VBCR1));
+
+        // unchanged value is not a change
+        eps.set_telemetry(CHANNEL_TBRD, 25.0);
+        EXPECT_EQ(tbrd, changes.get_version());
+
+        // converter update is a change
+        eps.configure_channel(CHANNEL_TBRD, ConverterParams{0.5, 0.0});
+        EXPECT_GT(changes.get_channel_version(CHANNEL_TBRD), tbrd);
+        EXPECT_EQ(0u, changes.get_channel_version(CHANNEL_INVALID));
+    }
+
+    TEST_F(ChangeTest, SwitchEvents)
+    {
+        observe();
+        const ChangeTracker& changes = eps.get_changes();
+
+        send_command(CMD_SET_PDM_ON, 3);
+        EXPECT_EQ(1u, count(CHANGE_SWITCH, 2));
+        uint64_t switches = changes.get_version(CHANGE_AREA_SWITCHES);
+        EXPECT_GT(switches, 0u);
+
+        // repeated command changes nothing
+        send_command(CMD_SET_PDM_ON, 3);
+        EXPECT_EQ(1u, count(CHANGE_SWITCH));
+        EXPECT_EQ(switches, changes.get_version(CHANGE_AREA_SWITCHES));
+
+        // switch channels deactivate
+        send_command(CMD_SET_PDM_OFF, 3);
+        EXPECT_EQ(2u, count(CHANGE_SWITCH, 2));
+        EXPECT_GT(changes.get_channel_version(CHANNEL_VSW3), switches);
+        EXPECT_EQ(0u, changes.get_channel_version(CHANNEL_VSW4));
+
+        send_command(CMD_SET_PDM_INITIAL_STATE_ON, 5);
+        EXPECT_EQ(1u, count(CHANGE_SWITCH, 4));
+    }
+
+    TEST_F(ChangeTest, ResetEvents)
+    {
+        observe(change_mask(CHANGE_BUS_RESET) | change_mask(CHANGE_BUS_RELEASE) | change_mask(CHANGE_WDT));
+        eps.set_time(1000);
+
+        send_command(CMD_SET_PCM_RESET, 0x1);
+        EXPECT_GT(count(CHANGE_BUS_RESET), 0u);
+        EXPECT_EQ(0u, count(CHANGE_BUS_RELEASE));
+        EXPECT_EQ(0u, count(CHANGE_SWITCH));
+
+        eps.set_time(2000);
+        EXPECT_EQ(count(CHANGE_BUS_RESET), count(CHANGE_BUS_RELEASE));
+
+        eps.set_time(2000 + DEFAULT_WDT_TIMEOUT_MS);
+        EXPECT_EQ(1u, count(CHANGE_WDT));
+        EXPECT_GT(eps.get_changes().get_version(CHANGE_AREA_STATUS), 0u);
+    }
+
+    TEST_F(ChangeTest, StatusEvents)
+    {
+        observe(change_mask(CHANGE_STATUS));
+        send_command(CMD_GET_BOARD_STATUS, 0);
+        EXPECT_EQ(0u, count(CHANGE_STATUS));
+
+        // invalid command sets status bits
+        send_command(static_cast<CommandType>(0xee), 0);
+        EXPECT_EQ(1u, count(CHANGE_STATUS, 0));
+        send_command(static_cast<CommandType>(0xee), 0);
+        EXPECT_EQ(1u, count(CHANGE_STATUS, 0));
+
+        eps.set_daughterboard_status(Status());
+        EXPECT_EQ(1u, count(CHANGE_STATUS, 1));
+    }
+
+    TEST_F(ChangeTest, RemoveObserver)
+    {
+        unsigned int id = eps.add_observer([this](const ChangeEvent& event) {events.push_back(event);});
+        eps.set_telemetry(CHANNEL_TBRD, 25.0);
+        EXPECT_EQ(1u, count(CHANGE_CHANNEL, CHANNEL_TBRD));
+
+        eps.remove_observer(id);
+        eps.set_telemetry(CHANNEL_TBRD, 26.0);
+        EXPECT_EQ(1u, events.size());
+    }
+
+    TEST_F(ChangeTest, Fork)
+    {
+        observe();
+        eps.set_telemetry(CHANNEL_TBRD, 25.0);
+        uint64_t version = eps.get_changes().get_version();
+        events.clear();
+
+        // fork keeps versions but not observers, and does not notify parent
+        std::unique_ptr<Eps> fork = eps.fork();
+        EXPECT_EQ(version, fork->get_changes().get_version());
+        fork->set_telemetry(CHANNEL_TBRD, 30.0);
+        fork->set_switch_state(1, true);
+        EXPECT_TRUE(events.empty());
+        EXPECT_EQ(version, eps.get_changes().get_version());
+        EXPECT_GT(fork->get_changes().get_channel_version(CHANNEL_TBRD), version);
+    }
+}
@@ -187,7 +187,18 @@ namespace
         data = send_command(CMD_GET_CHECKSUM, 0);
         test_command_status();
         EXPECT_EQ(2, data.size());
-        EXPECT_EQ(0xdead, unpack_response(data));
+        uint16_t xsum = eps.get_status().get_checksum();
+        EXPECT_NE(CHECKSUM, xsum);
+        EXPECT_EQ(xsum, unpack_response(data));
+
+        // EEPROM backed values change checksum
+        send_command(CMD_SET_WDT_PERIOD, 2);
+        data = send_command(CMD_GET_CHECKSUM, 0);
+        EXPECT_NE(xsum, unpack_response(data));
+        EXPECT_EQ(eps.get_status().get_checksum(), unpack_response(data));
+        send_command(CMD_SET_WDT_PERIOD, DEFAULT_WDT_TIMEOUT_MS / (60 * 1000));
+        data = send_command(CMD_GET_CHECKSUM, 0);
+        EXPECT_EQ(xsum, unpack_response(data));
     }
 
     TEST_F(CommandTest, GetTelemetry)
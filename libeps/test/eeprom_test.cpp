@@ -0,0 +1,135 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "eeprom.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+    const std::string EEPROM_FILE = "eeprom_test_" + std::to_string(getpid()) + ".eeprom"; // per test process
+
+    class EepromTest : public ::testing::Test
+    {
+    public:
+        EepromTest() :
+            ::testing::Test()
+        {
+            std::remove(EEPROM_FILE.c_str());
+        }
+
+        ~EepromTest()
+        {
+            std::remove(EEPROM_FILE.c_str());
+        }
+
+        // simple i2c write/read transaction
+        static I2CData send_command(Eps& eps, CommandType type, uint8_t param)
+        {
+            I2CData data{type, param};
+            eps.i2c_write(data);
+            eps.i2c_read(data);
+            return data;
+        }
+
+        // simulator attached to eeprom file
+        static std::unique_ptr<Eps> create_eps(std::shared_ptr<EepromStore>& store)
+        {
+            ByteSwapConfig swap;
+            swap.out = false; // responses in host byte order
+            std::unique_ptr<Eps> eps(new Eps(I2C_ADDRESS, false, swap));
+            store = std::make_shared<EepromStore>();
+            if(store->open(EEPROM_FILE)) eps->attach_eeprom(store);
+            return eps;
+        }
+    };
+
+    TEST_F(EepromTest, NewImage)
+    {
+        std::shared_ptr<EepromStore> store;
+        std::unique_ptr<Eps> eps = create_eps(store);
+        ASSERT_TRUE(store->is_open());
+        EXPECT_TRUE(store->is_new());
+        EXPECT_EQ(EEPROM_MAGIC, store->get().magic);
+        EXPECT_EQ(static_cast<uint32_t>(NUM_SWITCHES), store->get().num_switches);
+        EXPECT_EQ(DEFAULT_WDT_TIMEOUT_MS / (60 * 1000), store->get().wdt_period_min);
+    }
+
+    TEST_F(EepromTest, Restart)
+    {
+        {
+            std::shared_ptr<EepromStore> store;
+            std::unique_ptr<Eps> eps = create_eps(store);
+            send_command(*eps, CMD_SET_WDT_PERIOD, 2);
+            send_command(*eps, CMD_SET_PDM_INITIAL_STATE_ON, 3);
+            send_command(*eps, CMD_SET_PDM_INITIAL_STATE_ON, 8);
+            send_command(*eps, CMD_RESET_NODE, 0);
+            eps->set_time(1000);
+            eps->set_time(1000 + 2 * 60 * 1000);
+            EXPECT_EQ(1, eps->get_status().get_num_resets(RESET_WDT));
+            EXPECT_TRUE(store->sync());
+        }
+
+        // values survive simulator restart
+        std::shared_ptr<EepromStore> store;
+        std::unique_ptr<Eps> eps = create_eps(store);
+        EXPECT_FALSE(store->is_new());
+        EXPECT_EQ(2, send_command(*eps, CMD_GET_WDT_PERIOD, 0)[0]);
+        EXPECT_EQ(1, eps->get_status().get_num_resets(RESET_MANUAL));
+        EXPECT_EQ(1, eps->get_status().get_num_resets(RESET_WDT));
+        for(unsigned int i = 0; i < eps->get_num_switches(); i++)
+        {
+            EXPECT_EQ((i == 2) || (i == 7), eps->get_switch_initial_state(i)) << i;
+        }
+
+        // forks do not write through
+        std::unique_ptr<Eps> fork = eps->fork();
+        fork->set_switch_initial_state(0, true);
+        EXPECT_EQ(0, store->get().pdm_initial[0] & 0x1);
+        eps->set_switch_initial_state(0, true);
+        EXPECT_EQ(1, store->get().pdm_initial[0] & 0x1);
+    }
+
+    TEST_F(EepromTest, LayoutMismatch)
+    {
+        {
+            std::shared_ptr<EepromStore> store;
+            std::unique_ptr<Eps> eps = create_eps(store);
+            send_command(*eps, CMD_SET_WDT_PERIOD, 2);
+        }
+
+        // stored image for a different board is reinitialized from current values
+        BoardLayout layout;
+        unsigned int bcr = layout.add_bus("BCR", BUS_BCR);
+        layout.set_node_reset(bcr);
+        Eps other(I2C_ADDRESS, false, layout);
+        std::shared_ptr<EepromStore> store = std::make_shared<EepromStore>();
+        ASSERT_TRUE(store->open(EEPROM_FILE));
+        other.attach_eeprom(store);
+        EXPECT_EQ(0u, store->get().num_switches);
+        EXPECT_EQ(DEFAULT_WDT_TIMEOUT_MS / (60 * 1000), store->get().wdt_period_min);
+    }
+}
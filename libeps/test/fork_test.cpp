@@ -0,0 +1,164 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    class ForkTest : public ::testing::Test
+    {
+    public:
+        ForkTest() :
+            ::testing::Test(),
+            eps(I2C_ADDRESS, false)
+        {
+            eps.set_telemetry(CHANNEL_ISW2, 1.5);
+            eps.configure_channel(CHANNEL_ISW2, ConverterParams{0.002, 0.0});
+            eps.set_time(1000);
+            send_command(eps, CMD_SET_PDM_ON, 2);
+            send_command(eps, CMD_SET_PCM_RESET, 0x1);
+        }
+
+        // simple i2c write/read transaction
+        static I2CData send_command(Eps& target, CommandType type, uint8_t param)
+        {
+            I2CData data{type, param};
+            target.i2c_write(data);
+            target.i2c_read(data);
+            return data;
+        }
+
+        // state blob of simulator
+        static StateBlob get_state(const Eps& target)
+        {
+            StateBlob blob;
+            target.save_state(blob);
+            return blob;
+        }
+
+        Eps eps;
+    };
+
+    TEST_F(ForkTest, SameState)
+    {
+        std::unique_ptr<Eps> fork = eps.fork();
+        EXPECT_EQ(get_state(eps), get_state(*fork));
+        EXPECT_EQ(&eps.get_layout(), &fork->get_layout());
+
+        // pending reset releases in both
+        eps.set_time(2000);
+        fork->set_time(2000);
+        EXPECT_EQ(get_state(eps), get_state(*fork));
+    }
+
+    TEST_F(ForkTest, Independent)
+    {
+        std::unique_ptr<Eps> fork = eps.fork();
+        StateBlob before = get_state(eps);
+
+        send_command(*fork, CMD_SET_PDM_OFF, 2);
+        send_command(*fork, CMD_RESET_NODE, 0);
+        fork->set_telemetry(CHANNEL_ISW2, 0.5);
+        fork->configure_channel(CHANNEL_VSW2, ConverterParams{0.5, 0.0});
+        fork->set_time(5000);
+
+        EXPECT_EQ(before, get_state(eps));
+        EXPECT_TRUE(eps.get_switch_state(1));
+        EXPECT_FALSE(fork->get_switch_state(1));
+    }
+
+    TEST_F(ForkTest, OtherBoard)
+    {
+        std::unique_ptr<Eps> fork = eps.fork();
+        fork->set_address(I2C_ADDRESS + 1);
+        EXPECT_EQ(I2C_ADDRESS, eps.get_address());
+        EXPECT_EQ(I2C_ADDRESS + 1, fork->get_address());
+        EXPECT_EQ(&eps.get_layout(), &fork->get_layout());
+        EXPECT_EQ(get_state(eps), get_state(*fork));
+    }
+
+    TEST_F(ForkTest, ForkOutlivesParent)
+    {
+        std::unique_ptr<Eps> parent = eps.fork();
+        std::unique_ptr<Eps> fork = parent->fork();
+        parent.reset();
+
+        send_command(*fork, CMD_SET_PDM_ALL_ON, 0);
+        fork->set_time(3000);
+        EXPECT_TRUE(fork->get_switch_state(9));
+    }
+
+    TEST_F(ForkTest, LoadProfile)
+    {
+        std::shared_ptr<FileLoadProfile> profile(new FileLoadProfile());
+        profile->add_sample(0, 1.0);
+        profile->add_sample(2000, 2.0);
+        eps.set_switch_load(1, profile);
+
+        std::unique_ptr<Eps> fork = eps.fork();
+
+        // parent profile changes do not affect fork
+        profile->add_sample(3000, 3.0);
+        fork->set_time(4000);
+        ChannelTelemetry tlm;
+        fork->get_telemetry(CHANNEL_ISW2, tlm);
+        EXPECT_DOUBLE_EQ(2.0, tlm.analog);
+    }
+
+    TEST_F(ForkTest, Threads)
+    {
+        const unsigned int NUM_FORKS = 8;
+        std::vector<std::unique_ptr<Eps>> forks;
+        for(unsigned int i = 0; i < NUM_FORKS; i++)
+        {
+            forks.push_back(eps.fork());
+        }
+
+        // run identical scenarios concurrently
+        std::vector<std::thread> threads;
+        for(unsigned int i = 0; i < NUM_FORKS; i++)
+        {
+            Eps *fork = forks[i].get();
+            threads.push_back(std::thread([fork]() {
+                for(unsigned int t = 1; t <= 200; t++)
+                {
+                    fork->set_time(1000 + t * 100);
+                    send_command(*fork, (t % 2) ? CMD_SET_PDM_ON : CMD_SET_PDM_OFF, (t % 10) + 1);
+                    if(t % 50 == 0) send_command(*fork, CMD_SET_PCM_RESET, 0xf);
+                }
+            }));
+        }
+        for(unsigned int i = 0; i < threads.size(); i++)
+        {
+            threads[i].join();
+        }
+
+        StateBlob expected = get_state(*forks[0]);
+        for(unsigned int i = 1; i < NUM_FORKS; i++)
+        {
+            EXPECT_EQ(expected, get_state(*forks[i]));
+        }
+    }
+}
@@ -0,0 +1,198 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "frame.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    // find channel index in frame
+    int find_channel(const StateFrame& frame, ChannelCode code)
+    {
+        for(unsigned int i = 0; i < frame.num_channels; i++)
+        {
+            if(frame.codes[i] == code) return i;
+        }
+        return -1;
+    }
+
+    TEST(FrameTest, Disabled)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        EXPECT_FALSE(eps.get_frames());
+        std::shared_ptr<const FramePublisher> frames = eps.enable_frames();
+        ASSERT_TRUE(frames);
+        EXPECT_EQ(frames, eps.get_frames());
+        EXPECT_EQ(1u, frames->get_count());
+
+        // readers keep last frame
+        eps.disable_frames();
+        EXPECT_FALSE(eps.get_frames());
+        StateFrame frame;
+        EXPECT_TRUE(frames->read(frame));
+    }
+
+    TEST(FrameTest, Publish)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        std::shared_ptr<const FramePublisher> frames = eps.enable_frames();
+        StateFrame frame;
+
+        eps.set_telemetry(CHANNEL_TBRD, 25.0);
+        eps.set_switch_state(3, true);
+        eps.set_switch_initial_state(5, true);
+        eps.set_time(1000);
+        ASSERT_TRUE(frames->read(frame));
+        EXPECT_EQ(1000u, frame.time_ms);
+        EXPECT_EQ(eps.get_changes().get_version(), frame.version);
+        EXPECT_EQ(eps.get_num_switches(), frame.num_switches);
+        EXPECT_TRUE(StateFrame::is_set(frame.switch_actual, 3));
+        EXPECT_TRUE(StateFrame::is_set(frame.switch_expected, 3));
+        EXPECT_FALSE(StateFrame::is_set(frame.switch_actual, 4));
+        EXPECT_TRUE(StateFrame::is_set(frame.switch_initial, 5));
+        EXPECT_EQ(eps.get_status().get_checksum(), frame.board.checksum);
+
+        int index = find_channel(frame, CHANNEL_TBRD);
+        ASSERT_GE(index, 0);
+        ChannelTelemetry tlm;
+        eps.get_telemetry(CHANNEL_TBRD, tlm);
+        EXPECT_EQ(tlm.digital, frame.digital[index]);
+        EXPECT_DOUBLE_EQ(tlm.analog, frame.analog[index]);
+
+        // no frame without state or time change
+        uint64_t count = frames->get_count();
+        eps.set_time(1000);
+        eps.set_telemetry(CHANNEL_TBRD, 25.0);
+        EXPECT_EQ(count, frames->get_count());
+
+        // invalid command sets status bits
+        I2CData data{0xee, 0};
+        eps.i2c_write(data);
+        EXPECT_EQ(count + 1, frames->get_count());
+        ASSERT_TRUE(frames->read(frame));
+        EXPECT_TRUE(Status(frame.board.status).is_set(STATUS_INVALID_CMD));
+    }
+
+    TEST(FrameTest, BulkInit)
+    {
+        Eps single(I2C_ADDRESS, false);
+        Eps bulk(I2C_ADDRESS, false);
+        std::shared_ptr<const FramePublisher> frames = bulk.enable_frames();
+        uint64_t count = frames->get_count();
+
+        // bulk initialization matches per channel initialization, published once
+        TelemetryValues values;
+        values[CHANNEL_TBRD] = 25.0;
+        values[CHANNEL_VPCMBATV] = 7.8;
+        values[CHANNEL_IPCMBATV] = 1.2;
+        ConverterConfig config;
+        config[CHANNEL_TBRD] = ConverterParams{0.5, -10.0};
+        for(TelemetryValues::const_iterator it = values.begin(); it != values.end(); ++it)
+        {
+            single.set_telemetry(it->first, it->second);
+        }
+        single.configure_channel(CHANNEL_TBRD, config[CHANNEL_TBRD]);
+        bulk.set_telemetry(values);
+        EXPECT_EQ(count + 1, frames->get_count());
+        bulk.configure_channels(config);
+        EXPECT_EQ(count + 2, frames->get_count());
+
+        Telemetry expected;
+        Telemetry actual;
+        single.get_telemetry(expected);
+        bulk.get_telemetry(actual);
+        ASSERT_EQ(expected.size(), actual.size());
+        for(Telemetry::const_iterator it = expected.begin(); it != expected.end(); ++it)
+        {
+            EXPECT_EQ(it->second.digital, actual[it->first].digital) << it->first;
+            EXPECT_DOUBLE_EQ(it->second.analog, actual[it->first].analog) << it->first;
+        }
+    }
+
+    TEST(FrameTest, ChannelDescriptors)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        StateFrame frame;
+        eps.get_frame(frame);
+        EXPECT_EQ(eps.get_layout().get_channels().size(), frame.num_channels);
+
+        // descriptors follow board layout, buses numbered per type
+        int index = find_channel(frame, CHANNEL_IBCR1B);
+        ASSERT_GE(index, 0);
+        EXPECT_EQ(BUS_BCR, frame.channels[index].type);
+        EXPECT_EQ(0, frame.channels[index].bus);
+        EXPECT_EQ(SLOT_CURRENT_B, frame.channels[index].slot);
+
+        index = find_channel(frame, CHANNEL_ISW10);
+        ASSERT_GE(index, 0);
+        EXPECT_EQ(BUS_PDM, frame.channels[index].type);
+        EXPECT_EQ(9, frame.channels[index].bus);
+        EXPECT_EQ(SLOT_CURRENT, frame.channels[index].slot);
+
+        index = find_channel(frame, CHANNEL_TBRD);
+        ASSERT_GE(index, 0);
+        EXPECT_EQ(FRAME_NO_BUS, frame.channels[index].type);
+        EXPECT_EQ(SLOT_MISC, frame.channels[index].slot);
+    }
+
+    TEST(FrameTest, ConcurrentRead)
+    {
+        FramePublisher frames;
+        std::atomic<bool> done(false);
+        std::atomic<unsigned int> torn(0);
+
+        // readers check every frame is internally consistent
+        std::vector<std::thread> readers;
+        for(unsigned int r = 0; r < 2; r++)
+        {
+            readers.push_back(std::thread([&frames, &done, &torn]() {
+                StateFrame frame;
+                while(!done)
+                {
+                    if(!frames.read(frame)) continue;
+                    for(unsigned int i = 0; i < MAX_FRAME_CHANNELS; i++)
+                    {
+                        if(frame.analog[i] != static_cast<double>(frame.time_ms)) torn++;
+                    }
+                }
+            }));
+        }
+
+        StateFrame frame = StateFrame();
+        for(uint64_t t = 1; t <= 20000; t++)
+        {
+            frame.time_ms = t;
+            for(unsigned int i = 0; i < MAX_FRAME_CHANNELS; i++) frame.analog[i] = static_cast<double>(t);
+            frames.publish(frame);
+        }
+        done = true;
+        for(unsigned int r = 0; r < readers.size(); r++) readers[r].join();
+
+        EXPECT_EQ(0u, torn.load());
+        EXPECT_EQ(20000u, frames.get_count());
+    }
+}
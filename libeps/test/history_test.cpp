@@ -0,0 +1,136 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "history.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    TEST(HistoryTest, Decimation)
+    {
+        std::unique_ptr<ChannelHistory> history(new ChannelHistory());
+        for(unsigned int i = 0; i < 2 * HISTORY_DECIMATION * HISTORY_DECIMATION; i++)
+        {
+            history->add(i * 10, static_cast<double>(i % HISTORY_DECIMATION));
+        }
+        EXPECT_EQ(2 * HISTORY_DECIMATION * HISTORY_DECIMATION, history->get_count(0));
+        EXPECT_EQ(2 * HISTORY_DECIMATION, history->get_count(1));
+        EXPECT_EQ(2u, history->get_count(2));
+        EXPECT_EQ(0u, history->get_count(3));
+
+        // merged points keep min, max, and mean of their samples
+        HistoryPoint points[HISTORY_SIZE];
+        ASSERT_EQ(2u, history->read(2, points, HISTORY_SIZE));
+        EXPECT_EQ(0, points[0].min);
+        EXPECT_EQ(HISTORY_DECIMATION - 1, points[0].max);
+        EXPECT_DOUBLE_EQ((HISTORY_DECIMATION - 1) / 2.0, points[0].mean);
+        EXPECT_EQ((HISTORY_DECIMATION * HISTORY_DECIMATION - 1) * 10, points[0].time_ms);
+    }
+
+    TEST(HistoryTest, Wrap)
+    {
+        std::unique_ptr<ChannelHistory> history(new ChannelHistory());
+        HistoryPoint points[HISTORY_SIZE];
+        EXPECT_EQ(0u, history->read(0, points, HISTORY_SIZE));
+
+        // latest points oldest first, memory does not grow
+        for(unsigned int i = 0; i < 3 * HISTORY_SIZE + 7; i++)
+        {
+            history->add(i, i);
+        }
+        ASSERT_EQ(HISTORY_SIZE, history->read(0, points, HISTORY_SIZE));
+        EXPECT_EQ(2 * HISTORY_SIZE + 7, points[0].time_ms);
+        EXPECT_EQ(3 * HISTORY_SIZE + 6, points[HISTORY_SIZE - 1].time_ms);
+        ASSERT_EQ(4u, history->read(0, points, 4));
+        EXPECT_EQ(3 * HISTORY_SIZE + 3, points[0].time_ms);
+    }
+
+    TEST(HistoryTest, Store)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        std::shared_ptr<const HistoryStore> history = eps.enable_history(100);
+        ASSERT_TRUE(history);
+        EXPECT_EQ(history, eps.enable_history());
+        EXPECT_EQ(100u, history->get_period());
+        const ChannelHistory *channel = history->find(CHANNEL_TBRD);
+        ASSERT_TRUE(channel);
+        EXPECT_FALSE(history->find(CHANNEL_INVALID));
+
+        // sampled at most once per period
+        eps.set_telemetry(CHANNEL_TBRD, 25.0);
+        eps.set_time(50);
+        eps.set_time(100);
+        eps.set_telemetry(CHANNEL_TBRD, 30.0);
+        eps.set_time(150);
+        eps.set_time(250);
+        HistoryPoint points[HISTORY_SIZE];
+        ASSERT_EQ(3u, channel->read(0, points, HISTORY_SIZE));
+        EXPECT_EQ(100u, points[1].time_ms);
+        EXPECT_DOUBLE_EQ(25.0, points[1].mean);
+        EXPECT_EQ(250u, points[2].time_ms);
+        EXPECT_DOUBLE_EQ(30.0, points[2].mean);
+
+        // zoom level covering span
+        EXPECT_EQ(0u, history->get_level(10 * 1000));
+        EXPECT_EQ(1u, history->get_level(100 * 1000));
+        EXPECT_EQ(HISTORY_LEVELS - 1, history->get_level(1000ull * 60 * 60 * 1000));
+
+        // forks do not record
+        std::unique_ptr<Eps> fork = eps.fork();
+        EXPECT_FALSE(fork->get_history());
+    }
+
+    TEST(HistoryTest, ConcurrentRead)
+    {
+        std::unique_ptr<ChannelHistory> history(new ChannelHistory());
+        std::atomic<bool> done(false);
+        std::atomic<unsigned int> bad(0);
+
+        // readers check points are consecutive samples (value matches time)
+        std::thread reader([&history, &done, &bad]() {
+            std::vector<HistoryPoint> points(HISTORY_SIZE);
+            while(!done)
+            {
+                unsigned int num = history->read(0, points.data(), HISTORY_SIZE);
+                for(unsigned int i = 0; i < num; i++)
+                {
+                    if((points[i].mean != points[i].time_ms) || ((i > 0) && (points[i].time_ms != points[i - 1].time_ms + 1)))
+                    {
+                        bad++;
+                    }
+                }
+            }
+        });
+        for(unsigned int i = 0; i < 200000; i++)
+        {
+            history->add(i, i);
+        }
+        done = true;
+        reader.join();
+        EXPECT_EQ(0u, bad);
+    }
+}
@@ -0,0 +1,210 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+#include <map>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    class JournalTest : public ::testing::Test
+    {
+    public:
+        JournalTest() :
+            ::testing::Test(),
+            eps(I2C_ADDRESS, false)
+        {
+            PdmTripConfig config;
+            config.current_limit = 2.0;
+            config.trip_delay_ms = 100;
+            config.retry_delay_ms = 1000;
+            config.max_retries = 1;
+            eps.set_switch_trip_config(4, config);
+        }
+
+        // simple i2c write/read transaction
+        I2CData send_command(CommandType type, uint8_t param)
+        {
+            I2CData data{type, param};
+            eps.i2c_write(data);
+            eps.i2c_read(data);
+            return data;
+        }
+
+        // state blob of simulator
+        static StateBlob get_state(const Eps& target)
+        {
+            StateBlob blob;
+            target.save_state(blob);
+            return blob;
+        }
+
+        // scripted step with commands, loads, trips, and resets
+        void step(SimTime time)
+        {
+            eps.set_time(time);
+            switch((time / 100) % 7)
+            {
+                case 0: send_command(CMD_SET_PDM_ON, 5); break;
+                case 1: eps.get_load_publisher().publish(4, (time % 300) ? 1.0 : 3.0); break;
+                case 2: eps.set_telemetry(CHANNEL_TBRD, time / 1000.0); break;
+                case 3: send_command(CMD_SET_PCM_RESET, 0x2); break;
+                case 4: eps.set_switch_state(2, (time % 200) != 0); break;
+                case 5: send_command(CMD_GET_TELEMETRY, 0x10); break;
+                default: send_command(CMD_SET_PDM_OFF, 5); break;
+            }
+        }
+
+        Eps eps;
+    };
+
+    TEST_F(JournalTest, Disabled)
+    {
+        EXPECT_EQ(nullptr, eps.get_journal());
+        eps.set_time(1000);
+        EXPECT_EQ(nullptr, eps.reconstruct(500));
+        EXPECT_FALSE(eps.rewind(500));
+    }
+
+    TEST_F(JournalTest, Reconstruct)
+    {
+        JournalConfig config;
+        config.keyframe_interval_ms = 1000;
+        eps.enable_journal(config);
+
+        std::map<SimTime, StateBlob> states;
+        for(SimTime time = 100; time <= 6000; time += 100)
+        {
+            step(time);
+            states[time] = get_state(eps);
+        }
+        EXPECT_GT(eps.get_journal()->get_num_keyframes(), 1);
+
+        for(std::map<SimTime, StateBlob>::const_iterator it = states.begin(); it != states.end(); ++it)
+        {
+            std::unique_ptr<Eps> past = eps.reconstruct(it->first);
+            ASSERT_NE(nullptr, past);
+            EXPECT_EQ(it->second, get_state(*past)) << it->first;
+        }
+
+        // between steps is the state of the latest step
+        std::unique_ptr<Eps> past = eps.reconstruct(2550);
+        ASSERT_NE(nullptr, past);
+        EXPECT_EQ(states[2500], get_state(*past));
+    }
+
+    TEST_F(JournalTest, Rewind)
+    {
+        eps.enable_journal();
+        for(SimTime time = 100; time <= 3000; time += 100) step(time);
+        StateBlob at_end = get_state(eps);
+
+        // no load published at rewind time (pending loads are not journaled state)
+        ASSERT_TRUE(eps.rewind(1600));
+        EXPECT_EQ(1600, eps.get_time());
+
+        // rewound events are discarded
+        std::unique_ptr<Eps> latest = eps.reconstruct(3000);
+        ASSERT_NE(nullptr, latest);
+        EXPECT_EQ(get_state(eps), get_state(*latest));
+
+        // replaying the same inputs reaches the same state
+        for(SimTime time = 1700; time <= 3000; time += 100) step(time);
+        EXPECT_EQ(at_end, get_state(eps));
+    }
+
+    TEST_F(JournalTest, ConfigKeyframe)
+    {
+        eps.enable_journal();
+        eps.set_time(1000);
+        eps.configure_channel(CHANNEL_TBRD, ConverterParams{0.5, 0.0});
+        eps.set_telemetry(CHANNEL_TBRD, 20.0);
+        eps.set_time(2000);
+
+        std::unique_ptr<Eps> past = eps.reconstruct(1500);
+        ASSERT_NE(nullptr, past);
+        ChannelTelemetry now, then;
+        eps.get_telemetry(CHANNEL_TBRD, now);
+        past->get_telemetry(CHANNEL_TBRD, then);
+        EXPECT_EQ(now.digital, then.digital);
+    }
+
+    TEST_F(JournalTest, Bounded)
+    {
+        JournalConfig config;
+        config.max_events = 64;
+        config.max_keyframes = 4;
+        config.keyframe_interval_ms = 0;
+        eps.enable_journal(config);
+
+        std::size_t memory = 0;
+        for(SimTime time = 100; time <= 100000; time += 100)
+        {
+            step(time);
+            if(time == 50000) memory = eps.get_journal()->get_memory_usage();
+        }
+        const Journal *journal = eps.get_journal();
+        EXPECT_EQ(memory, journal->get_memory_usage());
+        EXPECT_LE(journal->get_next_seq() - journal->get_first_seq(), 64u);
+        EXPECT_LE(journal->get_num_keyframes(), 4u);
+
+        // oldest history is gone, recent history is reconstructable
+        SimTime begin = 0;
+        ASSERT_TRUE(journal->get_begin_time(begin));
+        EXPECT_GT(begin, 90000u);
+        EXPECT_EQ(nullptr, eps.reconstruct(begin - 1));
+        std::unique_ptr<Eps> past = eps.reconstruct(begin);
+        ASSERT_NE(nullptr, past);
+    }
+
+    TEST_F(JournalTest, InvalidInputs)
+    {
+        eps.enable_journal();
+        eps.set_time(100);
+        uint64_t seq = eps.get_journal()->get_next_seq();
+
+        // rejected inputs are not journaled
+        eps.set_switch_state(eps.get_num_switches(), true);
+        eps.set_switch_initial_state(eps.get_num_switches(), true);
+        eps.set_telemetry(static_cast<ChannelCode>(0xfff0), 1.0);
+        TelemetryValues values;
+        values[static_cast<ChannelCode>(0xfff0)] = 1.0;
+        values[CHANNEL_TBRD] = 2.0;
+        eps.set_telemetry(values);
+        EXPECT_EQ(seq + 1, eps.get_journal()->get_next_seq());
+    }
+
+    TEST_F(JournalTest, LoadState)
+    {
+        eps.enable_journal();
+        for(SimTime time = 100; time <= 1000; time += 100) step(time);
+
+        Eps other(I2C_ADDRESS, false);
+        other.set_time(5000);
+        eps.load_state(get_state(other));
+
+        // history before load is discarded
+        EXPECT_EQ(1u, eps.get_journal()->get_num_keyframes());
+        EXPECT_EQ(nullptr, eps.reconstruct(1000));
+    }
+}
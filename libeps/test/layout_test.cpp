@@ -0,0 +1,157 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "layout.hpp"
+#include <gtest/gtest.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+    const unsigned int NUM_LARGE_SWITCHES = 40;
+
+    // custom board: one bcr, two pcm buses, 40 switches split between them
+    BoardLayout large_layout()
+    {
+        BoardLayout layout;
+        unsigned int bcr = layout.add_bus("BCR", BUS_BCR, 2);
+        unsigned int pcm_a = layout.add_bus("PCM_A", BUS_PCM);
+        unsigned int pcm_b = layout.add_bus("PCM_B", BUS_PCM);
+        layout.connect(bcr, pcm_a);
+        layout.connect(bcr, pcm_b);
+        layout.add_pcm_reset(pcm_a);
+        layout.add_pcm_reset(pcm_b);
+        layout.set_node_reset(bcr);
+        layout.add_channel(CHANNEL_VBCR1, bcr, SLOT_VOLTAGE, 0);
+        layout.add_channel(CHANNEL_VBCR2, bcr, SLOT_VOLTAGE, 1);
+        layout.add_channel(CHANNEL_IPCM5V, pcm_a, SLOT_CURRENT);
+        layout.add_channel(CHANNEL_TBRD, BoardLayout::NO_BUS, SLOT_MISC);
+        for(unsigned int i = 0; i < NUM_LARGE_SWITCHES; i++)
+        {
+            unsigned int pdm = layout.add_bus("SW" + std::to_string(i), BUS_PDM);
+            layout.connect((i % 2) ? pcm_b : pcm_a, pdm);
+            layout.add_switch(pdm);
+            layout.add_channel(static_cast<ChannelCode>(0x1000 + i), pdm, SLOT_CURRENT);
+        }
+        return layout;
+    }
+
+    I2CData send_command(Eps& eps, CommandType type, uint8_t param)
+    {
+        I2CData data{type, param};
+        eps.i2c_write(data);
+        eps.i2c_read(data);
+        return data;
+    }
+
+    TEST(LayoutTest, BuiltInValid)
+    {
+        const BoardLayout& layout = BoardLayout::clyde_3g();
+        std::string error;
+        EXPECT_TRUE(layout.validate(error)) << error;
+        EXPECT_EQ(1 + NUM_PCM_BUSES + NUM_SWITCHES, layout.get_buses().size());
+        EXPECT_EQ(NUM_SWITCHES, layout.get_switches().size());
+
+        unsigned int sw3 = layout.get_switches()[2];
+        EXPECT_EQ(CHANNEL_ISW3, layout.find_channel(sw3, SLOT_CURRENT));
+        EXPECT_EQ(CHANNEL_SDBCR2B, layout.find_channel(layout.get_node_reset(), SLOT_SUN_B, 1));
+        EXPECT_EQ(CHANNEL_INVALID, layout.find_channel(sw3, SLOT_TEMP));
+    }
+
+    TEST(LayoutTest, Validate)
+    {
+        std::string error;
+
+        BoardLayout cycle = large_layout();
+        cycle.connect(cycle.find_bus("PCM_A"), cycle.find_bus("BCR"));
+        EXPECT_FALSE(cycle.validate(error));
+
+        BoardLayout bad_switch = large_layout();
+        bad_switch.add_switch(bad_switch.find_bus("PCM_A"));
+        EXPECT_FALSE(bad_switch.validate(error));
+
+        BoardLayout bad_slot = large_layout();
+        bad_slot.add_channel(CHANNEL_TBCR1A, bad_slot.find_bus("PCM_B"), SLOT_TEMP);
+        EXPECT_FALSE(bad_slot.validate(error));
+
+        BoardLayout duplicate = large_layout();
+        duplicate.add_channel(CHANNEL_TBRD, BoardLayout::NO_BUS, SLOT_MISC);
+        EXPECT_FALSE(duplicate.validate(error));
+    }
+
+    TEST(LayoutTest, LargeBoard)
+    {
+        Eps eps(I2C_ADDRESS, false, large_layout());
+        EXPECT_EQ(NUM_LARGE_SWITCHES, eps.get_num_switches());
+
+        // switch numbers beyond the built-in board are valid commands
+        send_command(eps, CMD_SET_PDM_ON, NUM_LARGE_SWITCHES);
+        EXPECT_TRUE(eps.get_switch_state(NUM_LARGE_SWITCHES - 1));
+        EXPECT_FALSE(eps.get_status().is_set(STATUS_INVALID_CHANNEL));
+        send_command(eps, CMD_SET_PDM_ON, NUM_LARGE_SWITCHES + 1);
+        EXPECT_TRUE(eps.get_status().is_set(STATUS_INVALID_CHANNEL));
+
+        // telemetry follows the layout
+        ChannelTelemetry tlm;
+        eps.set_telemetry(static_cast<ChannelCode>(0x1000 + 39), 1.5);
+        eps.get_telemetry(static_cast<ChannelCode>(0x1000 + 39), tlm);
+        EXPECT_DOUBLE_EQ(1.5, tlm.analog);
+        Telemetry all;
+        eps.get_telemetry(all);
+        EXPECT_EQ(4 + NUM_LARGE_SWITCHES, all.size());
+
+        // pcm reset bit 1 only resets odd switches
+        eps.set_telemetry(static_cast<ChannelCode>(0x1000), 1.0);
+        eps.set_telemetry(static_cast<ChannelCode>(0x1001), 1.0);
+        send_command(eps, CMD_SET_PDM_ALL_ON, 0);
+        send_command(eps, CMD_SET_PCM_RESET, 0x2);
+        eps.get_telemetry(static_cast<ChannelCode>(0x1000), tlm);
+        EXPECT_DOUBLE_EQ(1.0, tlm.analog);
+        eps.get_telemetry(static_cast<ChannelCode>(0x1001), tlm);
+        EXPECT_DOUBLE_EQ(0.0, tlm.analog);
+        eps.set_time(DEFAULT_BUS_RESET_TIME_MS);
+        eps.get_telemetry(static_cast<ChannelCode>(0x1001), tlm);
+        EXPECT_DOUBLE_EQ(1.0, tlm.analog);
+    }
+
+    TEST(LayoutTest, LoadAggregation)
+    {
+        Eps eps(I2C_ADDRESS, false, large_layout());
+        eps.set_load_aggregation(true);
+        for(unsigned int i = 0; i < NUM_LARGE_SWITCHES; i++)
+        {
+            eps.set_telemetry(static_cast<ChannelCode>(0x1000 + i), 0.1);
+            eps.set_switch_state(i, true);
+        }
+        eps.set_time(1);
+
+        ChannelTelemetry tlm;
+        eps.get_telemetry(CHANNEL_IPCM5V, tlm);
+        EXPECT_NEAR(2.0, tlm.analog, 1e-9);
+    }
+
+    TEST(LayoutTest, InvalidFallsBack)
+    {
+        BoardLayout layout = large_layout();
+        layout.set_node_reset(BoardLayout::NO_BUS);
+        Eps eps(I2C_ADDRESS, false, layout);
+        EXPECT_EQ(NUM_SWITCHES, eps.get_num_switches());
+    }
+}
@@ -0,0 +1,154 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "load.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    // current telemetry value
+    double get_current(const Eps& eps, ChannelCode code)
+    {
+        ChannelTelemetry tlm;
+        eps.get_telemetry(code, tlm);
+        return tlm.analog;
+    }
+
+    TEST(LoadTest, FileLoadProfile)
+    {
+        const char *filename = "load_test_profile.txt";
+        {
+            std::ofstream file(filename);
+            file << "# time_ms, current_A\n"
+                 << "100, 0.5\n"
+                 << "\n"
+                 << "200 1.5   # spike\n"
+                 << "400, 0.25\n";
+        }
+
+        FileLoadProfile profile;
+        ASSERT_TRUE(profile.load(filename));
+        std::remove(filename);
+
+        EXPECT_DOUBLE_EQ(0.0, profile.get_current(0));
+        EXPECT_DOUBLE_EQ(0.5, profile.get_current(100));
+        EXPECT_DOUBLE_EQ(0.5, profile.get_current(199));
+        EXPECT_DOUBLE_EQ(1.5, profile.get_current(200));
+        EXPECT_DOUBLE_EQ(0.25, profile.get_current(1000));
+
+        // time moving backwards
+        EXPECT_DOUBLE_EQ(1.5, profile.get_current(250));
+
+        EXPECT_FALSE(profile.load("missing_load_profile.txt"));
+    }
+
+    TEST(LoadTest, FileLoadProfileLoop)
+    {
+        FileLoadProfile profile(true);
+        profile.add_sample(0, 1.0);
+        profile.add_sample(100, 2.0);
+        profile.add_sample(200, 1.0);
+
+        EXPECT_DOUBLE_EQ(1.0, profile.get_current(50));
+        EXPECT_DOUBLE_EQ(2.0, profile.get_current(150));
+        EXPECT_DOUBLE_EQ(1.0, profile.get_current(250));
+        EXPECT_DOUBLE_EQ(2.0, profile.get_current(350));
+    }
+
+    TEST(LoadTest, SwitchLoad)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        std::shared_ptr<FileLoadProfile> profile(new FileLoadProfile);
+        profile->add_sample(0, 0.75);
+        profile->add_sample(1000, 1.25);
+        eps.set_switch_load(0, profile);
+        eps.set_switch_state(0, true);
+
+        eps.set_time(500);
+        EXPECT_DOUBLE_EQ(0.75, get_current(eps, CHANNEL_ISW1));
+        eps.set_time(1500);
+        EXPECT_DOUBLE_EQ(1.25, get_current(eps, CHANNEL_ISW1));
+
+        // off switch reads zero
+        eps.set_switch_state(0, false);
+        eps.set_time(2000);
+        EXPECT_DOUBLE_EQ(0.0, get_current(eps, CHANNEL_ISW1));
+    }
+
+    TEST(LoadTest, PublishedLoads)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        eps.set_load_aggregation(true);
+        eps.set_switch_state(0, true);
+        eps.set_switch_state(1, true);
+        eps.set_switch_state(2, true);
+
+        LoadBatch batch;
+        batch.push_back(LoadSample(0, 1.0));
+        batch.push_back(LoadSample(1, 0.5));
+        batch.push_back(LoadSample(2, 0.25));
+        batch.push_back(LoadSample(0, 1.5)); // latest wins
+        eps.get_load_publisher().publish(batch);
+
+        // applied on next time update
+        EXPECT_DOUBLE_EQ(0.0, get_current(eps, CHANNEL_ISW1));
+        eps.set_time(100);
+        EXPECT_DOUBLE_EQ(1.5, get_current(eps, CHANNEL_ISW1));
+        EXPECT_DOUBLE_EQ(0.5, get_current(eps, CHANNEL_ISW2));
+        EXPECT_DOUBLE_EQ(0.25, get_current(eps, CHANNEL_ISW3));
+
+        // pcm currents aggregated from connected switches
+        EXPECT_DOUBLE_EQ(2.0, get_current(eps, CHANNEL_IPCM12V));
+        EXPECT_DOUBLE_EQ(0.25, get_current(eps, CHANNEL_IPCM5V));
+        EXPECT_DOUBLE_EQ(0.0, get_current(eps, CHANNEL_IPCM3V3));
+
+        // switching off a load removes it from pcm current
+        eps.set_switch_state(1, false);
+        eps.set_time(200);
+        EXPECT_DOUBLE_EQ(1.5, get_current(eps, CHANNEL_IPCM12V));
+    }
+
+    TEST(LoadTest, PublisherCoalesces)
+    {
+        // samples published while time is paused keep only the latest per switch
+        LoadPublisher publisher;
+        for(int i = 0; i < 1000; i++)
+        {
+            publisher.publish(3, i * 0.001);
+            publisher.publish(1, i * 0.002);
+        }
+        publisher.publish(MAX_PUBLISHED_LOADS, 1.0); // dropped
+
+        LoadBatch batch;
+        ASSERT_TRUE(publisher.drain(batch));
+        ASSERT_EQ(2u, batch.size());
+        EXPECT_EQ(1u, batch[0].num);
+        EXPECT_DOUBLE_EQ(0.999 * 2, batch[0].current);
+        EXPECT_EQ(3u, batch[1].num);
+        EXPECT_DOUBLE_EQ(0.999, batch[1].current);
+        EXPECT_FALSE(publisher.drain(batch));
+    }
+}
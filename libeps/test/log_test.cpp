@@ -0,0 +1,212 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "log.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const std::string LOG_FILE = "log_test_" + std::to_string(getpid()) + ".bin"; // per test process
+    const std::string TEXT_FILE = "log_test_" + std::to_string(getpid()) + ".txt";
+
+    // message formatted from encoded arguments
+    template<typename... Args>
+    std::string format(const char *format, const Args&... args)
+    {
+        LogEntry entry;
+        LogEncoder encoder(entry);
+        encode_args(encoder, args...);
+        return format_log_message(format, entry);
+    }
+
+    // message formatted by printf
+    template<typename... Args>
+    std::string print(const char *format, Args... args)
+    {
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer), format, args...);
+        return buffer;
+    }
+
+    class LogTest : public ::testing::Test
+    {
+    public:
+        LogTest() :
+            ::testing::Test()
+        {
+        }
+
+        ~LogTest()
+        {
+            BinaryLog::get().set_level(LEVEL_DEBUG);
+            std::remove(LOG_FILE.c_str());
+            std::remove(TEXT_FILE.c_str());
+        }
+    };
+
+    TEST_F(LogTest, Format)
+    {
+        // same text as printf for the conversions the simulator logs
+        std::string name("BCR");
+        EXPECT_EQ(print("eps cmd %s: cmd=0x%x, param=0x%x", "SET_PDM_ON", 0x50u, 3u),
+                  format("eps cmd %s: cmd=0x%x, param=0x%x", "SET_PDM_ON", static_cast<uint8_t>(0x50), 3));
+        EXPECT_EQ(print("bus %s reset enabled (time=%fs)", "BCR", 1.5), format("bus %s reset enabled (time=%fs)", name, 1.5));
+        EXPECT_EQ(print("invalid switch number: %d", -4), format("invalid switch number: %d", -4));
+        EXPECT_EQ(print("time=%lums", 123456789ul), format("time=%lums", 123456789ul));
+        EXPECT_EQ(print("%-8s|%5.2f|%04u|%%", "a", 3.14159, 7u), format("%-8s|%5.2f|%04u|%%", "a", 3.14159, 7u));
+        EXPECT_EQ(print("state: %s", "on"), format("state: %s", true ? "on" : "off"));
+
+        // missing arguments are left as written
+        EXPECT_EQ("value=%d", format("value=%d"));
+    }
+
+    TEST_F(LogTest, Truncated)
+    {
+        std::string text(LOG_PAYLOAD_SIZE * 2, 'x');
+        std::string message = format("%s", text);
+        EXPECT_LT(message.size(), text.size());
+        EXPECT_EQ("...", message.substr(message.size() - 3));
+    }
+
+    TEST_F(LogTest, Level)
+    {
+        EXPECT_EQ(LEVEL_WARNING, to_log_level("WARNING"));
+        EXPECT_EQ(LEVEL_DEBUG, to_log_level("debug"));
+        EXPECT_EQ(LEVEL_OFF, to_log_level("off"));
+        EXPECT_EQ(LEVEL_INFO, to_log_level("unknown"));
+
+        BinaryLog::get().set_level(LEVEL_WARNING);
+        EXPECT_TRUE(BinaryLog::get().is_enabled(LEVEL_ERROR));
+        EXPECT_TRUE(BinaryLog::get().is_enabled(LEVEL_WARNING));
+        EXPECT_FALSE(BinaryLog::get().is_enabled(LEVEL_INFO));
+
+        // arguments of disabled records are not evaluated
+        int evaluated = 0;
+        EPS_LOG_INFO("value=%d", ++evaluated);
+        EXPECT_EQ(0, evaluated);
+    }
+
+    TEST_F(LogTest, Ring)
+    {
+        LogRing ring(16);
+        const unsigned int THREADS = 4;
+        const unsigned int RECORDS = 1000;
+        std::vector<std::thread> threads;
+        for(unsigned int t = 0; t < THREADS; t++)
+        {
+            threads.push_back(std::thread([&ring, t]() {
+                for(unsigned int i = 0; i < RECORDS; i++)
+                {
+                    uint64_t ticket = 0;
+                    LogEntry *entry = nullptr;
+                    while((entry = ring.claim(ticket)) == nullptr) std::this_thread::yield();
+                    entry->site = t;
+                    entry->time_ns = i;
+                    ring.publish(ticket);
+                }
+            }));
+        }
+
+        // records of each producer arrive in order
+        std::vector<uint64_t> next(THREADS, 0);
+        LogEntry entry;
+        unsigned int popped = 0;
+        while(popped < THREADS * RECORDS)
+        {
+            if(!ring.pop(entry))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            ASSERT_LT(entry.site, THREADS);
+            EXPECT_EQ(next[entry.site]++, entry.time_ns);
+            popped++;
+        }
+        for(std::thread& thread : threads) thread.join();
+        EXPECT_FALSE(ring.pop(entry));
+
+        // full ring drops
+        uint64_t ticket = 0;
+        for(unsigned int i = 0; i < 16; i++)
+        {
+            ASSERT_NE(nullptr, ring.claim(ticket));
+            ring.publish(ticket);
+        }
+        EXPECT_EQ(nullptr, ring.claim(ticket));
+    }
+
+    TEST_F(LogTest, BinaryFile)
+    {
+        {
+            LogWriter writer(LOG_FILE);
+            std::thread thread([]() {EPS_LOG_WARNING("watchdog timer reset (time=%fs)", 2.5);});
+            thread.join();
+            EPS_LOG_INFO("updating eps pdm switch %d state: %s", 3, "on");
+            EPS_LOG_DEBUG("debug %u", 1u);
+            BinaryLog::get().set_level(LEVEL_INFO);
+            EPS_LOG_DEBUG("debug %u", 2u);
+        }
+
+        // decoded as text log lines
+        FILE *text = std::fopen(TEXT_FILE.c_str(), "w");
+        ASSERT_NE(nullptr, text);
+        EXPECT_TRUE(decode_log(LOG_FILE, text));
+        std::fclose(text);
+        std::ifstream lines(TEXT_FILE);
+        std::vector<std::string> decoded;
+        std::string line;
+        while(std::getline(lines, line)) decoded.push_back(line);
+        ASSERT_EQ(3u, decoded.size());
+        EXPECT_NE(std::string::npos, decoded[0].find(" [WARNING] - watchdog timer reset (time=2.500000s)"));
+        EXPECT_NE(std::string::npos, decoded[1].find(" [INFO] - updating eps pdm switch 3 state: on"));
+        EXPECT_NE(std::string::npos, decoded[2].find(" [DEBUG] - debug 1"));
+        EXPECT_EQ(0u, decoded[0].find("20")); // date first
+    }
+
+    TEST_F(LogTest, MalformedFile)
+    {
+        // call site records with out of range ids are rejected
+        const uint32_t ids[] = {0, 0xffffffff, MAX_LOG_SITES + 1};
+        for(uint32_t id : ids)
+        {
+            FILE *file = std::fopen(LOG_FILE.c_str(), "wb");
+            ASSERT_NE(nullptr, file);
+            uint8_t level = LEVEL_INFO;
+            uint16_t length = 0;
+            std::fwrite(LOG_FILE_MAGIC, sizeof(LOG_FILE_MAGIC), 1, file);
+            std::fputc('S', file);
+            std::fwrite(&id, sizeof(id), 1, file);
+            std::fwrite(&level, sizeof(level), 1, file);
+            std::fwrite(&length, sizeof(length), 1, file);
+            std::fclose(file);
+
+            FILE *text = std::fopen(TEXT_FILE.c_str(), "w");
+            ASSERT_NE(nullptr, text);
+            EXPECT_FALSE(decode_log(LOG_FILE, text)) << id;
+            std::fclose(text);
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "rom.hpp"
+#include "eps.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    // bitwise reference CRC-16/CCITT-FALSE
+    uint16_t reference_crc(const std::vector<uint8_t>& data, uint16_t crc = CRC16_INIT)
+    {
+        for(unsigned int i = 0; i < data.size(); i++)
+        {
+            crc ^= static_cast<uint16_t>(data[i] << 8);
+            for(unsigned int j = 0; j < 8; j++)
+            {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ CRC16_POLY) : static_cast<uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    // checksum recomputed over complete image
+    uint16_t image_crc(const RomImage& image)
+    {
+        const std::vector<uint8_t>& firmware = image.get_firmware();
+        return crc16(image.get_config().data(), ROM_CONFIG_SIZE, crc16(firmware.data(), firmware.size()));
+    }
+
+    TEST(RomTest, Crc)
+    {
+        std::string check = "123456789";
+        EXPECT_EQ(0x29b1, crc16(reinterpret_cast<const uint8_t*>(check.data()), check.size()));
+
+        std::srand(1);
+        for(unsigned int size = 0; size < 100; size++)
+        {
+            std::vector<uint8_t> data(size);
+            for(unsigned int i = 0; i < size; i++) data[i] = static_cast<uint8_t>(std::rand());
+            EXPECT_EQ(reference_crc(data), crc16(data.data(), data.size())) << size;
+            EXPECT_EQ(reference_crc(data, 0x1234), crc16(data.data(), data.size(), 0x1234)) << size;
+
+            std::vector<uint8_t> zeros(size * 37);
+            EXPECT_EQ(reference_crc(zeros, 0xbeef), crc16_shift(0xbeef, zeros.size())) << size;
+        }
+    }
+
+    TEST(RomTest, IncrementalWrite)
+    {
+        RomImage image;
+        EXPECT_EQ(image_crc(image), image.get_checksum());
+        image.set_firmware(0xabcd, 0);
+        EXPECT_EQ(ROM_FIRMWARE_SIZE, image.get_firmware().size());
+        EXPECT_EQ(image_crc(image), image.get_checksum());
+
+        std::srand(2);
+        for(unsigned int i = 0; i < 200; i++)
+        {
+            std::size_t offset = std::rand() % ROM_CONFIG_SIZE;
+            std::size_t size = std::rand() % (ROM_CONFIG_SIZE - offset + 1);
+            std::vector<uint8_t> data(size);
+            for(unsigned int j = 0; j < size; j++) data[j] = static_cast<uint8_t>(std::rand());
+            image.write(offset, data.data(), data.size());
+            ASSERT_EQ(image_crc(image), image.get_checksum()) << offset << " " << size;
+        }
+
+        // out of range writes are ignored
+        uint16_t xsum = image.get_checksum();
+        uint8_t data[2] = {1, 2};
+        image.write(ROM_CONFIG_SIZE - 1, data, sizeof(data));
+        EXPECT_EQ(xsum, image.get_checksum());
+    }
+
+    TEST(RomTest, Firmware)
+    {
+        RomImage image;
+        image.set_firmware(0x1001, 0);
+        RomImage copy(image);
+        EXPECT_EQ(&image.get_firmware(), &copy.get_firmware());
+
+        RomImage db_image;
+        db_image.set_firmware(0x1001, 1);
+        EXPECT_NE(image.get_checksum(), db_image.get_checksum());
+        copy.set_firmware(0x1002, 0);
+        EXPECT_NE(image.get_checksum(), copy.get_checksum());
+        EXPECT_EQ(image_crc(copy), copy.get_checksum());
+    }
+
+    TEST(RomTest, EpsChecksum)
+    {
+        Eps eps(I2C_ADDRESS, true);
+        uint16_t xsum = eps.get_status().get_checksum();
+        uint16_t db_xsum = eps.get_daughterboard_status().get_checksum();
+        EXPECT_NE(xsum, db_xsum);
+
+        // switch initial state is EEPROM backed (motherboard only)
+        eps.set_switch_initial_state(3, true);
+        EXPECT_NE(xsum, eps.get_status().get_checksum());
+        EXPECT_EQ(db_xsum, eps.get_daughterboard_status().get_checksum());
+
+        // status updates keep checksum
+        uint16_t initial_xsum = eps.get_status().get_checksum();
+        eps.set_status(Status());
+        EXPECT_EQ(initial_xsum, eps.get_status().get_checksum());
+
+        // firmware version changes checksum
+        eps.set_version(Version(0x1234));
+        EXPECT_NE(initial_xsum, eps.get_status().get_checksum());
+        uint16_t version_xsum = eps.get_status().get_checksum();
+
+        // forks and saved state carry checksum
+        std::unique_ptr<Eps> fork = eps.fork();
+        EXPECT_EQ(version_xsum, fork->get_status().get_checksum());
+        StateBlob blob;
+        eps.save_state(blob);
+        Eps loaded(I2C_ADDRESS, true);
+        ASSERT_TRUE(loaded.load_state(blob));
+        EXPECT_EQ(version_xsum, loaded.get_status().get_checksum());
+        EXPECT_EQ(db_xsum, loaded.get_daughterboard_status().get_checksum());
+    }
+}
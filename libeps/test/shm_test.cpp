@@ -0,0 +1,88 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "shm.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+    const std::string SHM_NAME = "/eps_shm_test_" + std::to_string(getpid()); // per test process
+
+    TEST(ShmTest, EditRingOrder)
+    {
+        std::unique_ptr<EditRing> ring(new EditRing());
+        EditCommand command;
+        EXPECT_FALSE(ring->pop(command));
+
+        // ring wraps around several times in order
+        for(unsigned int i = 0; i < 3 * EDIT_RING_SIZE; i++)
+        {
+            ASSERT_TRUE(ring->push(EditCommand(EDIT_SWITCH, i, 1)));
+            ASSERT_TRUE(ring->pop(command));
+            EXPECT_EQ(i, command.num);
+        }
+
+        // full ring rejects pushes until popped
+        for(unsigned int i = 0; i < EDIT_RING_SIZE; i++) ASSERT_TRUE(ring->push(EditCommand(EDIT_TELEMETRY, i, i * 0.5)));
+        EXPECT_FALSE(ring->push(EditCommand()));
+        ASSERT_TRUE(ring->pop(command));
+        EXPECT_EQ(0u, command.num);
+        EXPECT_TRUE(ring->push(EditCommand()));
+    }
+
+    TEST(ShmTest, RoundTrip)
+    {
+        std::shared_ptr<ShmServer> server = std::make_shared<ShmServer>();
+        ASSERT_TRUE(server->create(SHM_NAME, I2C_ADDRESS));
+
+        Eps eps(I2C_ADDRESS, false);
+        eps.enable_frames(std::shared_ptr<FramePublisher>(server, &server->get_frames()));
+        eps.set_switch_state(1, true);
+
+        // viewer sees published state
+        ShmClient client;
+        ASSERT_TRUE(client.open(SHM_NAME));
+        EXPECT_TRUE(client.is_alive());
+        EXPECT_EQ(I2C_ADDRESS, client.get_address());
+        StateFrame frame;
+        client.get_frames().read(frame);
+        EXPECT_EQ(eps.get_num_switches(), frame.num_switches);
+        EXPECT_TRUE(StateFrame::is_set(frame.switch_actual, 1));
+
+        // edits reach the simulator
+        EXPECT_TRUE(client.send(EditCommand(EDIT_SWITCH, 2, 1)));
+        EditCommand command;
+        ASSERT_TRUE(server->poll(command));
+        EXPECT_EQ(EDIT_SWITCH, command.type);
+        EXPECT_EQ(2u, command.num);
+        EXPECT_FALSE(server->poll(command));
+
+        // closed segment is no longer alive or attachable
+        server->close();
+        EXPECT_FALSE(client.is_alive());
+        ShmClient late;
+        EXPECT_FALSE(late.open(SHM_NAME));
+    }
+}
@@ -0,0 +1,191 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    class StateTest : public ::testing::Test
+    {
+    public:
+        StateTest() :
+            ::testing::Test(),
+            eps(I2C_ADDRESS, false)
+        {
+            // non-default state throughout the board
+            eps.set_telemetry(CHANNEL_VBCR2, 19.5);
+            eps.set_telemetry(CHANNEL_TBRD, 21.0);
+            eps.set_telemetry(CHANNEL_ISW3, 3.0);
+            eps.configure_channel(CHANNEL_ISW3, ConverterParams{0.002, 0.1});
+            PdmTripConfig config;
+            config.current_limit = 2.0;
+            config.trip_delay_ms = 100;
+            config.retry_delay_ms = 1000;
+            config.max_retries = 2;
+            eps.set_switch_trip_config(2, config);
+
+            eps.set_time(1000);
+            send_command(CMD_SET_PDM_ON, 3);
+            send_command(CMD_SET_PDM_ON, 5);
+            send_command(CMD_SET_PDM_INITIAL_STATE_ON, 7);
+            send_command(CMD_SET_WDT_PERIOD, 2);
+            send_command(CMD_SET_PDM_TIMER_LIMIT, 0xff);
+            eps.set_time(1100);
+            send_command(CMD_SET_PCM_RESET, 0x4);
+        }
+
+        // simple i2c write/read transaction
+        I2CData send_command(CommandType type, uint8_t param)
+        {
+            I2CData data{type, param};
+            eps.i2c_write(data);
+            eps.i2c_read(data);
+            return data;
+        }
+
+        // compare observable state of two simulators
+        void expect_equal(const Eps& lhs, const Eps& rhs)
+        {
+            EXPECT_EQ(lhs.get_time(), rhs.get_time());
+            EXPECT_EQ(lhs.is_reset(), rhs.is_reset());
+            EXPECT_EQ(lhs.get_status().get_status(), rhs.get_status().get_status());
+            EXPECT_EQ(lhs.get_status().get_num_resets(RESET_MANUAL), rhs.get_status().get_num_resets(RESET_MANUAL));
+            for(unsigned int i = 0; i < lhs.get_num_switches(); i++)
+            {
+                EXPECT_EQ(lhs.get_switch_state(i), rhs.get_switch_state(i));
+                EXPECT_EQ(lhs.get_switch_initial_state(i), rhs.get_switch_initial_state(i));
+                EXPECT_EQ(lhs.is_switch_tripped(i), rhs.is_switch_tripped(i));
+            }
+
+            Telemetry lhs_tlm, rhs_tlm;
+            lhs.get_telemetry(lhs_tlm);
+            rhs.get_telemetry(rhs_tlm);
+            ASSERT_EQ(lhs_tlm.size(), rhs_tlm.size());
+            for(Telemetry::const_iterator it = lhs_tlm.begin(); it != lhs_tlm.end(); ++it)
+            {
+                EXPECT_EQ(it->second.digital, rhs_tlm[it->first].digital) << std::hex << it->first;
+                EXPECT_DOUBLE_EQ(it->second.analog, rhs_tlm[it->first].analog) << std::hex << it->first;
+            }
+        }
+
+        Eps eps;
+    };
+
+    TEST_F(StateTest, RoundTrip)
+    {
+        StateBlob blob;
+        eps.save_state(blob);
+
+        Eps copy(I2C_ADDRESS, false);
+        ASSERT_TRUE(copy.load_state(blob));
+        expect_equal(eps, copy);
+
+        // saved blob is identical
+        StateBlob copy_blob;
+        copy.save_state(copy_blob);
+        EXPECT_EQ(blob, copy_blob);
+    }
+
+    TEST_F(StateTest, PendingEvents)
+    {
+        StateBlob blob;
+        eps.save_state(blob);
+        Eps copy(I2C_ADDRESS, false);
+        ASSERT_TRUE(copy.load_state(blob));
+
+        // overcurrent trip, pcm reset release and watchdog continue identically
+        const SimTime TIMES[] = {1200, 1700, 2500, 2 * 60 * 1000 + 1100};
+        for(unsigned int i = 0; i < sizeof(TIMES) / sizeof(TIMES[0]); i++)
+        {
+            eps.set_time(TIMES[i]);
+            copy.set_time(TIMES[i]);
+            expect_equal(eps, copy);
+        }
+        EXPECT_EQ(1, copy.get_status().get_num_resets(RESET_WDT));
+    }
+
+    TEST_F(StateTest, InvalidBlob)
+    {
+        StateBlob blob;
+        eps.save_state(blob);
+
+        Eps copy(I2C_ADDRESS, false);
+        StateBlob before;
+        copy.save_state(before);
+
+        // truncated
+        StateBlob truncated(blob.begin(), blob.end() - 4);
+        EXPECT_FALSE(copy.load_state(truncated));
+
+        // wrong format version
+        StateBlob version(blob);
+        version[4]++;
+        EXPECT_FALSE(copy.load_state(version));
+
+        // trailing data
+        StateBlob trailing(blob);
+        trailing.push_back(0);
+        EXPECT_FALSE(copy.load_state(trailing));
+
+        // state unchanged
+        StateBlob after;
+        copy.save_state(after);
+        EXPECT_EQ(before, after);
+    }
+
+    TEST_F(StateTest, RawReader)
+    {
+        StateBlob blob;
+        StateWriter writer(blob);
+        writer.write(static_cast<uint32_t>(42));
+        writer.write(std::vector<double>{1.5, -2.5});
+
+        // reads from memory not owned by a blob, bounded by its size
+        StateReader reader(blob.data(), blob.size());
+        uint32_t value = 0;
+        std::vector<double> values;
+        EXPECT_TRUE(reader.read(value));
+        EXPECT_TRUE(reader.read(values));
+        EXPECT_TRUE(reader.is_done());
+        EXPECT_EQ(42u, value);
+        EXPECT_EQ(std::vector<double>({1.5, -2.5}), values);
+
+        StateReader truncated(blob.data(), blob.size() - 1);
+        EXPECT_TRUE(truncated.read(value));
+        EXPECT_FALSE(truncated.read(values));
+        EXPECT_FALSE(truncated.is_valid());
+    }
+
+    TEST_F(StateTest, LayoutMismatch)
+    {
+        StateBlob blob;
+        eps.save_state(blob);
+
+        BoardLayout layout;
+        unsigned int bcr = layout.add_bus("BCR", BUS_BCR);
+        layout.set_node_reset(bcr);
+        Eps other(I2C_ADDRESS, false, layout);
+        EXPECT_FALSE(other.load_state(blob));
+    }
+}
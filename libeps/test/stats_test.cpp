@@ -0,0 +1,190 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "stats.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+
+    // simple i2c write/read transaction
+    I2CData send_command(Eps& eps, CommandType type, uint8_t param)
+    {
+        I2CData data{type, param};
+        eps.i2c_write(data);
+        eps.i2c_read(data);
+        return data;
+    }
+
+    TEST(StatsTest, Buckets)
+    {
+        // small latencies are exact, larger ones within a sub bucket
+        for(uint64_t ns = 0; ns < 2 * LATENCY_SUB_BUCKETS; ns++)
+        {
+            unsigned int bucket = LatencyHistogram::get_bucket(ns);
+            EXPECT_EQ(ns, LatencyHistogram::get_lowest(bucket));
+            EXPECT_EQ(ns, LatencyHistogram::get_highest(bucket));
+        }
+        for(uint64_t ns = 2 * LATENCY_SUB_BUCKETS; ns < (1ull << LATENCY_MAX_BITS); ns = ns * 3 / 2 + 7)
+        {
+            unsigned int bucket = LatencyHistogram::get_bucket(ns);
+            ASSERT_LT(bucket, LATENCY_BUCKETS);
+            EXPECT_LE(LatencyHistogram::get_lowest(bucket), ns) << ns;
+            EXPECT_GE(LatencyHistogram::get_highest(bucket), ns) << ns;
+            EXPECT_LE(LatencyHistogram::get_highest(bucket) - LatencyHistogram::get_lowest(bucket) + 1,
+                      ns / LATENCY_SUB_BUCKETS + 1) << ns;
+        }
+
+        // buckets are contiguous, large values are clamped
+        for(unsigned int bucket = 1; bucket < LATENCY_BUCKETS; bucket++)
+        {
+            EXPECT_EQ(LatencyHistogram::get_highest(bucket - 1) + 1, LatencyHistogram::get_lowest(bucket));
+        }
+        EXPECT_EQ(LATENCY_BUCKETS - 1, LatencyHistogram::get_bucket(1ull << LATENCY_MAX_BITS));
+        EXPECT_EQ(LATENCY_BUCKETS - 1, LatencyHistogram::get_bucket(~0ull));
+    }
+
+    TEST(StatsTest, Percentiles)
+    {
+        std::unique_ptr<LatencyHistogram> histogram(new LatencyHistogram());
+        EXPECT_EQ(0u, histogram->get_percentile(50.0));
+        EXPECT_EQ(0u, histogram->get_min());
+
+        for(uint64_t ns = 1; ns <= 10000; ns++)
+        {
+            histogram->record(ns * 100);
+        }
+        EXPECT_EQ(10000u, histogram->get_count());
+        EXPECT_EQ(100u, histogram->get_min());
+        EXPECT_EQ(1000000u, histogram->get_max());
+        EXPECT_DOUBLE_EQ(500050.0, histogram->get_mean());
+        EXPECT_NEAR(500000.0, histogram->get_percentile(50.0), 500000.0 / LATENCY_SUB_BUCKETS);
+        EXPECT_NEAR(990000.0, histogram->get_percentile(99.0), 990000.0 / LATENCY_SUB_BUCKETS);
+        EXPECT_EQ(1000000u, histogram->get_percentile(100.0));
+    }
+
+    TEST(StatsTest, Threads)
+    {
+        const unsigned int NUM_THREADS = 4;
+        const unsigned int NUM_RECORDS = 10000;
+        std::shared_ptr<CommandStats> stats = std::make_shared<CommandStats>();
+        std::vector<std::thread> threads;
+        for(unsigned int i = 0; i < NUM_THREADS; i++)
+        {
+            threads.push_back(std::thread([stats, i]() {
+                for(unsigned int n = 0; n < NUM_RECORDS; n++)
+                {
+                    stats->record_latency(CMD_GET_TELEMETRY, 1000 * (i + 1));
+                }
+            }));
+        }
+        for(unsigned int i = 0; i < threads.size(); i++)
+        {
+            threads[i].join();
+        }
+
+        const LatencyHistogram& latency = stats->get_latency(CMD_GET_TELEMETRY);
+        EXPECT_EQ(NUM_THREADS * NUM_RECORDS, latency.get_count());
+        EXPECT_EQ(1000u, latency.get_min());
+        EXPECT_EQ(1000u * NUM_THREADS, latency.get_max());
+    }
+
+    TEST(StatsTest, Commands)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        EXPECT_EQ(nullptr, eps.get_stats());
+        std::shared_ptr<CommandStats> stats = eps.enable_stats();
+        EXPECT_EQ(stats, eps.enable_stats());
+
+        send_command(eps, CMD_GET_TELEMETRY, 0);
+        send_command(eps, CMD_GET_VERSION, 0);
+        send_command(eps, CMD_GET_VERSION, 0);
+        send_command(eps, CMD_SET_PDM_ON, 0x20);
+        send_command(eps, static_cast<CommandType>(0x99), 0);
+        send_command(eps, static_cast<CommandType>(0x98), 0);
+        eps.i2c_write(I2CData{CMD_GET_VERSION});
+
+        EXPECT_EQ(3u, stats->get_count(CMD_GET_VERSION));
+        EXPECT_EQ(2u, stats->get_errors(CMD_GET_VERSION, ERROR_NONE));
+        EXPECT_EQ(1u, stats->get_errors(CMD_GET_VERSION, ERROR_INVALID_CMD));
+        EXPECT_EQ(5u, stats->get_bytes_in(CMD_GET_VERSION));
+        EXPECT_EQ(6u, stats->get_bytes_out(CMD_GET_VERSION));
+        EXPECT_EQ(1u, stats->get_errors(CMD_SET_PDM_ON, ERROR_INVALID_CHANNEL));
+        EXPECT_EQ(1u, stats->get_count(CMD_GET_TELEMETRY));
+
+        // unknown commands are counted together
+        EXPECT_EQ(2u, stats->get_count(0x99));
+        EXPECT_EQ(2u, stats->get_errors(0x98, ERROR_INVALID_CMD));
+        EXPECT_EQ(0u, stats->get_count(CMD_RESET_NODE));
+
+        // commands in reset get no response
+        send_command(eps, CMD_RESET_NODE, 0);
+        send_command(eps, CMD_GET_BOARD_STATUS, 0);
+        EXPECT_EQ(1u, stats->get_errors(CMD_GET_BOARD_STATUS, ERROR_RESET));
+        EXPECT_EQ(0u, stats->get_bytes_out(CMD_GET_BOARD_STATUS));
+
+        // report lists received commands only
+        std::string report = stats->get_report();
+        EXPECT_NE(std::string::npos, report.find("GET_VERSION"));
+        EXPECT_NE(std::string::npos, report.find("INVALID_CHANNEL=1"));
+        EXPECT_NE(std::string::npos, report.find("UNKNOWN"));
+        EXPECT_EQ(std::string::npos, report.find("SET_PCM_RESET"));
+
+        // forks do not count
+        std::unique_ptr<Eps> fork = eps.fork();
+        EXPECT_EQ(nullptr, fork->get_stats());
+        send_command(*fork, CMD_GET_VERSION, 0);
+        EXPECT_EQ(3u, stats->get_count(CMD_GET_VERSION));
+
+        eps.disable_stats();
+        send_command(eps, CMD_GET_VERSION, 0);
+        EXPECT_EQ(3u, stats->get_count(CMD_GET_VERSION));
+    }
+
+    TEST(StatsTest, Events)
+    {
+        Eps eps(I2C_ADDRESS, false);
+        std::shared_ptr<CommandStats> stats = eps.enable_stats();
+
+        send_command(eps, CMD_GET_VERSION, 0);
+        send_command(eps, CMD_SET_PDM_ON, 0x20);
+        send_command(eps, static_cast<CommandType>(0x99), 0);
+        EXPECT_EQ(3u, stats->get_total_count());
+        EXPECT_EQ(1u, stats->get_total_errors(ERROR_NONE));
+        EXPECT_EQ(1u, stats->get_total_errors(ERROR_INVALID_CHANNEL));
+        EXPECT_EQ(1u, stats->get_total_errors(ERROR_INVALID_CMD));
+        EXPECT_EQ(2u, stats->get_total_failures());
+
+        // manual and watchdog resets reset the node bus
+        send_command(eps, CMD_RESET_NODE, 0);
+        EXPECT_EQ(1u, stats->get_events(EVENT_BUS_RESET));
+        EXPECT_EQ(0u, stats->get_events(EVENT_WDT_RESET));
+        eps.set_time(DEFAULT_BUS_RESET_TIME_MS);
+        eps.set_time(DEFAULT_BUS_RESET_TIME_MS + DEFAULT_WDT_TIMEOUT_MS);
+        EXPECT_EQ(1u, stats->get_events(EVENT_WDT_RESET));
+        EXPECT_EQ(2u, stats->get_events(EVENT_BUS_RESET));
+        EXPECT_EQ(0u, stats->get_events(EVENT_PDM_TRIP));
+    }
+}
@@ -0,0 +1,166 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "topology.hpp"
+#include "pdm.hpp"
+#include <gtest/gtest.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    // bus counting reset notifications
+    class CountBus : public Bus
+    {
+    public:
+        CountBus() : Bus(), count(0) {}
+        void on_reset(bool) {count++;}
+        unsigned int count;
+    };
+
+    // root -> (a, b) -> c (diamond)
+    class TopologyTest : public ::testing::Test
+    {
+    public:
+        TopologyTest() :
+            ::testing::Test(),
+            topology()
+        {
+            root_idx = topology.add(root);
+            a_idx = topology.add(a);
+            b_idx = topology.add(b);
+            c_idx = topology.add(c);
+            topology.connect(root_idx, a_idx);
+            topology.connect(root_idx, b_idx);
+            topology.connect(a_idx, c_idx);
+            topology.connect(b_idx, c_idx);
+        }
+
+        CountBus root, a, b, c;
+        unsigned int root_idx, a_idx, b_idx, c_idx;
+        BusTopology topology;
+    };
+
+    TEST_F(TopologyTest, Adjacency)
+    {
+        typedef std::vector<unsigned int> Indices;
+
+        EXPECT_EQ(4, topology.size());
+        EXPECT_EQ(Indices({a_idx, b_idx}), topology.get_children(root_idx));
+        EXPECT_EQ(Indices({a_idx, b_idx}), topology.get_parents(c_idx));
+        EXPECT_EQ(Indices({a_idx, b_idx, c_idx}), topology.get_descendants(root_idx));
+        EXPECT_EQ(Indices({c_idx}), topology.get_descendants(a_idx));
+        EXPECT_TRUE(topology.get_descendants(c_idx).empty());
+        EXPECT_TRUE(topology.get_parents(root_idx).empty());
+        EXPECT_LT(topology.get_rank(root_idx), topology.get_rank(a_idx));
+        EXPECT_LT(topology.get_rank(b_idx), topology.get_rank(c_idx));
+    }
+
+    TEST_F(TopologyTest, ResetPropagation)
+    {
+        root.reset(true);
+        EXPECT_EQ(0xf, topology.get_reset_state()[0]);
+        EXPECT_TRUE(a.is_reset());
+        EXPECT_TRUE(c.is_reset());
+        EXPECT_EQ(1, root.count);
+        EXPECT_EQ(1, c.count);
+
+        // releasing child while parent reset has no effect
+        a.reset(false);
+        EXPECT_TRUE(a.is_reset());
+        EXPECT_EQ(1, a.count);
+
+        root.reset(false);
+        EXPECT_EQ(0, topology.get_reset_state()[0]);
+        EXPECT_FALSE(c.is_reset());
+        EXPECT_EQ(2, c.count);
+    }
+
+    TEST_F(TopologyTest, ChangedOnly)
+    {
+        // c held in reset through both parents
+        a.reset(true);
+        b.reset(true);
+        EXPECT_EQ(1, c.count);
+        EXPECT_EQ(0, root.count);
+
+        a.reset(false);
+        EXPECT_FALSE(a.is_reset());
+        EXPECT_TRUE(c.is_reset());
+        EXPECT_EQ(1, c.count);
+
+        b.reset(false);
+        EXPECT_FALSE(c.is_reset());
+        EXPECT_EQ(2, c.count);
+
+        // repeated reset is ignored
+        c.reset(true);
+        c.reset(true);
+        EXPECT_EQ(3, c.count);
+    }
+
+    TEST_F(TopologyTest, PdmStateWords)
+    {
+        PdmStateWords words;
+        PdmBus pdm;
+        pdm.set_state_words(&words, 1 << 3);
+        topology.add(pdm);
+
+        pdm.set_state(true);
+        pdm.set_initial_state(true);
+        EXPECT_EQ(1u << 3, words.actual);
+        EXPECT_EQ(1u << 3, words.expected);
+        EXPECT_EQ(1u << 3, words.initial);
+
+        pdm.set_tripped(true);
+        EXPECT_EQ(0, words.actual);
+        EXPECT_EQ(1u << 3, words.expected);
+
+        pdm.set_state(false);
+        EXPECT_EQ(0, words.actual);
+        EXPECT_EQ(0, words.expected);
+        EXPECT_EQ(1u << 3, words.initial);
+    }
+
+    TEST(TopologyLargeTest, MultiWordChain)
+    {
+        // chain longer than one reset state word
+        const unsigned int NUM = 200;
+        std::vector<CountBus> buses(NUM);
+        BusTopology topology;
+        for(unsigned int i = 0; i < NUM; i++)
+        {
+            topology.add(buses[i]);
+            if(i > 0) topology.connect(i - 1, i);
+        }
+
+        buses[100].reset(true);
+        EXPECT_FALSE(buses[99].is_reset());
+        EXPECT_TRUE(buses[100].is_reset());
+        EXPECT_TRUE(buses[NUM - 1].is_reset());
+        EXPECT_EQ(4, topology.get_reset_state().size());
+
+        buses[0].reset(true);
+        EXPECT_TRUE(buses[99].is_reset());
+        EXPECT_EQ(1, buses[NUM - 1].count);
+
+        buses[0].reset(false);
+        EXPECT_FALSE(buses[NUM - 1].is_reset());
+        EXPECT_EQ(2, buses[NUM - 1].count);
+    }
+}
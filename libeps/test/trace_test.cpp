@@ -0,0 +1,189 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "command.hpp"
+#include "trace.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+    const std::string TRACE_FILE = "trace_test_" + std::to_string(getpid()) + ".json"; // per test process
+
+    // recorded events with name
+    std::vector<TraceEvent> get_events(const char *name)
+    {
+        std::vector<std::pair<uint64_t, TraceEvent>> events;
+        Tracer::get().read(events);
+        std::vector<TraceEvent> named;
+        for(const std::pair<uint64_t, TraceEvent>& event : events)
+        {
+            if(std::strcmp(event.second.name, name) == 0) named.push_back(event.second);
+        }
+        return named;
+    }
+
+    class TraceTest : public ::testing::Test
+    {
+    public:
+        TraceTest() :
+            ::testing::Test()
+        {
+            Tracer::get().clear();
+        }
+
+        ~TraceTest()
+        {
+            Tracer::get().disable();
+            Tracer::get().clear();
+            std::remove(TRACE_FILE.c_str());
+        }
+    };
+
+    TEST_F(TraceTest, Disabled)
+    {
+        {
+            TraceSpan span("span", "test");
+            trace_instant("instant", "test");
+        }
+        EXPECT_TRUE(get_events("span").empty());
+        EXPECT_TRUE(get_events("instant").empty());
+    }
+
+    TEST_F(TraceTest, Span)
+    {
+        Tracer::get().enable();
+        uint64_t begin = Tracer::get().now();
+        {
+            TraceSpan span("span", "test", "value", 42);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        trace_instant("instant", "test");
+
+        std::vector<TraceEvent> spans = get_events("span");
+        ASSERT_EQ(1u, spans.size());
+        EXPECT_EQ(TRACE_COMPLETE, static_cast<TracePhase>(spans[0].phase));
+        EXPECT_GE(spans[0].start_ns, begin);
+        EXPECT_GE(spans[0].duration_ns, 2000000u);
+        EXPECT_STREQ("value", spans[0].arg_name);
+        EXPECT_EQ(42, spans[0].arg);
+        std::vector<TraceEvent> instants = get_events("instant");
+        ASSERT_EQ(1u, instants.size());
+        EXPECT_EQ(TRACE_INSTANT, static_cast<TracePhase>(instants[0].phase));
+        EXPECT_GE(instants[0].start_ns, spans[0].start_ns + spans[0].duration_ns);
+    }
+
+    TEST_F(TraceTest, Threads)
+    {
+        Tracer::get().enable();
+        std::vector<std::thread> threads;
+        for(unsigned int t = 0; t < 4; t++)
+        {
+            threads.push_back(std::thread([]() {
+                for(unsigned int i = 0; i < 100; i++) trace_instant("thread", "test");
+            }));
+        }
+        for(std::thread& thread : threads) thread.join();
+
+        // buffers of exited threads are kept
+        std::vector<std::pair<uint64_t, TraceEvent>> events;
+        Tracer::get().read(events);
+        std::vector<uint64_t> tids;
+        for(const std::pair<uint64_t, TraceEvent>& event : events)
+        {
+            if(std::strcmp(event.second.name, "thread") != 0) continue;
+            if(std::find(tids.begin(), tids.end(), event.first) == tids.end()) tids.push_back(event.first);
+        }
+        EXPECT_EQ(400u, get_events("thread").size());
+        EXPECT_EQ(4u, tids.size());
+    }
+
+    TEST_F(TraceTest, Overwrite)
+    {
+        // thread buffer keeps the latest events
+        Tracer::get().enable(10);
+        std::thread thread([]() {
+            for(unsigned int i = 0; i < 25; i++) trace_instant("overwrite", "test", "i", i);
+        });
+        thread.join();
+        std::vector<TraceEvent> events = get_events("overwrite");
+        ASSERT_EQ(10u, events.size());
+        for(unsigned int i = 0; i < events.size(); i++)
+        {
+            EXPECT_EQ(15 + i, events[i].arg) << i;
+        }
+    }
+
+    TEST_F(TraceTest, Eps)
+    {
+        ByteSwapConfig swap;
+        swap.out = false; // responses in host byte order
+        Eps eps(I2C_ADDRESS, false, swap);
+        Tracer::get().enable();
+
+        I2CData data{CMD_SET_PDM_ON, 0};
+        eps.i2c_write(data);
+        eps.i2c_read(data);
+        eps.set_time(1000);
+        eps.i2c_write(I2CData{CMD_RESET_NODE, 0});
+        eps.set_time(1000 + DEFAULT_BUS_RESET_TIME_MS);
+
+        std::vector<TraceEvent> writes = get_events("i2c_write");
+        ASSERT_EQ(2u, writes.size());
+        EXPECT_EQ(CMD_SET_PDM_ON, writes[0].arg);
+        EXPECT_EQ(CMD_RESET_NODE, writes[1].arg);
+        EXPECT_EQ(1u, get_events("i2c_read").size());
+        EXPECT_EQ(2u, get_events("set_time").size());
+        EXPECT_EQ(1u, get_events("bus_reset_begin").size());
+        EXPECT_EQ(1u, get_events("bus_reset_end").size());
+    }
+
+    TEST_F(TraceTest, Write)
+    {
+        Tracer::get().enable();
+        Tracer::get().set_thread_name("test \"main\"");
+        {
+            TraceSpan span("span", "test", "value", -3);
+        }
+        trace_instant("instant", "test");
+        ASSERT_TRUE(Tracer::get().write(TRACE_FILE));
+
+        std::ifstream file(TRACE_FILE);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        std::string json = stream.str();
+        EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+        EXPECT_NE(std::string::npos, json.find("\"args\":{\"name\":\"test \\\"main\\\"\"}"));
+        EXPECT_NE(std::string::npos, json.find("{\"name\":\"span\",\"cat\":\"test\",\"ph\":\"X\""));
+        EXPECT_NE(std::string::npos, json.find("\"args\":{\"value\":-3}"));
+        EXPECT_NE(std::string::npos, json.find("{\"name\":\"instant\",\"cat\":\"test\",\"ph\":\"i\""));
+        EXPECT_EQ(std::string::npos, json.find("\"name\":\"i2c_write\""));
+    }
+}
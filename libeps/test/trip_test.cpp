@@ -0,0 +1,180 @@
+/* Copyright (C) 2009 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+#include "eps.hpp"
+#include "command.hpp"
+#include <gtest/gtest.h>
+
+using namespace itc::eps;
+
+namespace
+{
+    const uint8_t I2C_ADDRESS = 20;
+    const unsigned int SWITCH = 2;
+
+    class TripTest : public ::testing::Test
+    {
+    public:
+        TripTest() :
+            ::testing::Test(),
+            eps(I2C_ADDRESS, false)
+        {
+            PdmTripConfig config;
+            config.current_limit = 2.0;
+            config.trip_delay_ms = 100;
+            config.retry_delay_ms = 1000;
+            config.max_retries = 2;
+            eps.set_switch_trip_config(SWITCH, config);
+
+            eps.set_telemetry(CHANNEL_ISW3, 1.0);
+            eps.set_switch_state(SWITCH, true);
+        }
+
+        // advance sim time
+        void advance(SimTime delta_ms)
+        {
+            eps.set_time(eps.get_time() + delta_ms);
+        }
+
+        // current switch telemetry value
+        double get_current()
+        {
+            ChannelTelemetry tlm;
+            eps.get_telemetry(CHANNEL_ISW3, tlm);
+            return tlm.analog;
+        }
+
+        Eps eps;
+    };
+
+    TEST_F(TripTest, Config)
+    {
+        PdmTripConfig config = eps.get_switch_trip_config(SWITCH);
+        EXPECT_DOUBLE_EQ(2.0, config.current_limit);
+        EXPECT_EQ(100, config.trip_delay_ms);
+        EXPECT_EQ(1000, config.retry_delay_ms);
+        EXPECT_EQ(2, config.max_retries);
+
+        // default config never trips
+        config = eps.get_switch_trip_config(0);
+        EXPECT_FALSE(config.current_limit < 1e300);
+        EXPECT_EQ(0, config.max_retries);
+    }
+
+    TEST_F(TripTest, NoTripUnderLimit)
+    {
+        advance(10000);
+        EXPECT_TRUE(eps.get_switch_state(SWITCH));
+        EXPECT_FALSE(eps.is_switch_tripped(SWITCH));
+        EXPECT_DOUBLE_EQ(1.0, get_current());
+    }
+
+    TEST_F(TripTest, TripDelay)
+    {
+        // overcurrent shorter than trip delay
+        eps.set_telemetry(CHANNEL_ISW3, 3.0);
+        advance(50);
+        EXPECT_TRUE(eps.get_switch_state(SWITCH));
+        eps.set_telemetry(CHANNEL_ISW3, 1.0);
+        advance(100);
+        EXPECT_TRUE(eps.get_switch_state(SWITCH));
+
+        // overcurrent exceeding trip delay
+        eps.set_telemetry(CHANNEL_ISW3, 3.0);
+        advance(50);
+        EXPECT_TRUE(eps.get_switch_state(SWITCH));
+        advance(100);
+        EXPECT_FALSE(eps.get_switch_state(SWITCH));
+        EXPECT_TRUE(eps.is_switch_tripped(SWITCH));
+        EXPECT_DOUBLE_EQ(0.0, get_current());
+    }
+
+    TEST_F(TripTest, RetryAndLatch)
+    {
+        eps.set_telemetry(CHANNEL_ISW3, 3.0);
+
+        for(int i = 0; i < 2; i++)
+        {
+            // trip
+            advance(0);
+            advance(100);
+            EXPECT_FALSE(eps.get_switch_state(SWITCH));
+            EXPECT_TRUE(eps.is_switch_tripped(SWITCH));
+
+            // retry re-enables switch
+            advance(1000);
+            EXPECT_TRUE(eps.get_switch_state(SWITCH));
+            EXPECT_FALSE(eps.is_switch_tripped(SWITCH));
+            EXPECT_DOUBLE_EQ(3.0, get_current());
+        }
+
+        // retries exhausted, switch latched off
+        advance(0);
+        advance(100);
+        EXPECT_TRUE(eps.is_switch_tripped(SWITCH));
+        advance(10000);
+        EXPECT_FALSE(eps.get_switch_state(SWITCH));
+        EXPECT_TRUE(eps.is_switch_tripped(SWITCH));
+
+        // command clears latch
+        eps.set_telemetry(CHANNEL_ISW3, 1.0);
+        eps.set_switch_state(SWITCH, true);
+        EXPECT_TRUE(eps.get_switch_state(SWITCH));
+        EXPECT_FALSE(eps.is_switch_tripped(SWITCH));
+        advance(10000);
+        EXPECT_TRUE(eps.get_switch_state(SWITCH));
+    }
+
+    TEST_F(TripTest, AutoOff)
+    {
+        // auto-off timer (30s) turns off a tripped switch awaiting retry
+        I2CData data{CMD_SET_PDM_TIMER_LIMIT, 1, SWITCH + 1}; // limit, switch (no byte swap)
+        eps.i2c_write(data);
+        eps.set_telemetry(CHANNEL_ISW3, 3.0);
+        advance(0);
+        advance(100);
+        EXPECT_TRUE(eps.is_switch_tripped(SWITCH));
+        advance(30000);
+        EXPECT_FALSE(eps.get_switch_state(SWITCH));
+        EXPECT_FALSE(eps.is_switch_tripped(SWITCH));
+
+        // no retry for the switch turned off
+        advance(10000);
+        EXPECT_FALSE(eps.get_switch_state(SWITCH));
+        EXPECT_FALSE(eps.is_switch_tripped(SWITCH));
+    }
+
+    TEST_F(TripTest, ExpectedState)
+    {
+        eps.set_telemetry(CHANNEL_ISW3, 3.0);
+        advance(0);
+        advance(100);
+
+        I2CData data{CMD_GET_PDM_ALL_ACTUAL_STATE, 0};
+        eps.i2c_write(data);
+        eps.i2c_read(data);
+        ASSERT_EQ(4, data.size());
+        EXPECT_EQ(0, data[0] & (1 << (SWITCH + 1)));
+
+        data = I2CData{CMD_GET_PDM_ALL_EXPECTED_STATE, 0};
+        eps.i2c_write(data);
+        eps.i2c_read(data);
+        ASSERT_EQ(4, data.size());
+        EXPECT_NE(0, data[0] & (1 << (SWITCH + 1)));
+    }
+}